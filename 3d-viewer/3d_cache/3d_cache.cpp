@@ -29,6 +29,12 @@
 #include <fstream>
 #include <utility>
 #include <iterator>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <set>
+#include <thread>
+#include <vector>
 
 #include <wx/datetime.h>
 #include <wx/filename.h>
@@ -57,6 +63,9 @@
 
 #define MASK_3D_CACHE "3D_CACHE"
 
+// extension of the flat model cache files which hold the render data
+#define MODEL_CACHE_EXT ".3dcf"
+
 static wxCriticalSection lock3D_cache;
 
 
@@ -205,7 +214,8 @@ S3D_CACHE::~S3D_CACHE()
 }
 
 
-SCENEGRAPH* S3D_CACHE::load( const wxString& aModelFile, S3D_CACHE_ENTRY** aCachePtr )
+SCENEGRAPH* S3D_CACHE::load( const wxString& aModelFile, S3D_CACHE_ENTRY** aCachePtr,
+                             bool aSceneRequired )
 {
     if( aCachePtr )
         *aCachePtr = NULL;
@@ -262,6 +272,20 @@ SCENEGRAPH* S3D_CACHE::load( const wxString& aModelFile, S3D_CACHE_ENTRY** aCach
             }
         }
 
+        // an entry read from a flat model cache file only holds render data;
+        // its scene graph is loaded on first demand
+        if( aSceneRequired && NULL == mi->second->sceneData && NULL != mi->second->renderData )
+        {
+            if( !loadCacheData( mi->second ) )
+            {
+                mi->second->sceneData = m_Plugins->Load3DModel( full3Dpath,
+                                                                mi->second->pluginInfo );
+
+                if( NULL != mi->second->sceneData )
+                    saveCacheData( mi->second );
+            }
+        }
+
         if( NULL != aCachePtr )
             *aCachePtr = mi->second;
 
@@ -269,7 +293,7 @@ SCENEGRAPH* S3D_CACHE::load( const wxString& aModelFile, S3D_CACHE_ENTRY** aCach
     }
 
     // a cache item does not exist; search the Filename->Cachename map
-    return checkCache( full3Dpath, aCachePtr );
+    return checkCache( full3Dpath, aCachePtr, aSceneRequired );
 }
 
 
@@ -279,7 +303,8 @@ SCENEGRAPH* S3D_CACHE::Load( const wxString& aModelFile )
 }
 
 
-SCENEGRAPH* S3D_CACHE::checkCache( const wxString& aFileName, S3D_CACHE_ENTRY** aCachePtr )
+SCENEGRAPH* S3D_CACHE::checkCache( const wxString& aFileName, S3D_CACHE_ENTRY** aCachePtr,
+                                   bool aSceneRequired )
 {
     if( aCachePtr )
         *aCachePtr = NULL;
@@ -336,6 +361,11 @@ SCENEGRAPH* S3D_CACHE::checkCache( const wxString& aFileName, S3D_CACHE_ENTRY**
 
     ep->SetSHA1( sha1sum );
 
+    // the flat model cache holds the render data directly, so the scene graph
+    // is not needed at all when only the render data is wanted
+    if( !aSceneRequired && loadModelCacheData( ep ) )
+        return ep->sceneData;
+
     wxString bname = ep->GetCacheBaseName();
     wxString cachename = m_CacheDir + bname + wxT( ".3dc" );
 
@@ -502,6 +532,58 @@ bool S3D_CACHE::saveCacheData( S3D_CACHE_ENTRY* aCacheItem )
 }
 
 
+bool S3D_CACHE::loadModelCacheData( S3D_CACHE_ENTRY* aCacheItem )
+{
+    if( m_CacheDir.empty() )
+        return false;
+
+    wxString fname = m_CacheDir + aCacheItem->GetCacheBaseName() + wxT( MODEL_CACHE_EXT );
+
+    if( !wxFileName::FileExists( fname ) )
+        return false;
+
+    if( NULL != aCacheItem->renderData )
+        S3D::Destroy3DModel( &aCacheItem->renderData );
+
+    aCacheItem->renderData = S3D::ReadModelCache( fname.ToUTF8(), m_Plugins, checkTag );
+
+    return NULL != aCacheItem->renderData;
+}
+
+
+bool S3D_CACHE::saveModelCacheData( S3D_CACHE_ENTRY* aCacheItem )
+{
+    if( NULL == aCacheItem || NULL == aCacheItem->renderData )
+    {
+        wxLogTrace( MASK_3D_CACHE, "%s:%s:%d\n * aCacheItem has no valid render data",
+                    __FILE__, __FUNCTION__, __LINE__ );
+
+        return false;
+    }
+
+    if( m_CacheDir.empty() )
+    {
+        wxLogTrace( MASK_3D_CACHE,
+                    " * [3D model] cannot save model cache; config directory unknown" );
+
+        return false;
+    }
+
+    wxString fname = m_CacheDir + aCacheItem->GetCacheBaseName() + wxT( MODEL_CACHE_EXT );
+
+    if( wxFileName::Exists( fname ) && !wxFileName::FileExists( fname ) )
+    {
+        wxLogTrace( MASK_3D_CACHE, " * [3D model] path exists but is not a regular file '%s'",
+                    fname );
+
+        return false;
+    }
+
+    return S3D::WriteModelCache( fname.ToUTF8(), aCacheItem->renderData,
+                                 aCacheItem->pluginInfo.c_str() );
+}
+
+
 bool S3D_CACHE::Set3DConfigDir( const wxString& aConfigDir )
 {
     if( !m_ConfigDir.empty() )
@@ -725,7 +807,10 @@ void S3D_CACHE::ClosePlugins( void )
 S3DMODEL* S3D_CACHE::GetModel( const wxString& aModelFileName )
 {
     S3D_CACHE_ENTRY* cp = NULL;
-    SCENEGRAPH* sp = load( aModelFileName, &cp );
+    SCENEGRAPH* sp = load( aModelFileName, &cp, false );
+
+    if( cp && cp->renderData )
+        return cp->renderData;
 
     if( !sp )
         return NULL;
@@ -739,16 +824,185 @@ S3DMODEL* S3D_CACHE::GetModel( const wxString& aModelFileName )
         return NULL;
     }
 
-    if( cp->renderData )
-        return cp->renderData;
-
     S3DMODEL* mp = S3D::GetModel( sp );
     cp->renderData = mp;
 
+    if( NULL != mp )
+        saveModelCacheData( cp );
+
     return mp;
 }
 
 
+void S3D_CACHE::PreloadModels( const std::list< wxString >& aModelFiles )
+{
+    if( m_CacheDir.empty() )
+        return;
+
+    struct PRELOAD_ITEM
+    {
+        wxString      path;
+        wxDateTime    modTime;
+        bool          hashed;
+        unsigned char sha1sum[20];
+        S3DMODEL*     model;
+        SCENEGRAPH*   scene;
+        std::string   pluginInfo;
+        bool          fromPlugin;
+    };
+
+    // resolve the file names serially; only models not yet in the cache
+    // are of interest, and each one only once
+    std::vector< PRELOAD_ITEM > items;
+    std::set< wxString > seen;
+
+    for( const wxString& modelFile : aModelFiles )
+    {
+        if( modelFile.empty() )
+            continue;
+
+        wxString full3Dpath = m_FNResolver->ResolvePath( modelFile );
+
+        if( full3Dpath.empty() || !seen.insert( full3Dpath ).second )
+            continue;
+
+        wxCriticalSectionLocker lock( lock3D_cache );
+
+        if( m_CacheMap.find( full3Dpath ) == m_CacheMap.end() )
+        {
+            PRELOAD_ITEM item;
+            item.path = full3Dpath;
+            item.hashed = false;
+            item.model = NULL;
+            item.scene = NULL;
+            item.fromPlugin = false;
+            items.push_back( item );
+        }
+    }
+
+    if( items.empty() )
+        return;
+
+    // hash the model files and read their cache files in parallel; the flat
+    // model cache is preferred since it holds the render data directly
+    std::atomic<size_t> nextItem( 0 );
+    std::atomic<size_t> threadsFinished( 0 );
+
+    size_t parallelThreadCount = std::min<size_t>(
+            std::max<size_t>( std::thread::hardware_concurrency(), 2 ), items.size() );
+
+    for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+    {
+        std::thread t = std::thread( [&]()
+        {
+            for( size_t i = nextItem.fetch_add( 1 ); i < items.size();
+                 i = nextItem.fetch_add( 1 ) )
+            {
+                PRELOAD_ITEM& item = items[i];
+
+                item.modTime = wxFileName( item.path ).GetModificationTime();
+                item.hashed = getSHA1( item.path, item.sha1sum );
+
+                if( !item.hashed )
+                    continue;
+
+                wxString bname = m_CacheDir + sha1ToWXString( item.sha1sum );
+                wxString fname = bname + wxT( MODEL_CACHE_EXT );
+
+                if( wxFileName::FileExists( fname ) )
+                    item.model = S3D::ReadModelCache( fname.ToUTF8(), m_Plugins, checkTag );
+
+                fname = bname + wxT( ".3dc" );
+
+                if( NULL == item.model && wxFileName::FileExists( fname ) )
+                {
+                    item.scene = (SCENEGRAPH*) S3D::ReadCache( fname.ToUTF8(), m_Plugins,
+                                                               checkTag );
+                }
+            }
+
+            threadsFinished++;
+        } );
+
+        t.detach();
+    }
+
+    while( threadsFinished < parallelThreadCount )
+        std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+
+    // load the models which are not cached at all through the plugins
+    std::vector< wxString > pluginFiles;
+    std::vector< size_t >   pluginItems;
+
+    for( size_t i = 0; i < items.size(); ++i )
+    {
+        if( items[i].hashed && NULL == items[i].model && NULL == items[i].scene )
+        {
+            pluginFiles.push_back( items[i].path );
+            pluginItems.push_back( i );
+        }
+    }
+
+    if( !pluginFiles.empty() )
+    {
+        std::vector< SCENEGRAPH* > scenes;
+        std::vector< std::string > pluginInfo;
+
+        m_Plugins->Load3DModels( pluginFiles, scenes, pluginInfo );
+
+        for( size_t i = 0; i < pluginItems.size(); ++i )
+        {
+            PRELOAD_ITEM& item = items[pluginItems[i]];
+            item.scene = scenes[i];
+            item.pluginInfo = pluginInfo[i];
+            item.fromPlugin = true;
+        }
+    }
+
+    // add all models to the cache; as in checkCache(), models which could not
+    // be loaded get an entry too so no further attempts are made
+    wxCriticalSectionLocker lock( lock3D_cache );
+    size_t fromCache = 0;
+    size_t fromPlugin = 0;
+
+    for( PRELOAD_ITEM& item : items )
+    {
+        S3D_CACHE_ENTRY* ep = new S3D_CACHE_ENTRY;
+        ep->modTime = item.modTime;
+        ep->renderData = item.model;
+        ep->sceneData = item.scene;
+        ep->pluginInfo = item.pluginInfo;
+
+        if( item.hashed )
+            ep->SetSHA1( item.sha1sum );
+
+        if( m_CacheMap.insert( std::pair< wxString, S3D_CACHE_ENTRY* >
+                                   ( item.path, ep ) ).second == false )
+        {
+            // the model was loaded in the meantime
+            delete ep;
+            continue;
+        }
+
+        m_CacheList.push_back( ep );
+
+        if( item.fromPlugin && NULL != item.scene )
+        {
+            saveCacheData( ep );
+            ++fromPlugin;
+        }
+        else if( NULL != item.model || NULL != item.scene )
+        {
+            ++fromCache;
+        }
+    }
+
+    wxLogTrace( MASK_3D_CACHE, " * [3D model] preloaded %u models: %u from the cache, "
+                "%u through the plugins", (unsigned) items.size(), (unsigned) fromCache,
+                (unsigned) fromPlugin );
+}
+
+
 wxString S3D_CACHE::GetModelHash( const wxString& aModelFileName )
 {
     wxString full3Dpath = m_FNResolver->ResolvePath( aModelFileName );
@@ -81,10 +81,14 @@ private:
      *
      * @param[in]   aFileName   file name (full or partial path)
      * @param[out]  aCachePtr   optional return address for cache entry pointer
+     * @param[in]   aSceneRequired  false if only the render data is wanted; the
+     *                              scene graph is then not loaded when a flat
+     *                              model cache file is available
      * @return      SCENEGRAPH object associated with file name
      * @retval      NULL    on error
      */
-    SCENEGRAPH* checkCache( const wxString& aFileName, S3D_CACHE_ENTRY** aCachePtr = NULL );
+    SCENEGRAPH* checkCache( const wxString& aFileName, S3D_CACHE_ENTRY** aCachePtr = NULL,
+                            bool aSceneRequired = true );
 
     /**
      * Function getSHA1
@@ -103,8 +107,15 @@ private:
     // save scene data to a cache file
     bool saveCacheData( S3D_CACHE_ENTRY* aCacheItem );
 
+    // load render data from a flat model cache file
+    bool loadModelCacheData( S3D_CACHE_ENTRY* aCacheItem );
+
+    // save render data to a flat model cache file
+    bool saveModelCacheData( S3D_CACHE_ENTRY* aCacheItem );
+
     // the real load function (can supply a cache entry pointer to member functions)
-    SCENEGRAPH* load( const wxString& aModelFile, S3D_CACHE_ENTRY** aCachePtr = NULL );
+    SCENEGRAPH* load( const wxString& aModelFile, S3D_CACHE_ENTRY** aCachePtr = NULL,
+                      bool aSceneRequired = true );
 
 public:
     S3D_CACHE();
@@ -200,6 +211,18 @@ public:
      */
     S3DMODEL* GetModel( const wxString& aModelFileName );
 
+    /**
+     * Function PreloadModels
+     * loads the given models in parallel and adds them to the cache, so that
+     * the following calls to GetModel() do not have to load them one by one.
+     * Models are read from the flat model cache files, else from the scene
+     * cache files, else through the plugins (see S3D_PLUGIN_MANAGER::Load3DModels).
+     * Each resolved file name is loaded once; models already in the cache are skipped.
+     *
+     * @param aModelFiles is the list of partial or full paths of the models
+     */
+    void PreloadModels( const std::list< wxString >& aModelFiles );
+
     wxString GetModelHash( const wxString& aModelFileName );
 };
 
@@ -25,6 +25,12 @@
 #include <utility>
 #include <iostream>
 #include <sstream>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <thread>
 
 #include <wx/config.h>
 #include <wx/dir.h>
@@ -518,6 +524,108 @@ SCENEGRAPH* S3D_PLUGIN_MANAGER::Load3DModel( const wxString& aFileName, std::str
 }
 
 
+void S3D_PLUGIN_MANAGER::Load3DModels( const std::vector< wxString >& aFileNames,
+                                       std::vector< SCENEGRAPH* >& aScenes,
+                                       std::vector< std::string >& aPluginInfo )
+{
+    aScenes.assign( aFileNames.size(), NULL );
+    aPluginInfo.assign( aFileNames.size(), std::string() );
+
+    if( aFileNames.empty() )
+        return;
+
+    // find the candidate plugins of each model and open them up front,
+    // so the threads below only have to invoke Load()
+    std::vector< std::string > names( aFileNames.size() );
+    std::vector< std::vector< KICAD_PLUGIN_LDR_3D* > > candidates( aFileNames.size() );
+    std::map< KICAD_PLUGIN_LDR_3D*, bool > canRender;
+    std::set< KICAD_PLUGIN_LDR_3D* > concurrent;
+
+    for( size_t i = 0; i < aFileNames.size(); ++i )
+    {
+        names[i] = aFileNames[i].ToUTF8();
+
+        wxString ext = wxFileName( aFileNames[i] ).GetExt();
+
+        #ifdef _WIN32
+        ext.LowerCase();
+        #endif
+
+        auto items = m_ExtMap.equal_range( ext );
+
+        for( auto sL = items.first; sL != items.second; ++sL )
+        {
+            KICAD_PLUGIN_LDR_3D* plugin = sL->second;
+            auto it = canRender.find( plugin );
+
+            if( it == canRender.end() )
+            {
+                it = canRender.insert( std::make_pair( plugin, plugin->CanRender() ) ).first;
+
+                if( it->second && plugin->CanLoadConcurrently() )
+                    concurrent.insert( plugin );
+            }
+
+            if( it->second )
+                candidates[i].push_back( plugin );
+        }
+    }
+
+    // the locale is switched once for the whole batch: the plugins only
+    // switch it themselves when it is not already the "C" locale, so the
+    // threads below never call setlocale()
+    LOCALE_IO toggle;
+
+    // serializes the plugins which cannot load several models at once
+    std::mutex serialLock;
+
+    std::atomic<size_t> nextModel( 0 );
+    std::atomic<size_t> threadsFinished( 0 );
+
+    size_t parallelThreadCount = std::min<size_t>(
+            std::max<size_t>( std::thread::hardware_concurrency(), 2 ), aFileNames.size() );
+
+    for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+    {
+        std::thread t = std::thread( [&]()
+        {
+            for( size_t i = nextModel.fetch_add( 1 ); i < aFileNames.size();
+                 i = nextModel.fetch_add( 1 ) )
+            {
+                for( KICAD_PLUGIN_LDR_3D* plugin : candidates[i] )
+                {
+                    SCENEGRAPH* sp = NULL;
+
+                    if( concurrent.count( plugin ) )
+                    {
+                        sp = plugin->Load( names[i].c_str() );
+                    }
+                    else
+                    {
+                        std::lock_guard<std::mutex> lock( serialLock );
+                        sp = plugin->Load( names[i].c_str() );
+                    }
+
+                    if( NULL != sp )
+                    {
+                        plugin->GetPluginInfo( aPluginInfo[i] );
+                        aScenes[i] = sp;
+                        break;
+                    }
+                }
+            }
+
+            threadsFinished++;
+        } );
+
+        t.detach();
+    }
+
+    while( threadsFinished < parallelThreadCount )
+        std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+}
+
+
 void S3D_PLUGIN_MANAGER::ClosePlugins( void )
 {
     std::list< KICAD_PLUGIN_LDR_3D* >::iterator sP = m_Plugins.begin();
@@ -32,6 +32,7 @@
 #include <map>
 #include <list>
 #include <string>
+#include <vector>
 #include <wx/string.h>
 
 class wxWindow;
@@ -84,6 +85,20 @@ public:
 
     SCENEGRAPH* Load3DModel( const wxString& aFileName, std::string& aPluginInfo );
 
+    /**
+     * Function Load3DModels
+     * loads several models at once on a pool of threads. Plugins which can
+     * load concurrently (see CanLoadConcurrently() in 3d_plugin.h) run in
+     * parallel; the others are run one model at a time.
+     *
+     * @param aFileNames is the list of full paths of the models to load
+     * @param aScenes receives the scene of each model, NULL on failure
+     * @param aPluginInfo receives the PluginName:Version tag of each model's plugin
+     */
+    void Load3DModels( const std::vector< wxString >& aFileNames,
+                       std::vector< SCENEGRAPH* >& aScenes,
+                       std::vector< std::string >& aPluginInfo );
+
     /**
      * Function ClosePlugins
      * iterates through all discovered plugins and closes them to
@@ -24,6 +24,9 @@
 #include <iostream>
 #include <sstream>
 #include <fstream>
+#include <vector>
+#include <cstdint>
+#include <cstring>
 #include <wx/filename.h>
 #include <wx/log.h>
 #include "plugins/3dapi/ifsg_api.h"
@@ -43,6 +46,14 @@ static char BadNode[] = " * [BUG] NULL pointer passed for aNode\n";
 // version format of the cache file
 #define SG_VERSION_TAG "VERSION:2"
 
+// magic and version of the flat model cache file
+#define SG_MODEL_CACHE_MAGIC "KC3DFLAT"
+#define SG_MODEL_CACHE_VERSION 1
+
+// flags of a mesh within the flat model cache file
+#define SG_MODEL_CACHE_TEXCOORDS 1
+#define SG_MODEL_CACHE_COLORS    2
+
 
 static void formatMaterial( SMATERIAL& mat, SGAPPEARANCE const* app )
 {
@@ -533,6 +544,306 @@ S3DMODEL* S3D::GetModel( SCENEGRAPH* aNode )
 }
 
 
+// The flat model cache file is a plain image of an S3DMODEL in native byte order;
+// every field is a multiple of 4 bytes long so all arrays stay aligned:
+//
+//   char[8]    SG_MODEL_CACHE_MAGIC
+//   uint32_t   SG_MODEL_CACHE_VERSION, sizeof( SMATERIAL ), sizeof( SFVEC3F ),
+//              sizeof( SFVEC2F )
+//   uint32_t   plugin info length N, followed by N chars padded to 4 bytes
+//   uint32_t   number of materials, number of meshes
+//   SMATERIAL  materials[]
+//   per mesh:
+//   uint32_t   m_VertexSize, m_FaceIdxSize, m_MaterialIdx, flags
+//   SFVEC3F    positions[], normals[]
+//   SFVEC2F    texcoords[] (if flags & SG_MODEL_CACHE_TEXCOORDS)
+//   SFVEC3F    colors[] (if flags & SG_MODEL_CACHE_COLORS)
+//   uint32_t   face indices[]
+
+static void putU32( std::vector<char>& aBuf, uint32_t aValue )
+{
+    const char* p = reinterpret_cast<const char*>( &aValue );
+    aBuf.insert( aBuf.end(), p, p + sizeof( aValue ) );
+}
+
+
+static void putArray( std::vector<char>& aBuf, const void* aData, size_t aSize )
+{
+    const char* p = static_cast<const char*>( aData );
+    aBuf.insert( aBuf.end(), p, p + aSize );
+}
+
+
+/**
+ * FLAT_READER
+ * is a bounds checked cursor over the contents of a flat model cache file
+ */
+class FLAT_READER
+{
+public:
+    FLAT_READER( const std::vector<char>& aBuf ) : m_buf( aBuf ), m_pos( 0 ) {}
+
+    bool GetU32( uint32_t& aValue )
+    {
+        return Get( &aValue, sizeof( aValue ) );
+    }
+
+    bool Get( void* aData, size_t aSize )
+    {
+        if( aSize > m_buf.size() - m_pos )
+            return false;
+
+        memcpy( aData, &m_buf[m_pos], aSize );
+        m_pos += aSize;
+        return true;
+    }
+
+    bool Skip( size_t aSize )
+    {
+        if( aSize > m_buf.size() - m_pos )
+            return false;
+
+        m_pos += aSize;
+        return true;
+    }
+
+    bool AtEnd() const { return m_pos == m_buf.size(); }
+
+private:
+    const std::vector<char>& m_buf;
+    size_t                   m_pos;
+};
+
+
+bool S3D::WriteModelCache( const char* aFileName, const S3DMODEL* aModel,
+    const char* aPluginInfo )
+{
+    if( NULL == aFileName || aFileName[0] == 0 || NULL == aModel )
+        return false;
+
+    std::string pluginInfo;
+
+    if( NULL != aPluginInfo && aPluginInfo[0] != 0 )
+        pluginInfo = aPluginInfo;
+    else
+        pluginInfo = "INTERNAL:0.0.0.0";
+
+    // build the whole image in memory so the file is written with a single call
+    size_t bufSize = 64 + pluginInfo.size() + aModel->m_MaterialsSize * sizeof( SMATERIAL );
+
+    for( unsigned int i = 0; i < aModel->m_MeshesSize; ++i )
+    {
+        const SMESH& mesh = aModel->m_Meshes[i];
+
+        bufSize += 16 + mesh.m_VertexSize * ( 4 * sizeof( SFVEC3F ) + sizeof( SFVEC2F ) )
+                   + mesh.m_FaceIdxSize * sizeof( uint32_t );
+    }
+
+    std::vector<char> buf;
+    buf.reserve( bufSize );
+
+    putArray( buf, SG_MODEL_CACHE_MAGIC, 8 );
+    putU32( buf, SG_MODEL_CACHE_VERSION );
+    putU32( buf, sizeof( SMATERIAL ) );
+    putU32( buf, sizeof( SFVEC3F ) );
+    putU32( buf, sizeof( SFVEC2F ) );
+
+    putU32( buf, pluginInfo.size() );
+    putArray( buf, pluginInfo.data(), pluginInfo.size() );
+    buf.resize( ( buf.size() + 3 ) & ~(size_t) 3, 0 );
+
+    putU32( buf, aModel->m_MaterialsSize );
+    putU32( buf, aModel->m_MeshesSize );
+    putArray( buf, aModel->m_Materials, aModel->m_MaterialsSize * sizeof( SMATERIAL ) );
+
+    for( unsigned int i = 0; i < aModel->m_MeshesSize; ++i )
+    {
+        const SMESH& mesh = aModel->m_Meshes[i];
+        uint32_t flags = 0;
+
+        if( mesh.m_Texcoords )
+            flags |= SG_MODEL_CACHE_TEXCOORDS;
+
+        if( mesh.m_Color )
+            flags |= SG_MODEL_CACHE_COLORS;
+
+        putU32( buf, mesh.m_VertexSize );
+        putU32( buf, mesh.m_FaceIdxSize );
+        putU32( buf, mesh.m_MaterialIdx );
+        putU32( buf, flags );
+
+        putArray( buf, mesh.m_Positions, mesh.m_VertexSize * sizeof( SFVEC3F ) );
+        putArray( buf, mesh.m_Normals, mesh.m_VertexSize * sizeof( SFVEC3F ) );
+
+        if( mesh.m_Texcoords )
+            putArray( buf, mesh.m_Texcoords, mesh.m_VertexSize * sizeof( SFVEC2F ) );
+
+        if( mesh.m_Color )
+            putArray( buf, mesh.m_Color, mesh.m_VertexSize * sizeof( SFVEC3F ) );
+
+        putArray( buf, mesh.m_FaceIdx, mesh.m_FaceIdxSize * sizeof( uint32_t ) );
+    }
+
+    OPEN_OSTREAM( output, aFileName );
+
+    if( output.fail() )
+    {
+        wxString errmsg;
+        errmsg << __FILE__ << ": " << __FUNCTION__ << ": " << __LINE__ << "\n";
+        errmsg << " * [INFO] " << "failed to open file" << " '" << aFileName << "'";
+        wxLogTrace( MASK_3D_SG, errmsg );
+        return false;
+    }
+
+    output.write( buf.data(), buf.size() );
+    bool rval = !output.fail();
+    CLOSE_STREAM( output );
+
+    if( !rval )
+    {
+        // delete the defective file
+        wxRemoveFile( wxString::FromUTF8Unchecked( aFileName ) );
+    }
+
+    return rval;
+}
+
+
+S3DMODEL* S3D::ReadModelCache( const char* aFileName, void* aPluginMgr,
+        bool (*aTagCheck)( const char*, void* ) )
+{
+    if( NULL == aFileName || aFileName[0] == 0 )
+        return NULL;
+
+    OPEN_ISTREAM( file, aFileName );
+
+    if( file.fail() )
+        return NULL;
+
+    // read the whole file with a single call; the arrays are then copied out
+    // of the buffer without any per-field stream I/O
+    file.seekg( 0, std::ios_base::end );
+    std::streamoff fileSize = file.tellg();
+    file.seekg( 0, std::ios_base::beg );
+
+    if( fileSize <= 0 )
+    {
+        CLOSE_STREAM( file );
+        return NULL;
+    }
+
+    std::vector<char> buf( (size_t) fileSize );
+    file.read( buf.data(), buf.size() );
+    bool readOk = !file.fail();
+    CLOSE_STREAM( file );
+
+    if( !readOk )
+        return NULL;
+
+    FLAT_READER reader( buf );
+    char magic[8];
+    uint32_t version, matSize, vec3Size, vec2Size, infoSize;
+
+    if( !reader.Get( magic, 8 ) || memcmp( magic, SG_MODEL_CACHE_MAGIC, 8 )
+        || !reader.GetU32( version ) || version != SG_MODEL_CACHE_VERSION
+        || !reader.GetU32( matSize ) || matSize != sizeof( SMATERIAL )
+        || !reader.GetU32( vec3Size ) || vec3Size != sizeof( SFVEC3F )
+        || !reader.GetU32( vec2Size ) || vec2Size != sizeof( SFVEC2F )
+        || !reader.GetU32( infoSize ) )
+    {
+        wxLogTrace( MASK_3D_SG, " * [INFO] '%s' is not a valid model cache file", aFileName );
+        return NULL;
+    }
+
+    std::string pluginInfo( infoSize, 0 );
+
+    if( !reader.Get( &pluginInfo[0], infoSize ) || !reader.Skip( ( 4 - infoSize % 4 ) % 4 ) )
+        return NULL;
+
+    if( NULL != aTagCheck && !aTagCheck( pluginInfo.c_str(), aPluginMgr ) )
+    {
+        wxLogTrace( MASK_3D_SG, " * [INFO] model cache file '%s' has an incompatible plugin "
+                    "tag '%s'", aFileName, pluginInfo.c_str() );
+        return NULL;
+    }
+
+    uint32_t nMaterials, nMeshes;
+
+    if( !reader.GetU32( nMaterials ) || !reader.GetU32( nMeshes ) || 0 == nMeshes
+        || nMaterials > buf.size() / sizeof( SMATERIAL ) || nMeshes > buf.size() / 16 )
+    {
+        return NULL;
+    }
+
+    S3DMODEL* model = S3D::New3DModel();
+
+    model->m_Materials = new SMATERIAL[nMaterials];
+    model->m_MaterialsSize = nMaterials;
+    model->m_Meshes = new SMESH[nMeshes];
+    model->m_MeshesSize = nMeshes;
+
+    for( uint32_t i = 0; i < nMeshes; ++i )
+        S3D::INIT_SMESH( model->m_Meshes[i] );
+
+    bool ok = reader.Get( model->m_Materials, nMaterials * sizeof( SMATERIAL ) );
+
+    for( uint32_t i = 0; ok && i < nMeshes; ++i )
+    {
+        SMESH& mesh = model->m_Meshes[i];
+        uint32_t nVertex, nIndex, matIdx, flags;
+
+        ok = reader.GetU32( nVertex ) && reader.GetU32( nIndex ) && reader.GetU32( matIdx )
+             && reader.GetU32( flags );
+
+        // reject sizes which cannot possibly fit in the file before allocating
+        if( !ok || matIdx >= nMaterials || nVertex > buf.size() / ( 2 * sizeof( SFVEC3F ) )
+            || nIndex > buf.size() / sizeof( uint32_t ) )
+        {
+            ok = false;
+            break;
+        }
+
+        mesh.m_VertexSize = nVertex;
+        mesh.m_FaceIdxSize = nIndex;
+        mesh.m_MaterialIdx = matIdx;
+        mesh.m_Positions = new SFVEC3F[nVertex];
+        mesh.m_Normals = new SFVEC3F[nVertex];
+        mesh.m_FaceIdx = new unsigned int[nIndex];
+
+        ok = reader.Get( mesh.m_Positions, nVertex * sizeof( SFVEC3F ) )
+             && reader.Get( mesh.m_Normals, nVertex * sizeof( SFVEC3F ) );
+
+        if( ok && ( flags & SG_MODEL_CACHE_TEXCOORDS ) )
+        {
+            mesh.m_Texcoords = new SFVEC2F[nVertex];
+            ok = reader.Get( mesh.m_Texcoords, nVertex * sizeof( SFVEC2F ) );
+        }
+
+        if( ok && ( flags & SG_MODEL_CACHE_COLORS ) )
+        {
+            mesh.m_Color = new SFVEC3F[nVertex];
+            ok = reader.Get( mesh.m_Color, nVertex * sizeof( SFVEC3F ) );
+        }
+
+        ok = ok && reader.Get( mesh.m_FaceIdx, nIndex * sizeof( uint32_t ) );
+
+        // the renderers index the vertex arrays without further checks
+        for( uint32_t j = 0; ok && j < nIndex; ++j )
+            ok = mesh.m_FaceIdx[j] < nVertex;
+    }
+
+    if( !ok || !reader.AtEnd() )
+    {
+        wxLogTrace( MASK_3D_SG, " * [INFO] model cache file '%s' is truncated or corrupt",
+                    aFileName );
+        S3D::Destroy3DModel( &model );
+        return NULL;
+    }
+
+    return model;
+}
+
+
 void S3D::Destroy3DModel( S3DMODEL** aModel )
 {
     if( NULL == aModel || NULL == *aModel )
@@ -43,6 +43,8 @@
  */
 const wxChar *CINFO3D_VISU::m_logTrace = wxT( "KI_TRACE_EDA_CINFO3D_VISU" );
 
+std::mutex CINFO3D_VISU::s_textLock;
+
 
 CINFO3D_VISU G_null_CINFO3D_VISU;
 
@@ -31,6 +31,7 @@
 #define CINFO3D_VISU_H
 
 #include <vector>
+#include <mutex>
 #include "../3d_rendering/3d_render_raytracing/accelerators/ccontainer2d.h"
 #include "../3d_rendering/3d_render_raytracing/accelerators/ccontainer.h"
 #include "../3d_rendering/3d_render_raytracing/shapes3D/cbbox.h"
@@ -50,6 +51,7 @@
 #include <class_zone.h>
 #include <class_module.h>
 #include <reporter.h>
+#include <md5_hash.h>
 
 /// A type that stores a container of 2d objects for each layer id
 typedef std::map< PCB_LAYER_ID, CBVHCONTAINER2D *> MAP_CONTAINER_2D;
@@ -421,6 +423,45 @@ class CINFO3D_VISU
     void createBoardPolygon();
     void createLayers( REPORTER *aStatusTextReporter );
     void destroyLayers();
+    void destroyHoles();
+
+    /**
+     * @brief buildCopperLayer - converts the tracks, pads, module graphics and
+     * drawings of a copper layer into its (already created) container and,
+     * for the legacy OpenGL render with copper thickness, into its poly.
+     * The zones are added to the container by createLayers.
+     * Thread safe for different layers.
+     * @param aLayerId - the copper layer to build
+     * @param aTrackList - the tracks of the board on enabled layers
+     */
+    void buildCopperLayer( PCB_LAYER_ID aLayerId,
+                           const std::vector< const TRACK *> &aTrackList );
+
+    /**
+     * @brief buildTechLayer - converts all the items of a technical layer into
+     * its (already created) container and poly.
+     * Thread safe for different layers.
+     * @param aLayerId - the technical layer to build
+     */
+    void buildTechLayer( PCB_LAYER_ID aLayerId );
+
+    /**
+     * @brief layersSettingsHash - hash of the settings the layer conversion depends on
+     * (board, scale, copper layers count, render engine and flags).
+     * When it changes, all layers must be rebuilt.
+     */
+    MD5_HASH layersSettingsHash() const;
+
+    /**
+     * @brief layerItemsHash - hash of the geometry of all the board items
+     * that are converted into the layer aLayerId.
+     * Used to reuse the containers of the layers that did not change
+     * since the last call to createLayers.
+     * @param aLayerId - the layer to hash
+     * @param aTrackList - the tracks of the board on enabled layers
+     */
+    MD5_HASH layerItemsHash( PCB_LAYER_ID aLayerId,
+                             const std::vector< const TRACK *> &aTrackList ) const;
 
     // Helper functions to create the board
     COBJECT2D *createNewTrack( const TRACK* aTrack , int aClearanceValue ) const;
@@ -547,6 +588,12 @@ private:
     /// It contains polygon contours for each layer
     MAP_POLY          m_layers_poly;
 
+    /// Hash of the items of each layer, when its container and poly were built
+    std::map< PCB_LAYER_ID, MD5_HASH > m_layers_hash;
+
+    /// Hash of the settings used to build the layers (see layersSettingsHash)
+    MD5_HASH          m_layers_settings_hash;
+
     /// It contains polygon contours for holes of each layer (outer holes)
     MAP_POLY          m_layers_outer_holes_poly;
 
@@ -663,6 +710,11 @@ private:
      */
     static const wxChar *m_logTrace;
 
+    /// Texts are converted by GRText through the global basic_gal and
+    /// static call back parameters, so text conversions must be serialized
+    /// when layers are built in parallel.
+    static std::mutex s_textLock;
+
 };
 
 /// This is a dummy visualization configuration
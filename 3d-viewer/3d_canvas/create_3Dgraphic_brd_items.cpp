@@ -97,6 +97,8 @@ void CINFO3D_VISU::AddShapeWithClearanceToContainer( const TEXTE_PCB* aText,
     if( aText->IsMirrored() )
         size.x = -size.x;
 
+    std::lock_guard<std::mutex> lock( s_textLock );
+
     s_boardItem    = (const BOARD_ITEM *) &aText;
     s_dstcontainer = aDstContainer;
     s_textWidth    = aText->GetThickness() + ( 2 * aClearanceValue );
@@ -215,6 +217,11 @@ void CINFO3D_VISU::AddGraphicsShapesWithClearanceToContainer( const MODULE* aMod
     if( aModule->Value().GetLayer() == aLayerId && aModule->Value().IsVisible() )
         texts.push_back( &aModule->Value() );
 
+    if( texts.empty() )
+        return;
+
+    std::lock_guard<std::mutex> lock( s_textLock );
+
     s_boardItem    = (const BOARD_ITEM *)&aModule->Value();
     s_dstcontainer = aDstContainer;
     s_biuTo3Dunits = m_biuTo3Dunits;
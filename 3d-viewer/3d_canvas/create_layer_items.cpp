@@ -55,9 +55,11 @@
 #include <thread>
 #include <algorithm>
 #include <atomic>
+#include <chrono>
 
 #include <profile.h>
 
+
 void CINFO3D_VISU::destroyLayers()
 {
     if( !m_layers_poly.empty() )
@@ -73,6 +75,28 @@ void CINFO3D_VISU::destroyLayers()
         m_layers_poly.clear();
     }
 
+    if( !m_layers_container2D.empty() )
+    {
+        for( MAP_CONTAINER_2D::iterator ii = m_layers_container2D.begin();
+             ii != m_layers_container2D.end();
+             ++ii )
+        {
+            delete ii->second;
+            ii->second = NULL;
+        }
+
+        m_layers_container2D.clear();
+    }
+
+    m_layers_hash.clear();
+    m_layers_settings_hash.Init();
+
+    destroyHoles();
+}
+
+
+void CINFO3D_VISU::destroyHoles()
+{
     if( !m_layers_inner_holes_poly.empty() )
     {
         for( MAP_POLY::iterator ii = m_layers_inner_holes_poly.begin();
@@ -99,48 +123,609 @@ void CINFO3D_VISU::destroyLayers()
         m_layers_outer_holes_poly.clear();
     }
 
-    if( !m_layers_container2D.empty() )
+    if( !m_layers_holes2D.empty() )
     {
-        for( MAP_CONTAINER_2D::iterator ii = m_layers_container2D.begin();
-             ii != m_layers_container2D.end();
+        for( MAP_CONTAINER_2D::iterator ii = m_layers_holes2D.begin();
+             ii != m_layers_holes2D.end();
              ++ii )
         {
-            delete ii->second;
-            ii->second = NULL;
+            delete ii->second;
+            ii->second = NULL;
+        }
+
+        m_layers_holes2D.clear();
+    }
+
+    m_through_holes_inner.Clear();
+    m_through_holes_outer.Clear();
+    m_through_holes_vias_outer.Clear();
+    m_through_holes_vias_inner.Clear();
+    m_through_outer_holes_poly_NPTH.RemoveAllContours();
+    m_through_outer_holes_poly.RemoveAllContours();
+    //m_through_inner_holes_poly.RemoveAllContours();
+
+    m_through_outer_holes_vias_poly.RemoveAllContours();
+    m_through_inner_holes_vias_poly.RemoveAllContours();
+}
+
+
+// Helpers to build the hash of the items of a layer
+// /////////////////////////////////////////////////////////////////////////////
+
+static void hashPoint( MD5_HASH &aHash, const wxPoint &aPoint )
+{
+    aHash.Hash( aPoint.x );
+    aHash.Hash( aPoint.y );
+}
+
+
+static void hashSize( MD5_HASH &aHash, const wxSize &aSize )
+{
+    aHash.Hash( aSize.x );
+    aHash.Hash( aSize.y );
+}
+
+
+static void hashDouble( MD5_HASH &aHash, double aValue )
+{
+    aHash.Hash( (uint8_t *) &aValue, sizeof( aValue ) );
+}
+
+
+static void hashString( MD5_HASH &aHash, const wxString &aString )
+{
+    const wxScopedCharBuffer buffer = aString.utf8_str();
+
+    aHash.Hash( (uint8_t *) buffer.data(), buffer.length() );
+}
+
+
+static void hashPoly( MD5_HASH &aHash, const SHAPE_POLY_SET &aPoly )
+{
+    aHash.Hash( aPoly.OutlineCount() );
+
+    for( auto vertex = aPoly.CIterateWithHoles(); vertex; vertex++ )
+    {
+        aHash.Hash( vertex->x );
+        aHash.Hash( vertex->y );
+    }
+}
+
+
+static void hashText( MD5_HASH &aHash, const EDA_TEXT &aText, double aAngle )
+{
+    hashString( aHash, aText.GetShownText() );
+    hashPoint( aHash, aText.GetTextPos() );
+    hashSize( aHash, aText.GetTextSize() );
+    hashDouble( aHash, aAngle );
+    aHash.Hash( aText.GetThickness() );
+    aHash.Hash( aText.GetHorizJustify() );
+    aHash.Hash( aText.GetVertJustify() );
+    aHash.Hash( aText.IsMirrored() );
+    aHash.Hash( aText.IsItalic() );
+    aHash.Hash( aText.IsVisible() );
+    aHash.Hash( aText.IsMultilineAllowed() );
+}
+
+
+static void hashDrawSegment( MD5_HASH &aHash, const DRAWSEGMENT &aSegment )
+{
+    aHash.Hash( aSegment.GetShape() );
+    hashPoint( aHash, aSegment.GetStart() );
+    hashPoint( aHash, aSegment.GetEnd() );
+    aHash.Hash( aSegment.GetWidth() );
+    hashDouble( aHash, aSegment.GetAngle() );
+
+    for( const wxPoint &pt : aSegment.GetBezierPoints() )
+        hashPoint( aHash, pt );
+
+    hashPoly( aHash, aSegment.GetPolyShape() );
+}
+
+
+static void hashPad( MD5_HASH &aHash, const D_PAD &aPad )
+{
+    hashPoint( aHash, aPad.GetPosition() );
+    hashSize( aHash, aPad.GetSize() );
+    hashDouble( aHash, aPad.GetOrientation() );
+    aHash.Hash( aPad.GetShape() );
+    aHash.Hash( aPad.GetAttribute() );
+    hashSize( aHash, aPad.GetDrillSize() );
+    aHash.Hash( aPad.GetDrillShape() );
+    hashPoint( aHash, aPad.GetOffset() );
+    hashSize( aHash, aPad.GetDelta() );
+    aHash.Hash( aPad.GetRoundRectCornerRadius() );
+    aHash.Hash( aPad.GetSolderMaskMargin() );
+    hashSize( aHash, aPad.GetSolderPasteMargin() );
+    hashPoly( aHash, aPad.GetCustomShapeAsPolygon() );
+}
+
+
+MD5_HASH CINFO3D_VISU::layersSettingsHash() const
+{
+    MD5_HASH hash;
+
+    hash.Init();
+
+    const BOARD *board = m_board;
+    hash.Hash( (uint8_t *) &board, sizeof( board ) );
+
+    hashDouble( hash, m_biuTo3Dunits );
+    hash.Hash( m_copperLayersCount );
+    hash.Hash( m_render_engine );
+    hash.Hash( GetCopperThicknessBIU() );
+    hash.Hash( g_DrawDefaultLineThickness );
+
+    for( size_t flag = 0; flag < m_drawFlags.size(); ++flag )
+        hash.Hash( m_drawFlags[flag] );
+
+    // The list of tracks, so all copper layers, depends on the enabled layers
+    for( int layer = 0; layer < PCB_LAYER_ID_COUNT; ++layer )
+        hash.Hash( Is3DLayerEnabled( static_cast<PCB_LAYER_ID>( layer ) ) );
+
+    hash.Finalize();
+
+    return hash;
+}
+
+
+MD5_HASH CINFO3D_VISU::layerItemsHash( PCB_LAYER_ID aLayerId,
+                                       const std::vector< const TRACK *> &aTrackList ) const
+{
+    MD5_HASH hash;
+
+    hash.Init();
+    hash.Hash( aLayerId );
+
+    if( IsCopperLayer( aLayerId ) )
+    {
+        for( const TRACK *track : aTrackList )
+        {
+            if( !track->IsOnLayer( aLayerId ) )
+                continue;
+
+            hash.Hash( track->Type() );
+            hashPoint( hash, track->GetStart() );
+            hashPoint( hash, track->GetEnd() );
+            hash.Hash( track->GetWidth() );
+        }
+    }
+
+    for( auto module : m_board->Modules() )
+    {
+        for( auto pad : module->Pads() )
+        {
+            if( pad->IsOnLayer( aLayerId ) )
+                hashPad( hash, *pad );
+        }
+
+        for( auto item : module->GraphicalItems() )
+        {
+            if( item->GetLayer() != aLayerId )
+                continue;
+
+            switch( item->Type() )
+            {
+            case PCB_MODULE_TEXT_T:
+            {
+                const TEXTE_MODULE *text = static_cast<const TEXTE_MODULE *>( item );
+                hashText( hash, *text, text->GetDrawRotation() );
+            }
+            break;
+
+            case PCB_MODULE_EDGE_T:
+                hashDrawSegment( hash, *static_cast<const EDGE_MODULE *>( item ) );
+                break;
+
+            default:
+                break;
+            }
+        }
+
+        if( module->Reference().GetLayer() == aLayerId )
+            hashText( hash, module->Reference(), module->Reference().GetDrawRotation() );
+
+        if( module->Value().GetLayer() == aLayerId )
+            hashText( hash, module->Value(), module->Value().GetDrawRotation() );
+    }
+
+    for( auto item : m_board->Drawings() )
+    {
+        if( !item->IsOnLayer( aLayerId ) )
+            continue;
+
+        hash.Hash( item->Type() );
+
+        switch( item->Type() )
+        {
+        case PCB_LINE_T:
+            hashDrawSegment( hash, *static_cast<const DRAWSEGMENT *>( item ) );
+            break;
+
+        case PCB_TEXT_T:
+        {
+            const TEXTE_PCB *text = static_cast<const TEXTE_PCB *>( item );
+            hashText( hash, *text, text->GetTextAngle() );
+        }
+        break;
+
+        case PCB_DIMENSION_T:
+        {
+            const DIMENSION *dimension = static_cast<const DIMENSION *>( item );
+
+            hashText( hash, dimension->Text(), dimension->Text().GetTextAngle() );
+            hash.Hash( dimension->GetWidth() );
+
+            const wxPoint *points[] = {
+                &dimension->m_crossBarO,     &dimension->m_crossBarF,
+                &dimension->m_featureLineGO, &dimension->m_featureLineGF,
+                &dimension->m_featureLineDO, &dimension->m_featureLineDF,
+                &dimension->m_arrowD1F,      &dimension->m_arrowD2F,
+                &dimension->m_arrowG1F,      &dimension->m_arrowG2F };
+
+            for( const wxPoint *pt : points )
+                hashPoint( hash, *pt );
+        }
+        break;
+
+        default:
+            break;
+        }
+    }
+
+    for( int ii = 0; ii < m_board->GetAreaCount(); ++ii )
+    {
+        const ZONE_CONTAINER *zone = m_board->GetArea( ii );
+
+        if( ( zone == nullptr ) || !zone->IsOnLayer( aLayerId ) )
+            continue;
+
+        hashPoly( hash, zone->GetFilledPolysList() );
+    }
+
+    hash.Finalize();
+
+    return hash;
+}
+
+
+void CINFO3D_VISU::buildCopperLayer( PCB_LAYER_ID aLayerId,
+                                     const std::vector< const TRACK *> &aTrackList )
+{
+    // Note: only find() is used on the maps, they are shared with the other threads
+    wxASSERT( m_layers_container2D.find( aLayerId ) != m_layers_container2D.end() );
+
+    CBVHCONTAINER2D *layerContainer = m_layers_container2D.find( aLayerId )->second;
+
+    // ADD TRACKS
+    for( const TRACK *track : aTrackList )
+    {
+        // NOTE: Vias can be on multiple layers
+        if( !track->IsOnLayer( aLayerId ) )
+            continue;
+
+        // Add object item to layer container
+        layerContainer->Add( createNewTrack( track, 0.0f ) );
+    }
+
+    // ADD PADS
+    for( auto module : m_board->Modules() )
+    {
+        // Note: NPTH pads are not drawn on copper layers when the pad
+        // has same shape as its hole
+        AddPadsShapesWithClearanceToContainer( module,
+                                               layerContainer,
+                                               aLayerId,
+                                               0,
+                                               true );
+
+        // Micro-wave modules may have items on copper layers
+        AddGraphicsShapesWithClearanceToContainer( module,
+                                                   layerContainer,
+                                                   aLayerId,
+                                                   0 );
+    }
+
+    // ADD GRAPHIC ITEMS ON COPPER LAYERS (texts)
+    for( auto item : m_board->Drawings() )
+    {
+        if( !item->IsOnLayer( aLayerId ) )
+            continue;
+
+        switch( item->Type() )
+        {
+        case PCB_LINE_T:
+        {
+            AddShapeWithClearanceToContainer( (DRAWSEGMENT*)item,
+                                              layerContainer,
+                                              aLayerId,
+                                              0 );
+        }
+        break;
+
+        case PCB_TEXT_T:
+            AddShapeWithClearanceToContainer( (TEXTE_PCB*) item,
+                                              layerContainer,
+                                              aLayerId,
+                                              0 );
+        break;
+
+        case PCB_DIMENSION_T:
+            AddShapeWithClearanceToContainer( (DIMENSION*) item,
+                                              layerContainer,
+                                              aLayerId,
+                                              0 );
+        break;
+
+        default:
+            wxLogTrace( m_logTrace,
+                        wxT( "createLayers: item type: %d not implemented" ),
+                        item->Type() );
+        break;
+        }
+    }
+
+    // The poly contours are only created for the legacy OpenGL render
+    // with copper thickness
+    // /////////////////////////////////////////////////////////////////////////
+    MAP_POLY::const_iterator layerPolyIter = m_layers_poly.find( aLayerId );
+
+    if( layerPolyIter == m_layers_poly.end() )
+        return;
+
+    SHAPE_POLY_SET *layerPoly = layerPolyIter->second;
+
+    // Creates outline contours of the tracks and add it to the poly of the layer
+    for( const TRACK *track : aTrackList )
+    {
+        if( !track->IsOnLayer( aLayerId ) )
+            continue;
+
+        // Add the track contour
+        track->TransformShapeWithClearanceToPolygon( *layerPoly, 0 );
+    }
+
+    // Add modules PADs poly contourns
+    for( auto module : m_board->Modules() )
+    {
+        // Note: NPTH pads are not drawn on copper layers when the pad
+        // has same shape as its hole
+        transformPadsShapesWithClearanceToPolygon( module->Pads(),
+                                                   aLayerId,
+                                                   *layerPoly,
+                                                   0,
+                                                   true );
+
+        // Micro-wave modules may have items on copper layers
+        {
+            std::lock_guard<std::mutex> lock( s_textLock );
+            module->TransformGraphicTextWithClearanceToPolygonSet( aLayerId, *layerPoly, 0 );
+        }
+
+        transformGraphicModuleEdgeToPolygonSet( module, aLayerId, *layerPoly );
+    }
+
+    // Add graphic item on copper layers to poly contourns
+    for( auto item : m_board->Drawings() )
+    {
+        if( !item->IsOnLayer( aLayerId ) )
+            continue;
+
+        switch( item->Type() )
+        {
+        case PCB_LINE_T:
+            ( (DRAWSEGMENT*) item )->TransformShapeWithClearanceToPolygon( *layerPoly, 0 );
+            break;
+
+        case PCB_TEXT_T:
+        {
+            std::lock_guard<std::mutex> lock( s_textLock );
+            ( (TEXTE_PCB*) item )->TransformShapeWithClearanceToPolygonSet( *layerPoly, 0 );
+        }
+        break;
+
+        default:
+            wxLogTrace( m_logTrace, wxT( "createLayers: item type: %d not implemented" ),
+                    item->Type() );
+            break;
+        }
+    }
+
+    // ADD COPPER ZONES
+    if( GetFlag( FL_ZONE ) )
+    {
+        for( int ii = 0; ii < m_board->GetAreaCount(); ++ii )
+        {
+            const ZONE_CONTAINER* zone = m_board->GetArea( ii );
+
+            if( zone == nullptr )
+                break;
+
+            if( zone->GetLayer() == aLayerId )
+                zone->TransformSolidAreasShapesToPolygonSet( *layerPoly );
+        }
+    }
+
+    // This will make a union of all added contours
+    layerPoly->Simplify( SHAPE_POLY_SET::PM_FAST );
+}
+
+
+void CINFO3D_VISU::buildTechLayer( PCB_LAYER_ID aLayerId )
+{
+    // Note: only find() is used on the maps, they are shared with the other threads
+    wxASSERT( m_layers_container2D.find( aLayerId ) != m_layers_container2D.end() );
+    wxASSERT( m_layers_poly.find( aLayerId ) != m_layers_poly.end() );
+
+    CBVHCONTAINER2D *layerContainer = m_layers_container2D.find( aLayerId )->second;
+    SHAPE_POLY_SET *layerPoly = m_layers_poly.find( aLayerId )->second;
+
+    // Add drawing objects
+    // /////////////////////////////////////////////////////////////////////
+    for( auto item : m_board->Drawings() )
+    {
+        if( !item->IsOnLayer( aLayerId ) )
+            continue;
+
+        switch( item->Type() )
+        {
+        case PCB_LINE_T:
+            AddShapeWithClearanceToContainer( (DRAWSEGMENT*)item,
+                                              layerContainer,
+                                              aLayerId,
+                                              0 );
+            break;
+
+        case PCB_TEXT_T:
+            AddShapeWithClearanceToContainer( (TEXTE_PCB*) item,
+                                              layerContainer,
+                                              aLayerId,
+                                              0 );
+            break;
+
+        case PCB_DIMENSION_T:
+            AddShapeWithClearanceToContainer( (DIMENSION*) item,
+                                              layerContainer,
+                                              aLayerId,
+                                              0 );
+            break;
+
+        default:
+            break;
+        }
+    }
+
+
+    // Add drawing contours
+    // /////////////////////////////////////////////////////////////////////
+    for( auto item : m_board->Drawings() )
+    {
+        if( !item->IsOnLayer( aLayerId ) )
+            continue;
+
+        switch( item->Type() )
+        {
+        case PCB_LINE_T:
+            ( (DRAWSEGMENT*) item )->TransformShapeWithClearanceToPolygon( *layerPoly, 0 );
+            break;
+
+        case PCB_TEXT_T:
+        {
+            std::lock_guard<std::mutex> lock( s_textLock );
+            ( (TEXTE_PCB*) item )->TransformShapeWithClearanceToPolygonSet( *layerPoly, 0 );
+        }
+        break;
+
+        default:
+            break;
+        }
+    }
+
+
+    // Add modules tech layers - objects
+    // /////////////////////////////////////////////////////////////////////
+    for( auto module : m_board->Modules() )
+    {
+        if( (aLayerId == F_SilkS) || (aLayerId == B_SilkS) )
+        {
+            int     linewidth = g_DrawDefaultLineThickness;
+
+            for( auto pad : module->Pads() )
+            {
+                if( !pad->IsOnLayer( aLayerId ) )
+                    continue;
+
+                buildPadShapeThickOutlineAsSegments( pad, layerContainer, linewidth );
+            }
+        }
+        else
+        {
+            AddPadsShapesWithClearanceToContainer(
+                    module, layerContainer, aLayerId, 0, false );
+        }
+
+        AddGraphicsShapesWithClearanceToContainer( module, layerContainer, aLayerId, 0 );
+    }
+
+
+    // Add modules tech layers - contours
+    // /////////////////////////////////////////////////////////////////////
+    for( auto module : m_board->Modules() )
+    {
+        if( (aLayerId == F_SilkS) || (aLayerId == B_SilkS) )
+        {
+            const int linewidth = g_DrawDefaultLineThickness;
+
+            for( auto pad : module->Pads() )
+            {
+                if( !pad->IsOnLayer( aLayerId ) )
+                    continue;
+
+                buildPadShapeThickOutlineAsPolygon( pad, *layerPoly, linewidth );
+            }
+        }
+        else
+        {
+            transformPadsShapesWithClearanceToPolygon(
+                    module->Pads(), aLayerId, *layerPoly, 0, false );
         }
 
-        m_layers_container2D.clear();
+        // On tech layers, use a poor circle approximation, only for texts (stroke font)
+        {
+            std::lock_guard<std::mutex> lock( s_textLock );
+            module->TransformGraphicTextWithClearanceToPolygonSet( aLayerId, *layerPoly, 0 );
+        }
+
+        // Add the remaining things with dynamic seg count for circles
+        transformGraphicModuleEdgeToPolygonSet( module, aLayerId, *layerPoly );
     }
 
-    if( !m_layers_holes2D.empty() )
+
+    // Draw non copper zones
+    // /////////////////////////////////////////////////////////////////////
+    if( GetFlag( FL_ZONE ) )
     {
-        for( MAP_CONTAINER_2D::iterator ii = m_layers_holes2D.begin();
-             ii != m_layers_holes2D.end();
-             ++ii )
+        for( int ii = 0; ii < m_board->GetAreaCount(); ++ii )
         {
-            delete ii->second;
-            ii->second = NULL;
+            ZONE_CONTAINER* zone = m_board->GetArea( ii );
+
+            if( !zone->IsOnLayer( aLayerId ) )
+                continue;
+
+            AddSolidAreasShapesToContainer( zone,
+                                            layerContainer,
+                                            aLayerId );
         }
 
-        m_layers_holes2D.clear();
-    }
+        for( int ii = 0; ii < m_board->GetAreaCount(); ++ii )
+        {
+            ZONE_CONTAINER* zone = m_board->GetArea( ii );
 
-    m_through_holes_inner.Clear();
-    m_through_holes_outer.Clear();
-    m_through_holes_vias_outer.Clear();
-    m_through_holes_vias_inner.Clear();
-    m_through_outer_holes_poly_NPTH.RemoveAllContours();
-    m_through_outer_holes_poly.RemoveAllContours();
-    //m_through_inner_holes_poly.RemoveAllContours();
+            if( !zone->IsOnLayer( aLayerId ) )
+                continue;
 
-    m_through_outer_holes_vias_poly.RemoveAllContours();
-    m_through_inner_holes_vias_poly.RemoveAllContours();
+            zone->TransformSolidAreasShapesToPolygonSet( *layerPoly );
+        }
+    }
+
+    // This will make a union of all added contours
+    layerPoly->Simplify( SHAPE_POLY_SET::PM_FAST );
 }
 
 
 void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
 {
-    destroyLayers();
+    // The layers are kept from the previous call and only the ones whose items
+    // changed are rebuilt. A change of the settings they depend on invalidates all.
+    // The holes are cheap compared to the layers and are always rebuilt.
+    const MD5_HASH settingsHash = layersSettingsHash();
+
+    if( !m_layers_settings_hash.IsValid() || ( m_layers_settings_hash != settingsHash ) )
+        destroyLayers();
+    else
+        destroyHoles();
+
+    m_layers_settings_hash = settingsHash;
 
     // Build Copper layers
     // Based on: https://github.com/KiCad/kicad-source-mirror/blob/master/3d-viewer/3d_draw.cpp#L692
@@ -202,7 +787,7 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
     start_Time = GetRunningMicroSecs();
 #endif
 
-    // Prepare copper layers index and containers
+    // Prepare copper and tech layers index
     // /////////////////////////////////////////////////////////////////////////
     std::vector< PCB_LAYER_ID > layer_id;
     layer_id.clear();
@@ -219,57 +804,155 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
             continue;
 
         layer_id.push_back( curr_layer_id );
+    }
+
+    // draw graphic items, on technical layers
+    static const PCB_LAYER_ID teckLayerList[] = {
+            B_Adhes,
+            F_Adhes,
+            B_Paste,
+            F_Paste,
+            B_SilkS,
+            F_SilkS,
+            B_Mask,
+            F_Mask,
+
+            // Aux Layers
+            Dwgs_User,
+            Cmts_User,
+            Eco1_User,
+            Eco2_User,
+            Edge_Cuts,
+            Margin
+        };
+
+    // User layers are not drawn here, only technical layers
+    std::vector< PCB_LAYER_ID > all_layer_id( layer_id );
+
+    for( LSEQ seq = LSET::AllNonCuMask().Seq( teckLayerList, arrayDim( teckLayerList ) );
+         seq;
+         ++seq )
+    {
+        const PCB_LAYER_ID curr_layer_id = *seq;
+
+        if( !Is3DLayerEnabled( curr_layer_id ) )
+                    continue;
+
+        all_layer_id.push_back( curr_layer_id );
+    }
 
-        CBVHCONTAINER2D *layerContainer = new CBVHCONTAINER2D;
-        m_layers_container2D[curr_layer_id] = layerContainer;
+    auto releaseLayer = [&]( PCB_LAYER_ID aLayerId )
+    {
+        MAP_CONTAINER_2D::iterator container = m_layers_container2D.find( aLayerId );
 
-        if( GetFlag( FL_RENDER_OPENGL_COPPER_THICKNESS ) &&
-            (m_render_engine == RENDER_ENGINE_OPENGL_LEGACY) )
+        if( container != m_layers_container2D.end() )
         {
-            SHAPE_POLY_SET *layerPoly = new SHAPE_POLY_SET;
-            m_layers_poly[curr_layer_id] = layerPoly;
+            delete container->second;
+            m_layers_container2D.erase( container );
         }
-    }
 
-#ifdef PRINT_STATISTICS_3D_VIEWER
-    printf( "T02: %.3f ms\n", (float)( GetRunningMicroSecs() - start_Time ) / 1e3 );
-    start_Time = GetRunningMicroSecs();
-#endif
+        MAP_POLY::iterator poly = m_layers_poly.find( aLayerId );
 
-    if( aStatusTextReporter )
-        aStatusTextReporter->Report( _( "Create tracks and vias" ) );
+        if( poly != m_layers_poly.end() )
+        {
+            delete poly->second;
+            m_layers_poly.erase( poly );
+        }
 
-    // Create tracks as objects and add it to container
-    // /////////////////////////////////////////////////////////////////////////
-    for( unsigned int lIdx = 0; lIdx < layer_id.size(); ++lIdx )
+        m_layers_hash.erase( aLayerId );
+    };
+
+    // Release the layers that are not shown anymore
+    std::vector< PCB_LAYER_ID > hidden_layer_id;
+
+    for( MAP_CONTAINER_2D::const_iterator ii = m_layers_container2D.begin();
+         ii != m_layers_container2D.end();
+         ++ii )
     {
-        const PCB_LAYER_ID curr_layer_id = layer_id[lIdx];
+        if( std::find( all_layer_id.begin(), all_layer_id.end(), ii->first ) ==
+            all_layer_id.end() )
+            hidden_layer_id.push_back( ii->first );
+    }
 
-        wxASSERT( m_layers_container2D.find( curr_layer_id ) != m_layers_container2D.end() );
+    for( PCB_LAYER_ID hidden_layer : hidden_layer_id )
+        releaseLayer( hidden_layer );
+
+    // Find the layers whose items changed and create their containers
+    // /////////////////////////////////////////////////////////////////////////
+    if( aStatusTextReporter )
+        aStatusTextReporter->Report( _( "Check modified layers" ) );
 
-        CBVHCONTAINER2D *layerContainer = m_layers_container2D[curr_layer_id];
+    std::vector< MD5_HASH > layerHash( all_layer_id.size() );
 
-        // ADD TRACKS
-        unsigned int nTracks = trackList.size();
+    {
+        std::atomic<size_t> nextItem( 0 );
+        std::atomic<size_t> threadsFinished( 0 );
 
-        for( unsigned int trackIdx = 0; trackIdx < nTracks; ++trackIdx )
+        size_t parallelThreadCount = std::min<size_t>(
+                std::max<size_t>( std::thread::hardware_concurrency(), 2 ),
+                all_layer_id.size() );
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
         {
-            const TRACK *track = trackList[trackIdx];
+            std::thread t = std::thread( [&]()
+            {
+                for( size_t i = nextItem.fetch_add( 1 );
+                            i < all_layer_id.size();
+                            i = nextItem.fetch_add( 1 ) )
+                {
+                    layerHash[i] = layerItemsHash( all_layer_id[i], trackList );
+                }
 
-            // NOTE: Vias can be on multiple layers
-            if( !track->IsOnLayer( curr_layer_id ) )
-                continue;
+                threadsFinished++;
+            } );
 
-            // Add object item to layer container
-            layerContainer->Add( createNewTrack( track, 0.0f ) );
+            t.detach();
         }
+
+        while( threadsFinished < parallelThreadCount )
+            std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+    }
+
+    const bool buildCopperPoly = GetFlag( FL_RENDER_OPENGL_COPPER_THICKNESS ) &&
+                                 (m_render_engine == RENDER_ENGINE_OPENGL_LEGACY);
+
+    std::vector< PCB_LAYER_ID > build_layer_id;
+    std::vector< bool > layerRebuilt( PCB_LAYER_ID_COUNT, false );
+
+    for( unsigned int lIdx = 0; lIdx < all_layer_id.size(); ++lIdx )
+    {
+        const PCB_LAYER_ID curr_layer_id = all_layer_id[lIdx];
+
+        std::map< PCB_LAYER_ID, MD5_HASH >::const_iterator cached =
+                m_layers_hash.find( curr_layer_id );
+
+        // Unchanged layer, keep its container and poly
+        if( ( cached != m_layers_hash.end() ) && ( cached->second == layerHash[lIdx] ) )
+            continue;
+
+        releaseLayer( curr_layer_id );
+
+        m_layers_container2D[curr_layer_id] = new CBVHCONTAINER2D;
+
+        if( !IsCopperLayer( curr_layer_id ) || buildCopperPoly )
+            m_layers_poly[curr_layer_id] = new SHAPE_POLY_SET;
+
+        m_layers_hash[curr_layer_id] = layerHash[lIdx];
+        layerRebuilt[curr_layer_id] = true;
+        build_layer_id.push_back( curr_layer_id );
     }
 
+    wxLogTrace( m_logTrace, wxT( "createLayers: %u layers rebuilt, %u reused" ),
+                (unsigned int) build_layer_id.size(),
+                (unsigned int)( all_layer_id.size() - build_layer_id.size() ) );
+
 #ifdef PRINT_STATISTICS_3D_VIEWER
-    printf( "T03: %.3f ms\n", (float)( GetRunningMicroSecs() - start_Time  ) / 1e3 );
+    printf( "T02: %.3f ms\n", (float)( GetRunningMicroSecs() - start_Time ) / 1e3 );
     start_Time = GetRunningMicroSecs();
 #endif
 
+    if( aStatusTextReporter )
+        aStatusTextReporter->Report( _( "Create vias and holes" ) );
+
     // Create VIAS and THTs objects and add it to holes containers
     // /////////////////////////////////////////////////////////////////////////
     for( unsigned int lIdx = 0; lIdx < layer_id.size(); ++lIdx )
@@ -350,7 +1033,7 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
     }
 
 #ifdef PRINT_STATISTICS_3D_VIEWER
-    printf( "T04: %.3f ms\n", (float)( GetRunningMicroSecs() - start_Time  ) / 1e3 );
+    printf( "T03: %.3f ms\n", (float)( GetRunningMicroSecs() - start_Time  ) / 1e3 );
     start_Time = GetRunningMicroSecs();
 #endif
 
@@ -448,41 +1131,7 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
     }
 
 #ifdef PRINT_STATISTICS_3D_VIEWER
-    printf( "T05: %.3f ms\n", (float)( GetRunningMicroSecs() - start_Time  ) / 1e3 );
-    start_Time = GetRunningMicroSecs();
-#endif
-
-    // Creates outline contours of the tracks and add it to the poly of the layer
-    // /////////////////////////////////////////////////////////////////////////
-    if( GetFlag( FL_RENDER_OPENGL_COPPER_THICKNESS ) &&
-        (m_render_engine == RENDER_ENGINE_OPENGL_LEGACY) )
-    {
-        for( unsigned int lIdx = 0; lIdx < layer_id.size(); ++lIdx )
-        {
-            const PCB_LAYER_ID curr_layer_id = layer_id[lIdx];
-
-            wxASSERT( m_layers_poly.find( curr_layer_id ) != m_layers_poly.end() );
-
-            SHAPE_POLY_SET *layerPoly = m_layers_poly[curr_layer_id];
-
-            // ADD TRACKS
-            unsigned int nTracks = trackList.size();
-
-            for( unsigned int trackIdx = 0; trackIdx < nTracks; ++trackIdx )
-            {
-                const TRACK *track = trackList[trackIdx];
-
-                if( !track->IsOnLayer( curr_layer_id ) )
-                    continue;
-
-                // Add the track contour
-                track->TransformShapeWithClearanceToPolygon( *layerPoly, 0 );
-            }
-        }
-    }
-
-#ifdef PRINT_STATISTICS_3D_VIEWER
-    printf( "T06: %.3f ms\n", (float)( GetRunningMicroSecs()  - start_Time  ) / 1e3 );
+    printf( "T04: %.3f ms\n", (float)( GetRunningMicroSecs() - start_Time  ) / 1e3 );
     start_Time = GetRunningMicroSecs();
 #endif
 
@@ -502,257 +1151,79 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
             const int inflate = (pad->GetAttribute () != PAD_ATTRIB_HOLE_NOT_PLATED) ?
                                 GetCopperThicknessBIU() : 0;
 
-            m_stats_nr_holes++;
-            m_stats_hole_med_diameter += ( ( pad->GetDrillSize().x +
-                                             pad->GetDrillSize().y ) / 2.0f ) * m_biuTo3Dunits;
-
-            m_through_holes_outer.Add( createNewPadDrill( pad, inflate ) );
-            m_through_holes_inner.Add( createNewPadDrill( pad,       0 ) );
-        }
-    }
-    if( m_stats_nr_holes )
-        m_stats_hole_med_diameter /= (float)m_stats_nr_holes;
-
-#ifdef PRINT_STATISTICS_3D_VIEWER
-    printf( "T07: %.3f ms\n", (float)( GetRunningMicroSecs() - start_Time  ) / 1e3 );
-    start_Time = GetRunningMicroSecs();
-#endif
-
-    // Add contours of the pad holes (pads can be Circle or Segment holes)
-    // /////////////////////////////////////////////////////////////////////////
-    for( auto module : m_board->Modules() )
-    {
-        for( auto pad : module->Pads() )
-        {
-            const wxSize padHole = pad->GetDrillSize();
-
-            if( !padHole.x ) // Not drilled pad like SMD pad
-                continue;
-
-            // The hole in the body is inflated by copper thickness.
-            const int inflate = GetCopperThicknessBIU();
-
-            if( pad->GetAttribute () != PAD_ATTRIB_HOLE_NOT_PLATED )
-            {
-                pad->BuildPadDrillShapePolygon( m_through_outer_holes_poly, inflate );
-
-                pad->BuildPadDrillShapePolygon( m_through_inner_holes_poly, 0 );
-            }
-            else
-            {
-                // If not plated, no copper.
-                pad->BuildPadDrillShapePolygon( m_through_outer_holes_poly_NPTH, inflate );
-            }
-        }
-    }
-
-#ifdef PRINT_STATISTICS_3D_VIEWER
-    printf( "T08: %.3f ms\n", (float)( GetRunningMicroSecs()  - start_Time  ) / 1e3 );
-    start_Time = GetRunningMicroSecs();
-#endif
-
-    // Add modules PADs objects to containers
-    // /////////////////////////////////////////////////////////////////////////
-    for( unsigned int lIdx = 0; lIdx < layer_id.size(); ++lIdx )
-    {
-        const PCB_LAYER_ID curr_layer_id = layer_id[lIdx];
-
-        wxASSERT( m_layers_container2D.find( curr_layer_id ) != m_layers_container2D.end() );
-
-        CBVHCONTAINER2D *layerContainer = m_layers_container2D[curr_layer_id];
-
-        // ADD PADS
-        for( auto module : m_board->Modules() )
-        {
-            // Note: NPTH pads are not drawn on copper layers when the pad
-            // has same shape as its hole
-            AddPadsShapesWithClearanceToContainer( module,
-                                                   layerContainer,
-                                                   curr_layer_id,
-                                                   0,
-                                                   true );
-
-            // Micro-wave modules may have items on copper layers
-            AddGraphicsShapesWithClearanceToContainer( module,
-                                                       layerContainer,
-                                                       curr_layer_id,
-                                                       0 );
-        }
-    }
-
-#ifdef PRINT_STATISTICS_3D_VIEWER
-    printf( "T09: %.3f ms\n", (float)( GetRunningMicroSecs()  - start_Time  ) / 1e3 );
-    start_Time = GetRunningMicroSecs();
-#endif
-
-    // Add modules PADs poly contourns
-    // /////////////////////////////////////////////////////////////////////////
-    if( GetFlag( FL_RENDER_OPENGL_COPPER_THICKNESS ) &&
-        (m_render_engine == RENDER_ENGINE_OPENGL_LEGACY) )
-    {
-        for( unsigned int lIdx = 0; lIdx < layer_id.size(); ++lIdx )
-        {
-            const PCB_LAYER_ID curr_layer_id = layer_id[lIdx];
-
-            wxASSERT( m_layers_poly.find( curr_layer_id ) != m_layers_poly.end() );
-
-            SHAPE_POLY_SET *layerPoly = m_layers_poly[curr_layer_id];
-
-            // ADD PADS
-            for( auto module : m_board->Modules() )
-            {
-                // Construct polys
-                // /////////////////////////////////////////////////////////////
-
-                // Note: NPTH pads are not drawn on copper layers when the pad
-                // has same shape as its hole
-                transformPadsShapesWithClearanceToPolygon( module->Pads(),
-                                                           curr_layer_id,
-                                                           *layerPoly,
-                                                           0,
-                                                           true );
-
-                // Micro-wave modules may have items on copper layers
-                module->TransformGraphicTextWithClearanceToPolygonSet(
-                        curr_layer_id, *layerPoly, 0 );
-
-                transformGraphicModuleEdgeToPolygonSet( module, curr_layer_id, *layerPoly );
-            }
-        }
-    }
-
-#ifdef PRINT_STATISTICS_3D_VIEWER
-    printf( "T10: %.3f ms\n", (float)( GetRunningMicroSecs() - start_Time  ) / 1e3 );
-    start_Time = GetRunningMicroSecs();
-#endif
-
-    // Add graphic item on copper layers to object containers
-    // /////////////////////////////////////////////////////////////////////////
-    for( unsigned int lIdx = 0; lIdx < layer_id.size(); ++lIdx )
-    {
-        const PCB_LAYER_ID curr_layer_id = layer_id[lIdx];
-
-        wxASSERT( m_layers_container2D.find( curr_layer_id ) != m_layers_container2D.end() );
-
-        CBVHCONTAINER2D *layerContainer = m_layers_container2D[curr_layer_id];
-
-        // ADD GRAPHIC ITEMS ON COPPER LAYERS (texts)
-        for( auto item : m_board->Drawings() )
-        {
-            if( !item->IsOnLayer( curr_layer_id ) )
-                continue;
-
-            switch( item->Type() )
-            {
-            case PCB_LINE_T:
-            {
-                AddShapeWithClearanceToContainer( (DRAWSEGMENT*)item,
-                                                  layerContainer,
-                                                  curr_layer_id,
-                                                  0 );
-            }
-            break;
-
-            case PCB_TEXT_T:
-                AddShapeWithClearanceToContainer( (TEXTE_PCB*) item,
-                                                  layerContainer,
-                                                  curr_layer_id,
-                                                  0 );
-            break;
-
-            case PCB_DIMENSION_T:
-                AddShapeWithClearanceToContainer( (DIMENSION*) item,
-                                                  layerContainer,
-                                                  curr_layer_id,
-                                                  0 );
-            break;
+            m_stats_nr_holes++;
+            m_stats_hole_med_diameter += ( ( pad->GetDrillSize().x +
+                                             pad->GetDrillSize().y ) / 2.0f ) * m_biuTo3Dunits;
 
-            default:
-                wxLogTrace( m_logTrace,
-                            wxT( "createLayers: item type: %d not implemented" ),
-                            item->Type() );
-            break;
-            }
+            m_through_holes_outer.Add( createNewPadDrill( pad, inflate ) );
+            m_through_holes_inner.Add( createNewPadDrill( pad,       0 ) );
         }
     }
+    if( m_stats_nr_holes )
+        m_stats_hole_med_diameter /= (float)m_stats_nr_holes;
 
 #ifdef PRINT_STATISTICS_3D_VIEWER
-    printf( "T11: %.3f ms\n", (float)( GetRunningMicroSecs() - start_Time  ) / 1e3 );
+    printf( "T05: %.3f ms\n", (float)( GetRunningMicroSecs() - start_Time  ) / 1e3 );
     start_Time = GetRunningMicroSecs();
 #endif
 
-    // Add graphic item on copper layers to poly contourns
+    // Add contours of the pad holes (pads can be Circle or Segment holes)
     // /////////////////////////////////////////////////////////////////////////
-    if( GetFlag( FL_RENDER_OPENGL_COPPER_THICKNESS ) &&
-        (m_render_engine == RENDER_ENGINE_OPENGL_LEGACY) )
+    for( auto module : m_board->Modules() )
     {
-        for( unsigned int lIdx = 0; lIdx < layer_id.size(); ++lIdx )
+        for( auto pad : module->Pads() )
         {
-            const PCB_LAYER_ID curr_layer_id = layer_id[lIdx];
+            const wxSize padHole = pad->GetDrillSize();
 
-            wxASSERT( m_layers_poly.find( curr_layer_id ) != m_layers_poly.end() );
+            if( !padHole.x ) // Not drilled pad like SMD pad
+                continue;
 
-            SHAPE_POLY_SET *layerPoly = m_layers_poly[curr_layer_id];
+            // The hole in the body is inflated by copper thickness.
+            const int inflate = GetCopperThicknessBIU();
 
-            // ADD GRAPHIC ITEMS ON COPPER LAYERS (texts)
-            for( auto item : m_board->Drawings() )
+            if( pad->GetAttribute () != PAD_ATTRIB_HOLE_NOT_PLATED )
             {
-                if( !item->IsOnLayer( curr_layer_id ) )
-                    continue;
+                pad->BuildPadDrillShapePolygon( m_through_outer_holes_poly, inflate );
 
-                switch( item->Type() )
-                {
-                case PCB_LINE_T:
-                    ( (DRAWSEGMENT*) item )->TransformShapeWithClearanceToPolygon( *layerPoly, 0 );
-                    break;
-
-                case PCB_TEXT_T:
-                    ( (TEXTE_PCB*) item )->TransformShapeWithClearanceToPolygonSet( *layerPoly, 0 );
-                    break;
-
-                default:
-                    wxLogTrace( m_logTrace, wxT( "createLayers: item type: %d not implemented" ),
-                            item->Type() );
-                    break;
-                }
+                pad->BuildPadDrillShapePolygon( m_through_inner_holes_poly, 0 );
+            }
+            else
+            {
+                // If not plated, no copper.
+                pad->BuildPadDrillShapePolygon( m_through_outer_holes_poly_NPTH, inflate );
             }
         }
     }
 
 #ifdef PRINT_STATISTICS_3D_VIEWER
-    printf( "T12: %.3f ms\n", (float)( GetRunningMicroSecs() - start_Time  ) / 1e3 );
+    printf( "T06: %.3f ms\n", (float)( GetRunningMicroSecs()  - start_Time  ) / 1e3 );
     start_Time = GetRunningMicroSecs();
 #endif
 
-    if( GetFlag( FL_ZONE ) )
-    {
-        if( aStatusTextReporter )
-            aStatusTextReporter->Report( _( "Create zones" ) );
+    // Convert the items of the modified layers, one layer per thread
+    // /////////////////////////////////////////////////////////////////////////
+    if( aStatusTextReporter )
+        aStatusTextReporter->Report( _( "Build layers" ) );
 
-        // Add zones objects
-        // /////////////////////////////////////////////////////////////////////
-        std::atomic<size_t> nextZone( 0 );
+    {
+        std::atomic<size_t> nextItem( 0 );
         std::atomic<size_t> threadsFinished( 0 );
 
-        size_t parallelThreadCount = std::max<size_t>( std::thread::hardware_concurrency(), 2 );
+        size_t parallelThreadCount = std::min<size_t>(
+                std::max<size_t>( std::thread::hardware_concurrency(), 2 ),
+                build_layer_id.size() );
         for( size_t ii = 0; ii < parallelThreadCount; ++ii )
         {
             std::thread t = std::thread( [&]()
             {
-                for( size_t areaId = nextZone.fetch_add( 1 );
-                            areaId < static_cast<size_t>( m_board->GetAreaCount() );
-                            areaId = nextZone.fetch_add( 1 ) )
+                for( size_t i = nextItem.fetch_add( 1 );
+                            i < build_layer_id.size();
+                            i = nextItem.fetch_add( 1 ) )
                 {
-                    const ZONE_CONTAINER* zone = m_board->GetArea( areaId );
-
-                    if( zone == nullptr )
-                        break;
-
-                    auto layerContainer = m_layers_container2D.find( zone->GetLayer() );
-
-                    if( layerContainer != m_layers_container2D.end() )
-                        AddSolidAreasShapesToContainer( zone, layerContainer->second,
-                                                        zone->GetLayer() );
+                    if( IsCopperLayer( build_layer_id[i] ) )
+                        buildCopperLayer( build_layer_id[i], trackList );
+                    else
+                        buildTechLayer( build_layer_id[i] );
                 }
 
                 threadsFinished++;
@@ -763,66 +1234,50 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
 
         while( threadsFinished < parallelThreadCount )
             std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
-
     }
 
 #ifdef PRINT_STATISTICS_3D_VIEWER
-    printf( "fill zones T13: %.3f ms\n", (float)( GetRunningMicroSecs()  - start_Time  ) / 1e3 );
+    printf( "T07: %.3f ms\n", (float)( GetRunningMicroSecs() - start_Time  ) / 1e3 );
     start_Time = GetRunningMicroSecs();
 #endif
 
-    if( GetFlag( FL_ZONE ) &&
-        GetFlag( FL_RENDER_OPENGL_COPPER_THICKNESS ) &&
-        (m_render_engine == RENDER_ENGINE_OPENGL_LEGACY) )
+    if( GetFlag( FL_ZONE ) )
     {
-        // ADD COPPER ZONES
-        for( int ii = 0; ii < m_board->GetAreaCount(); ++ii )
-        {
-            const ZONE_CONTAINER* zone = m_board->GetArea( ii );
-
-            if( zone == nullptr )
-                break;
-
-            auto layerContainer = m_layers_poly.find( zone->GetLayer() );
-
-            if( layerContainer != m_layers_poly.end() )
-                zone->TransformSolidAreasShapesToPolygonSet( *layerContainer->second );
-        }
-    }
-
-#ifdef PRINT_STATISTICS_3D_VIEWER
-    printf( "T14: %.3f ms\n", (float)( GetRunningMicroSecs() - start_Time  ) / 1e3 );
-    start_Time = GetRunningMicroSecs();
-#endif
-
-    // Simplify layer polygons
-    // /////////////////////////////////////////////////////////////////////////
-
-    if( aStatusTextReporter )
-        aStatusTextReporter->Report( _( "Simplifying copper layers polygons" ) );
+        if( aStatusTextReporter )
+            aStatusTextReporter->Report( _( "Create zones" ) );
 
-    if( GetFlag( FL_RENDER_OPENGL_COPPER_THICKNESS ) &&
-        (m_render_engine == RENDER_ENGINE_OPENGL_LEGACY) )
-    {
-        std::atomic<size_t> nextItem( 0 );
+        // Add copper zones objects of the modified layers
+        // (zones of tech layers are added by buildTechLayer)
+        // /////////////////////////////////////////////////////////////////////
+        std::atomic<size_t> nextZone( 0 );
         std::atomic<size_t> threadsFinished( 0 );
 
         size_t parallelThreadCount = std::min<size_t>(
                 std::max<size_t>( std::thread::hardware_concurrency(), 2 ),
-                layer_id.size() );
+                m_board->GetAreaCount() );
         for( size_t ii = 0; ii < parallelThreadCount; ++ii )
         {
-            std::thread t = std::thread( [&nextItem, &threadsFinished, &layer_id, this]()
+            std::thread t = std::thread( [&]()
             {
-                for( size_t i = nextItem.fetch_add( 1 );
-                            i < layer_id.size();
-                            i = nextItem.fetch_add( 1 ) )
+                for( size_t areaId = nextZone.fetch_add( 1 );
+                            areaId < static_cast<size_t>( m_board->GetAreaCount() );
+                            areaId = nextZone.fetch_add( 1 ) )
                 {
-                    auto layerPoly = m_layers_poly.find( layer_id[i] );
+                    const ZONE_CONTAINER* zone = m_board->GetArea( areaId );
+
+                    if( zone == nullptr )
+                        break;
 
-                    if( layerPoly != m_layers_poly.end() )
-                        // This will make a union of all added contours
-                        layerPoly->second->Simplify( SHAPE_POLY_SET::PM_FAST );
+                    const PCB_LAYER_ID zoneLayer = zone->GetLayer();
+
+                    if( !IsCopperLayer( zoneLayer ) || !layerRebuilt[zoneLayer] )
+                        continue;
+
+                    auto layerContainer = m_layers_container2D.find( zoneLayer );
+
+                    if( layerContainer != m_layers_container2D.end() )
+                        AddSolidAreasShapesToContainer( zone, layerContainer->second,
+                                                        zoneLayer );
                 }
 
                 threadsFinished++;
@@ -836,7 +1291,7 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
     }
 
 #ifdef PRINT_STATISTICS_3D_VIEWER
-    printf( "T15: %.3f ms\n", (float)( GetRunningMicroSecs() - start_Time ) / 1e3 );
+    printf( "fill zones T08: %.3f ms\n", (float)( GetRunningMicroSecs()  - start_Time  ) / 1e3 );
     start_Time = GetRunningMicroSecs();
 #endif
 
@@ -864,12 +1319,6 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
         }
     }
 
-#ifdef PRINT_STATISTICS_3D_VIEWER
-    printf( "T16: %.3f ms\n", (float)( GetRunningMicroSecs() - start_Time ) / 1e3 );
-#endif
-    // End Build Copper layers
-
-
     // This will make a union of all added contourns
     m_through_inner_holes_poly.Simplify( SHAPE_POLY_SET::PM_FAST );
     m_through_outer_holes_poly.Simplify( SHAPE_POLY_SET::PM_FAST );
@@ -878,248 +1327,79 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
     //m_through_inner_holes_vias_poly.Simplify( SHAPE_POLY_SET::PM_FAST ); // Not in use
 
 #ifdef PRINT_STATISTICS_3D_VIEWER
-    unsigned stats_endCopperLayersTime = GetRunningMicroSecs();
+    printf( "T09: %.3f ms\n", (float)( GetRunningMicroSecs() - start_Time ) / 1e3 );
+
+    unsigned stats_endLayersTime = GetRunningMicroSecs();
 #endif
 
-    // Build Tech layers
-    // Based on: https://github.com/KiCad/kicad-source-mirror/blob/master/3d-viewer/3d_draw.cpp#L1059
+    // Build BVH for holes and vias
     // /////////////////////////////////////////////////////////////////////////
+
 #ifdef PRINT_STATISTICS_3D_VIEWER
-    unsigned stats_startTechLayersTime = GetRunningMicroSecs();
+    unsigned stats_startHolesBVHTime = GetRunningMicroSecs();
 #endif
-
     if( aStatusTextReporter )
-        aStatusTextReporter->Report( _( "Build Tech layers" ) );
-
-    // draw graphic items, on technical layers
-    static const PCB_LAYER_ID teckLayerList[] = {
-            B_Adhes,
-            F_Adhes,
-            B_Paste,
-            F_Paste,
-            B_SilkS,
-            F_SilkS,
-            B_Mask,
-            F_Mask,
+        aStatusTextReporter->Report( _( "Build BVH for holes and vias" ) );
 
-            // Aux Layers
-            Dwgs_User,
-            Cmts_User,
-            Eco1_User,
-            Eco2_User,
-            Edge_Cuts,
-            Margin
-        };
+    std::vector< CBVHCONTAINER2D *> bvhList;
 
-    // User layers are not drawn here, only technical layers
+    bvhList.push_back( &m_through_holes_inner );
+    bvhList.push_back( &m_through_holes_outer );
 
-    for( LSEQ seq = LSET::AllNonCuMask().Seq( teckLayerList, arrayDim( teckLayerList ) );
-         seq;
-         ++seq )
+    for( MAP_CONTAINER_2D::iterator ii = m_layers_holes2D.begin();
+         ii != m_layers_holes2D.end();
+         ++ii )
     {
-        const PCB_LAYER_ID curr_layer_id = *seq;
-
-        if( !Is3DLayerEnabled( curr_layer_id ) )
-                    continue;
-
-        CBVHCONTAINER2D *layerContainer = new CBVHCONTAINER2D;
-        m_layers_container2D[curr_layer_id] = layerContainer;
-
-        SHAPE_POLY_SET *layerPoly = new SHAPE_POLY_SET;
-        m_layers_poly[curr_layer_id] = layerPoly;
-
-        // Add drawing objects
-        // /////////////////////////////////////////////////////////////////////
-        for( auto item : m_board->Drawings() )
-        {
-            if( !item->IsOnLayer( curr_layer_id ) )
-                continue;
-
-            switch( item->Type() )
-            {
-            case PCB_LINE_T:
-                AddShapeWithClearanceToContainer( (DRAWSEGMENT*)item,
-                                                  layerContainer,
-                                                  curr_layer_id,
-                                                  0 );
-                break;
-
-            case PCB_TEXT_T:
-                AddShapeWithClearanceToContainer( (TEXTE_PCB*) item,
-                                                  layerContainer,
-                                                  curr_layer_id,
-                                                  0 );
-                break;
-
-            case PCB_DIMENSION_T:
-                AddShapeWithClearanceToContainer( (DIMENSION*) item,
-                                                  layerContainer,
-                                                  curr_layer_id,
-                                                  0 );
-                break;
-
-            default:
-                break;
-            }
-        }
-
-
-        // Add drawing contours
-        // /////////////////////////////////////////////////////////////////////
-        for( auto item : m_board->Drawings() )
-        {
-            if( !item->IsOnLayer( curr_layer_id ) )
-                continue;
-
-            switch( item->Type() )
-            {
-            case PCB_LINE_T:
-                ( (DRAWSEGMENT*) item )->TransformShapeWithClearanceToPolygon( *layerPoly, 0 );
-                break;
-
-            case PCB_TEXT_T:
-                ( (TEXTE_PCB*) item )->TransformShapeWithClearanceToPolygonSet( *layerPoly, 0 );
-                break;
-
-            default:
-                break;
-            }
-        }
-
-
-        // Add modules tech layers - objects
-        // /////////////////////////////////////////////////////////////////////
-        for( auto module : m_board->Modules() )
-        {
-            if( (curr_layer_id == F_SilkS) || (curr_layer_id == B_SilkS) )
-            {
-                int     linewidth = g_DrawDefaultLineThickness;
-
-                for( auto pad : module->Pads() )
-                {
-                    if( !pad->IsOnLayer( curr_layer_id ) )
-                        continue;
+        bvhList.push_back( ii->second );
+    }
 
-                    buildPadShapeThickOutlineAsSegments( pad, layerContainer, linewidth );
-                }
-            }
-            else
-            {
-                AddPadsShapesWithClearanceToContainer(
-                        module, layerContainer, curr_layer_id, 0, false );
-            }
+    // We only need the Solder mask to initialize the BVH
+    // because..?
+    // The BVH of a reused layer is still valid.
+    if( layerRebuilt[B_Mask] )
+        bvhList.push_back( m_layers_container2D[B_Mask] );
 
-            AddGraphicsShapesWithClearanceToContainer( module, layerContainer, curr_layer_id, 0 );
-        }
+    if( layerRebuilt[F_Mask] )
+        bvhList.push_back( m_layers_container2D[F_Mask] );
 
+    {
+        std::atomic<size_t> nextItem( 0 );
+        std::atomic<size_t> threadsFinished( 0 );
 
-        // Add modules tech layers - contours
-        // /////////////////////////////////////////////////////////////////////
-        for( auto module : m_board->Modules() )
+        size_t parallelThreadCount = std::min<size_t>(
+                std::max<size_t>( std::thread::hardware_concurrency(), 2 ),
+                bvhList.size() );
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
         {
-            if( (curr_layer_id == F_SilkS) || (curr_layer_id == B_SilkS) )
+            std::thread t = std::thread( [&nextItem, &threadsFinished, &bvhList]()
             {
-                const int linewidth = g_DrawDefaultLineThickness;
-
-                for( auto pad : module->Pads() )
+                for( size_t i = nextItem.fetch_add( 1 );
+                            i < bvhList.size();
+                            i = nextItem.fetch_add( 1 ) )
                 {
-                    if( !pad->IsOnLayer( curr_layer_id ) )
-                        continue;
-
-                    buildPadShapeThickOutlineAsPolygon( pad, *layerPoly, linewidth );
+                    bvhList[i]->BuildBVH();
                 }
-            }
-            else
-            {
-                transformPadsShapesWithClearanceToPolygon(
-                        module->Pads(), curr_layer_id, *layerPoly, 0, false );
-            }
-
-            // On tech layers, use a poor circle approximation, only for texts (stroke font)
-            module->TransformGraphicTextWithClearanceToPolygonSet( curr_layer_id, *layerPoly, 0 );
 
-            // Add the remaining things with dynamic seg count for circles
-            transformGraphicModuleEdgeToPolygonSet( module, curr_layer_id, *layerPoly );
-        }
-
-
-        // Draw non copper zones
-        // /////////////////////////////////////////////////////////////////////
-        if( GetFlag( FL_ZONE ) )
-        {
-            for( int ii = 0; ii < m_board->GetAreaCount(); ++ii )
-            {
-                ZONE_CONTAINER* zone = m_board->GetArea( ii );
-
-                if( !zone->IsOnLayer( curr_layer_id ) )
-                    continue;
-
-                AddSolidAreasShapesToContainer( zone,
-                                                layerContainer,
-                                                curr_layer_id );
-            }
-
-            for( int ii = 0; ii < m_board->GetAreaCount(); ++ii )
-            {
-                ZONE_CONTAINER* zone = m_board->GetArea( ii );
-
-                if( !zone->IsOnLayer( curr_layer_id ) )
-                    continue;
+                threadsFinished++;
+            } );
 
-                zone->TransformSolidAreasShapesToPolygonSet( *layerPoly );
-            }
+            t.detach();
         }
 
-        // This will make a union of all added contours
-        layerPoly->Simplify( SHAPE_POLY_SET::PM_FAST );
-    }
-    // End Build Tech layers
-
-#ifdef PRINT_STATISTICS_3D_VIEWER
-    unsigned stats_endTechLayersTime = GetRunningMicroSecs();
-#endif
-
-
-    // Build BVH for holes and vias
-    // /////////////////////////////////////////////////////////////////////////
-
-#ifdef PRINT_STATISTICS_3D_VIEWER
-    unsigned stats_startHolesBVHTime = GetRunningMicroSecs();
-#endif
-    if( aStatusTextReporter )
-        aStatusTextReporter->Report( _( "Build BVH for holes and vias" ) );
-
-    m_through_holes_inner.BuildBVH();
-    m_through_holes_outer.BuildBVH();
-
-    if( !m_layers_holes2D.empty() )
-    {
-        for( MAP_CONTAINER_2D::iterator ii = m_layers_holes2D.begin();
-             ii != m_layers_holes2D.end();
-             ++ii )
-        {
-            ((CBVHCONTAINER2D *)(ii->second))->BuildBVH();
-        }
+        while( threadsFinished < parallelThreadCount )
+            std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
     }
 
-    // We only need the Solder mask to initialize the BVH
-    // because..?
-    if( (CBVHCONTAINER2D *)m_layers_container2D[B_Mask] )
-        ((CBVHCONTAINER2D *)m_layers_container2D[B_Mask])->BuildBVH();
-
-    if( (CBVHCONTAINER2D *)m_layers_container2D[F_Mask] )
-        ((CBVHCONTAINER2D *)m_layers_container2D[F_Mask])->BuildBVH();
-
 #ifdef PRINT_STATISTICS_3D_VIEWER
     unsigned stats_endHolesBVHTime = GetRunningMicroSecs();
 
     printf( "CINFO3D_VISU::createLayers times\n" );
-    printf( "  Copper Layers:          %.3f ms\n",
-            (float)( stats_endCopperLayersTime  - stats_startCopperLayersTime  ) / 1e3 );
+    printf( "  Copper and Tech Layers: %.3f ms\n",
+            (float)( stats_endLayersTime        - stats_startCopperLayersTime  ) / 1e3 );
     printf( "  Holes BVH creation:     %.3f ms\n",
             (float)( stats_endHolesBVHTime      - stats_startHolesBVHTime      ) / 1e3 );
-    printf( "  Tech Layers:            %.3f ms\n",
-            (float)( stats_endTechLayersTime    - stats_startTechLayersTime    ) / 1e3 );
+    printf( "  Layers rebuilt:         %u of %u\n",
+            (unsigned int) build_layer_id.size(), (unsigned int) all_layer_id.size() );
     printf( "Statistics:\n" );
     printf( "  m_stats_nr_tracks                   %u\n", m_stats_nr_tracks );
     printf( "  m_stats_nr_vias                     %u\n", m_stats_nr_vias );
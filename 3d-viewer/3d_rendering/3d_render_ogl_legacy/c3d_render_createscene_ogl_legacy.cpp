@@ -902,6 +902,20 @@ void C3D_RENDER_OGL_LEGACY::load_3D_models( REPORTER *aStatusTextReporter )
         (!m_settings.GetFlag( FL_MODULE_ATTRIBUTES_VIRTUAL )) )
         return;
 
+    // Load the models not yet in our map in parallel first
+    std::list< wxString > modelFiles;
+
+    for( auto module : m_settings.GetBoard()->Modules() )
+    {
+        for( auto& model : module->Models() )
+        {
+            if( m_3dmodel_map.find( model.m_Filename ) == m_3dmodel_map.end() )
+                modelFiles.push_back( model.m_Filename );
+        }
+    }
+
+    m_settings.Get3DCacheManager()->PreloadModels( modelFiles );
+
     // Go for all modules
     for( auto module : m_settings.GetBoard()->Modules() )
     {
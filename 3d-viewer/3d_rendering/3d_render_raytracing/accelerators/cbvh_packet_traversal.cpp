@@ -45,26 +45,64 @@ struct StackNode
 };
 
 
+static inline unsigned int firstBit( uint64_t aMask )
+{
+#if defined( __GNUC__ )
+    return __builtin_ctzll( aMask );
+#else
+    unsigned int i = 0;
+
+    while( !( aMask & 1 ) )
+    {
+        aMask >>= 1;
+        i++;
+    }
+
+    return i;
+#endif
+}
+
+
+static inline unsigned int lastBit( uint64_t aMask )
+{
+#if defined( __GNUC__ )
+    return 63 - __builtin_clzll( aMask );
+#else
+    unsigned int i = 0;
+
+    while( aMask >>= 1 )
+        i++;
+
+    return i;
+#endif
+}
+
+
+/// @return the mask of the rays after aIndex
+static inline uint64_t raysAfter( unsigned int aIndex )
+{
+    return ~( ( (uint64_t)2 << aIndex ) - 1 );
+}
+
+
 static inline unsigned int getFirstHit( const RAYPACKET &aRayPacket,
                                         const CBBOX &aBBox,
                                         unsigned int ia,
-                                        HITINFO_PACKET *aHitInfoPacket )
+                                        const float *aTHit )
 {
     float hitT;
 
     if( aBBox.Intersect( aRayPacket.m_ray[ia], &hitT ) )
-        if( hitT < aHitInfoPacket[ia].m_HitInfo.m_tHit )
+        if( hitT < aTHit[ia] )
             return ia;
 
     if( !aRayPacket.m_Frustum.Intersect( aBBox ) )
         return RAYPACKET_RAYS_PER_PACKET;
 
-    for( unsigned int i = ia + 1; i < RAYPACKET_RAYS_PER_PACKET; ++i )
-    {
-        if( aBBox.Intersect( aRayPacket.m_ray[i], &hitT ) )
-            if( hitT < aHitInfoPacket[i].m_HitInfo.m_tHit )
-                return i;
-    }
+    const uint64_t mask = RAYPACKET_IntersectBBox( aRayPacket, aBBox, aTHit ) & raysAfter( ia );
+
+    if( mask )
+        return firstBit( mask );
 
     return RAYPACKET_RAYS_PER_PACKET;
 }
@@ -75,16 +113,12 @@ static inline unsigned int getFirstHit( const RAYPACKET &aRayPacket,
 static inline unsigned int getLastHit( const RAYPACKET &aRayPacket,
                                        const CBBOX &aBBox,
                                        unsigned int ia,
-                                       HITINFO_PACKET *aHitInfoPacket )
+                                       const float *aTHit )
 {
-    for( unsigned int ie = (RAYPACKET_RAYS_PER_PACKET - 1); ie > ia; --ie )
-    {
-        float hitT;
+    const uint64_t mask = RAYPACKET_IntersectBBox( aRayPacket, aBBox, aTHit ) & raysAfter( ia );
 
-        if( aBBox.Intersect( aRayPacket.m_ray[ie], &hitT ) )
-            if( hitT < aHitInfoPacket[ie].m_HitInfo.m_tHit )
-                return ie + 1;
-    }
+    if( mask )
+        return lastBit( mask ) + 1;
 
     return ia + 1;
 }
@@ -107,13 +141,19 @@ bool CBVH_PBRT::Intersect( const RAYPACKET &aRayPacket,
     int todoOffset = 0, nodeNum = 0;
     StackNode todo[MAX_TODOS];
 
+    // The hit distance of each ray, contiguous for the packet bbox tests
+    float tHit[RAYPACKET_RAYS_PER_PACKET];
+
+    for( unsigned int i = 0; i < RAYPACKET_RAYS_PER_PACKET; ++i )
+        tHit[i] = aHitInfoPacket[i].m_HitInfo.m_tHit;
+
     unsigned int ia = 0;
 
     while( true )
     {
         const LinearBVHNode *curCell = &m_nodes[nodeNum];
 
-        ia = getFirstHit( aRayPacket, curCell->bounds, ia, aHitInfoPacket );
+        ia = getFirstHit( aRayPacket, curCell->bounds, ia, tHit );
 
         if( ia < RAYPACKET_RAYS_PER_PACKET )
         {
@@ -130,7 +170,7 @@ bool CBVH_PBRT::Intersect( const RAYPACKET &aRayPacket,
                 const unsigned int ie = getLastHit( aRayPacket,
                                                     curCell->bounds,
                                                     ia,
-                                                    aHitInfoPacket );
+                                                    tHit );
 
                 for( int j = 0; j < curCell->nPrimitives; ++j )
                 {
@@ -148,6 +188,7 @@ bool CBVH_PBRT::Intersect( const RAYPACKET &aRayPacket,
                                 anyHitted |= hitted;
                                 aHitInfoPacket[i].m_hitresult |= hitted;
                                 aHitInfoPacket[i].m_HitInfo.m_acc_node_info = nodeNum;
+                                tHit[i] = aHitInfoPacket[i].m_HitInfo.m_tHit;
                             }
                         }
                     }
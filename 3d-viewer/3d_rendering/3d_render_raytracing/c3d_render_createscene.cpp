@@ -47,6 +47,10 @@
 
 #include <base_units.h>
 #include <profile.h>        // To use GetRunningMicroSecs or another profiling utility
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
 
 /**
   * Scale convertion from 3d model units to pcb units
@@ -246,6 +250,198 @@ void C3D_RENDER_RAYTRACING::create_3d_object_from(  CCONTAINER &aDstContainer,
 }
 
 
+/**
+ * @brief create_3d_layer_objects - creates the 3D objects of the 2D items of a
+ * layer, cut by the holes of the layer and the through holes.
+ * It does not modify the containers of the render, so it can be called from
+ * several threads for different layers.
+ * @param aLayerId - the layer (not a solder mask layer)
+ * @param aContainer2d - the 2D items of the layer
+ * @param aDstObjects - the created objects are appended to this list
+ */
+void C3D_RENDER_RAYTRACING::create_3d_layer_objects( PCB_LAYER_ID aLayerId,
+                                                     const CBVHCONTAINER2D *aContainer2d,
+                                                     std::vector<COBJECT *> &aDstObjects )
+{
+    CMATERIAL *materialLayer = &m_materials.m_SilkS;
+    SFVEC3F layerColor = SFVEC3F( 0.0f, 0.0f, 0.0f );
+
+    switch( aLayerId )
+    {
+        case B_Adhes:
+        case F_Adhes:
+        break;
+
+        case B_Paste:
+        case F_Paste:
+            materialLayer = &m_materials.m_Paste;
+
+            if( m_settings.GetFlag( FL_USE_REALISTIC_MODE ) )
+                layerColor = m_settings.m_SolderPasteColor;
+            else
+                layerColor = m_settings.GetLayerColor( aLayerId );
+        break;
+
+        case B_SilkS:
+        case F_SilkS:
+            materialLayer = &m_materials.m_SilkS;
+
+            if( m_settings.GetFlag( FL_USE_REALISTIC_MODE ) )
+                layerColor = m_settings.m_SilkScreenColor;
+            else
+                layerColor = m_settings.GetLayerColor( aLayerId );
+        break;
+
+        case Dwgs_User:
+        case Cmts_User:
+        case Eco1_User:
+        case Eco2_User:
+        case Edge_Cuts:
+        case Margin:
+        break;
+
+        case B_CrtYd:
+        case F_CrtYd:
+        break;
+
+        case B_Fab:
+        case F_Fab:
+        break;
+
+        default:
+            materialLayer = &m_materials.m_Copper;
+
+            if( m_settings.GetFlag( FL_USE_REALISTIC_MODE ) )
+                layerColor = m_settings.m_CopperColor;
+            else
+                layerColor = m_settings.GetLayerColor( aLayerId );
+        break;
+    }
+
+    const LIST_OBJECT2D &listObject2d = aContainer2d->GetList();
+
+    for( LIST_OBJECT2D::const_iterator itemOnLayer = listObject2d.begin();
+         itemOnLayer != listObject2d.end();
+         ++itemOnLayer )
+    {
+        const COBJECT2D *object2d_A = static_cast<const COBJECT2D *>(*itemOnLayer);
+
+        // not yet used / implemented (can be used in future to clip the objects in the board borders
+        COBJECT2D *object2d_C = CSGITEM_FULL;
+
+        std::vector<const COBJECT2D *> *object2d_B = CSGITEM_EMPTY;
+
+        if( true )  // previously, was a option, now holes are always drawn in zones
+        {
+            object2d_B = new std::vector<const COBJECT2D *>();
+
+            // Check if there are any layerhole that intersects this object
+            // Eg: a segment is cutted by a via hole or THT hole.
+            // /////////////////////////////////////////////////////////////
+            const MAP_CONTAINER_2D &layerHolesMap = m_settings.GetMapLayersHoles();
+
+            if( layerHolesMap.find(aLayerId) != layerHolesMap.end() )
+            {
+                MAP_CONTAINER_2D::const_iterator ii_hole = layerHolesMap.find(aLayerId);
+
+                const CBVHCONTAINER2D *containerLayerHoles2d =
+                        static_cast<const CBVHCONTAINER2D *>(ii_hole->second);
+
+
+                CONST_LIST_OBJECT2D intersectionList;
+                containerLayerHoles2d->GetListObjectsIntersects( object2d_A->GetBBox(),
+                                                                 intersectionList );
+
+                if( !intersectionList.empty() )
+                {
+                    for( CONST_LIST_OBJECT2D::const_iterator holeOnLayer =
+                         intersectionList.begin();
+                         holeOnLayer != intersectionList.end();
+                         ++holeOnLayer )
+                    {
+                        const COBJECT2D *hole2d = static_cast<const COBJECT2D *>(*holeOnLayer);
+
+                        //if( object2d_A->Intersects( hole2d->GetBBox() ) )
+                            //if( object2d_A->GetBBox().Intersects( hole2d->GetBBox() ) )
+                                object2d_B->push_back( hole2d );
+                    }
+                }
+            }
+
+            // Check if there are any THT that intersects this object
+            // /////////////////////////////////////////////////////////////
+            if( !m_settings.GetThroughHole_Outer().GetList().empty() )
+            {
+                CONST_LIST_OBJECT2D intersectionList;
+
+                m_settings.GetThroughHole_Outer().GetListObjectsIntersects(
+                            object2d_A->GetBBox(),
+                            intersectionList );
+
+                if( !intersectionList.empty() )
+                {
+                    for( CONST_LIST_OBJECT2D::const_iterator hole = intersectionList.begin();
+                         hole != intersectionList.end();
+                         ++hole )
+                    {
+                        const COBJECT2D *hole2d = static_cast<const COBJECT2D *>(*hole);
+
+                        //if( object2d_A->Intersects( hole2d->GetBBox() ) )
+                            //if( object2d_A->GetBBox().Intersects( hole2d->GetBBox() ) )
+                                object2d_B->push_back( hole2d );
+                    }
+                }
+            }
+
+            if( object2d_B->empty() )
+            {
+                delete object2d_B;
+                object2d_B = CSGITEM_EMPTY;
+            }
+        }
+
+        if( (object2d_B == CSGITEM_EMPTY) &&
+            (object2d_C == CSGITEM_FULL) )
+        {
+#if 0
+           create_3d_object_from( m_object_container,
+                                  object2d_A,
+                                  m_settings.GetLayerBottomZpos3DU( aLayerId ),
+                                  m_settings.GetLayerTopZpos3DU( aLayerId ),
+                                  materialLayer,
+                                  layerColor );
+#else
+            CLAYERITEM *objPtr = new CLAYERITEM( object2d_A,
+                                                 m_settings.GetLayerBottomZpos3DU( aLayerId ),
+                                                 m_settings.GetLayerTopZpos3DU( aLayerId ) );
+            objPtr->SetMaterial( materialLayer );
+            objPtr->SetColor( ConvertSRGBToLinear( layerColor ) );
+            aDstObjects.push_back( objPtr );
+#endif
+        }
+        else
+        {
+#if 1
+            CITEMLAYERCSG2D *itemCSG2d = new CITEMLAYERCSG2D( object2d_A,
+                                                              object2d_B,
+                                                              object2d_C,
+                                                              object2d_A->GetBoardItem() );
+            m_containerWithObjectsToDelete.Add( itemCSG2d );
+
+            CLAYERITEM *objPtr = new CLAYERITEM( itemCSG2d,
+                                                 m_settings.GetLayerBottomZpos3DU( aLayerId ),
+                                                 m_settings.GetLayerTopZpos3DU( aLayerId ) );
+
+            objPtr->SetMaterial( materialLayer );
+            objPtr->SetColor( ConvertSRGBToLinear( layerColor ) );
+
+            aDstObjects.push_back( objPtr );
+#endif
+        }
+    }
+}
+
+
 void C3D_RENDER_RAYTRACING::reload( REPORTER *aStatusTextReporter )
 {
     m_reloadRequested = false;
@@ -438,6 +634,9 @@ void C3D_RENDER_RAYTRACING::reload( REPORTER *aStatusTextReporter )
     printf("Add layers maps...\n");
 #endif
 
+    // Collect the layers, the objects of each layer are created in parallel
+    std::vector< MAP_CONTAINER_2D::const_iterator > layerList;
+
     for( MAP_CONTAINER_2D::const_iterator ii = m_settings.GetMapLayers().begin();
          ii != m_settings.GetMapLayers().end();
          ++ii )
@@ -448,184 +647,50 @@ void C3D_RENDER_RAYTRACING::reload( REPORTER *aStatusTextReporter )
         if( (layer_id == B_Mask) || (layer_id == F_Mask) )
             continue;
 
-        CMATERIAL *materialLayer = &m_materials.m_SilkS;
-        SFVEC3F layerColor = SFVEC3F( 0.0f, 0.0f, 0.0f );
-
-        switch( layer_id )
-        {
-            case B_Adhes:
-            case F_Adhes:
-            break;
-
-            case B_Paste:
-            case F_Paste:
-                materialLayer = &m_materials.m_Paste;
-
-                if( m_settings.GetFlag( FL_USE_REALISTIC_MODE ) )
-                    layerColor = m_settings.m_SolderPasteColor;
-                else
-                    layerColor = m_settings.GetLayerColor( layer_id );
-            break;
+        layerList.push_back( ii );
+    }
 
-            case B_SilkS:
-            case F_SilkS:
-                materialLayer = &m_materials.m_SilkS;
+    std::vector< std::vector<COBJECT *> > layerObjects( layerList.size() );
 
-                if( m_settings.GetFlag( FL_USE_REALISTIC_MODE ) )
-                    layerColor = m_settings.m_SilkScreenColor;
-                else
-                    layerColor = m_settings.GetLayerColor( layer_id );
-            break;
-
-            case Dwgs_User:
-            case Cmts_User:
-            case Eco1_User:
-            case Eco2_User:
-            case Edge_Cuts:
-            case Margin:
-            break;
-
-            case B_CrtYd:
-            case F_CrtYd:
-            break;
-
-            case B_Fab:
-            case F_Fab:
-            break;
-
-            default:
-                materialLayer = &m_materials.m_Copper;
-
-                if( m_settings.GetFlag( FL_USE_REALISTIC_MODE ) )
-                    layerColor = m_settings.m_CopperColor;
-                else
-                    layerColor = m_settings.GetLayerColor( layer_id );
-            break;
-        }
+    if( !layerList.empty() )
+    {
+        std::atomic<size_t> nextLayer( 0 );
+        std::atomic<size_t> threadsFinished( 0 );
 
-        const CBVHCONTAINER2D *container2d = static_cast<const CBVHCONTAINER2D *>(ii->second);
-        const LIST_OBJECT2D &listObject2d = container2d->GetList();
+        size_t parallelThreadCount = std::min<size_t>(
+                std::max<size_t>( std::thread::hardware_concurrency(), 2 ),
+                layerList.size() );
 
-        for( LIST_OBJECT2D::const_iterator itemOnLayer = listObject2d.begin();
-             itemOnLayer != listObject2d.end();
-             ++itemOnLayer )
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
         {
-            const COBJECT2D *object2d_A = static_cast<const COBJECT2D *>(*itemOnLayer);
-
-            // not yet used / implemented (can be used in future to clip the objects in the board borders
-            COBJECT2D *object2d_C = CSGITEM_FULL;
-
-            std::vector<const COBJECT2D *> *object2d_B = CSGITEM_EMPTY;
-
-            if( true )  // previously, was a option, now holes are always drawn in zones
+            std::thread t = std::thread( [&]()
             {
-                object2d_B = new std::vector<const COBJECT2D *>();
-
-                // Check if there are any layerhole that intersects this object
-                // Eg: a segment is cutted by a via hole or THT hole.
-                // /////////////////////////////////////////////////////////////
-                const MAP_CONTAINER_2D &layerHolesMap = m_settings.GetMapLayersHoles();
-
-                if( layerHolesMap.find(layer_id) != layerHolesMap.end() )
-                {
-                    MAP_CONTAINER_2D::const_iterator ii_hole = layerHolesMap.find(layer_id);
-
-                    const CBVHCONTAINER2D *containerLayerHoles2d =
-                            static_cast<const CBVHCONTAINER2D *>(ii_hole->second);
-
-
-                    CONST_LIST_OBJECT2D intersectionList;
-                    containerLayerHoles2d->GetListObjectsIntersects( object2d_A->GetBBox(),
-                                                                     intersectionList );
-
-                    if( !intersectionList.empty() )
-                    {
-                        for( CONST_LIST_OBJECT2D::const_iterator holeOnLayer =
-                             intersectionList.begin();
-                             holeOnLayer != intersectionList.end();
-                             ++holeOnLayer )
-                        {
-                            const COBJECT2D *hole2d = static_cast<const COBJECT2D *>(*holeOnLayer);
-
-                            //if( object2d_A->Intersects( hole2d->GetBBox() ) )
-                                //if( object2d_A->GetBBox().Intersects( hole2d->GetBBox() ) )
-                                    object2d_B->push_back( hole2d );
-                        }
-                    }
-                }
-
-                // Check if there are any THT that intersects this object
-                // /////////////////////////////////////////////////////////////
-                if( !m_settings.GetThroughHole_Outer().GetList().empty() )
-                {
-                    CONST_LIST_OBJECT2D intersectionList;
-
-                    m_settings.GetThroughHole_Outer().GetListObjectsIntersects(
-                                object2d_A->GetBBox(),
-                                intersectionList );
-
-                    if( !intersectionList.empty() )
-                    {
-                        for( CONST_LIST_OBJECT2D::const_iterator hole = intersectionList.begin();
-                             hole != intersectionList.end();
-                             ++hole )
-                        {
-                            const COBJECT2D *hole2d = static_cast<const COBJECT2D *>(*hole);
-
-                            //if( object2d_A->Intersects( hole2d->GetBBox() ) )
-                                //if( object2d_A->GetBBox().Intersects( hole2d->GetBBox() ) )
-                                    object2d_B->push_back( hole2d );
-                        }
-                    }
-                }
-
-                if( object2d_B->empty() )
+                for( size_t i = nextLayer.fetch_add( 1 );
+                            i < layerList.size();
+                            i = nextLayer.fetch_add( 1 ) )
                 {
-                    delete object2d_B;
-                    object2d_B = CSGITEM_EMPTY;
+                    create_3d_layer_objects(
+                            static_cast<PCB_LAYER_ID>( layerList[i]->first ),
+                            static_cast<const CBVHCONTAINER2D *>( layerList[i]->second ),
+                            layerObjects[i] );
                 }
-            }
 
-            if( (object2d_B == CSGITEM_EMPTY) &&
-                (object2d_C == CSGITEM_FULL) )
-            {
-#if 0
-               create_3d_object_from( m_object_container,
-                                      object2d_A,
-                                      m_settings.GetLayerBottomZpos3DU( layer_id ),
-                                      m_settings.GetLayerTopZpos3DU( layer_id ),
-                                      materialLayer,
-                                      layerColor );
-#else
-                CLAYERITEM *objPtr = new CLAYERITEM( object2d_A,
-                                                     m_settings.GetLayerBottomZpos3DU( layer_id ),
-                                                     m_settings.GetLayerTopZpos3DU( layer_id ) );
-                objPtr->SetMaterial( materialLayer );
-                objPtr->SetColor( ConvertSRGBToLinear( layerColor ) );
-                m_object_container.Add( objPtr );
-#endif
-            }
-            else
-            {
-#if 1
-                CITEMLAYERCSG2D *itemCSG2d = new CITEMLAYERCSG2D( object2d_A,
-                                                                  object2d_B,
-                                                                  object2d_C,
-                                                                  object2d_A->GetBoardItem() );
-                m_containerWithObjectsToDelete.Add( itemCSG2d );
+                threadsFinished++;
+            } );
 
-                CLAYERITEM *objPtr = new CLAYERITEM( itemCSG2d,
-                                                     m_settings.GetLayerBottomZpos3DU( layer_id ),
-                                                     m_settings.GetLayerTopZpos3DU( layer_id ) );
+            t.detach();
+        }
 
-                objPtr->SetMaterial( materialLayer );
-                objPtr->SetColor( ConvertSRGBToLinear( layerColor ) );
+        while( threadsFinished < parallelThreadCount )
+            std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+    }
 
-                m_object_container.Add( objPtr );
-#endif
-            }
-        }
-    }// for each layer on map
+    // Add them in the layers order, so the scene does not depend on the threads timing
+    for( size_t i = 0; i < layerObjects.size(); ++i )
+    {
+        for( size_t j = 0; j < layerObjects[i].size(); ++j )
+            m_object_container.Add( layerObjects[i][j] );
+    }
 
 
 
@@ -1194,6 +1259,24 @@ void C3D_RENDER_RAYTRACING::add_3D_vias_and_pads_to_container()
 
 void C3D_RENDER_RAYTRACING::load_3D_models()
 {
+    // No cache manager (e.g. an offscreen render without the models)
+    if( !m_settings.Get3DCacheManager() )
+        return;
+
+    // Load the models of the board in parallel first
+    std::list< wxString > modelFiles;
+
+    for( auto module : m_settings.GetBoard()->Modules() )
+    {
+        if( m_settings.ShouldModuleBeDisplayed( (MODULE_ATTR_T)module->GetAttributes() ) )
+        {
+            for( auto& model : module->Models() )
+                modelFiles.push_back( model.m_Filename );
+        }
+    }
+
+    m_settings.Get3DCacheManager()->PreloadModels( modelFiles );
+
     // Go for all modules
     for( auto module : m_settings.GetBoard()->Modules() )
     {
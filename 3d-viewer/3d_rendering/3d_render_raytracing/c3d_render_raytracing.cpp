@@ -41,6 +41,7 @@
 #include "3d_math.h"
 #include "../common_ogl/ogl_utils.h"
 #include <profile.h>        // To use GetRunningMicroSecs or another profiling utility
+#include <wx/image.h>
 
 // This should be used in future for the function
 // convertLinearToSRGB
@@ -298,6 +299,78 @@ bool C3D_RENDER_RAYTRACING::Redraw( bool aIsMoving, REPORTER *aStatusTextReporte
 }
 
 
+bool C3D_RENDER_RAYTRACING::RenderToImage( const wxSize &aSize,
+                                           wxImage &aImage,
+                                           REPORTER *aStatusTextReporter )
+{
+    if( ( aSize.x <= 0 ) || ( aSize.y <= 0 ) || !m_settings.GetBoard() )
+        return false;
+
+    if( m_reloadRequested )
+    {
+        if( aStatusTextReporter )
+            aStatusTextReporter->Report( _( "Loading..." ) );
+
+        reload( aStatusTextReporter );
+    }
+
+    // Render a buffer of whole ray packets, with no display offset, that is
+    // used as the window, then crop it to the requested size
+    const wxSize bufferSize( ( aSize.x + RAYPACKET_DIM - 1 ) & RAYPACKET_INVMASK,
+                             ( aSize.y + RAYPACKET_DIM - 1 ) & RAYPACKET_INVMASK );
+
+    const wxSize oldWindowSize = m_windowSize;
+
+    m_windowSize = bufferSize;
+    m_settings.CameraGet().SetCurWindowSize( bufferSize );
+
+    m_realBufferSize = SFVEC2UI( bufferSize.x, bufferSize.y );
+    m_xoffset = 0;
+    m_yoffset = 0;
+
+    initialize_block_buffers();
+
+    std::vector<GLubyte> buffer( m_realBufferSize.x * m_realBufferSize.y * 4 );
+
+    // Each call of render() runs a state (or a part of the tracing) on all the cores
+    m_rt_render_state = RT_RENDER_STATE_MAX;
+
+    do
+    {
+        render( buffer.data(), aStatusTextReporter );
+    } while( m_rt_render_state != RT_RENDER_STATE_FINISH );
+
+    // The buffer rows go from the bottom to the top of the window
+    const unsigned int x0 = ( bufferSize.x - aSize.x ) / 2;
+    const unsigned int y0 = ( bufferSize.y - aSize.y ) / 2;
+
+    aImage.Create( aSize.x, aSize.y, false );
+
+    unsigned char *dst = aImage.GetData();
+
+    for( int y = 0; y < aSize.y; ++y )
+    {
+        const GLubyte *src = &buffer[ ( ( y0 + aSize.y - 1 - y ) * m_realBufferSize.x + x0 ) * 4 ];
+
+        for( int x = 0; x < aSize.x; ++x )
+        {
+            *dst++ = src[0];
+            *dst++ = src[1];
+            *dst++ = src[2];
+            src += 4;
+        }
+    }
+
+    // Restore the window size, and force the buffers (and the PBO) to be
+    // initialized again on the next Redraw
+    m_windowSize = oldWindowSize;
+    m_oldWindowsSize = wxSize( 0, 0 );
+    m_rt_render_state = RT_RENDER_STATE_MAX;
+
+    return true;
+}
+
+
 void C3D_RENDER_RAYTRACING::render( GLubyte *ptrPBO , REPORTER *aStatusTextReporter )
 {
     if( (m_rt_render_state == RT_RENDER_STATE_FINISH) ||
@@ -2128,6 +2201,14 @@ void C3D_RENDER_RAYTRACING::initialize_block_positions()
     m_xoffset = (m_windowSize.x - m_realBufferSize.x) / 2;
     m_yoffset = (m_windowSize.y - m_realBufferSize.y) / 2;
 
+    initialize_block_buffers();
+
+    opengl_init_pbo();
+}
+
+
+void C3D_RENDER_RAYTRACING::initialize_block_buffers()
+{
     m_postshader_ssao.UpdateSize( m_realBufferSize );
 
 
@@ -2153,6 +2234,4 @@ void C3D_RENDER_RAYTRACING::initialize_block_positions()
     // Create m_shader buffer
     delete[] m_shaderBuffer;
     m_shaderBuffer = new SFVEC3F[m_realBufferSize.x * m_realBufferSize.y];
-
-    opengl_init_pbo();
 }
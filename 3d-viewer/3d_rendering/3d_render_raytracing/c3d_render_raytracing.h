@@ -41,6 +41,8 @@
 
 #include <map>
 
+class wxImage;
+
 /// Vector of materials
 typedef std::vector< CBLINN_PHONG_MATERIAL > MODEL_MATERIALS;
 
@@ -69,6 +71,22 @@ public:
 
     int GetWaitForEditingTimeOut() override;
 
+    /**
+     * @brief RenderToImage - renders the full quality image (tracing and post
+     * processing) of the current camera into aImage, without an OpenGL context.
+     * The board is loaded first if a reload was requested.
+     * The image is rendered on all the cores and the call returns when it is finished.
+     * As the tracer works on whole ray packets, the camera frame is the one of
+     * aSize rounded up to a multiple of RAYPACKET_DIM, cropped to aSize.
+     * @param aSize: the image size in pixels
+     * @param aImage: receives the RGB image
+     * @param aStatusTextReporter: optional reporter of the loading and render progress
+     * @return true if the image was rendered
+     */
+    bool RenderToImage( const wxSize &aSize,
+                        wxImage &aImage,
+                        REPORTER *aStatusTextReporter = NULL );
+
 private:
     bool initializeOpenGL();
     void initializeNewWindowSize();
@@ -191,6 +209,10 @@ private:
                                 const CMATERIAL *aMaterial,
                                 const SFVEC3F &aObjColor );
 
+    void create_3d_layer_objects( PCB_LAYER_ID aLayerId,
+                                  const CBVHCONTAINER2D *aContainer2d,
+                                  std::vector<COBJECT *> &aDstObjects );
+
     void add_3D_vias_and_pads_to_container();
     void insert3DViaHole( const VIA* aVia );
     void insert3DPadHole( const D_PAD* aPad );
@@ -202,6 +224,7 @@ private:
     MAP_MODEL_MATERIALS m_model_materials;
 
     void initialize_block_positions();
+    void initialize_block_buffers();
 
     void render( GLubyte *ptrPBO, REPORTER *aStatusTextReporter );
     void render_preview( GLubyte *ptrPBO );
@@ -30,29 +30,39 @@
 
 #include "cfrustum.h"
 
-// !TODO: optimize wih SSE
-//#if(GLM_ARCH != GLM_ARCH_PURE)
-#if 0
-#error not implemented
-#else
+#ifdef RAYTRACING_USE_SSE
+#include <xmmintrin.h>
+#endif
 
+#include <cfloat>
 
-#endif
 
 void CFRUSTUM::GenerateFrustum( const RAY &topLeft,
                                 const RAY &topRight,
                                 const RAY &bottomLeft,
                                 const RAY &bottomRight )
 {
-    m_point[0] = topLeft.m_Origin;
-    m_point[1] = topRight.m_Origin;
-    m_point[2] = bottomLeft.m_Origin;
-    m_point[3] = topLeft.m_Origin;
-
-    m_normals[0] = glm::cross( topRight.m_Dir,    topLeft.m_Dir );              // TOP
-    m_normals[1] = glm::cross( bottomRight.m_Dir, topRight.m_Dir );             // RIGHT
-    m_normals[2] = glm::cross( bottomLeft.m_Dir,  bottomRight.m_Dir );          // BOTTOM
-    m_normals[3] = glm::cross( topLeft.m_Dir,     bottomLeft.m_Dir );           // LEFT
+    const SFVEC3F point[4] = { topLeft.m_Origin,
+                               topRight.m_Origin,
+                               bottomLeft.m_Origin,
+                               topLeft.m_Origin };
+
+    const SFVEC3F normal[4] = {
+        glm::cross( topRight.m_Dir,    topLeft.m_Dir ),             // TOP
+        glm::cross( bottomRight.m_Dir, topRight.m_Dir ),            // RIGHT
+        glm::cross( bottomLeft.m_Dir,  bottomRight.m_Dir ),         // BOTTOM
+        glm::cross( topLeft.m_Dir,     bottomLeft.m_Dir ) };        // LEFT
+
+    for( unsigned int i = 0; i < 4; ++i )
+    {
+        m_pointX[i] = point[i].x;
+        m_pointY[i] = point[i].y;
+        m_pointZ[i] = point[i].z;
+
+        m_normalX[i] = normal[i].x;
+        m_normalY[i] = normal[i].y;
+        m_normalZ[i] = normal[i].z;
+    }
 }
 
 
@@ -62,42 +72,58 @@ void CFRUSTUM::GenerateFrustum( const RAY &topLeft,
 // by Nathan Slobody and Adam Wright
 // The frustum test is not exllude all the boxes,
 // when a box is behind and if it is intersecting the planes it will not be discardly but should.
+//
+// A box is on the right side of a plane if any of its corners is. Instead of
+// testing the 8 corners, only the corner that goes the most along the plane
+// normal (the "positive vertex") is tested.
 bool CFRUSTUM::Intersect( const CBBOX &aBBox ) const
 {
-    const SFVEC3F box[8] = { aBBox.Min(),
-                             aBBox.Max(),
-                             SFVEC3F(aBBox.Min().x, aBBox.Min().y, aBBox.Max().z),
-                             SFVEC3F(aBBox.Min().x, aBBox.Max().y, aBBox.Min().z),
-                             SFVEC3F(aBBox.Min().x, aBBox.Max().y, aBBox.Max().z),
-                             SFVEC3F(aBBox.Max().x, aBBox.Min().y, aBBox.Min().z),
-                             SFVEC3F(aBBox.Max().x, aBBox.Min().y, aBBox.Max().z),
-                             SFVEC3F(aBBox.Max().x, aBBox.Max().y, aBBox.Min().z) };
-
-    // test each plane of frustum individually; if the point is on the wrong
+    const SFVEC3F &bmin = aBBox.Min();
+    const SFVEC3F &bmax = aBBox.Max();
+
+#ifdef RAYTRACING_USE_SSE
+    const __m128 zero = _mm_setzero_ps();
+
+    const __m128 nx = _mm_loadu_ps( m_normalX );
+    const __m128 ny = _mm_loadu_ps( m_normalY );
+    const __m128 nz = _mm_loadu_ps( m_normalZ );
+
+    // Select the positive vertex of the box for each plane
+    const __m128 sx = _mm_cmpge_ps( nx, zero );
+    const __m128 sy = _mm_cmpge_ps( ny, zero );
+    const __m128 sz = _mm_cmpge_ps( nz, zero );
+
+    const __m128 px = _mm_or_ps( _mm_and_ps( sx, _mm_set1_ps( bmax.x ) ),
+                                 _mm_andnot_ps( sx, _mm_set1_ps( bmin.x ) ) );
+    const __m128 py = _mm_or_ps( _mm_and_ps( sy, _mm_set1_ps( bmax.y ) ),
+                                 _mm_andnot_ps( sy, _mm_set1_ps( bmin.y ) ) );
+    const __m128 pz = _mm_or_ps( _mm_and_ps( sz, _mm_set1_ps( bmax.z ) ),
+                                 _mm_andnot_ps( sz, _mm_set1_ps( bmin.z ) ) );
+
+    // dot( pointPlane - vertex, normalPlane ) of the 4 planes
+    const __m128 dot = _mm_add_ps( _mm_add_ps(
+            _mm_mul_ps( _mm_sub_ps( _mm_loadu_ps( m_pointX ), px ), nx ),
+            _mm_mul_ps( _mm_sub_ps( _mm_loadu_ps( m_pointY ), py ), ny ) ),
+            _mm_mul_ps( _mm_sub_ps( _mm_loadu_ps( m_pointZ ), pz ), nz ) );
+
+    return _mm_movemask_ps( _mm_cmplt_ps( dot, _mm_set1_ps( FLT_EPSILON ) ) ) == 0xF;
+#else
+    // test each plane of frustum individually; if the box is on the wrong
     // side of the plane, the box is outside the frustum and we can exit
-    int out_side = 0;
-
     for( unsigned int i = 0; i < 4; ++i )
     {
-        const SFVEC3F &pointPlane  = m_point[i];
-        const SFVEC3F &normalPlane = m_normals[i];
+        const SFVEC3F normalPlane( m_normalX[i], m_normalY[i], m_normalZ[i] );
 
-        for( unsigned int j = 0; j < 8; ++j )
-        {
-            const SFVEC3F OP = pointPlane - box[j];
-            const float dot = glm::dot( OP, normalPlane );
+        const SFVEC3F vertex( normalPlane.x >= 0.0f ? bmax.x : bmin.x,
+                              normalPlane.y >= 0.0f ? bmax.y : bmin.y,
+                              normalPlane.z >= 0.0f ? bmax.z : bmin.z );
 
-            if( dot < FLT_EPSILON )
-            {
-                out_side++;
+        const SFVEC3F OP = SFVEC3F( m_pointX[i], m_pointY[i], m_pointZ[i] ) - vertex;
 
-                break;
-            }
-        }
+        if( glm::dot( OP, normalPlane ) >= FLT_EPSILON )
+            return false;
     }
 
-    if( out_side == 4 )
-        return true;
-
-    return false;
+    return true;
+#endif
 }
@@ -33,11 +33,11 @@
 #include "shapes3D/cbbox.h"
 #include "ray.h"
 
-// !TODO: optimize wih SSE
-//#if(GLM_ARCH != GLM_ARCH_PURE)
-#if 0
-#error not implemented
-#else
+// SSE is part of all the x86-64 (and most of the x86) builds
+#if defined( __SSE__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && ( _M_IX86_FP >= 1 ) )
+#define RAYTRACING_USE_SSE
+#endif
+
 struct CFRUSTUM
 {
 
@@ -62,10 +62,16 @@ public:
     bool Intersect( const CBBOX &aBBox ) const;
 
 private:
-        SFVEC3F m_normals[4];
-        SFVEC3F m_point[4];
+    // The 4 planes (point and normal) stored as structure of arrays,
+    // so they are all tested at once with SSE
+    float m_pointX[4];
+    float m_pointY[4];
+    float m_pointZ[4];
+
+    float m_normalX[4];
+    float m_normalY[4];
+    float m_normalZ[4];
 };
-#endif
 
 
 #endif // _CFRUSTUM_H_
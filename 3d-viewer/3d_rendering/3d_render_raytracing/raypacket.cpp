@@ -31,6 +31,18 @@
 #include "../3d_fastmath.h"
 #include <wx/debug.h>
 
+#include <algorithm>
+
+#ifdef RAYTRACING_USE_SSE
+#include <xmmintrin.h>
+
+// The AVX kernel is built with a target attribute and selected at runtime
+#if defined( __GNUC__ ) && ( defined( __x86_64__ ) || defined( __i386__ ) )
+#define RAYTRACING_USE_AVX
+#include <immintrin.h>
+#endif
+#endif
+
 
 static void RAYPACKET_GenerateFrustum( CFRUSTUM *m_Frustum, RAY *m_ray )
 {
@@ -42,6 +54,21 @@ static void RAYPACKET_GenerateFrustum( CFRUSTUM *m_Frustum, RAY *m_ray )
 }
 
 
+static void RAYPACKET_GenerateSoA( RAYPACKET_SOA *aSoA, const RAY *aRay )
+{
+    for( unsigned int i = 0; i < RAYPACKET_RAYS_PER_PACKET; ++i )
+    {
+        aSoA->m_OriginX[i] = aRay[i].m_Origin.x;
+        aSoA->m_OriginY[i] = aRay[i].m_Origin.y;
+        aSoA->m_OriginZ[i] = aRay[i].m_Origin.z;
+
+        aSoA->m_InvDirX[i] = aRay[i].m_InvDir.x;
+        aSoA->m_InvDirY[i] = aRay[i].m_InvDir.y;
+        aSoA->m_InvDirZ[i] = aRay[i].m_InvDir.z;
+    }
+}
+
+
 RAYPACKET::RAYPACKET( const CCAMERA &aCamera, const SFVEC2I &aWindowsPosition )
 {
     unsigned int i = 0;
@@ -66,6 +93,7 @@ RAYPACKET::RAYPACKET( const CCAMERA &aCamera, const SFVEC2I &aWindowsPosition )
     wxASSERT( i == RAYPACKET_RAYS_PER_PACKET );
 
     RAYPACKET_GenerateFrustum( &m_Frustum, m_ray );
+    RAYPACKET_GenerateSoA( &m_soa, m_ray );
 }
 
 
@@ -75,6 +103,7 @@ RAYPACKET::RAYPACKET( const CCAMERA &aCamera,
     RAYPACKET_InitRays( aCamera, aWindowsPosition, m_ray );
 
     RAYPACKET_GenerateFrustum( &m_Frustum, m_ray );
+    RAYPACKET_GenerateSoA( &m_soa, m_ray );
 }
 
 
@@ -88,6 +117,7 @@ RAYPACKET::RAYPACKET( const CCAMERA &aCamera,
                                            m_ray );
 
     RAYPACKET_GenerateFrustum( &m_Frustum, m_ray );
+    RAYPACKET_GenerateSoA( &m_soa, m_ray );
 }
 
 
@@ -119,6 +149,7 @@ RAYPACKET::RAYPACKET( const CCAMERA &aCamera,
     wxASSERT( i == RAYPACKET_RAYS_PER_PACKET );
 
     RAYPACKET_GenerateFrustum( &m_Frustum, m_ray );
+    RAYPACKET_GenerateSoA( &m_soa, m_ray );
 }
 
 
@@ -148,6 +179,7 @@ RAYPACKET::RAYPACKET( const CCAMERA &aCamera,
     wxASSERT( i == RAYPACKET_RAYS_PER_PACKET );
 
     RAYPACKET_GenerateFrustum( &m_Frustum, m_ray );
+    RAYPACKET_GenerateSoA( &m_soa, m_ray );
 }
 
 
@@ -193,3 +225,230 @@ void RAYPACKET_InitRays_with2DDisplacement( const CCAMERA &aCamera,
         }
     }
 }
+
+
+// Ray / bbox slab test of all the rays of a packet
+// "An Efficient and Robust Ray-Box Intersection Algorithm"
+// Amy Williams, Steve Barrus, R. Keith Morley, Peter Shirley
+// http://people.csail.mit.edu/amy/papers/box-jgt.pdf
+//
+// A ray hits the box if the exit distance is positive and not smaller than the
+// entry distance, and the entry distance is closer than its current hit.
+// The NaN produced by a ray parallel to a slab and starting on its border are
+// ignored by the min/max (they return the second operand), as the accumulated
+// value is always the second operand.
+
+static uint64_t intersectBBox_scalar( const RAYPACKET_SOA &aSoA,
+                                      const CBBOX &aBBox,
+                                      const float *aTHit )
+{
+    const SFVEC3F &bmin = aBBox.Min();
+    const SFVEC3F &bmax = aBBox.Max();
+
+    uint64_t mask = 0;
+
+    for( unsigned int i = 0; i < RAYPACKET_RAYS_PER_PACKET; ++i )
+    {
+        const float tx0 = ( bmin.x - aSoA.m_OriginX[i] ) * aSoA.m_InvDirX[i];
+        const float tx1 = ( bmax.x - aSoA.m_OriginX[i] ) * aSoA.m_InvDirX[i];
+        const float ty0 = ( bmin.y - aSoA.m_OriginY[i] ) * aSoA.m_InvDirY[i];
+        const float ty1 = ( bmax.y - aSoA.m_OriginY[i] ) * aSoA.m_InvDirY[i];
+        const float tz0 = ( bmin.z - aSoA.m_OriginZ[i] ) * aSoA.m_InvDirZ[i];
+        const float tz1 = ( bmax.z - aSoA.m_OriginZ[i] ) * aSoA.m_InvDirZ[i];
+
+        float tmin = tx0 < tx1 ? tx0 : tx1;
+        float tmax = tx0 > tx1 ? tx0 : tx1;
+
+        const float tymin = ty0 < ty1 ? ty0 : ty1;
+        const float tymax = ty0 > ty1 ? ty0 : ty1;
+        const float tzmin = tz0 < tz1 ? tz0 : tz1;
+        const float tzmax = tz0 > tz1 ? tz0 : tz1;
+
+        tmin = tymin > tmin ? tymin : tmin;
+        tmin = tzmin > tmin ? tzmin : tmin;
+        tmax = tymax < tmax ? tymax : tmax;
+        tmax = tzmax < tmax ? tzmax : tmax;
+
+        if( ( tmax >= 0.0f ) && ( tmax >= tmin ) && ( tmin < aTHit[i] ) )
+            mask |= (uint64_t)1 << i;
+    }
+
+    return mask;
+}
+
+
+#ifdef RAYTRACING_USE_SSE
+
+static uint64_t intersectBBox_sse( const RAYPACKET_SOA &aSoA,
+                                   const CBBOX &aBBox,
+                                   const float *aTHit )
+{
+    const __m128 minX = _mm_set1_ps( aBBox.Min().x );
+    const __m128 minY = _mm_set1_ps( aBBox.Min().y );
+    const __m128 minZ = _mm_set1_ps( aBBox.Min().z );
+    const __m128 maxX = _mm_set1_ps( aBBox.Max().x );
+    const __m128 maxY = _mm_set1_ps( aBBox.Max().y );
+    const __m128 maxZ = _mm_set1_ps( aBBox.Max().z );
+    const __m128 zero = _mm_setzero_ps();
+
+    uint64_t mask = 0;
+
+    for( unsigned int i = 0; i < RAYPACKET_RAYS_PER_PACKET; i += 4 )
+    {
+        const __m128 oX = _mm_loadu_ps( &aSoA.m_OriginX[i] );
+        const __m128 oY = _mm_loadu_ps( &aSoA.m_OriginY[i] );
+        const __m128 oZ = _mm_loadu_ps( &aSoA.m_OriginZ[i] );
+        const __m128 iX = _mm_loadu_ps( &aSoA.m_InvDirX[i] );
+        const __m128 iY = _mm_loadu_ps( &aSoA.m_InvDirY[i] );
+        const __m128 iZ = _mm_loadu_ps( &aSoA.m_InvDirZ[i] );
+
+        const __m128 tx0 = _mm_mul_ps( _mm_sub_ps( minX, oX ), iX );
+        const __m128 tx1 = _mm_mul_ps( _mm_sub_ps( maxX, oX ), iX );
+        const __m128 ty0 = _mm_mul_ps( _mm_sub_ps( minY, oY ), iY );
+        const __m128 ty1 = _mm_mul_ps( _mm_sub_ps( maxY, oY ), iY );
+        const __m128 tz0 = _mm_mul_ps( _mm_sub_ps( minZ, oZ ), iZ );
+        const __m128 tz1 = _mm_mul_ps( _mm_sub_ps( maxZ, oZ ), iZ );
+
+        __m128 tmin = _mm_min_ps( tx0, tx1 );
+        __m128 tmax = _mm_max_ps( tx0, tx1 );
+
+        tmin = _mm_max_ps( _mm_min_ps( ty0, ty1 ), tmin );
+        tmin = _mm_max_ps( _mm_min_ps( tz0, tz1 ), tmin );
+        tmax = _mm_min_ps( _mm_max_ps( ty0, ty1 ), tmax );
+        tmax = _mm_min_ps( _mm_max_ps( tz0, tz1 ), tmax );
+
+        const __m128 hit = _mm_and_ps( _mm_and_ps( _mm_cmpge_ps( tmax, zero ),
+                                                   _mm_cmpge_ps( tmax, tmin ) ),
+                                       _mm_cmplt_ps( tmin, _mm_loadu_ps( &aTHit[i] ) ) );
+
+        mask |= (uint64_t)_mm_movemask_ps( hit ) << i;
+    }
+
+    return mask;
+}
+
+#endif
+
+
+#ifdef RAYTRACING_USE_AVX
+
+__attribute__(( target( "avx" ) ))
+static uint64_t intersectBBox_avx( const RAYPACKET_SOA &aSoA,
+                                   const CBBOX &aBBox,
+                                   const float *aTHit )
+{
+    const __m256 minX = _mm256_set1_ps( aBBox.Min().x );
+    const __m256 minY = _mm256_set1_ps( aBBox.Min().y );
+    const __m256 minZ = _mm256_set1_ps( aBBox.Min().z );
+    const __m256 maxX = _mm256_set1_ps( aBBox.Max().x );
+    const __m256 maxY = _mm256_set1_ps( aBBox.Max().y );
+    const __m256 maxZ = _mm256_set1_ps( aBBox.Max().z );
+    const __m256 zero = _mm256_setzero_ps();
+
+    uint64_t mask = 0;
+
+    for( unsigned int i = 0; i < RAYPACKET_RAYS_PER_PACKET; i += 8 )
+    {
+        const __m256 oX = _mm256_loadu_ps( &aSoA.m_OriginX[i] );
+        const __m256 oY = _mm256_loadu_ps( &aSoA.m_OriginY[i] );
+        const __m256 oZ = _mm256_loadu_ps( &aSoA.m_OriginZ[i] );
+        const __m256 iX = _mm256_loadu_ps( &aSoA.m_InvDirX[i] );
+        const __m256 iY = _mm256_loadu_ps( &aSoA.m_InvDirY[i] );
+        const __m256 iZ = _mm256_loadu_ps( &aSoA.m_InvDirZ[i] );
+
+        const __m256 tx0 = _mm256_mul_ps( _mm256_sub_ps( minX, oX ), iX );
+        const __m256 tx1 = _mm256_mul_ps( _mm256_sub_ps( maxX, oX ), iX );
+        const __m256 ty0 = _mm256_mul_ps( _mm256_sub_ps( minY, oY ), iY );
+        const __m256 ty1 = _mm256_mul_ps( _mm256_sub_ps( maxY, oY ), iY );
+        const __m256 tz0 = _mm256_mul_ps( _mm256_sub_ps( minZ, oZ ), iZ );
+        const __m256 tz1 = _mm256_mul_ps( _mm256_sub_ps( maxZ, oZ ), iZ );
+
+        __m256 tmin = _mm256_min_ps( tx0, tx1 );
+        __m256 tmax = _mm256_max_ps( tx0, tx1 );
+
+        tmin = _mm256_max_ps( _mm256_min_ps( ty0, ty1 ), tmin );
+        tmin = _mm256_max_ps( _mm256_min_ps( tz0, tz1 ), tmin );
+        tmax = _mm256_min_ps( _mm256_max_ps( ty0, ty1 ), tmax );
+        tmax = _mm256_min_ps( _mm256_max_ps( tz0, tz1 ), tmax );
+
+        const __m256 hit = _mm256_and_ps(
+                _mm256_and_ps( _mm256_cmp_ps( tmax, zero, _CMP_GE_OQ ),
+                               _mm256_cmp_ps( tmax, tmin, _CMP_GE_OQ ) ),
+                _mm256_cmp_ps( tmin, _mm256_loadu_ps( &aTHit[i] ), _CMP_LT_OQ ) );
+
+        mask |= (uint64_t)_mm256_movemask_ps( hit ) << i;
+    }
+
+    return mask;
+}
+
+#endif
+
+
+typedef uint64_t (*INTERSECT_BBOX_FUNC)( const RAYPACKET_SOA &aSoA,
+                                         const CBBOX &aBBox,
+                                         const float *aTHit );
+
+
+static RAYPACKET_SIMD supportedSIMD()
+{
+#if defined( RAYTRACING_USE_AVX )
+    // This runs from a static initializer, possibly before the one of libgcc which
+    // fills the CPU features queried by __builtin_cpu_supports()
+    __builtin_cpu_init();
+
+    if( __builtin_cpu_supports( "avx" ) )
+        return RAYPACKET_SIMD_AVX;
+#endif
+
+#if defined( RAYTRACING_USE_SSE )
+    return RAYPACKET_SIMD_SSE;
+#else
+    return RAYPACKET_SIMD_NONE;
+#endif
+}
+
+
+static INTERSECT_BBOX_FUNC intersectBBoxFunc( RAYPACKET_SIMD aSIMD )
+{
+    switch( aSIMD )
+    {
+#ifdef RAYTRACING_USE_AVX
+    case RAYPACKET_SIMD_AVX:
+        return intersectBBox_avx;
+#endif
+
+#ifdef RAYTRACING_USE_SSE
+    case RAYPACKET_SIMD_SSE:
+        return intersectBBox_sse;
+#endif
+
+    default:
+        return intersectBBox_scalar;
+    }
+}
+
+
+static RAYPACKET_SIMD      s_simd = supportedSIMD();
+static INTERSECT_BBOX_FUNC s_intersectBBox = intersectBBoxFunc( s_simd );
+
+
+uint64_t RAYPACKET_IntersectBBox( const RAYPACKET &aRayPacket,
+                                  const CBBOX &aBBox,
+                                  const float *aTHit )
+{
+    return s_intersectBBox( aRayPacket.m_soa, aBBox, aTHit );
+}
+
+
+RAYPACKET_SIMD RAYPACKET_GetSIMD()
+{
+    return s_simd;
+}
+
+
+void RAYPACKET_SetSIMD( RAYPACKET_SIMD aSIMD )
+{
+    s_simd = std::min( aSIMD, supportedSIMD() );
+    s_intersectBBox = intersectBBoxFunc( s_simd );
+}
@@ -34,16 +34,37 @@
 #include "cfrustum.h"
 #include "../ccamera.h"
 
+#include <stdint.h>
+
 #define RAYPACKET_DIM (1 << 3)
 #define RAYPACKET_MASK    (unsigned int)( (RAYPACKET_DIM - 1))
 #define RAYPACKET_INVMASK (unsigned int)(~(RAYPACKET_DIM - 1))
 #define RAYPACKET_RAYS_PER_PACKET (RAYPACKET_DIM * RAYPACKET_DIM)
 
 
+// The bbox test of a packet returns one bit per ray
+static_assert( RAYPACKET_RAYS_PER_PACKET <= 64, "RAYPACKET_RAYS_PER_PACKET must fit a uint64_t" );
+
+
+/// Copy of the ray origins and inverse directions of a packet as structure of
+/// arrays, so several rays are tested at once against a bbox
+struct RAYPACKET_SOA
+{
+    float m_OriginX[RAYPACKET_RAYS_PER_PACKET];
+    float m_OriginY[RAYPACKET_RAYS_PER_PACKET];
+    float m_OriginZ[RAYPACKET_RAYS_PER_PACKET];
+
+    float m_InvDirX[RAYPACKET_RAYS_PER_PACKET];
+    float m_InvDirY[RAYPACKET_RAYS_PER_PACKET];
+    float m_InvDirZ[RAYPACKET_RAYS_PER_PACKET];
+};
+
+
 struct RAYPACKET
 {
-    CFRUSTUM    m_Frustum;
-    RAY         m_ray[RAYPACKET_RAYS_PER_PACKET];
+    CFRUSTUM        m_Frustum;
+    RAY             m_ray[RAYPACKET_RAYS_PER_PACKET];
+    RAYPACKET_SOA   m_soa;
 
     RAYPACKET( const CCAMERA &aCamera,
                const SFVEC2I &aWindowsPosition );
@@ -73,4 +94,39 @@ void RAYPACKET_InitRays_with2DDisplacement( const CCAMERA &aCamera,
                                             const SFVEC2F &a2DWindowsPosDisplacementFactor,
                                             RAY *aRayPck );
 
+
+/// Instruction sets that can be used by the ray packet kernels
+enum RAYPACKET_SIMD
+{
+    RAYPACKET_SIMD_NONE = 0,
+    RAYPACKET_SIMD_SSE,
+    RAYPACKET_SIMD_AVX
+};
+
+/**
+ * @brief RAYPACKET_IntersectBBox - tests all the rays of a packet against a bbox
+ * (slab test), using the instruction set selected at runtime for this CPU
+ * @param aRayPacket: the packet to test
+ * @param aBBox: the bbox
+ * @param aTHit: the current hit distance of each ray of the packet
+ * @return a mask with the bit i set if the ray i hits the bbox closer than aTHit[i]
+ */
+uint64_t RAYPACKET_IntersectBBox( const RAYPACKET &aRayPacket,
+                                  const CBBOX &aBBox,
+                                  const float *aTHit );
+
+/**
+ * @brief RAYPACKET_GetSIMD
+ * @return the instruction set used by RAYPACKET_IntersectBBox
+ */
+RAYPACKET_SIMD RAYPACKET_GetSIMD();
+
+/**
+ * @brief RAYPACKET_SetSIMD - selects the instruction set used by RAYPACKET_IntersectBBox,
+ * e.g. to benchmark the kernels. It is limited to the best one supported by the CPU.
+ * Must not be called while rendering.
+ * @param aSIMD: the instruction set to use
+ */
+void RAYPACKET_SetSIMD( RAYPACKET_SIMD aSIMD );
+
 #endif // _RAYPACKET_H_
@@ -60,6 +60,6 @@ void COBJECT3D_STATS::PrintStats()
 
     for( unsigned int i = 0; i < OBJ3D_MAX; ++i )
     {
-        printf( "  %20s  %u\n", OBJECT3D_STR[i], m_counter[i] );
+        printf( "  %20s  %u\n", OBJECT3D_STR[i], m_counter[i].load() );
     }
 }
@@ -33,6 +33,7 @@
 #include "cbbox.h"
 #include "../hitinfo.h"
 #include "../cmaterial.h"
+#include <atomic>
 
 
 enum OBJECT3D_TYPE
@@ -103,9 +104,11 @@ class COBJECT3D_STATS
 {
 public:
 
-    void ResetStats() { memset( m_counter,
-                                0,
-                                sizeof( unsigned int ) * OBJ3D_MAX ); }
+    void ResetStats()
+    {
+        for( unsigned int i = 0; i < OBJ3D_MAX; ++i )
+            m_counter[i] = 0;
+    }
 
     unsigned int GetCountOf( OBJECT3D_TYPE aObjType ) const { return m_counter[aObjType]; }
 
@@ -128,7 +131,8 @@ private:
     ~COBJECT3D_STATS(){}
 
 private:
-    unsigned int m_counter[OBJ3D_MAX];
+    // Objects are created from several threads when the scene is built
+    std::atomic<unsigned int> m_counter[OBJ3D_MAX];
 
     static COBJECT3D_STATS *s_instance;
 };
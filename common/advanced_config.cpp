@@ -90,6 +90,27 @@ static const wxChar AllowLegacyCanvasInGtk3[] = wxT( "AllowLegacyCanvasInGtk3" )
  */
 static const wxChar CoroutineStackSize[] = wxT( "CoroutineStackSize" );
 
+/**
+ * Draw the redraw statistics of the last frame (items queried, culled, drawn from
+ * cache, re-tessellated and redraw time) over GAL canvases.  Used to profile the
+ * rendering on large boards.
+ */
+static const wxChar ShowRedrawStats[] = wxT( "ShowRedrawStats" );
+
+/**
+ * With the Cairo (software) canvas, keep the layers of the board as raster tiles
+ * and only render again the tiles where items were modified, so panning and zooming
+ * back and forth does not redraw every item.
+ */
+static const wxChar CairoTileCache[] = wxT( "CairoTileCache" );
+
+/**
+ * Make the footprint autoplacer evaluate candidate positions on a coarse grid, then
+ * only on the placement grid around the best coarse positions. Much faster on large
+ * boards, but it can miss the best position.
+ */
+static const wxChar CoarseAutoplaceSearch[] = wxT( "CoarseAutoplaceSearch" );
+
 } // namespace KEYS
 
 
@@ -171,6 +192,9 @@ ADVANCED_CFG::ADVANCED_CFG()
     m_allowLegacyCanvasInGtk3 = false;
     m_realTimeConnectivity = true;
     m_coroutineStackSize = AC_STACK::default_stack;
+    m_showRedrawStats = false;
+    m_cairoTileCache = false;
+    m_coarseAutoplaceSearch = false;
 
     loadFromConfigFile();
 }
@@ -217,6 +241,15 @@ void ADVANCED_CFG::loadSettings( wxConfigBase& aCfg )
             new PARAM_CFG_INT( true, AC_KEYS::CoroutineStackSize, &m_coroutineStackSize,
                     AC_STACK::default_stack, AC_STACK::min_stack, AC_STACK::max_stack ) );
 
+    configParams.push_back(
+            new PARAM_CFG_BOOL( true, AC_KEYS::ShowRedrawStats, &m_showRedrawStats, false ) );
+
+    configParams.push_back(
+            new PARAM_CFG_BOOL( true, AC_KEYS::CairoTileCache, &m_cairoTileCache, false ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL(
+            true, AC_KEYS::CoarseAutoplaceSearch, &m_coarseAutoplaceSearch, false ) );
+
     wxConfigLoadSetups( &aCfg, configParams );
 
     dumpCfg( configParams );
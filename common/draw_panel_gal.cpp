@@ -27,6 +27,7 @@
 #include <eda_draw_frame.h>
 #include <kiface_i.h>
 #include <confirm.h>
+#include <advanced_config.h>
 
 #include <class_draw_panel_gal.h>
 #include <view/view.h>
@@ -60,6 +61,7 @@ EDA_DRAW_PANEL_GAL::EDA_DRAW_PANEL_GAL( wxWindow* aParentWindow, wxWindowID aWin
     m_eventDispatcher = NULL;
     m_lostFocus  = false;
     m_stealsFocus = true;
+    m_showRedrawStats = ADVANCED_CFG::GetCfg().m_showRedrawStats;
 
     m_currentCursor = wxStockCursor( wxCURSOR_ARROW );
 
@@ -191,6 +193,11 @@ void EDA_DRAW_PANEL_GAL::onPaint( wxPaintEvent& WXUNUSED( aEvent ) )
                 m_view->IsTargetDirty( KIGFX::TARGET_NONCACHED ) )
                 m_gal->ClearScreen();
 
+            // The statistics are drawn on the non cached target, so it must be redrawn
+            // on each frame to erase the previous ones
+            if( m_showRedrawStats )
+                m_view->MarkTargetDirty( KIGFX::TARGET_NONCACHED );
+
             m_view->ClearTargets();
 
             // Grid has to be redrawn only when the NONCACHED target is redrawn
@@ -198,6 +205,9 @@ void EDA_DRAW_PANEL_GAL::onPaint( wxPaintEvent& WXUNUSED( aEvent ) )
                 m_gal->DrawGrid();
 
             m_view->Redraw();
+
+            if( m_showRedrawStats )
+                drawRedrawStats();
         }
 
         m_gal->DrawCursor( m_viewControls->GetCursorPosition() );
@@ -223,6 +233,44 @@ void EDA_DRAW_PANEL_GAL::onPaint( wxPaintEvent& WXUNUSED( aEvent ) )
 }
 
 
+void EDA_DRAW_PANEL_GAL::drawRedrawStats()
+{
+    const KIGFX::VIEW_REDRAW_STATS& stats = m_view->GetRedrawStats();
+
+    const wxString lines[] =
+    {
+        wxString::Format( "redraw %.1f ms, update %.1f ms", stats.redrawTime, stats.updateTime ),
+        wxString::Format( "layers %d, queried %d", stats.layersDrawn, stats.itemsQueried ),
+        wxString::Format( "hidden %d, LOD culled %d", stats.itemsHidden, stats.itemsCulledLOD ),
+        wxString::Format( "cached %d, immediate %d, recached %d", stats.itemsDrawnCached,
+                          stats.itemsDrawnImmediate, stats.itemsRecached ),
+        wxString::Format( "tiles rendered %d, painted %d", stats.tilesRendered,
+                          stats.tilesPainted )
+    };
+
+    // Text size and positions are given in pixels
+    const double textSize = 12.0;
+    const double glyphSize = m_view->ToWorld( textSize );
+
+    m_gal->SetTarget( KIGFX::TARGET_NONCACHED );
+    m_gal->SetLayerDepth( m_gal->GetMinDepth() );
+    m_gal->ResetTextAttributes();
+    m_gal->SetHorizontalJustify( GR_TEXT_HJUSTIFY_LEFT );
+    m_gal->SetVerticalJustify( GR_TEXT_VJUSTIFY_TOP );
+    m_gal->SetGlyphSize( VECTOR2D( glyphSize, glyphSize ) );
+    m_gal->SetLineWidth( glyphSize / 8.0 );
+    m_gal->SetIsFill( false );
+    m_gal->SetIsStroke( true );
+    m_gal->SetStrokeColor( m_painter->GetSettings()->GetCursorColor() );
+
+    for( unsigned ii = 0; ii < arrayDim( lines ); ii++ )
+    {
+        VECTOR2D pos = m_view->ToWorld( VECTOR2D( textSize, textSize * ( 1.5 * ii + 1 ) ) );
+        m_gal->BitmapText( lines[ii], pos, 0.0 );
+    }
+}
+
+
 void EDA_DRAW_PANEL_GAL::onSize( wxSizeEvent& aEvent )
 {
     KIGFX::GAL_CONTEXT_LOCKER locker( m_gal );
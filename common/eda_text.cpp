@@ -164,6 +164,8 @@ bool EDA_TEXT::Replace( wxFindReplaceData& aSearchData )
 
 int EDA_TEXT::LenSize( const wxString& aLine, int aThickness ) const
 {
+    std::lock_guard<std::recursive_mutex> lock( basic_gal_mutex );
+
     basic_gal.SetFontItalic( IsItalic() );
     basic_gal.SetFontBold( IsBold() );
     basic_gal.SetLineWidth( (float) aThickness );
@@ -205,6 +207,8 @@ EDA_RECT EDA_TEXT::GetTextBox( int aLine, int aThickness, bool aInvertY ) const
     int            linecount = 1;
     bool           hasOverBar = false;     // true if the first line of text as an overbar
 
+    std::lock_guard<std::recursive_mutex> lock( basic_gal_mutex );
+
     if( IsMultilineAllowed() )
     {
         wxStringSplit( text, strings, '\n' );
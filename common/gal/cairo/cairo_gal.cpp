@@ -52,6 +52,11 @@ CAIRO_GAL_BASE::CAIRO_GAL_BASE( GAL_DISPLAY_OPTIONS& aDisplayOptions ) :
     groupCounter        = 0;
     currentGroup        = nullptr;
 
+    // Initialise raster tiles
+    tileCounter         = 0;
+    tileTargetContext   = nullptr;
+    cairo_matrix_init_identity( &tileTargetMatrix );
+
     lineWidth = 1.0;
     linePixelWidth = 1.0;
     lineWidthInPixels = 1.0;
@@ -73,6 +78,9 @@ CAIRO_GAL_BASE::~CAIRO_GAL_BASE()
 {
     ClearCache();
 
+    for( auto it = tiles.begin(); it != tiles.end(); )
+        DeleteTile( ( it++ )->first );
+
     if( surface )
         cairo_surface_destroy( surface );
 
@@ -902,6 +910,106 @@ void CAIRO_GAL_BASE::ClearCache()
 }
 
 
+int CAIRO_GAL_BASE::CreateTile( int aSize )
+{
+    TILE tile;
+    tile.surface = cairo_image_surface_create( GAL_FORMAT, aSize, aSize );
+    tile.context = cairo_create( tile.surface );
+
+    if( cairo_status( tile.context ) != CAIRO_STATUS_SUCCESS )
+    {
+        cairo_destroy( tile.context );
+        cairo_surface_destroy( tile.surface );
+        return -1;
+    }
+
+    int tileNumber = tileCounter++;
+    tiles.insert( std::make_pair( tileNumber, tile ) );
+
+    return tileNumber;
+}
+
+
+void CAIRO_GAL_BASE::BeginTile( int aTileNumber, const VECTOR2D& aScreenOrigin )
+{
+    auto it = tiles.find( aTileNumber );
+
+    wxCHECK( it != tiles.end() && !tileTargetContext, /* void */ );
+
+    // Finish what was drawn on the target
+    storePath();
+
+    cairo_t* tileContext = it->second.context;
+
+    // Tiles are painted on the target, so they use the same settings
+    cairo_set_antialias( tileContext, cairo_get_antialias( currentContext ) );
+    cairo_set_operator( tileContext, cairo_get_operator( currentContext ) );
+
+    cairo_save( tileContext );
+    cairo_set_operator( tileContext, CAIRO_OPERATOR_CLEAR );
+    cairo_paint( tileContext );
+    cairo_restore( tileContext );
+    cairo_new_path( tileContext );
+
+    tileTargetContext = currentContext;
+    currentContext = tileContext;
+
+    // Move the tile origin to (0, 0)
+    cairo_matrix_t translation;
+    cairo_matrix_init_translate( &translation, -aScreenOrigin.x, -aScreenOrigin.y );
+
+    tileTargetMatrix = cairoWorldScreenMatrix;
+    cairo_matrix_multiply( &cairoWorldScreenMatrix, &tileTargetMatrix, &translation );
+    updateWorldScreenMatrix();
+}
+
+
+void CAIRO_GAL_BASE::EndTile()
+{
+    wxCHECK( tileTargetContext, /* void */ );
+
+    storePath();
+    cairo_surface_flush( cairo_get_target( currentContext ) );
+
+    currentContext = tileTargetContext;
+    tileTargetContext = nullptr;
+
+    cairoWorldScreenMatrix = tileTargetMatrix;
+    updateWorldScreenMatrix();
+}
+
+
+void CAIRO_GAL_BASE::DrawTile( int aTileNumber, const VECTOR2I& aScreenOrigin )
+{
+    auto it = tiles.find( aTileNumber );
+
+    if( it == tiles.end() )
+        return;
+
+    storePath();
+
+    cairo_save( currentContext );
+    cairo_identity_matrix( currentContext );
+    cairo_set_source_surface( currentContext, it->second.surface, aScreenOrigin.x,
+                              aScreenOrigin.y );
+    cairo_paint( currentContext );
+    cairo_restore( currentContext );
+}
+
+
+void CAIRO_GAL_BASE::DeleteTile( int aTileNumber )
+{
+    auto it = tiles.find( aTileNumber );
+
+    if( it == tiles.end() )
+        return;
+
+    cairo_destroy( it->second.context );
+    cairo_surface_destroy( it->second.surface );
+    tiles.erase( it );
+}
+
+
 void CAIRO_GAL_BASE::SetNegativeDrawMode( bool aSetting )
 {
     cairo_set_operator( currentContext, aSetting ? CAIRO_OPERATOR_CLEAR : CAIRO_OPERATOR_OVER );
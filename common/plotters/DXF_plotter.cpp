@@ -593,9 +593,12 @@ void DXF_PLOTTER::PenTo( const wxPoint& pos, char plume )
         // DXF LINE
         wxString cname = getDXFColorName( m_currentColor );
         const char *lname = getDXFLineType( (PlotDashType) m_currentLineType );
-        fprintf( outputFile, "0\nLINE\n8\n%s\n6\n%s\n10\n%g\n20\n%g\n11\n%g\n21\n%g\n",
-                 TO_UTF8( cname ), lname,
-                 pen_lastpos_dev.x, pen_lastpos_dev.y, pos_dev.x, pos_dev.y );
+        PLOT_WRITER( outputFile ).Text( "0\nLINE\n8\n" ).Text( TO_UTF8( cname ) )
+                .Text( "\n6\n" ).Text( lname )
+                .Text( "\n10\n" ).Double( pen_lastpos_dev.x )
+                .Text( "\n20\n" ).Double( pen_lastpos_dev.y )
+                .Text( "\n11\n" ).Double( pos_dev.x )
+                .Text( "\n21\n" ).Double( pos_dev.y ).Char( '\n' );
     }
     penLastpos = pos;
 }
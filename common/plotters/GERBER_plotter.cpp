@@ -61,6 +61,23 @@ GERBER_PLOTTER::GERBER_PLOTTER()
     m_gerberUnitFmt = 6;
     m_useX2format = true;
     m_useNetAttributes = true;
+    m_useApertureMacros = false;
+}
+
+
+GERBER_PLOTTER::~GERBER_PLOTTER()
+{
+    // Emergency cleanup: the files are usually closed by EndPlot(), and they must be
+    // closed before their buffers are freed (see setFileBuffer()).  Once StartPlot() is
+    // called, outputFile is one of them, and the PLOTTER destructor must not close it again.
+    if( finalFile )
+    {
+        if( workFile )
+            fclose( workFile );
+
+        fclose( finalFile );
+        outputFile = NULL;
+    }
 }
 
 
@@ -101,8 +118,8 @@ void GERBER_PLOTTER::SetGerberCoordinatesFormat( int aResolution, bool aUseInche
 void GERBER_PLOTTER::emitDcode( const DPOINT& pt, int dcode )
 {
 
-    fprintf( outputFile, "X%dY%dD%02d*\n",
-	    KiROUND( pt.x ), KiROUND( pt.y ), dcode );
+    PLOT_WRITER( outputFile ).Char( 'X' ).Int( KiROUND( pt.x ) ).Char( 'Y' ).Int( KiROUND( pt.y ) )
+            .Char( 'D' ).Int( dcode, 2 ).Text( "*\n" );
 }
 
 
@@ -186,6 +203,8 @@ bool GERBER_PLOTTER::StartPlot()
     if( outputFile == NULL )
         return false;
 
+    setFileBuffer( workFile, true );
+
     for( unsigned ii = 0; ii < m_headerExtraLines.GetCount(); ii++ )
     {
         if( ! m_headerExtraLines[ii].IsEmpty() )
@@ -262,6 +281,8 @@ bool GERBER_PLOTTER::EndPlot()
     fclose( workFile );
     fclose( finalFile );
     ::wxRemoveFile( m_workFilename );
+    workFile   = NULL;
+    finalFile  = NULL;
     outputFile = 0;
 
     return true;
@@ -295,38 +316,79 @@ void GERBER_PLOTTER::SetCurrentLineWidth( int width, void* aData )
 }
 
 
-std::vector<APERTURE>::iterator GERBER_PLOTTER::getAperture( const wxSize& aSize,
-                        APERTURE::APERTURE_TYPE aType, int aApertureAttribute )
+size_t GERBER_PLOTTER::APERTURE_KEY_HASH::operator()( const APERTURE_KEY& aKey ) const
 {
-    int last_D_code = 9;
+    size_t seed = std::hash<int>()( aKey.m_Type );
 
-    // Search an existing aperture
-    std::vector<APERTURE>::iterator tool = apertures.begin();
+    for( int value : { aKey.m_SizeX, aKey.m_SizeY, aKey.m_Attribute } )
+        seed ^= std::hash<int>()( value ) + 0x9e3779b9 + ( seed << 6 ) + ( seed >> 2 );
 
-    while( tool != apertures.end() )
-    {
-        last_D_code = tool->m_DCode;
+    return seed;
+}
 
-        if( (tool->m_Type == aType) && (tool->m_Size == aSize) &&
-            (tool->m_ApertureAttribute == aApertureAttribute) )
-            return tool;
 
-        ++tool;
-    }
+std::vector<APERTURE>::iterator GERBER_PLOTTER::getAperture( const wxSize& aSize,
+                        APERTURE::APERTURE_TYPE aType, int aApertureAttribute )
+{
+    // Search an existing aperture
+    APERTURE_KEY key = { aType, aSize.x, aSize.y, aApertureAttribute };
+    auto         found = m_apertureIndex.find( key );
+
+    if( found != m_apertureIndex.end() )
+        return apertures.begin() + found->second;
 
     // Allocate a new aperture
     APERTURE new_tool;
     new_tool.m_Size  = aSize;
     new_tool.m_Type  = aType;
-    new_tool.m_DCode = last_D_code + 1;
+    new_tool.m_DCode = apertures.empty() ? FIRST_DCODE_VALUE : apertures.back().m_DCode + 1;
     new_tool.m_ApertureAttribute = aApertureAttribute;
 
+    m_apertureIndex[key] = apertures.size();
     apertures.push_back( new_tool );
 
     return apertures.end() - 1;
 }
 
 
+void GERBER_PLOTTER::selectOutlineAperture( const std::string& aMacroBody,
+                                            int aApertureAttribute )
+{
+    if( !m_useNetAttributes )
+        aApertureAttribute = 0;
+
+    std::string key = std::to_string( aApertureAttribute ) + ':' + aMacroBody;
+    auto        found = m_outlineApertureIndex.find( key );
+    size_t      index;
+
+    if( found != m_outlineApertureIndex.end() )
+    {
+        index = found->second;
+    }
+    else
+    {
+        APERTURE new_tool;
+        new_tool.m_Size  = wxSize( 0, 0 );
+        new_tool.m_Type  = APERTURE::AT_OUTLINE_MACRO;
+        new_tool.m_DCode = apertures.empty() ? FIRST_DCODE_VALUE : apertures.back().m_DCode + 1;
+        new_tool.m_ApertureAttribute = aApertureAttribute;
+        new_tool.m_MacroBody = aMacroBody;
+
+        index = apertures.size();
+        m_outlineApertureIndex[key] = index;
+        apertures.push_back( new_tool );
+        currentAperture = apertures.end();  // the push_back invalidated it
+    }
+
+    if( currentAperture == apertures.end()
+            || (size_t) ( currentAperture - apertures.begin() ) != index )
+    {
+        currentAperture = apertures.begin() + index;
+        PLOT_WRITER( outputFile ).Char( 'D' ).Int( currentAperture->m_DCode ).Text( "*\n" );
+    }
+}
+
+
 void GERBER_PLOTTER::selectAperture( const wxSize&           aSize,
                                      APERTURE::APERTURE_TYPE aType,
                                      int aApertureAttribute )
@@ -344,7 +406,7 @@ void GERBER_PLOTTER::selectAperture( const wxSize&           aSize,
     {
         // Pick an existing aperture or create a new one
         currentAperture = getAperture( aSize, aType, aApertureAttribute );
-        fprintf( outputFile, "D%d*\n", currentAperture->m_DCode );
+        PLOT_WRITER( outputFile ).Char( 'D' ).Int( currentAperture->m_DCode ).Text( "*\n" );
     }
 }
 
@@ -395,6 +457,14 @@ void GERBER_PLOTTER::writeApertureList()
                             useX1StructuredComment ).c_str(), outputFile );
         }
 
+        if( tool->m_Type == APERTURE::AT_OUTLINE_MACRO )
+        {
+            // The macro must be defined before the aperture using it
+            fprintf( outputFile, "%%AMOUTLINE%d*\n", tool->m_DCode );
+            fputs( tool->m_MacroBody.c_str(), outputFile );
+            fputs( "%\n", outputFile );
+        }
+
         char* text = cbuf + sprintf( cbuf, "%%ADD%d", tool->m_DCode );
 
         /* Please note: the Gerber specs for mass parameters say that
@@ -438,6 +508,10 @@ void GERBER_PLOTTER::writeApertureList()
             sprintf( text, "P,%#fX%dX%#f*%%\n", tool->GetDiameter() * fscale,
                      tool->GetVerticeCount(), tool->GetRotation() );
             break;
+
+        case APERTURE::AT_OUTLINE_MACRO:
+            sprintf( text, "OUTLINE%d*%%\n", tool->m_DCode );
+            break;
         }
 
         fputs( cbuf, outputFile );
@@ -527,9 +601,10 @@ void GERBER_PLOTTER::Arc( const wxPoint& aCenter, double aStAngle, double aEndAn
     else
         fprintf( outputFile, "G02" );
 
-    fprintf( outputFile, "X%dY%dI%dJ%dD01*\n",
-             KiROUND( devEnd.x ), KiROUND( devEnd.y ),
-             KiROUND( devCenter.x ), KiROUND( devCenter.y ) );
+    PLOT_WRITER( outputFile ).Char( 'X' ).Int( KiROUND( devEnd.x ) )
+            .Char( 'Y' ).Int( KiROUND( devEnd.y ) )
+            .Char( 'I' ).Int( KiROUND( devCenter.x ) )
+            .Char( 'J' ).Int( KiROUND( devCenter.y ) ).Text( "D01*\n" );
 
     fprintf( outputFile, "G01*\n" ); // Back to linear interpol (perhaps useless here).
 }
@@ -912,7 +987,13 @@ void GERBER_PLOTTER::FlashPadCustom( const wxPoint& aPadPos, const wxSize& aSize
                                      EDA_DRAW_MODE_T aTraceMode, void* aData )
 
 {
-    // A Pad custom is plotted as polygon.
+    // With aperture macros, a filled pad custom is flashed with a macro shared
+    // by all the pads having the same shape.
+    if( m_useApertureMacros && aTraceMode == FILLED
+            && flashOutlineMacro( aPadPos, aPolygons, aData ) )
+        return;
+
+    // Otherwise a Pad custom is plotted as polygon.
 
     // A flashed circle @aPadPos is added (anchor pad)
     // However, because the anchor pad can be circle or rect, we use only
@@ -964,6 +1045,72 @@ void GERBER_PLOTTER::FlashPadCustom( const wxPoint& aPadPos, const wxSize& aSize
 }
 
 
+// The Gerber specification limits the vertex count of an outline primitive
+#define OUTLINE_PRIMITIVE_MAX_VERTICES 5000
+
+
+bool GERBER_PLOTTER::flashOutlineMacro( const wxPoint& aPadPos, SHAPE_POLY_SET* aPolygons,
+                                        void* aData )
+{
+    if( aPolygons->OutlineCount() == 0 )
+        return false;
+
+    for( int cnt = 0; cnt < aPolygons->OutlineCount(); ++cnt )
+    {
+        int count = aPolygons->Outline( cnt ).PointCount();
+
+        if( aPolygons->HoleCount( cnt ) || count < 3 || count > OUTLINE_PRIMITIVE_MAX_VERTICES )
+            return false;
+    }
+
+    // The macro coordinates are relative to the flash position, in the file unit.
+    // They are calculated from the corner positions relative to the pad in IU, so identical
+    // pads give the same macro body wherever they are.
+    DPOINT origin_dev = userToDeviceCoordinates( plotOffset );
+    double unit = pow( 10.0, m_gerberUnitFmt );   // device units per file unit
+    char   buff[80];
+
+    std::string body;
+
+    for( int cnt = 0; cnt < aPolygons->OutlineCount(); ++cnt )
+    {
+        const SHAPE_LINE_CHAIN& poly = aPolygons->Outline( cnt );
+
+        // Outline primitive: exposure on, vertex count, the vertices (the first one
+        // repeated at the end), rotation
+        sprintf( buff, "4,1,%d,\n", poly.PointCount() );
+        body += buff;
+
+        for( int ii = 0; ii <= poly.PointCount(); ++ii )
+        {
+            const VECTOR2I& corner = poly.CPoint( ii % poly.PointCount() );
+            wxPoint         offset( corner.x - aPadPos.x, corner.y - aPadPos.y );
+            DPOINT          rel_dev = userToDeviceCoordinates( plotOffset + offset ) - origin_dev;
+
+            sprintf( buff, "%.*f,%.*f,\n", m_gerberUnitFmt, KiROUND( rel_dev.x ) / unit,
+                     m_gerberUnitFmt, KiROUND( rel_dev.y ) / unit );
+            body += buff;
+        }
+
+        body += "0*\n";
+    }
+
+    body.pop_back();    // no line break before the closing '%'
+
+    GBR_METADATA* gbr_metadata = static_cast<GBR_METADATA*>( aData );
+    int           aperture_attrib = gbr_metadata ? gbr_metadata->GetApertureAttrib() : 0;
+
+    selectOutlineAperture( body, aperture_attrib );
+
+    if( gbr_metadata )
+        formatNetAttribute( &gbr_metadata->m_NetlistMetadata );
+
+    emitDcode( userToDeviceCoordinates( aPadPos ), 3 );
+
+    return true;
+}
+
+
 void GERBER_PLOTTER::FlashPadTrapez( const wxPoint& aPadPos,  const wxPoint* aCorners,
                                      double aPadOrient, EDA_DRAW_MODE_T aTrace_Mode, void* aData )
 
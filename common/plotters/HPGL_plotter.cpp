@@ -412,7 +412,8 @@ void HPGL_PLOTTER::PenTo( const wxPoint& pos, char plume )
     DPOINT pos_dev = userToDeviceCoordinates( pos );
 
     if( penLastpos != pos )
-        fprintf( outputFile, "PA %.0f,%.0f;\n", pos_dev.x, pos_dev.y );
+        PLOT_WRITER( outputFile ).Text( "PA " ).Rounded( pos_dev.x ).Char( ',' )
+                .Rounded( pos_dev.y ).Text( ";\n" );
 
     penLastpos = pos;
 }
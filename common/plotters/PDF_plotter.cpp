@@ -40,6 +40,15 @@
 #include <wx/mstream.h>
 
 
+PDF_PLOTTER::~PDF_PLOTTER()
+{
+    // Emergency cleanup: the work file is usually closed by ClosePage(),
+    // and it must be closed before its buffer is freed (see setFileBuffer())
+    if( workFile )
+        fclose( workFile );
+}
+
+
 /*
  * Open or create the plot file aFullFilename
  * return true if success, false if the file cannot be created/opened
@@ -58,6 +67,8 @@ bool PDF_PLOTTER::OpenFile( const wxString& aFullFilename )
     if( outputFile == NULL )
         return false ;
 
+    setFileBuffer( outputFile );
+
     return true;
 }
 
@@ -296,16 +307,17 @@ void PDF_PLOTTER::PlotPoly( const std::vector< wxPoint >& aCornerList,
     SetCurrentLineWidth( aWidth );
 
     DPOINT pos = userToDeviceCoordinates( aCornerList[0] );
-    fprintf( workFile, "%g %g m\n", pos.x, pos.y );
+    PLOT_WRITER writer( workFile );
+    writer.Double( pos.x ).Char( ' ' ).Double( pos.y ).Text( " m\n" );
 
     for( unsigned ii = 1; ii < aCornerList.size(); ii++ )
     {
         pos = userToDeviceCoordinates( aCornerList[ii] );
-        fprintf( workFile, "%g %g l\n", pos.x, pos.y );
+        writer.Double( pos.x ).Char( ' ' ).Double( pos.y ).Text( " l\n" );
     }
 
     // Close path and stroke(/fill)
-    fprintf( workFile, "%c\n", aFill == NO_FILL ? 'S' : 'b' );
+    writer.Char( aFill == NO_FILL ? 'S' : 'b' ).Char( '\n' );
 }
 
 
@@ -327,9 +339,8 @@ void PDF_PLOTTER::PenTo( const wxPoint& pos, char plume )
     if( penState != plume || pos != penLastpos )
     {
         DPOINT pos_dev = userToDeviceCoordinates( pos );
-        fprintf( workFile, "%g %g %c\n",
-                 pos_dev.x, pos_dev.y,
-                 ( plume=='D' ) ? 'l' : 'm' );
+        PLOT_WRITER( workFile ).Double( pos_dev.x ).Char( ' ' ).Double( pos_dev.y )
+                .Char( ' ' ).Char( ( plume=='D' ) ? 'l' : 'm' ).Char( '\n' );
     }
     penState   = plume;
     penLastpos = pos;
@@ -499,6 +510,10 @@ int PDF_PLOTTER::startPdfStream(int handle)
     workFilename = filename + wxT(".tmp");
     workFile = wxFopen( workFilename, wxT( "w+b" ));
     wxASSERT( workFile );
+
+    if( workFile )
+        setFileBuffer( workFile, true );
+
     return handle;
 }
 
@@ -136,9 +136,8 @@ void PSLIKE_PLOTTER::FlashPadCircle( const wxPoint& aPadPos, int aDiameter,
 void PSLIKE_PLOTTER::FlashPadRect( const wxPoint& aPadPos, const wxSize& aSize,
                                    double aPadOrient, EDA_DRAW_MODE_T aTraceMode, void* aData )
 {
-    static std::vector< wxPoint > cornerList;
+    std::vector< wxPoint > cornerList;
     wxSize size( aSize );
-    cornerList.clear();
 
     if( aTraceMode == FILLED )
         SetCurrentLineWidth( 0 );
@@ -254,8 +253,7 @@ void PSLIKE_PLOTTER::FlashPadCustom( const wxPoint& aPadPos, const wxSize& aSize
 void PSLIKE_PLOTTER::FlashPadTrapez( const wxPoint& aPadPos, const wxPoint *aCorners,
                                      double aPadOrient, EDA_DRAW_MODE_T aTraceMode, void* aData )
 {
-    static std::vector< wxPoint > cornerList;
-    cornerList.clear();
+    std::vector< wxPoint > cornerList;
 
     for( int ii = 0; ii < 4; ii++ )
         cornerList.push_back( aCorners[ii] );
@@ -642,16 +640,17 @@ void PS_PLOTTER::PlotPoly( const std::vector< wxPoint >& aCornerList,
     SetCurrentLineWidth( aWidth );
 
     DPOINT pos = userToDeviceCoordinates( aCornerList[0] );
-    fprintf( outputFile, "newpath\n%g %g moveto\n", pos.x, pos.y );
+    PLOT_WRITER writer( outputFile );
+    writer.Text( "newpath\n" ).Double( pos.x ).Char( ' ' ).Double( pos.y ).Text( " moveto\n" );
 
     for( unsigned ii = 1; ii < aCornerList.size(); ii++ )
     {
         pos = userToDeviceCoordinates( aCornerList[ii] );
-        fprintf( outputFile, "%g %g lineto\n", pos.x, pos.y );
+        writer.Double( pos.x ).Char( ' ' ).Double( pos.y ).Text( " lineto\n" );
     }
 
     // Close/(fill) the path
-    fprintf( outputFile, "poly%d\n", aFill );
+    writer.Text( "poly" ).Int( aFill ).Char( '\n' );
 }
 
 
@@ -785,9 +784,8 @@ void PS_PLOTTER::PenTo( const wxPoint& pos, char plume )
     if( penState != plume || pos != penLastpos )
     {
         DPOINT pos_dev = userToDeviceCoordinates( pos );
-        fprintf( outputFile, "%g %g %sto\n",
-                 pos_dev.x, pos_dev.y,
-                 ( plume=='D' ) ? "line" : "move" );
+        PLOT_WRITER( outputFile ).Double( pos_dev.x ).Char( ' ' ).Double( pos_dev.y )
+                .Text( ( plume=='D' ) ? " lineto\n" : " moveto\n" );
     }
 
     penState   = plume;
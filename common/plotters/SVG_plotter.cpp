@@ -529,21 +529,22 @@ void SVG_PLOTTER::PlotPoly( const std::vector<wxPoint>& aCornerList,
     }
 
     DPOINT pos = userToDeviceCoordinates( aCornerList[0] );
-    fprintf( outputFile, "d=\"M %g,%g\n", pos.x, pos.y );
+    PLOT_WRITER writer( outputFile );
+    writer.Text( "d=\"M " ).Double( pos.x ).Char( ',' ).Double( pos.y ).Char( '\n' );
 
     for( unsigned ii = 1; ii < aCornerList.size() - 1; ii++ )
     {
         pos = userToDeviceCoordinates( aCornerList[ii] );
-        fprintf( outputFile, "%g,%g\n", pos.x, pos.y );
+        writer.Double( pos.x ).Char( ',' ).Double( pos.y ).Char( '\n' );
     }
 
     // If the cornerlist ends where it begins, then close the poly
     if( aCornerList.front() == aCornerList.back() )
-        fprintf( outputFile, "Z\" /> \n" );
+        writer.Text( "Z\" /> \n" );
     else
     {
         pos = userToDeviceCoordinates( aCornerList.back() );
-        fprintf( outputFile, "%g,%g\n\" /> \n", pos.x, pos.y );
+        writer.Double( pos.x ).Char( ',' ).Double( pos.y ).Text( "\n\" /> \n" );
     }
 }
 
@@ -591,14 +592,14 @@ void SVG_PLOTTER::PenTo( const wxPoint& pos, char plume )
             setSVGPlotStyle();
         }
 
-        fprintf( outputFile, "<path d=\"M%d %d\n",
-                 (int) pos_dev.x, (int) pos_dev.y );
+        PLOT_WRITER( outputFile ).Text( "<path d=\"M" ).Int( (int) pos_dev.x ).Char( ' ' )
+                .Int( (int) pos_dev.y ).Char( '\n' );
     }
     else if( penState != plume || pos != penLastpos )
     {
         DPOINT pos_dev = userToDeviceCoordinates( pos );
-        fprintf( outputFile, "L%d %d\n",
-                 (int) pos_dev.x, (int) pos_dev.y );
+        PLOT_WRITER( outputFile ).Char( 'L' ).Int( (int) pos_dev.x ).Char( ' ' )
+                .Int( (int) pos_dev.y ).Char( '\n' );
     }
 
     penState    = plume;
@@ -38,6 +38,9 @@
  */
 
 #include <fctsys.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <vector>
 
 #include <trigo.h>
@@ -51,6 +54,192 @@
 #include <geometry/shape_line_chain.h>
 #include <geometry/geometry_utils.h>
 
+// Powers of ten used by PLOT_WRITER::Double(); 1e-4 ... 1e-1 are the nearest doubles, which
+// are all slightly above the exact values, so a >= s_pow10[i] is an exact comparison.
+static const double s_pow10[] = { 1e-4, 1e-3, 1e-2, 1e-1, 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6,
+                                  1e7, 1e8, 1e9 };
+
+
+static char* formatUnsigned( char* aEnd, unsigned long long aValue, int aMinDigits )
+{
+    char* p = aEnd;
+
+    do
+    {
+        *--p = char( '0' + aValue % 10 );
+        aValue /= 10;
+    } while( aValue );
+
+    while( aEnd - p < aMinDigits )
+        *--p = '0';
+
+    return p;
+}
+
+
+char* PLOT_WRITER::reserve( size_t aLen )
+{
+    if( m_len + aLen > sizeof( m_buf ) )
+        Flush();
+
+    char* p = m_buf + m_len;
+    m_len += aLen;
+    return p;
+}
+
+
+void PLOT_WRITER::Flush()
+{
+    if( m_len )
+        fwrite( m_buf, 1, m_len, m_file );
+
+    m_len = 0;
+}
+
+
+PLOT_WRITER& PLOT_WRITER::Char( char aChar )
+{
+    *reserve( 1 ) = aChar;
+    return *this;
+}
+
+
+PLOT_WRITER& PLOT_WRITER::Text( const char* aText )
+{
+    size_t len = strlen( aText );
+
+    if( len > sizeof( m_buf ) )
+    {
+        Flush();
+        fwrite( aText, 1, len, m_file );
+    }
+    else
+    {
+        memcpy( reserve( len ), aText, len );
+    }
+
+    return *this;
+}
+
+
+PLOT_WRITER& PLOT_WRITER::Int( long long aValue, int aMinDigits )
+{
+    char  tmp[48];
+    char* end = tmp + sizeof( tmp );
+    char* p = formatUnsigned( end, aValue < 0 ? 0ULL - (unsigned long long) aValue
+                                              : (unsigned long long) aValue,
+                              std::min( aMinDigits, 40 ) );
+
+    if( aValue < 0 )
+        *--p = '-';
+
+    memcpy( reserve( end - p ), p, end - p );
+    return *this;
+}
+
+
+PLOT_WRITER& PLOT_WRITER::Double( double aValue )
+{
+    double a = std::fabs( aValue );
+
+    if( a == 0.0 )
+        return Text( std::signbit( aValue ) ? "-0" : "0" );
+
+    // Only the fixed notation of "%g" is handled here: 1e-4 <= |aValue| < 1e6 (i.e. the
+    // exponent of the 6 significant digits is -4 ... 5).  Everything else (exponent notation,
+    // nan, inf) goes to snprintf().
+    if( a >= 1e-4 && a < 1e6 )
+    {
+        int exp10 = 5;
+
+        while( a < s_pow10[exp10 + 4] )
+            --exp10;
+
+        // The 6 significant digits, rounded half to even like printf().  The product has an
+        // error far below 1e-6 (the scale is an exact power of ten and the result < 1e6), so
+        // the rounding is exact unless the scaled value is a near tie, left to snprintf().
+        double scaled = a * s_pow10[5 - exp10 + 4];
+        double fl = std::floor( scaled );
+        double frac = scaled - fl;
+
+        if( std::fabs( frac - 0.5 ) > 1e-6 )
+        {
+            unsigned long long digits = (unsigned long long) fl + ( frac > 0.5 ? 1 : 0 );
+
+            if( digits < 1000000 )
+            {
+                char  dbuf[6];
+                formatUnsigned( dbuf + 6, digits, 6 );
+
+                // The digits after the decimal point, without the trailing zeros
+                int last = 5;
+
+                while( last > exp10 && dbuf[last] == '0' )
+                    --last;
+
+                char* p = reserve( 16 );
+                char* start = p;
+
+                if( std::signbit( aValue ) )
+                    *p++ = '-';
+
+                if( exp10 >= 0 )
+                {
+                    memcpy( p, dbuf, exp10 + 1 );
+                    p += exp10 + 1;
+
+                    if( last > exp10 )
+                    {
+                        *p++ = '.';
+                        memcpy( p, dbuf + exp10 + 1, last - exp10 );
+                        p += last - exp10;
+                    }
+                }
+                else
+                {
+                    *p++ = '0';
+                    *p++ = '.';
+
+                    for( int i = exp10; i < -1; ++i )
+                        *p++ = '0';
+
+                    memcpy( p, dbuf, last + 1 );
+                    p += last + 1;
+                }
+
+                m_len -= 16 - ( p - start );
+                return *this;
+            }
+        }
+    }
+
+    char tmp[32];
+    int  len = snprintf( tmp, sizeof( tmp ), "%g", aValue );
+    memcpy( reserve( len ), tmp, len );
+    return *this;
+}
+
+
+PLOT_WRITER& PLOT_WRITER::Rounded( double aValue )
+{
+    if( std::fabs( aValue ) < 1e15 )
+    {
+        // nearbyint() rounds half to even in the default rounding mode, like printf()
+        double r = std::nearbyint( aValue );
+
+        if( r == 0.0 && std::signbit( aValue ) )
+            return Text( "-0" );
+
+        return Int( (long long) r );
+    }
+
+    char tmp[512];
+    int  len = snprintf( tmp, sizeof( tmp ), "%.0f", aValue );
+    memcpy( reserve( len ), tmp, len );
+    return *this;
+}
+
+
 PLOTTER::PLOTTER( )
 {
     plotScale = 1;
@@ -90,10 +279,27 @@ bool PLOTTER::OpenFile( const wxString& aFullFilename )
     if( outputFile == NULL )
         return false ;
 
+    setFileBuffer( outputFile );
+
     return true;
 }
 
 
+// Large enough to make the system calls rare, small enough to not matter for memory
+#define PLOT_FILE_BUFFER_SIZE ( 256 * 1024 )
+
+
+void PLOTTER::setFileBuffer( FILE* aFile, bool aWorkFile )
+{
+    std::unique_ptr<char[]>& buffer = aWorkFile ? m_workFileBuffer : m_outputFileBuffer;
+
+    if( !buffer )
+        buffer.reset( new char[PLOT_FILE_BUFFER_SIZE] );
+
+    setvbuf( aFile, buffer.get(), _IOFBF, PLOT_FILE_BUFFER_SIZE );
+}
+
+
 DPOINT PLOTTER::userToDeviceCoordinates( const wxPoint& aCoordinate )
 {
     wxPoint pos = aCoordinate - plotOffset;
@@ -32,14 +32,19 @@
 #include <view/view_item.h>
 #include <view/view_rtree.h>
 #include <view/view_overlay.h>
+#include <view/view_tile_cache.h>
 
 #include <gal/definitions.h>
 #include <gal/graphics_abstraction_layer.h>
 #include <painter.h>
 
-#ifdef __WXDEBUG__
 #include <profile.h>
-#endif /* __WXDEBUG__  */
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <future>
+#include <thread>
 
 namespace KIGFX {
 
@@ -90,6 +95,8 @@ private:
     int     m_flags;            ///< Visibility flags
     int     m_requiredUpdate;   ///< Flag required for updating
     int     m_drawPriority;     ///< Order to draw this item in a layer, lowest first
+    BOX2I   m_bbox;             ///< Bounding box when the item was last indexed, used to
+                                ///< invalidate the raster tiles covering its previous position
 
     ///> Helper for storing cached items group ids
     typedef std::pair<int, int> GroupPair;
@@ -358,6 +365,7 @@ void VIEW::Add( VIEW_ITEM* aItem, int aDrawPriority )
 
     aItem->ViewGetLayers( layers, layers_count );
     aItem->viewPrivData()->saveLayers( layers, layers_count );
+    aItem->viewPrivData()->m_bbox = aItem->ViewBBox();
 
     m_allItems->push_back( aItem );
 
@@ -395,6 +403,8 @@ void VIEW::Remove( VIEW_ITEM* aItem )
     int layers[VIEW::VIEW_MAX_LAYERS], layers_count;
     viewData->getLayers( layers, layers_count );
 
+    invalidateTiles( aItem );
+
     for( int i = 0; i < layers_count; ++i )
     {
         VIEW_LAYER& l = m_layers[layers[i]];
@@ -521,6 +531,10 @@ void VIEW::SetGAL( GAL* aGal )
     bool recacheGroups = ( m_gal != nullptr );    // recache groups only if GAL is reassigned
     m_gal = aGal;
 
+    // the tiles belong to the previous GAL
+    if( m_tileCache )
+        m_tileCache->SetGAL( m_gal );
+
     // clear group numbers, so everything is going to be recached
     if( recacheGroups )
         clearGroupCache();
@@ -776,9 +790,17 @@ struct VIEW::updateItemsColor
 
 void VIEW::UpdateLayerColor( int aLayer )
 {
-    // There is no point in updating non-cached layers
+    // Non-cached layers are drawn again, unless they are kept as raster tiles
     if( !IsCached( aLayer ) )
+    {
+        if( m_tileCache )
+        {
+            InvalidateTiles( aLayer );
+            MarkTargetDirty( m_layers[aLayer].target );
+        }
+
         return;
+    }
 
     BOX2I r;
 
@@ -822,6 +844,7 @@ void VIEW::UpdateAllLayersColor()
         }
     }
 
+    InvalidateTiles();
     MarkDirty();
 }
 
@@ -969,11 +992,20 @@ struct VIEW::drawItem
     {
         wxCHECK( aItem->viewPrivData(), false );
 
+        view->m_redrawStats.itemsQueried++;
+
         // Conditions that have to be fulfilled for an item to be drawn
-        bool drawCondition = aItem->viewPrivData()->isRenderable() &&
-                             aItem->ViewGetLOD( layer, view ) < view->m_scale;
-        if( !drawCondition )
+        if( !aItem->viewPrivData()->isRenderable() )
+        {
+            view->m_redrawStats.itemsHidden++;
             return true;
+        }
+
+        if( aItem->ViewGetLOD( layer, view ) >= view->m_scale )
+        {
+            view->m_redrawStats.itemsCulledLOD++;
+            return true;
+        }
 
         if( useDrawPriority )
             drawItems.push_back( aItem );
@@ -1009,12 +1041,41 @@ struct VIEW::drawItem
 
 void VIEW::redrawRect( const BOX2I& aRect )
 {
+    if( m_tileCache && m_gal->HasRasterTiles() )
+    {
+        // The tiles painted in this frame must stay in the cache until it is complete
+        const VECTOR2I screenSize = m_gal->GetScreenPixelSize();
+        const int      tileSize = m_tileCache->GetTileSize();
+        size_t         tiledLayers = 0;
+
+        for( VIEW_LAYER* l : m_orderedLayers )
+        {
+            if( l->visible && IsTargetDirty( l->target ) && areRequiredLayersEnabled( l->id )
+                    && useTiles( *l ) )
+                tiledLayers++;
+        }
+
+        // A partially visible tile at each side
+        size_t tilesPerLayer = (size_t) ( screenSize.x / tileSize + 2 )
+                                        * ( screenSize.y / tileSize + 2 );
+
+        m_tileCache->BeginFrame( tilesPerLayer * tiledLayers );
+    }
+
     for( VIEW_LAYER* l : m_orderedLayers )
     {
         if( l->visible && IsTargetDirty( l->target ) && areRequiredLayersEnabled( l->id ) )
         {
+            if( useTiles( *l ) )
+            {
+                redrawTiles( *l );
+                continue;
+            }
+
             drawItem drawFunc( this, l->id, m_useDrawPriority, m_reverseDrawOrder );
 
+            m_redrawStats.layersDrawn++;
+
             m_gal->SetTarget( l->target );
             m_gal->SetLayerDepth( l->renderingOrder );
             l->items->Query( aRect, drawFunc );
@@ -1026,6 +1087,167 @@ void VIEW::redrawRect( const BOX2I& aRect )
 }
 
 
+bool VIEW::useTiles( const VIEW_LAYER& aLayer ) const
+{
+    // Layers drawn in the negative mode clear the layers below them, so they cannot
+    // be rendered separately
+    return m_tileCache && m_gal->HasRasterTiles() && aLayer.target == TARGET_NONCACHED
+            && !aLayer.diffLayer;
+}
+
+
+// Finds out if a tile area contains any visible item, without drawing them
+struct tileContentVisitor
+{
+    tileContentVisitor() :
+        m_found( false )
+    {
+    }
+
+    bool operator()( VIEW_ITEM* aItem )
+    {
+        if( aItem->viewPrivData()->getFlags() & VISIBLE )
+            m_found = true;
+
+        // Stop at the first visible item
+        return !m_found;
+    }
+
+    bool m_found;
+};
+
+
+void VIEW::redrawTiles( const VIEW_LAYER& aLayer )
+{
+    const int tileSize = m_tileCache->GetTileSize();
+    const int margin = VIEW_TILE_CACHE::TILE_MARGIN;
+
+    const MATRIX3x3D& worldScreen = m_gal->GetWorldScreenMatrix();
+    const int         zoom = m_tileCache->GetZoomLevel( worldScreen );
+
+    // The tile grid is aligned on the world origin, so panning does not move it. Tiles are
+    // painted on whole pixels to keep them sharp.
+    const VECTOR2D offset( worldScreen.m_data[0][2], worldScreen.m_data[1][2] );
+    const VECTOR2I pixelOffset( KiROUND( offset.x ), KiROUND( offset.y ) );
+    const VECTOR2I screenSize = m_gal->GetScreenPixelSize();
+
+    const int xMin = std::floor( -offset.x / tileSize );
+    const int yMin = std::floor( -offset.y / tileSize );
+    const int xMax = std::floor( ( screenSize.x - offset.x ) / tileSize );
+    const int yMax = std::floor( ( screenSize.y - offset.y ) / tileSize );
+
+    m_redrawStats.layersDrawn++;
+
+    m_gal->SetTarget( aLayer.target );
+    m_gal->SetLayerDepth( aLayer.renderingOrder );
+
+    for( int y = yMin; y <= yMax; ++y )
+    {
+        for( int x = xMin; x <= xMax; ++x )
+        {
+            VIEW_TILE_CACHE::TILE_KEY key = { aLayer.id, zoom, x, y };
+            VECTOR2D tileOrigin( x * tileSize + offset.x, y * tileSize + offset.y );
+            int      tile = -1;
+
+            if( !m_tileCache->Find( key, tile ) )
+            {
+                BOX2D area( ToWorld( tileOrigin - VECTOR2D( margin, margin ) ), VECTOR2D( 0, 0 ) );
+                area.Merge( ToWorld( tileOrigin + VECTOR2D( tileSize + margin, -margin ) ) );
+                area.Merge( ToWorld( tileOrigin + VECTOR2D( -margin, tileSize + margin ) ) );
+                area.Merge( ToWorld( tileOrigin + VECTOR2D( tileSize + margin,
+                                                            tileSize + margin ) ) );
+
+                BOX2I              worldBox( area.GetPosition(), area.GetSize() );
+                tileContentVisitor content;
+
+                // Empty tiles are neither rendered nor stored
+                aLayer.items->Query( worldBox, content );
+
+                if( !content.m_found )
+                    continue;
+
+                tile = m_gal->CreateTile( tileSize );
+
+                if( tile >= 0 )
+                {
+                    drawItem drawFunc( this, aLayer.id, m_useDrawPriority, m_reverseDrawOrder );
+                    int      drawn = m_redrawStats.itemsDrawnImmediate;
+
+                    m_gal->BeginTile( tile, tileOrigin );
+                    aLayer.items->Query( worldBox, drawFunc );
+
+                    if( m_useDrawPriority )
+                        drawFunc.deferredDraw();
+
+                    m_gal->EndTile();
+                    m_redrawStats.tilesRendered++;
+
+                    // The items may all be hidden by their level of detail
+                    if( drawn == m_redrawStats.itemsDrawnImmediate )
+                    {
+                        m_gal->DeleteTile( tile );
+                        tile = -1;
+                    }
+                    else
+                    {
+                        m_tileCache->Add( key, tile, worldBox );
+                    }
+                }
+            }
+
+            if( tile >= 0 )
+            {
+                m_gal->DrawTile( tile, VECTOR2I( x * tileSize, y * tileSize ) + pixelOffset );
+                m_redrawStats.tilesPainted++;
+            }
+        }
+    }
+}
+
+
+void VIEW::invalidateTiles( VIEW_ITEM* aItem )
+{
+    auto viewData = aItem->viewPrivData();
+
+    if( !m_tileCache || !viewData )
+        return;
+
+    int layers[VIEW_MAX_LAYERS], layers_count;
+    viewData->getLayers( layers, layers_count );
+
+    for( int i = 0; i < layers_count; ++i )
+        m_tileCache->Invalidate( layers[i], viewData->m_bbox );
+}
+
+
+void VIEW::SetUseTileCache( bool aEnable )
+{
+    if( aEnable && !m_tileCache )
+    {
+        m_tileCache.reset( new VIEW_TILE_CACHE );
+        m_tileCache->SetGAL( m_gal );
+    }
+    else if( !aEnable )
+    {
+        m_tileCache.reset();
+    }
+
+    MarkDirty();
+}
+
+
+void VIEW::InvalidateTiles( int aLayer )
+{
+    if( !m_tileCache )
+        return;
+
+    if( aLayer < 0 )
+        m_tileCache->Clear();
+    else
+        m_tileCache->InvalidateLayer( aLayer );
+}
+
+
 void VIEW::draw( VIEW_ITEM* aItem, int aLayer, bool aImmediate )
 {
     auto viewData = aItem->viewPrivData();
@@ -1039,13 +1261,18 @@ void VIEW::draw( VIEW_ITEM* aItem, int aLayer, bool aImmediate )
         int group = viewData->getGroup( aLayer );
 
         if( group >= 0 )
+        {
             m_gal->DrawGroup( group );
+            m_redrawStats.itemsDrawnCached++;
+        }
         else
             Update( aItem );
     }
     else
     {
         // Immediate mode
+        m_redrawStats.itemsDrawnImmediate++;
+
         if( !m_painter->Draw( aItem, aLayer ) )
             aItem->ViewDraw( aLayer, this );  // Alternative drawing method
     }
@@ -1120,6 +1347,7 @@ void VIEW::Clear()
     m_nextDrawPriority = 0;
 
     m_gal->ClearCache();
+    InvalidateTiles();
 }
 
 
@@ -1144,9 +1372,7 @@ void VIEW::ClearTargets()
 
 void VIEW::Redraw()
 {
-#ifdef __WXDEBUG__
     PROF_COUNTER totalRealTime;
-#endif /* __WXDEBUG__ */
 
     VECTOR2D screenSize = m_gal->GetScreenPixelSize();
     BOX2D    rect( ToWorld( VECTOR2D( 0, 0 ) ),
@@ -1167,8 +1393,14 @@ void VIEW::Redraw()
     markTargetClean( TARGET_NONCACHED );
     markTargetClean( TARGET_OVERLAY );
 
-#ifdef __WXDEBUG__
     totalRealTime.Stop();
+
+    // The frame is complete: publish its statistics and start collecting the next one
+    m_redrawStats.redrawTime = totalRealTime.msecs();
+    m_lastRedrawStats = m_redrawStats;
+    m_redrawStats.Clear();
+
+#ifdef __WXDEBUG__
     wxLogTrace( "GAL_PROFILE", "VIEW::Redraw(): %.1f ms", totalRealTime.msecs() );
 #endif /* __WXDEBUG__ */
 }
@@ -1215,6 +1447,9 @@ void VIEW::clearGroupCache()
 
 void VIEW::invalidateItem( VIEW_ITEM* aItem, int aUpdateFlags )
 {
+    // Tiles covering the item at its previous position
+    invalidateTiles( aItem );
+
     if( aUpdateFlags & INITIAL_ADD )
     {
         // Don't update layers or bbox, since it was done in VIEW::Add()
@@ -1254,6 +1489,10 @@ void VIEW::invalidateItem( VIEW_ITEM* aItem, int aUpdateFlags )
         MarkTargetDirty( m_layers[layerId].target );
     }
 
+    // Tiles covering the item at its new position
+    aItem->viewPrivData()->m_bbox = aItem->ViewBBox();
+    invalidateTiles( aItem );
+
     aItem->viewPrivData()->clearUpdateFlags();
 }
 
@@ -1319,6 +1558,8 @@ void VIEW::updateItemGeometry( VIEW_ITEM* aItem, int aLayer )
         aItem->ViewDraw( aLayer, this ); // Alternative drawing method
 
     m_gal->EndGroup();
+
+    m_redrawStats.itemsRecached++;
 }
 
 
@@ -1415,29 +1656,90 @@ void VIEW::RecacheAllItems()
             l->items->Query( r, visitor );
         }
     }
+
+    InvalidateTiles();
 }
 
 
 void VIEW::UpdateItems()
 {
+    PROF_COUNTER totalRealTime;
+
     if( m_gal->IsVisible() )
     {
-        GAL_UPDATE_CONTEXT ctx( m_gal );
+        std::vector<VIEW_ITEM*> updated;
 
         for( VIEW_ITEM* item : *m_allItems )
         {
             auto viewData = item->viewPrivData();
 
-            if( !viewData )
-                continue;
+            if( viewData && viewData->m_requiredUpdate != NONE )
+                updated.push_back( item );
+        }
+
+        prepareItems( updated );
+
+        GAL_UPDATE_CONTEXT ctx( m_gal );
+
+        for( VIEW_ITEM* item : updated )
+        {
+            auto viewData = item->viewPrivData();
+
+            invalidateItem( item, viewData->m_requiredUpdate );
+            viewData->m_requiredUpdate = NONE;
+        }
+    }
+
+    m_redrawStats.updateTime += totalRealTime.msecs();
+}
+
 
-            if( viewData->m_requiredUpdate != NONE )
+void VIEW::prepareItems( const std::vector<VIEW_ITEM*>& aItems )
+{
+    // Minimal number of items handled by a thread, so small updates
+    // (e.g. moving a few items) do not pay for the thread creation
+    const size_t itemsPerThread = 64;
+
+    if( !m_painter || aItems.empty() )
+        return;
+
+    std::atomic<size_t> nextItem( 0 );
+
+    auto prepare = [&]() -> size_t
+    {
+        size_t count = 0;
+
+        for( size_t i = nextItem++; i < aItems.size(); i = nextItem++ )
+        {
+            auto viewData = aItems[i]->viewPrivData();
+
+            // Only geometry changes need new shapes, colors are changed in the cache
+            if( viewData->m_requiredUpdate & ( GEOMETRY | LAYERS | REPAINT | INITIAL_ADD ) )
             {
-                invalidateItem( item, viewData->m_requiredUpdate );
-                viewData->m_requiredUpdate = NONE;
+                m_painter->PrepareDraw( aItems[i] );
+                count++;
             }
         }
+
+        return count;
+    };
+
+    size_t parallelThreadCount = std::min<size_t>( std::thread::hardware_concurrency(),
+            ( aItems.size() + itemsPerThread - 1 ) / itemsPerThread );
+
+    if( parallelThreadCount <= 1 )
+    {
+        prepare();
+        return;
     }
+
+    std::vector<std::future<size_t>> returns( parallelThreadCount );
+
+    for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+        returns[ii] = std::async( std::launch::async, prepare );
+
+    for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+        returns[ii].wait();
 }
 
 
@@ -0,0 +1,266 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <view/view_tile_cache.h>
+#include <gal/graphics_abstraction_layer.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace KIGFX;
+
+
+VIEW_TILE_CACHE::VIEW_TILE_CACHE( int aTileSize, size_t aMemoryBudget ) :
+    m_gal( nullptr ),
+    m_tileSize( aTileSize ),
+    m_memoryBudget( aMemoryBudget ),
+    m_maxTiles( 0 ),
+    m_frame( 0 )
+{
+    BeginFrame( 0 );
+}
+
+
+VIEW_TILE_CACHE::~VIEW_TILE_CACHE()
+{
+    Clear();
+}
+
+
+void VIEW_TILE_CACHE::SetGAL( GAL* aGal )
+{
+    m_tiles.clear();
+    m_lru.clear();
+    m_zoomLevels.clear();
+    m_gal = aGal;
+}
+
+
+int VIEW_TILE_CACHE::GetZoomLevel( const MATRIX3x3D& aWorldScreenMatrix )
+{
+    int unused = -1;
+
+    for( size_t i = 0; i < m_zoomLevels.size(); ++i )
+    {
+        const ZOOM_LEVEL& level = m_zoomLevels[i];
+
+        if( level.m[0][0] == aWorldScreenMatrix.m_data[0][0]
+                && level.m[0][1] == aWorldScreenMatrix.m_data[0][1]
+                && level.m[1][0] == aWorldScreenMatrix.m_data[1][0]
+                && level.m[1][1] == aWorldScreenMatrix.m_data[1][1] )
+        {
+            return i;
+        }
+
+        if( unused < 0 && level.tileCount == 0 )
+            unused = i;
+    }
+
+    if( unused < 0 )
+    {
+        unused = m_zoomLevels.size();
+        m_zoomLevels.emplace_back();
+    }
+
+    ZOOM_LEVEL& level = m_zoomLevels[unused];
+
+    for( int row = 0; row < 2; ++row )
+    {
+        for( int col = 0; col < 2; ++col )
+            level.m[row][col] = aWorldScreenMatrix.m_data[row][col];
+    }
+
+    level.tileCount = 0;
+
+    return unused;
+}
+
+
+void VIEW_TILE_CACHE::BeginFrame( size_t aWorkingSet )
+{
+    // Tiles are stored as 32 bit pixels
+    const size_t tileBytes = (size_t) m_tileSize * m_tileSize * 4;
+
+    m_frame++;
+    m_maxTiles = aWorkingSet + m_memoryBudget / tileBytes;
+}
+
+
+bool VIEW_TILE_CACHE::Find( const TILE_KEY& aKey, int& aGalTile )
+{
+    auto it = m_tiles.find( aKey );
+
+    if( it == m_tiles.end() )
+        return false;
+
+    // Move the tile to the front of the LRU list
+    m_lru.splice( m_lru.begin(), m_lru, it->second.lruEntry );
+    it->second.frame = m_frame;
+    aGalTile = it->second.galTile;
+
+    return true;
+}
+
+
+void VIEW_TILE_CACHE::Add( const TILE_KEY& aKey, int aGalTile, const BOX2I& aWorldBox )
+{
+    auto it = m_tiles.find( aKey );
+
+    if( it != m_tiles.end() )
+        remove( it );
+
+    // The least recently used tile is in the current frame only if all of them are, then
+    // the cache grows until the next frame
+    while( m_tiles.size() >= m_maxTiles && !m_lru.empty() )
+    {
+        auto last = m_tiles.find( m_lru.back() );
+
+        if( last->second.frame == m_frame )
+            break;
+
+        remove( last );
+    }
+
+    m_lru.push_front( aKey );
+    m_tiles[aKey] = { aGalTile, aWorldBox, m_frame, m_lru.begin() };
+    m_zoomLevels[aKey.zoom].tileCount++;
+}
+
+
+void VIEW_TILE_CACHE::Invalidate( int aLayer, const BOX2I& aWorldBox )
+{
+    if( m_tiles.empty() )
+        return;
+
+    const double corners[4][2] = {
+        { (double) aWorldBox.GetLeft(), (double) aWorldBox.GetTop() },
+        { (double) aWorldBox.GetRight(), (double) aWorldBox.GetTop() },
+        { (double) aWorldBox.GetLeft(), (double) aWorldBox.GetBottom() },
+        { (double) aWorldBox.GetRight(), (double) aWorldBox.GetBottom() }
+    };
+
+    // Range of tiles to check at each zoom level, in tile grid coordinates
+    struct RANGE
+    {
+        int zoom;
+        int xMin, yMin, xMax, yMax;
+    };
+
+    std::vector<RANGE> ranges;
+    double             lookups = 0.0;
+
+    for( size_t i = 0; i < m_zoomLevels.size(); ++i )
+    {
+        const ZOOM_LEVEL& level = m_zoomLevels[i];
+
+        if( level.tileCount == 0 )
+            continue;
+
+        double xMin = HUGE_VAL, yMin = HUGE_VAL, xMax = -HUGE_VAL, yMax = -HUGE_VAL;
+
+        for( const auto& corner : corners )
+        {
+            double x = level.m[0][0] * corner[0] + level.m[0][1] * corner[1];
+            double y = level.m[1][0] * corner[0] + level.m[1][1] * corner[1];
+
+            xMin = std::min( xMin, x );
+            xMax = std::max( xMax, x );
+            yMin = std::min( yMin, y );
+            yMax = std::max( yMax, y );
+        }
+
+        // Tiles are rendered with a margin, see VIEW::redrawTiles()
+        xMin = std::floor( ( xMin - TILE_MARGIN ) / m_tileSize );
+        yMin = std::floor( ( yMin - TILE_MARGIN ) / m_tileSize );
+        xMax = std::floor( ( xMax + TILE_MARGIN ) / m_tileSize );
+        yMax = std::floor( ( yMax + TILE_MARGIN ) / m_tileSize );
+
+        lookups += ( xMax - xMin + 1 ) * ( yMax - yMin + 1 );
+
+        // A large item: it is faster to test every tile
+        if( lookups > m_tiles.size() )
+            break;
+
+        ranges.push_back( { (int) i, (int) xMin, (int) yMin, (int) xMax, (int) yMax } );
+    }
+
+    if( lookups > m_tiles.size() )
+    {
+        for( auto it = m_tiles.begin(); it != m_tiles.end(); )
+        {
+            if( it->first.layer == aLayer && it->second.worldBox.Intersects( aWorldBox ) )
+                it = remove( it );
+            else
+                ++it;
+        }
+
+        return;
+    }
+
+    for( const RANGE& range : ranges )
+    {
+        for( int y = range.yMin; y <= range.yMax; ++y )
+        {
+            for( int x = range.xMin; x <= range.xMax; ++x )
+            {
+                auto it = m_tiles.find( { aLayer, range.zoom, x, y } );
+
+                if( it != m_tiles.end() )
+                    remove( it );
+            }
+        }
+    }
+}
+
+
+void VIEW_TILE_CACHE::InvalidateLayer( int aLayer )
+{
+    for( auto it = m_tiles.begin(); it != m_tiles.end(); )
+    {
+        if( it->first.layer == aLayer )
+            it = remove( it );
+        else
+            ++it;
+    }
+}
+
+
+void VIEW_TILE_CACHE::Clear()
+{
+    for( auto it = m_tiles.begin(); it != m_tiles.end(); )
+        it = remove( it );
+
+    m_zoomLevels.clear();
+}
+
+
+VIEW_TILE_CACHE::TILE_MAP::iterator VIEW_TILE_CACHE::remove( TILE_MAP::iterator aTile )
+{
+    if( m_gal )
+        m_gal->DeleteTile( aTile->second.galTile );
+
+    m_zoomLevels[aTile->first.zoom].tileCount--;
+    m_lru.erase( aTile->second.lruEntry );
+
+    return m_tiles.erase( aTile );
+}
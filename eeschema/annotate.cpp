@@ -68,6 +68,7 @@ void SCH_EDIT_FRAME::DeleteAnnotation( bool aCurrentSheetOnly )
     {
         SCH_SCREENS ScreenList;
         ScreenList.ClearAnnotation();
+        ScreenList.InvalidateItemIndexes();
     }
 
     // Update the references for the sheet that is currently being displayed.
@@ -236,6 +237,9 @@ void SCH_EDIT_FRAME::AnnotateComponents( bool              aAnnotateSchematic,
     g_CurrentSheet->UpdateAllScreenReferences();
     SetSheetNumberAndCount();
 
+    // The references of the components of all the sheets may have changed
+    screens.InvalidateItemIndexes();
+
     SyncView();
     GetCanvas()->Refresh();
     OnModify();
@@ -24,6 +24,7 @@
 
 #include <fctsys.h>
 #include <sch_edit_frame.h>
+#include <connection_graph.h>
 #include <lib_item.h>
 #include <general.h>
 #include <sch_bus_entry.h>
@@ -63,9 +64,11 @@ bool SCH_EDIT_FRAME::TestDanglingEnds()
     for( SCH_ITEM* item = GetScreen()->GetDrawList().begin(); item; item = item->Next() )
         item->GetEndPoints( endPoints );
 
+    DANGLING_END_INDEX index( endPoints );
+
     for( SCH_ITEM* item = GetScreen()->GetDrawList().begin(); item; item = item->Next() )
     {
-        if( item->UpdateDanglingState( endPoints ) )
+        if( item->UpdateDanglingState( index ) )
         {
             GetCanvas()->GetView()->Update( item, KIGFX::REPAINT );
             hasStateChanged = true;
@@ -258,8 +261,9 @@ void SCH_EDIT_FRAME::NormalizeSchematicOnFirstLoad( bool recalculateConnections
     for( const auto& sheet : list )
         SchematicCleanUp( sheet.LastScreen() );
 
+    // The schematic was just cleaned up, but all the connections are new
     if( recalculateConnections )
-        RecalculateConnections( false );
+        g_ConnectionGraph->Recalculate( list, true );
 }
 
 
@@ -283,6 +287,7 @@ bool SCH_EDIT_FRAME::BreakSegment( SCH_LINE* aSegment, const wxPoint& aPoint,
 
     RefreshItem( aSegment );
     aSegment->SetEndPoint( aPoint );
+    aScreen->UpdateItemIndex( aSegment );
 
     if( aNewSegment )
         *aNewSegment = newSegment;
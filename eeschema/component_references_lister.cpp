@@ -32,6 +32,9 @@
 
 #include <wx/regex.h>
 #include <algorithm>
+#include <map>
+#include <set>
+#include <tuple>
 #include <vector>
 #include <unordered_set>
 
@@ -43,7 +46,11 @@
 #include <sch_edit_frame.h>
 
 
-//#define USE_OLD_ALGO
+// A component instance: the component and the path of its sheet
+typedef std::pair<SCH_COMPONENT*, wxString> INSTANCE_KEY;
+
+// Reference prefix, value, symbol name, units locked and locked unit of a component
+typedef std::tuple<std::string, wxString, std::string, bool, int> CANDIDATE_KEY;
 
 
 void SCH_REFERENCE_LIST::RemoveItem( unsigned int aIndex )
@@ -141,28 +148,6 @@ bool SCH_REFERENCE_LIST::sortByTimeStamp( const SCH_REFERENCE& item1,
     return ii < 0;
 }
 
-int SCH_REFERENCE_LIST::FindUnit( size_t aIndex, int aUnit )
-{
-    int NumRef;
-
-    NumRef = componentFlatList[aIndex].m_NumRef;
-
-    for( size_t ii = 0; ii < componentFlatList.size(); ii++ )
-    {
-        if(  ( aIndex == ii )
-          || ( componentFlatList[ii].m_IsNew )
-          || ( componentFlatList[ii].m_NumRef != NumRef )
-          || ( componentFlatList[aIndex].CompareRef( componentFlatList[ii] ) != 0 ) )
-            continue;
-
-        if( componentFlatList[ii].m_Unit == aUnit )
-            return (int) ii;
-    }
-
-    return -1;
-}
-
-
 void SCH_REFERENCE_LIST::RemoveSubComponentsFromList()
 {
     SCH_COMPONENT* libItem;
@@ -196,106 +181,162 @@ void SCH_REFERENCE_LIST::RemoveSubComponentsFromList()
 }
 
 
-void SCH_REFERENCE_LIST::GetRefsInUse( int aIndex, std::vector< int >& aIdList, int aMinRefId )
+// A helper function to build a full reference string of a SCH_REFERENCE item
+wxString buildFullReference( const SCH_REFERENCE& aItem, int aUnitNumber = -1 )
 {
-    aIdList.clear();
-
-    for( unsigned ii = 0; ii < componentFlatList.size(); ii++ )
-    {
-        if(  ( componentFlatList[aIndex].CompareRef( componentFlatList[ii] ) == 0 )
-          && ( componentFlatList[ii].m_NumRef >= aMinRefId )  )
-            aIdList.push_back( componentFlatList[ii].m_NumRef );
-    }
-
-    sort( aIdList.begin(), aIdList.end() );
+    wxString fullref;
+    fullref = aItem.GetRef() + aItem.GetRefNumber();
 
-    // Ensure each reference number appears only once.  If there are components with
-    // multiple parts per package the same number will be stored for each part.
-    std::vector< int >::iterator it = unique( aIdList.begin(), aIdList.end() );
+    if( aUnitNumber < 0 )
+        fullref << ".." << aItem.GetUnit();
+    else
+        fullref << ".." << aUnitNumber;
 
-    // Using the C++ unique algorithm only moves the duplicate entries to the end of
-    // of the array.  This removes the duplicate entries from the array.
-    aIdList.resize( it - aIdList.begin() );
+    return fullref;
 }
 
 
-int SCH_REFERENCE_LIST::GetLastReference( int aIndex, int aMinValue )
+void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int aStartNumber,
+      SCH_MULTI_UNIT_REFERENCE_MAP aLockedUnitMap )
 {
-    int lastNumber = aMinValue;
+    if ( componentFlatList.size() == 0 )
+        return;
 
-    for( unsigned ii = 0; ii < componentFlatList.size(); ii++ )
-    {
-        // search only for the current reference prefix:
-        if( componentFlatList[aIndex].CompareRef( componentFlatList[ii] ) != 0 )
-            continue;
+    int LastReferenceNumber = 0;
+    int NumberOfUnits, Unit;
 
-        // update max value for the current reference prefix
-        if( lastNumber < componentFlatList[ii].m_NumRef )
-            lastNumber = componentFlatList[ii].m_NumRef;
-    }
+    /* The reference numbers in use, the annotated units and the components waiting for a
+     * unit are indexed once, and the indexes are updated each time a reference is changed:
+     * no search scans the whole list, so annotating n components is O(n log n).
+     */
 
-    return lastNumber;
-}
+    // For each reference prefix, the count of references using each reference number
+    std::map<std::string, std::map<int, int>> numbersInUse;
 
+    // For each reference prefix, the count of annotated references using each
+    // (reference number, unit)
+    std::map<std::string, std::map<std::pair<int, int>, int>> unitsInUse;
 
-int SCH_REFERENCE_LIST::CreateFirstFreeRefId( std::vector<int>& aIdList, int aFirstValue )
-{
-    int expectedId = aFirstValue;
+    // The not annotated and not yet tested components, by reference prefix, value, symbol
+    // name and locked unit
+    std::map<CANDIDATE_KEY, std::set<unsigned>> candidates;
 
-    // We search for expected Id a value >= aFirstValue.
-    // Skip existing Id < aFirstValue
-    unsigned ii = 0;
+    // The positions of each component instance (component and sheet path) in the list
+    std::map<INSTANCE_KEY, std::vector<unsigned>> instances;
 
-    for( ; ii < aIdList.size(); ii++ )
+    // The reference numbers in use by the current reference prefix, and the numbers of
+    // this prefix released since the current group started: like the numbers in use when
+    // the group started, they cannot be allocated again in this group.
+    std::map<int, int>* groupNumbers = nullptr;
+    std::set<int>       releasedNumbers;
+    int                 nextRefId = 0;
+
+    auto candidateKey = [&]( const SCH_REFERENCE& aRef, bool aLocked, int aUnit )
     {
-        if( expectedId <= aIdList[ii] )
-            break;
-    }
+        return CANDIDATE_KEY( aRef.m_Ref.c_str(), aRef.m_Value->GetText(),
+                              aRef.m_RootCmp->GetLibId().GetLibItemName().c_str(), aLocked,
+                              aLocked ? aUnit : 0 );
+    };
+
+    auto addToIndexes = [&]( unsigned aIndex )
+    {
+        SCH_REFERENCE& ref = componentFlatList[aIndex];
+
+        numbersInUse[ ref.m_Ref ][ ref.m_NumRef ]++;
+
+        if( !ref.m_IsNew )
+            unitsInUse[ ref.m_Ref ][ std::make_pair( ref.m_NumRef, ref.m_Unit ) ]++;
+        else if( !ref.m_Flag )
+            candidates[ candidateKey( ref, ref.IsUnitsLocked(), ref.m_Unit ) ].insert( aIndex );
+    };
 
-    // Ids are sorted by increasing value, from aFirstValue
-    // So we search from aFirstValue the first not used value, i.e. the first hole in list.
-    for( ; ii < aIdList.size(); ii++ )
+    auto removeFromIndexes = [&]( unsigned aIndex )
     {
-        if( expectedId != aIdList[ii] )    // This id is not yet used.
+        SCH_REFERENCE&      ref = componentFlatList[aIndex];
+        std::map<int, int>& numbers = numbersInUse[ ref.m_Ref ];
+        auto                number = numbers.find( ref.m_NumRef );
+
+        if( --number->second == 0 )
         {
-            // Insert this free Id, in order to keep list sorted
-            aIdList.insert( aIdList.begin() + ii, expectedId );
-            return expectedId;
+            numbers.erase( number );
+
+            if( &numbers == groupNumbers )
+                releasedNumbers.insert( ref.m_NumRef );
         }
 
-        expectedId++;
-    }
+        if( !ref.m_IsNew )
+        {
+            std::map<std::pair<int, int>, int>& units = unitsInUse[ ref.m_Ref ];
+            auto unit = units.find( std::make_pair( ref.m_NumRef, ref.m_Unit ) );
 
-    // All existing Id are tested, and all values are found in use.
-    // So Create a new one.
-    aIdList.push_back( expectedId );
-    return expectedId;
-}
+            if( --unit->second == 0 )
+                units.erase( unit );
+        }
+        else if( !ref.m_Flag )
+        {
+            candidates[ candidateKey( ref, ref.IsUnitsLocked(), ref.m_Unit ) ].erase( aIndex );
+        }
+    };
 
+    // Returns the first not annotated component after aIndex in the candidates of aKey
+    auto findCandidate = [&]( const CANDIDATE_KEY& aKey, unsigned aIndex ) -> unsigned
+    {
+        auto candidateSet = candidates.find( aKey );
 
-// A helper function to build a full reference string of a SCH_REFERENCE item
-wxString buildFullReference( const SCH_REFERENCE& aItem, int aUnitNumber = -1 )
-{
-    wxString fullref;
-    fullref = aItem.GetRef() + aItem.GetRefNumber();
+        if( candidateSet != candidates.end() )
+        {
+            auto candidate = candidateSet->second.upper_bound( aIndex );
 
-    if( aUnitNumber < 0 )
-        fullref << ".." << aItem.GetUnit();
-    else
-        fullref << ".." << aUnitNumber;
+            if( candidate != candidateSet->second.end() )
+                return *candidate;
+        }
 
-    return fullref;
-}
+        return componentFlatList.size();
+    };
 
+    // Returns the first free reference number of the current group
+    auto createFirstFreeRefId = [&]()
+    {
+        while( groupNumbers->count( nextRefId ) || releasedNumbers.count( nextRefId ) )
+            nextRefId++;
 
-void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int aStartNumber,
-      SCH_MULTI_UNIT_REFERENCE_MAP aLockedUnitMap )
-{
-    if ( componentFlatList.size() == 0 )
-        return;
+        return nextRefId;
+    };
 
-    int LastReferenceNumber = 0;
-    int NumberOfUnits, Unit;
+    auto startGroup = [&]( unsigned aIndex )
+    {
+        // when using sheet number, ensure ref number >= sheet number* aSheetIntervalId
+        if( aUseSheetNum )
+            nextRefId = componentFlatList[aIndex].m_SheetNum * aSheetIntervalId + 1;
+        else
+            nextRefId = aStartNumber + 1;
+
+        groupNumbers = &numbersInUse[ componentFlatList[aIndex].m_Ref ];
+        releasedNumbers.clear();
+    };
+
+    for( unsigned ii = 0; ii < componentFlatList.size(); ii++ )
+    {
+        addToIndexes( ii );
+        instances[ INSTANCE_KEY( componentFlatList[ii].GetComp(),
+                                 componentFlatList[ii].GetSheetPath().Path() ) ].push_back( ii );
+    }
+
+    // The locked unit list of each component instance, the first one found in aLockedUnitMap
+    std::map<INSTANCE_KEY, SCH_REFERENCE_LIST*> lockedLists;
+
+    for( SCH_MULTI_UNIT_REFERENCE_MAP::value_type& pair : aLockedUnitMap )
+    {
+        unsigned n_refs = pair.second.GetCount();
+
+        for( unsigned thisRefI = 0; thisRefI < n_refs; ++thisRefI )
+        {
+            SCH_REFERENCE& thisRef = pair.second[thisRefI];
+
+            lockedLists.emplace( INSTANCE_KEY( thisRef.GetComp(), thisRef.GetSheetPath().Path() ),
+                                 &pair.second );
+        }
+    }
 
     /* calculate index of the first component with the same reference prefix
      * than the current component.  All components having the same reference
@@ -304,23 +345,7 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
      */
     unsigned first = 0;
 
-    // calculate the last used number for this reference prefix:
-#ifdef USE_OLD_ALGO
-    int minRefId = 0;
-
-    // when using sheet number, ensure ref number >= sheet number* aSheetIntervalId
-    if( aUseSheetNum )
-        minRefId = componentFlatList[first].m_SheetNum * aSheetIntervalId;
-
-    LastReferenceNumber = GetLastReference( first, minRefId );
-#else
-    int minRefId;
-
-    // when using sheet number, ensure ref number >= sheet number* aSheetIntervalId
-    if( aUseSheetNum )
-        minRefId = componentFlatList[first].m_SheetNum * aSheetIntervalId + 1;
-    else
-        minRefId = aStartNumber + 1;
+    startGroup( first );
 
     // For multi units components, when "keep order of multi unit" option is selected,
     // store the list of already used full references.
@@ -334,11 +359,6 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
     // inUseRefs keep trace of previously allocated references
     std::unordered_set<wxString> inUseRefs;
 
-    // This is the list of all Id already in use for a given reference prefix.
-    // Will be refilled for each new reference prefix.
-    std::vector<int>idList;
-    GetRefsInUse( first, idList, minRefId );
-#endif
     for( unsigned ii = 0; ii < componentFlatList.size(); ii++ )
     {
         if( componentFlatList[ii].m_Flag )
@@ -346,64 +366,35 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
 
         // Check whether this component is in aLockedUnitMap.
         SCH_REFERENCE_LIST* lockedList = NULL;
-        for( SCH_MULTI_UNIT_REFERENCE_MAP::value_type& pair : aLockedUnitMap )
-        {
-            unsigned n_refs = pair.second.GetCount();
+        auto locked = lockedLists.find( INSTANCE_KEY( componentFlatList[ii].GetComp(),
+                                              componentFlatList[ii].GetSheetPath().Path() ) );
 
-            for( unsigned thisRefI = 0; thisRefI < n_refs; ++thisRefI )
-            {
-                SCH_REFERENCE &thisRef = pair.second[thisRefI];
-
-                if( thisRef.IsSameInstance( componentFlatList[ii] ) )
-                {
-                    lockedList = &pair.second;
-                    break;
-                }
-            }
-            if( lockedList != NULL ) break;
-        }
+        if( locked != lockedLists.end() )
+            lockedList = locked->second;
 
         if(  ( componentFlatList[first].CompareRef( componentFlatList[ii] ) != 0 )
           || ( aUseSheetNum && ( componentFlatList[first].m_SheetNum != componentFlatList[ii].m_SheetNum ) )  )
         {
             // New reference found: we need a new ref number for this reference
             first = ii;
-#ifdef USE_OLD_ALGO
-            minRefId = 0;
-
-            // when using sheet number, ensure ref number >= sheet number* aSheetIntervalId
-            if( aUseSheetNum )
-                minRefId = componentFlatList[ii].m_SheetNum * aSheetIntervalId;
-
-            LastReferenceNumber = GetLastReference( ii, minRefId );
-
-#else
-            // when using sheet number, ensure ref number >= sheet number* aSheetIntervalId
-            if( aUseSheetNum )
-                minRefId = componentFlatList[ii].m_SheetNum * aSheetIntervalId + 1;
-            else
-                minRefId = aStartNumber + 1;
-
-            GetRefsInUse( first, idList, minRefId );
-#endif
+            startGroup( first );
         }
 
         // Annotation of one part per package components (trivial case).
         if( componentFlatList[ii].GetLibPart()->GetUnitCount() <= 1 )
         {
+            removeFromIndexes( ii );
+
             if( componentFlatList[ii].m_IsNew )
             {
-#ifdef USE_OLD_ALGO
-                LastReferenceNumber++;
-#else
-                LastReferenceNumber = CreateFirstFreeRefId( idList, minRefId );
-#endif
+                LastReferenceNumber = createFirstFreeRefId();
                 componentFlatList[ii].m_NumRef = LastReferenceNumber;
             }
 
             componentFlatList[ii].m_Unit  = 1;
             componentFlatList[ii].m_Flag  = 1;
             componentFlatList[ii].m_IsNew = false;
+            addToIndexes( ii );
             continue;
         }
 
@@ -412,17 +403,16 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
 
         if( componentFlatList[ii].m_IsNew )
         {
-#ifdef USE_OLD_ALGO
-            LastReferenceNumber++;
-#else
-            LastReferenceNumber = CreateFirstFreeRefId( idList, minRefId );
-#endif
+            removeFromIndexes( ii );
+
+            LastReferenceNumber = createFirstFreeRefId();
             componentFlatList[ii].m_NumRef = LastReferenceNumber;
 
             if( !componentFlatList[ii].IsUnitsLocked() )
                 componentFlatList[ii].m_Unit = 1;
 
             componentFlatList[ii].m_Flag = 1;
+            addToIndexes( ii );
         }
 
         // If this component is in aLockedUnitMap, copy the annotation to all
@@ -434,11 +424,14 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
             for( unsigned thisRefI = 0; thisRefI < n_refs; ++thisRefI )
             {
                 SCH_REFERENCE &thisRef = (*lockedList)[thisRefI];
+                INSTANCE_KEY   instance( thisRef.GetComp(), thisRef.GetSheetPath().Path() );
 
-                if( thisRef.IsSameInstance( componentFlatList[ii] ) )
+                if( instance == locked->first )
                 {
                     // This is the component we're currently annotating. Hold the unit!
+                    removeFromIndexes( ii );
                     componentFlatList[ii].m_Unit = thisRef.m_Unit;
+                    addToIndexes( ii );
                     // lock this new full reference
                     inUseRefs.insert( buildFullReference( componentFlatList[ii] ) );
                 }
@@ -450,26 +443,33 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
                     continue;
 
                 // Find the matching component
-                for( unsigned jj = ii + 1; jj < componentFlatList.size(); jj++ )
+                auto matches = instances.find( instance );
+
+                if( matches == instances.end() )
+                    continue;
+
+                auto match = std::upper_bound( matches->second.begin(), matches->second.end(),
+                                               ii );
+
+                if( match == matches->second.end() )
+                    continue;
+
+                unsigned jj = *match;
+                wxString ref_candidate = buildFullReference( componentFlatList[ii], thisRef.m_Unit );
+
+                // propagate the new reference and unit selection to the "old" component,
+                // if this new full reference is not already used (can happens when initial
+                // multiunits components have duplicate references)
+                if( inUseRefs.find( ref_candidate ) == inUseRefs.end() )
                 {
-                    if( ! thisRef.IsSameInstance( componentFlatList[jj] ) )
-                        continue;
-
-                    wxString ref_candidate = buildFullReference( componentFlatList[ii], thisRef.m_Unit );
-
-                    // propagate the new reference and unit selection to the "old" component,
-                    // if this new full reference is not already used (can happens when initial
-                    // multiunits components have duplicate references)
-                    if( inUseRefs.find( ref_candidate ) == inUseRefs.end() )
-                    {
-                        componentFlatList[jj].m_NumRef = componentFlatList[ii].m_NumRef;
-                        componentFlatList[jj].m_Unit = thisRef.m_Unit;
-                        componentFlatList[jj].m_IsNew = false;
-                        componentFlatList[jj].m_Flag = 1;
-                        // lock this new full reference
-                        inUseRefs.insert( ref_candidate );
-                        break;
-                    }
+                    removeFromIndexes( jj );
+                    componentFlatList[jj].m_NumRef = componentFlatList[ii].m_NumRef;
+                    componentFlatList[jj].m_Unit = thisRef.m_Unit;
+                    componentFlatList[jj].m_IsNew = false;
+                    componentFlatList[jj].m_Flag = 1;
+                    addToIndexes( jj );
+                    // lock this new full reference
+                    inUseRefs.insert( ref_candidate );
                 }
             }
         }
@@ -479,44 +479,31 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
             * we search for others parts that have the same value and the same
             * reference prefix (ref without ref number)
             */
+            SCH_REFERENCE& ref = componentFlatList[ii];
+            auto&          units = unitsInUse[ ref.m_Ref ];
+
             for( Unit = 1; Unit <= NumberOfUnits; Unit++ )
             {
-                if( componentFlatList[ii].m_Unit == Unit )
+                if( ref.m_Unit == Unit )
                     continue;
 
-                int found = FindUnit( ii, Unit );
-
-                if( found >= 0 )
+                if( units.count( std::make_pair( ref.m_NumRef, Unit ) ) )
                     continue; // this unit exists for this reference (unit already annotated)
 
-                // Search a component to annotate ( same prefix, same value, not annotated)
-                for( unsigned jj = ii + 1; jj < componentFlatList.size(); jj++ )
+                // Search a component to annotate ( same prefix, same value, not annotated),
+                // either without locked units or locked to this unit
+                unsigned jj = std::min( findCandidate( candidateKey( ref, false, Unit ), ii ),
+                                        findCandidate( candidateKey( ref, true, Unit ), ii ) );
+
+                if( jj < componentFlatList.size() )
                 {
-                    if( componentFlatList[jj].m_Flag )    // already tested
-                        continue;
-
-                    if( componentFlatList[ii].CompareRef( componentFlatList[jj] ) != 0 )
-                        continue;
-
-                    if( componentFlatList[jj].CompareValue( componentFlatList[ii] ) != 0 )
-                        continue;
-
-                    if( componentFlatList[jj].CompareLibName( componentFlatList[ii] ) != 0 )
-                        continue;
-
-                    if( !componentFlatList[jj].m_IsNew )
-                        continue;
-
-                    // Component without reference number found, annotate it if possible
-                    if( !componentFlatList[jj].IsUnitsLocked()
-                        || ( componentFlatList[jj].m_Unit == Unit ) )
-                    {
-                        componentFlatList[jj].m_NumRef = componentFlatList[ii].m_NumRef;
-                        componentFlatList[jj].m_Unit   = Unit;
-                        componentFlatList[jj].m_Flag   = 1;
-                        componentFlatList[jj].m_IsNew  = false;
-                        break;
-                    }
+                    // Component without reference number found, annotate it
+                    removeFromIndexes( jj );
+                    componentFlatList[jj].m_NumRef = ref.m_NumRef;
+                    componentFlatList[jj].m_Unit   = Unit;
+                    componentFlatList[jj].m_Flag   = 1;
+                    componentFlatList[jj].m_IsNew  = false;
+                    addToIndexes( jj );
                 }
             }
         }
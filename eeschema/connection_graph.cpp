@@ -19,6 +19,7 @@
  */
 
 #include <list>
+#include <numeric>
 #include <thread>
 #include <algorithm>
 #include <future>
@@ -42,7 +43,7 @@
 #include <connection_graph.h>
 
 
-bool CONNECTION_SUBGRAPH::ResolveDrivers( bool aCreateMarkers )
+bool CONNECTION_SUBGRAPH::ResolveDrivers( ERC_MARKER_BUFFER* aMarkers )
 {
     int highest_priority = -1;
     std::vector<SCH_ITEM*> candidates;
@@ -134,7 +135,7 @@ bool CONNECTION_SUBGRAPH::ResolveDrivers( bool aCreateMarkers )
     else
         m_driver_connection = nullptr;
 
-    if( aCreateMarkers && m_multiple_drivers )
+    if( aMarkers && m_multiple_drivers )
     {
         // First check if all the candidates are actually the same
         bool same = true;
@@ -171,20 +172,19 @@ bool CONNECTION_SUBGRAPH::ResolveDrivers( bool aCreateMarkers )
                       second_item->GetPosition();
 
             auto marker = new SCH_MARKER();
-            marker->SetTimeStamp( GetNewTimeStamp() );
             marker->SetMarkerType( MARKER_BASE::MARKER_ERC );
             marker->SetErrorLevel( MARKER_BASE::MARKER_SEVERITY_WARNING );
             marker->SetData( ERCE_DRIVER_CONFLICT, p0, msg, p1 );
 
-            m_sheet.LastScreen()->Append( marker );
+            aMarkers->Add( m_sheet.LastScreen(), marker );
 
-            // If aCreateMarkers is true, then this is part of ERC check, so we
+            // If aMarkers is given, then this is part of ERC check, so we
             // should return false even if the driver was assigned
             return false;
         }
     }
 
-    return aCreateMarkers || ( m_driver != nullptr );
+    return aMarkers || ( m_driver != nullptr );
 }
 
 
@@ -358,6 +358,7 @@ void CONNECTION_GRAPH::Reset()
         delete subgraph;
 
     m_items.clear();
+    m_screen_items.clear();
     m_subgraphs.clear();
     m_driver_subgraphs.clear();
     m_sheet_to_subgraphs_map.clear();
@@ -380,24 +381,114 @@ void CONNECTION_GRAPH::Recalculate( SCH_SHEET_LIST aSheetList, bool aUncondition
     PROF_COUNTER recalc_time;
     PROF_COUNTER update_items;
 
-    if( aUnconditional )
-        Reset();
+    // Find the screens whose connectivity changed: the ones having dirty items, and
+    // the ones whose list of connectable items changed (deleted items are not flagged)
+    std::unordered_map<SCH_SCREEN*, std::vector<SCH_ITEM*>> screen_items;
+    std::unordered_set<SCH_SCREEN*> changed_screens;
 
     for( const auto& sheet : aSheetList )
     {
-        std::vector<SCH_ITEM*> items;
+        SCH_SCREEN* screen = sheet.LastScreen();
+
+        if( screen_items.count( screen ) )
+            continue;
+
+        std::vector<SCH_ITEM*>& items = screen_items[ screen ];
+        bool dirty = aUnconditional;
 
-        for( auto item = sheet.LastScreen()->GetDrawItems();
-             item; item = item->Next() )
+        for( auto item = screen->GetDrawItems(); item; item = item->Next() )
         {
-            if( item->IsConnectable() &&
-                ( aUnconditional || item->IsConnectivityDirty() ) )
+            if( item->IsConnectable() )
             {
                 items.push_back( item );
+                dirty |= item->IsConnectivityDirty();
+            }
+        }
+
+        if( !dirty )
+        {
+            auto prev = m_screen_items.find( screen );
+            dirty = ( prev == m_screen_items.end() || prev->second != items );
+        }
+
+        if( dirty )
+            changed_screens.insert( screen );
+    }
+
+    if( changed_screens.empty() && screen_items.size() == m_screen_items.size() )
+        return;
+
+    // The subgraphs and the net names are rebuilt from scratch, but the links between the
+    // items of the unchanged screens are kept.  The net names and codes of a subgraph can
+    // depend on labels and power pins of any sheet, and the net codes are numbered in
+    // subgraph order, so rebuilding only part of the subgraphs would renumber the others.
+    Reset();
+    m_screen_items = std::move( screen_items );
+
+    // Sheets sharing a screen share their items, so the sheets are grouped by screen and
+    // the groups are updated in parallel.  The results of each sheet are then merged in
+    // sheet order, so the graph doesn't depend on the thread scheduling.
+    std::vector<std::vector<size_t>> screen_sheets;
+    std::unordered_map<SCH_SCREEN*, size_t> screen_groups;
+
+    for( size_t sheetId = 0; sheetId < aSheetList.size(); sheetId++ )
+    {
+        auto group = screen_groups.emplace( aSheetList[sheetId].LastScreen(),
+                                            screen_sheets.size() );
+
+        if( group.second )
+            screen_sheets.emplace_back();
+
+        screen_sheets[ group.first->second ].push_back( sheetId );
+    }
+
+    std::vector<std::vector<SCH_ITEM*>> sheet_items( aSheetList.size() );
+    std::vector<std::vector<std::pair<SCH_SHEET_PATH, SCH_PIN*>>> sheet_power_pins(
+            aSheetList.size() );
+
+    size_t parallelThreadCount = std::min<size_t>( std::thread::hardware_concurrency(),
+                                                   screen_sheets.size() );
+
+    std::atomic<size_t> nextScreen( 0 );
+    std::vector<std::future<size_t>> returns( parallelThreadCount );
+
+    auto update_lambda = [&]() -> size_t
+    {
+        for( size_t screenId = nextScreen++; screenId < screen_sheets.size();
+             screenId = nextScreen++ )
+        {
+            for( size_t sheetId : screen_sheets[ screenId ] )
+            {
+                const SCH_SHEET_PATH& sheet = aSheetList[ sheetId ];
+                SCH_SCREEN* screen = sheet.LastScreen();
+
+                updateItemConnectivity( sheet, m_screen_items.at( screen ),
+                                        changed_screens.count( screen ) > 0,
+                                        sheet_items[ sheetId ], sheet_power_pins[ sheetId ] );
             }
         }
 
-        updateItemConnectivity( sheet, items );
+        return 1;
+    };
+
+    if( parallelThreadCount == 1 )
+        update_lambda();
+    else
+    {
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            returns[ii] = std::async( std::launch::async, update_lambda );
+
+        // Finalize the threads
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            returns[ii].wait();
+    }
+
+    for( size_t sheetId = 0; sheetId < aSheetList.size(); sheetId++ )
+    {
+        m_items.insert( sheet_items[ sheetId ].begin(), sheet_items[ sheetId ].end() );
+        m_invisible_power_pins.insert( m_invisible_power_pins.end(),
+                                       sheet_power_pins[ sheetId ].begin(),
+                                       sheet_power_pins[ sheetId ].end() );
     }
 
     update_items.Stop();
@@ -406,8 +497,16 @@ void CONNECTION_GRAPH::Recalculate( SCH_SHEET_LIST aSheetList, bool aUncondition
     PROF_COUNTER tde;
 
     // IsDanglingStateChanged() also adds connected items for things like SCH_TEXT
-    SCH_SCREENS schematic;
-    schematic.TestDanglingEnds();
+    if( aUnconditional )
+    {
+        SCH_SCREENS schematic;
+        schematic.TestDanglingEnds();
+    }
+    else
+    {
+        for( auto screen : changed_screens )
+            screen->TestDanglingEnds();
+    }
 
     tde.Stop();
     wxLogTrace( "CONN_PROFILE", "TestDanglingEnds() %0.4f ms", tde.msecs() );
@@ -420,7 +519,9 @@ void CONNECTION_GRAPH::Recalculate( SCH_SHEET_LIST aSheetList, bool aUncondition
     wxLogTrace( "CONN_PROFILE", "BuildConnectionGraph() %0.4f ms", build_graph.msecs() );
 
     recalc_time.Stop();
-    wxLogTrace( "CONN_PROFILE", "Recalculate time %0.4f ms", recalc_time.msecs() );
+    wxLogTrace( "CONN_PROFILE", "Recalculate time %0.4f ms (%u of %u screens changed)",
+                recalc_time.msecs(), (unsigned) changed_screens.size(),
+                (unsigned) m_screen_items.size() );
 
 #ifndef DEBUG
     // Pressure relief valve for release builds
@@ -435,16 +536,22 @@ void CONNECTION_GRAPH::Recalculate( SCH_SHEET_LIST aSheetList, bool aUncondition
 }
 
 
-void CONNECTION_GRAPH::updateItemConnectivity( SCH_SHEET_PATH aSheet,
-                                               std::vector<SCH_ITEM*> aItemList )
+void CONNECTION_GRAPH::updateItemConnectivity( const SCH_SHEET_PATH& aSheet,
+        const std::vector<SCH_ITEM*>& aItemList, bool aUpdateLinks,
+        std::vector<SCH_ITEM*>& aGraphItems,
+        std::vector<std::pair<SCH_SHEET_PATH, SCH_PIN*>>& aPowerPins )
 {
     std::unordered_map< wxPoint, std::vector<SCH_ITEM*> > connection_map;
 
     for( auto item : aItemList )
     {
         std::vector< wxPoint > points;
-        item->GetConnectionPoints( points );
-        item->ConnectedItems().clear();
+
+        if( aUpdateLinks )
+        {
+            item->GetConnectionPoints( points );
+            item->ConnectedItems().clear();
+        }
 
         if( item->Type() == SCH_SHEET_T )
         {
@@ -455,11 +562,15 @@ void CONNECTION_GRAPH::updateItemConnectivity( SCH_SHEET_PATH aSheet,
                     pin.InitializeConnection( aSheet );
                 }
 
-                pin.ConnectedItems().clear();
                 pin.Connection( aSheet )->Reset();
 
-                connection_map[ pin.GetTextPos() ].push_back( &pin );
-                m_items.insert( &pin );
+                if( aUpdateLinks )
+                {
+                    pin.ConnectedItems().clear();
+                    connection_map[ pin.GetTextPos() ].push_back( &pin );
+                }
+
+                aGraphItems.push_back( &pin );
             }
         }
         else if( item->Type() == SCH_COMPONENT_T )
@@ -474,24 +585,29 @@ void CONNECTION_GRAPH::updateItemConnectivity( SCH_SHEET_PATH aSheet,
             {
                 pin.InitializeConnection( aSheet );
 
-                wxPoint pos = t.TransformCoordinate( pin.GetPosition() ) + component->GetPosition();
-
                 // because calling the first time is not thread-safe
                 pin.GetDefaultNetName( aSheet );
-                pin.ConnectedItems().clear();
 
                 // Invisible power pins need to be post-processed later
 
                 if( pin.IsPowerConnection() && !pin.IsVisible() )
-                    m_invisible_power_pins.emplace_back( std::make_pair( aSheet, &pin ) );
+                    aPowerPins.emplace_back( std::make_pair( aSheet, &pin ) );
+
+                if( aUpdateLinks )
+                {
+                    wxPoint pos = t.TransformCoordinate( pin.GetPosition() )
+                                  + component->GetPosition();
 
-                connection_map[ pos ].push_back( &pin );
-                m_items.insert( &pin );
+                    pin.ConnectedItems().clear();
+                    connection_map[ pos ].push_back( &pin );
+                }
+
+                aGraphItems.push_back( &pin );
             }
         }
         else
         {
-            m_items.insert( item );
+            aGraphItems.push_back( item );
             auto conn = item->InitializeConnection( aSheet );
 
             // Set bus/net property here so that the propagation code uses it
@@ -1235,14 +1351,48 @@ void CONNECTION_GRAPH::buildConnectionGraph()
         }
     }
 
-    // Update any subgraph that was invalidated above
-    for( auto subgraph : invalidated_subgraphs )
+    // Update any subgraph that was invalidated above.  The drivers only depend on the
+    // items of each subgraph, so they are resolved in parallel before the net codes
+    // are assigned.
+    std::vector<CONNECTION_SUBGRAPH*> resolve_graphs;
+
+    std::copy_if( invalidated_subgraphs.begin(), invalidated_subgraphs.end(),
+                  std::back_inserter( resolve_graphs ),
+                  [&] ( const CONNECTION_SUBGRAPH* candidate ) {
+                      return !candidate->m_absorbed;
+                  } );
+
+    parallelThreadCount = std::min<size_t>( std::thread::hardware_concurrency(),
+            ( resolve_graphs.size() + 3 ) / 4 );
+
+    std::atomic<size_t> nextResolve( 0 );
+    std::vector<std::future<size_t>> resolveReturns( parallelThreadCount );
+
+    auto resolve_lambda = [&nextResolve, &resolve_graphs]() -> size_t
     {
-        if( subgraph->m_absorbed )
-            continue;
+        for( size_t subgraphId = nextResolve++; subgraphId < resolve_graphs.size();
+             subgraphId = nextResolve++ )
+        {
+            resolve_graphs[subgraphId]->ResolveDrivers();
+        }
 
-        subgraph->ResolveDrivers();
+        return 1;
+    };
 
+    if( parallelThreadCount == 1 )
+        resolve_lambda();
+    else
+    {
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            resolveReturns[ii] = std::async( std::launch::async, resolve_lambda );
+
+        // Finalize the threads
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            resolveReturns[ii].wait();
+    }
+
+    for( auto subgraph : resolve_graphs )
+    {
         if( subgraph->m_driver_connection->IsBus() )
             assignNetCodesToBus( subgraph->m_driver_connection );
         else
@@ -1782,56 +1932,92 @@ std::vector<const CONNECTION_SUBGRAPH*> CONNECTION_GRAPH::GetBusesNeedingMigrati
 
 int CONNECTION_GRAPH::RunERC( const ERC_SETTINGS& aSettings, bool aCreateMarkers )
 {
-    int error_count = 0;
+    // The checks of one subgraph only read the graph and the other subgraphs, so the
+    // subgraphs are checked in parallel.  Each subgraph buffers its own markers, which are
+    // added to the screens afterwards in subgraph order, so the result doesn't depend on
+    // the thread scheduling.
+    std::vector<int> error_counts( m_subgraphs.size(), 0 );
+    std::vector<ERC_MARKER_BUFFER> markers( aCreateMarkers ? m_subgraphs.size() : 0 );
 
-    for( auto&& subgraph : m_subgraphs )
+    size_t parallelThreadCount = std::min<size_t>( std::thread::hardware_concurrency(),
+            ( m_subgraphs.size() + 3 ) / 4 );
+
+    std::atomic<size_t> nextSubgraph( 0 );
+    std::vector<std::future<size_t>> returns( parallelThreadCount );
+
+    auto erc_lambda = [&]() -> size_t
     {
-        // Graph is supposed to be up-to-date before calling RunERC()
-        wxASSERT( !subgraph->m_dirty );
+        for( size_t subgraphId = nextSubgraph++; subgraphId < m_subgraphs.size();
+             subgraphId = nextSubgraph++ )
+        {
+            auto subgraph = m_subgraphs[subgraphId];
+            ERC_MARKER_BUFFER* buffer = aCreateMarkers ? &markers[subgraphId] : nullptr;
+            int& error_count = error_counts[subgraphId];
+
+            // Graph is supposed to be up-to-date before calling RunERC()
+            wxASSERT( !subgraph->m_dirty );
+
+            /**
+             * NOTE:
+             *
+             * We could check that labels attached to bus subgraphs follow the
+             * proper format (i.e. actually define a bus).
+             *
+             * This check doesn't need to be here right now because labels
+             * won't actually be connected to bus wires if they aren't in the right
+             * format due to their TestDanglingEnds() implementation.
+             */
+
+            if( aSettings.check_bus_driver_conflicts &&
+                !subgraph->ResolveDrivers( buffer ) )
+                error_count++;
+
+            if( aSettings.check_bus_to_net_conflicts &&
+                !ercCheckBusToNetConflicts( subgraph, buffer ) )
+                error_count++;
+
+            if( aSettings.check_bus_entry_conflicts &&
+                !ercCheckBusToBusEntryConflicts( subgraph, buffer ) )
+                error_count++;
+
+            if( aSettings.check_bus_to_bus_conflicts &&
+                !ercCheckBusToBusConflicts( subgraph, buffer ) )
+                error_count++;
+
+            // The following checks are always performed since they don't currently
+            // have an option exposed to the user
+
+            if( !ercCheckNoConnects( subgraph, buffer ) )
+                error_count++;
+
+            if( !ercCheckLabels( subgraph, buffer, aSettings.check_unique_global_labels ) )
+                error_count++;
+        }
+
+        return 1;
+    };
 
-        /**
-         * NOTE:
-         *
-         * We could check that labels attached to bus subgraphs follow the
-         * proper format (i.e. actually define a bus).
-         *
-         * This check doesn't need to be here right now because labels
-         * won't actually be connected to bus wires if they aren't in the right
-         * format due to their TestDanglingEnds() implementation.
-         */
-
-        if( aSettings.check_bus_driver_conflicts &&
-            !subgraph->ResolveDrivers( aCreateMarkers ) )
-            error_count++;
-
-        if( aSettings.check_bus_to_net_conflicts &&
-            !ercCheckBusToNetConflicts( subgraph, aCreateMarkers ) )
-            error_count++;
-
-        if( aSettings.check_bus_entry_conflicts &&
-            !ercCheckBusToBusEntryConflicts( subgraph, aCreateMarkers ) )
-            error_count++;
-
-        if( aSettings.check_bus_to_bus_conflicts &&
-            !ercCheckBusToBusConflicts( subgraph, aCreateMarkers ) )
-            error_count++;
-
-        // The following checks are always performed since they don't currently
-        // have an option exposed to the user
-
-        if( !ercCheckNoConnects( subgraph, aCreateMarkers ) )
-            error_count++;
-
-        if( !ercCheckLabels( subgraph, aCreateMarkers, aSettings.check_unique_global_labels ) )
-            error_count++;
+    if( parallelThreadCount == 1 )
+        erc_lambda();
+    else
+    {
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            returns[ii] = std::async( std::launch::async, erc_lambda );
+
+        // Finalize the threads
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            returns[ii].wait();
     }
 
-    return error_count;
+    for( auto& buffer : markers )
+        buffer.Flush();
+
+    return std::accumulate( error_counts.begin(), error_counts.end(), 0 );
 }
 
 
 bool CONNECTION_GRAPH::ercCheckBusToNetConflicts( const CONNECTION_SUBGRAPH* aSubgraph,
-                                                  bool aCreateMarkers )
+                                                  ERC_MARKER_BUFFER* aMarkers )
 {
     wxString msg;
     auto sheet = aSubgraph->m_sheet;
@@ -1875,7 +2061,7 @@ bool CONNECTION_GRAPH::ercCheckBusToNetConflicts( const CONNECTION_SUBGRAPH* aSu
 
     if( net_item && bus_item )
     {
-        if( aCreateMarkers )
+        if( aMarkers )
         {
             msg.Printf( _( "%s and %s are graphically connected but cannot"
                            " electrically connect because one is a bus and"
@@ -1884,14 +2070,13 @@ bool CONNECTION_GRAPH::ercCheckBusToNetConflicts( const CONNECTION_SUBGRAPH* aSu
                         net_item->GetSelectMenuText( m_frame->GetUserUnits() ) );
 
             auto marker = new SCH_MARKER();
-            marker->SetTimeStamp( GetNewTimeStamp() );
             marker->SetMarkerType( MARKER_BASE::MARKER_ERC );
             marker->SetErrorLevel( MARKER_BASE::MARKER_SEVERITY_ERROR );
             marker->SetData( ERCE_BUS_TO_NET_CONFLICT,
                              net_item->GetPosition(), msg,
                              bus_item->GetPosition() );
 
-            screen->Append( marker );
+            aMarkers->Add( screen, marker );
         }
 
         return false;
@@ -1902,7 +2087,7 @@ bool CONNECTION_GRAPH::ercCheckBusToNetConflicts( const CONNECTION_SUBGRAPH* aSu
 
 
 bool CONNECTION_GRAPH::ercCheckBusToBusConflicts( const CONNECTION_SUBGRAPH* aSubgraph,
-                                                  bool aCreateMarkers )
+                                                  ERC_MARKER_BUFFER* aMarkers )
 {
     wxString msg;
     auto sheet = aSubgraph->m_sheet;
@@ -1957,7 +2142,7 @@ bool CONNECTION_GRAPH::ercCheckBusToBusConflicts( const CONNECTION_SUBGRAPH* aSu
 
         if( !match )
         {
-            if( aCreateMarkers )
+            if( aMarkers )
             {
                 msg.Printf( _( "%s and %s are graphically connected but do "
                                "not share any bus members" ),
@@ -1965,14 +2150,13 @@ bool CONNECTION_GRAPH::ercCheckBusToBusConflicts( const CONNECTION_SUBGRAPH* aSu
                             port->GetSelectMenuText( m_frame->GetUserUnits() ) );
 
                 auto marker = new SCH_MARKER();
-                marker->SetTimeStamp( GetNewTimeStamp() );
                 marker->SetMarkerType( MARKER_BASE::MARKER_ERC );
                 marker->SetErrorLevel( MARKER_BASE::MARKER_SEVERITY_ERROR );
                 marker->SetData( ERCE_BUS_TO_BUS_CONFLICT,
                                  label->GetPosition(), msg,
                                  port->GetPosition() );
 
-                screen->Append( marker );
+                aMarkers->Add( screen, marker );
             }
 
             return false;
@@ -1984,7 +2168,7 @@ bool CONNECTION_GRAPH::ercCheckBusToBusConflicts( const CONNECTION_SUBGRAPH* aSu
 
 
 bool CONNECTION_GRAPH::ercCheckBusToBusEntryConflicts( const CONNECTION_SUBGRAPH* aSubgraph,
-                                                       bool aCreateMarkers )
+                                                       ERC_MARKER_BUFFER* aMarkers )
 {
     wxString msg;
     bool conflict = false;
@@ -2034,7 +2218,7 @@ bool CONNECTION_GRAPH::ercCheckBusToBusEntryConflicts( const CONNECTION_SUBGRAPH
 
     if( conflict )
     {
-        if( aCreateMarkers )
+        if( aMarkers )
         {
             msg.Printf( _( "%s (%s) is connected to %s (%s) but is not a member of the bus" ),
                         bus_entry->GetSelectMenuText( m_frame->GetUserUnits() ),
@@ -2043,14 +2227,13 @@ bool CONNECTION_GRAPH::ercCheckBusToBusEntryConflicts( const CONNECTION_SUBGRAPH
                         bus_wire->Connection( sheet )->Name( true ) );
 
             auto marker = new SCH_MARKER();
-            marker->SetTimeStamp( GetNewTimeStamp() );
             marker->SetMarkerType( MARKER_BASE::MARKER_ERC );
             marker->SetErrorLevel( MARKER_BASE::MARKER_SEVERITY_WARNING );
             marker->SetData( ERCE_BUS_ENTRY_CONFLICT,
                              bus_entry->GetPosition(), msg,
                              bus_entry->GetPosition() );
 
-            screen->Append( marker );
+            aMarkers->Add( screen, marker );
         }
 
         return false;
@@ -2062,7 +2245,7 @@ bool CONNECTION_GRAPH::ercCheckBusToBusEntryConflicts( const CONNECTION_SUBGRAPH
 
 // TODO(JE) Check sheet pins here too?
 bool CONNECTION_GRAPH::ercCheckNoConnects( const CONNECTION_SUBGRAPH* aSubgraph,
-                                           bool aCreateMarkers )
+                                           ERC_MARKER_BUFFER* aMarkers )
 {
     wxString msg;
     auto sheet = aSubgraph->m_sheet;
@@ -2101,7 +2284,7 @@ bool CONNECTION_GRAPH::ercCheckNoConnects( const CONNECTION_SUBGRAPH* aSubgraph,
 
         if( pin && has_invalid_items )
         {
-            if( aCreateMarkers )
+            if( aMarkers )
             {
                 wxPoint pos = pin->GetTransformedPosition();
 
@@ -2110,12 +2293,11 @@ bool CONNECTION_GRAPH::ercCheckNoConnects( const CONNECTION_SUBGRAPH* aSubgraph,
                             pin->GetParentComponent()->GetRef( &aSubgraph->m_sheet ) );
 
                 auto marker = new SCH_MARKER();
-                marker->SetTimeStamp( GetNewTimeStamp() );
                 marker->SetMarkerType( MARKER_BASE::MARKER_ERC );
                 marker->SetErrorLevel( MARKER_BASE::MARKER_SEVERITY_WARNING );
                 marker->SetData( ERCE_NOCONNECT_CONNECTED, pos, msg, pos );
 
-                screen->Append( marker );
+                aMarkers->Add( screen, marker );
             }
 
             return false;
@@ -2123,19 +2305,18 @@ bool CONNECTION_GRAPH::ercCheckNoConnects( const CONNECTION_SUBGRAPH* aSubgraph,
 
         if( !has_other_items )
         {
-            if( aCreateMarkers )
+            if( aMarkers )
             {
                 wxPoint pos = aSubgraph->m_no_connect->GetPosition();
 
                 msg.Printf( _( "No-connect marker is not connected to anything" ) );
 
                 auto marker = new SCH_MARKER();
-                marker->SetTimeStamp( GetNewTimeStamp() );
                 marker->SetMarkerType( MARKER_BASE::MARKER_ERC );
                 marker->SetErrorLevel( MARKER_BASE::MARKER_SEVERITY_WARNING );
                 marker->SetData( ERCE_NOCONNECT_NOT_CONNECTED, pos, msg, pos );
 
-                screen->Append( marker );
+                aMarkers->Add( screen, marker );
             }
 
             return false;
@@ -2187,7 +2368,7 @@ bool CONNECTION_GRAPH::ercCheckNoConnects( const CONNECTION_SUBGRAPH* aSubgraph,
 
         if( pin && !has_other_connections && pin->GetType() != PIN_NC )
         {
-            if( aCreateMarkers )
+            if( aMarkers )
             {
                 wxPoint pos = pin->GetTransformedPosition();
 
@@ -2196,12 +2377,11 @@ bool CONNECTION_GRAPH::ercCheckNoConnects( const CONNECTION_SUBGRAPH* aSubgraph,
                             pin->GetParentComponent()->GetRef( &aSubgraph->m_sheet ) );
 
                 auto marker = new SCH_MARKER();
-                marker->SetTimeStamp( GetNewTimeStamp() );
                 marker->SetMarkerType( MARKER_BASE::MARKER_ERC );
                 marker->SetErrorLevel( MARKER_BASE::MARKER_SEVERITY_WARNING );
                 marker->SetData( ERCE_PIN_NOT_CONNECTED, pos, msg, pos );
 
-                screen->Append( marker );
+                aMarkers->Add( screen, marker );
             }
 
             return false;
@@ -2213,7 +2393,7 @@ bool CONNECTION_GRAPH::ercCheckNoConnects( const CONNECTION_SUBGRAPH* aSubgraph,
 
 
 bool CONNECTION_GRAPH::ercCheckLabels( const CONNECTION_SUBGRAPH* aSubgraph,
-                                       bool aCreateMarkers, bool aCheckGlobalLabels )
+                                       ERC_MARKER_BUFFER* aMarkers, bool aCheckGlobalLabels )
 {
     // Label connection rules:
     // Local labels are flagged if they don't connect to any pins and don't have a no-connect
@@ -2279,7 +2459,7 @@ bool CONNECTION_GRAPH::ercCheckLabels( const CONNECTION_SUBGRAPH* aSubgraph,
 
     if( !has_other_connections )
     {
-        if( aCreateMarkers )
+        if( aMarkers )
         {
             SCH_SCREEN* screen = aSubgraph->m_sheet.LastScreen();
             wxPoint pos = text->GetPosition();
@@ -2292,12 +2472,11 @@ bool CONNECTION_GRAPH::ercCheckLabels( const CONNECTION_SUBGRAPH* aSubgraph,
             msg.Printf( _( "%s %s is not connected anywhere else in the schematic." ),
                         prefix, GetChars( text->ShortenedShownText() ) );
 
-            marker->SetTimeStamp( GetNewTimeStamp() );
             marker->SetMarkerType( MARKER_BASE::MARKER_ERC );
             marker->SetErrorLevel( MARKER_BASE::MARKER_SEVERITY_WARNING );
             marker->SetData( type, pos, msg, pos );
 
-            screen->Append( marker );
+            aMarkers->Add( screen, marker );
         }
 
         return false;
@@ -36,9 +36,11 @@
 #endif
 
 
+class ERC_MARKER_BUFFER;
 class SCH_EDIT_FRAME;
 class SCH_HIERLABEL;
 class SCH_PIN;
+class SCH_SCREEN;
 class SCH_SHEET_PIN;
 
 
@@ -80,10 +82,10 @@ public:
      * If multiple possible drivers exist, picks one according to the priority.
      * If multiple "winners" exist, returns false and sets m_driver to nullptr.
      *
-     * @param aCreateMarkers controls whether ERC markers should be added for conflicts
+     * @param aMarkers receives the ERC markers for conflicts; nullptr to skip the ERC check
      * @return true if m_driver was set, or false if a conflict occurred
      */
-    bool ResolveDrivers( bool aCreateMarkers = false );
+    bool ResolveDrivers( ERC_MARKER_BUFFER* aMarkers = nullptr );
 
     /**
      * Returns the fully-qualified net name for this subgraph (if one exists)
@@ -206,6 +208,15 @@ public:
     /**
      * Updates the connection graph for the given list of sheets.
      *
+     * Unless aUnconditional is set, only the screens having dirty items, or whose
+     * connectable items were added or removed since the last recalculation, have
+     * their graphical connectivity and dangling ends updated.  Nothing is done when
+     * no screen changed.  The subgraphs, their drivers and the net names are always
+     * rebuilt for the whole hierarchy.
+     *
+     * A change of the reference, unit or pins of a component marks its connectivity
+     * dirty, since the default net names of its pins and the links to them change.
+     *
      * @param aSheetList is the list of possibly modified sheets
      * @param aUnconditional is true if an unconditional full recalculation should be done
      */
@@ -233,6 +244,9 @@ public:
      *
      * Precondition: graph is up-to-date
      *
+     * The subgraphs are checked in parallel; the markers are added to the screens
+     * in subgraph order once all the checks are done.
+     *
      * @param aSettings is used to control which tests to run
      * @param aCreateMarkers controls whether error markers are created
      * @return the number of errors found
@@ -249,6 +263,10 @@ private:
 
     std::unordered_set<SCH_ITEM*> m_items;
 
+    // The connectable items of each screen at the last recalculation, used to find
+    // the screens whose items were added or removed since
+    std::unordered_map<SCH_SCREEN*, std::vector<SCH_ITEM*>> m_screen_items;
+
     // The owner of all CONNECTION_SUBGRAPH objects
     std::vector<CONNECTION_SUBGRAPH*> m_subgraphs;
 
@@ -308,13 +326,24 @@ private:
      * checks to ensure that the items should actually connect, the items are
      * linked together using ConnectedItems().
      *
-     * As a side effect, items are loaded into m_items for BuildConnectionGraph()
+     * The items to load into m_items for BuildConnectionGraph() and the invisible power
+     * pins are returned instead of being stored, so that sheets with different screens
+     * can be updated concurrently.  Sheets sharing a screen share their items and must
+     * be updated from the same thread.
      *
      * @param aSheet is the path to the sheet of all items in the list
      * @param aItemList is a list of items to consider
+     * @param aUpdateLinks is false to only reinitialize the connections of the items,
+     *                     keeping the links made by a previous update (for sheets whose
+     *                     items did not change since)
+     * @param aGraphItems receives the items to add to m_items
+     * @param aPowerPins receives the invisible power pins to add to m_invisible_power_pins
      */
-    void updateItemConnectivity( SCH_SHEET_PATH aSheet,
-                                 std::vector<SCH_ITEM*> aItemList );
+    void updateItemConnectivity( const SCH_SHEET_PATH& aSheet,
+                                 const std::vector<SCH_ITEM*>& aItemList,
+                                 bool aUpdateLinks,
+                                 std::vector<SCH_ITEM*>& aGraphItems,
+                                 std::vector<std::pair<SCH_SHEET_PATH, SCH_PIN*>>& aPowerPins );
 
     /**
      * Generates the connection graph (after all item connectivity has been updated)
@@ -373,11 +402,11 @@ private:
      * For example, a net wire connected to a bus port/pin, or vice versa
      *
      * @param  aSubgraph      is the subgraph to examine
-     * @param  aCreateMarkers controls whether error markers are created
+     * @param  aMarkers      receives the error markers; nullptr to create none
      * @return                true for no errors, false for errors
      */
     bool ercCheckBusToNetConflicts( const CONNECTION_SUBGRAPH* aSubgraph,
-                                    bool aCreateMarkers );
+                                    ERC_MARKER_BUFFER* aMarkers );
 
     /**
      * Checks one subgraph for conflicting connections between two bus items
@@ -387,11 +416,11 @@ private:
      * sheet pin
      *
      * @param  aSubgraph      is the subgraph to examine
-     * @param  aCreateMarkers controls whether error markers are created
+     * @param  aMarkers      receives the error markers; nullptr to create none
      * @return                true for no errors, false for errors
      */
     bool ercCheckBusToBusConflicts( const CONNECTION_SUBGRAPH* aSubgraph,
-                                    bool aCreateMarkers );
+                                    ERC_MARKER_BUFFER* aMarkers );
 
     /**
      * Checks one subgraph for conflicting bus entry to bus connections
@@ -403,11 +432,11 @@ private:
      * "USB.DP" but someone might accidentally just enter "DP"
      *
      * @param  aSubgraph      is the subgraph to examine
-     * @param  aCreateMarkers controls whether error markers are created
+     * @param  aMarkers      receives the error markers; nullptr to create none
      * @return                true for no errors, false for errors
      */
     bool ercCheckBusToBusEntryConflicts( const CONNECTION_SUBGRAPH* aSubgraph,
-                                         bool aCreateMarkers );
+                                         ERC_MARKER_BUFFER* aMarkers );
 
     /**
      * Checks one subgraph for proper presence or absence of no-connect symbols
@@ -416,11 +445,11 @@ private:
      * A pin without a no-connect symbol should have at least one connection
      *
      * @param  aSubgraph      is the subgraph to examine
-     * @param  aCreateMarkers controls whether error markers are created
+     * @param  aMarkers      receives the error markers; nullptr to create none
      * @return                true for no errors, false for errors
      */
     bool ercCheckNoConnects( const CONNECTION_SUBGRAPH* aSubgraph,
-                             bool aCreateMarkers );
+                             ERC_MARKER_BUFFER* aMarkers );
 
     /**
      * Checks one subgraph for proper connection of labels
@@ -428,11 +457,11 @@ private:
      * Labels should be connected to something
      *
      * @param  aSubgraph      is the subgraph to examine
-     * @param  aCreateMarkers controls whether error markers are created
+     * @param  aMarkers      receives the error markers; nullptr to create none
      * @param  aCheckGlobalLabels is true if global labels should be checked for loneliness
      * @return                true for no errors, false for errors
      */
-    bool ercCheckLabels( const CONNECTION_SUBGRAPH* aSubgraph, bool aCreateMarkers,
+    bool ercCheckLabels( const CONNECTION_SUBGRAPH* aSubgraph, ERC_MARKER_BUFFER* aMarkers,
                          bool aCheckGlobalLabels );
 
 };
@@ -23,6 +23,10 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <atomic>
+#include <future>
+#include <thread>
+
 #include <fctsys.h>
 #include <gestfich.h>
 #include <pgm_base.h>
@@ -526,89 +530,107 @@ void DIALOG_ERC::TestErc( REPORTER& aReporter )
     // Reset the connection type indicator
     objectsConnectedList->ResetConnectionsType();
 
-    unsigned lastItemIdx = 0;
-    unsigned nextItemIdx = 0;
-    int MinConn    = NOC;
-
     // Check that a pin appears in only one net.  This check is necessary because multi-unit
     // components that have shared pins could be wired to different nets.
     std::unordered_map<wxString, wxString> pin_to_net_map;
 
     // The netlist generated by SCH_EDIT_FRAME::BuildNetListBase is sorted by net number, which
-    // means we can group netlist items into ranges that live in the same net. The range from
-    // nextItem to the current item (exclusive) needs to be checked against the current item.
-    // The lastItem variable is used as a helper to pass the last item's number from one loop
-    // iteration to the next, which simplifies the initial pass.
+    // means we can group netlist items into ranges that live in the same net.  Each range is
+    // stored as its first item and the item after its last one.
+    std::vector<std::pair<unsigned, unsigned>> netRanges;
+    int lastNet = 0;
+
     for( unsigned itemIdx = 0; itemIdx < objectsConnectedList->size(); itemIdx++ )
     {
         auto item = objectsConnectedList->GetItem( itemIdx );
-        auto lastItem = objectsConnectedList->GetItem( lastItemIdx );
-
-        auto lastNet = lastItem->GetNet();
         auto net = item->GetNet();
 
-        wxASSERT_MSG( lastNet <= net, wxT( "Netlist not correctly ordered" ) );
-
-        if( lastNet != net )
+        if( netRanges.empty() || lastNet != net )
         {
+            wxASSERT_MSG( netRanges.empty() || lastNet < net,
+                          wxT( "Netlist not correctly ordered" ) );
+
             // New net found:
-            MinConn      = NOC;
-            nextItemIdx = itemIdx;
+            netRanges.emplace_back( itemIdx, itemIdx );
+            lastNet = net;
         }
 
-        switch( item->m_Type )
-        {
-        // These items do not create erc problems
-        case NET_ITEM_UNSPECIFIED:
-        case NET_SEGMENT:
-        case NET_BUS:
-        case NET_JUNCTION:
-        case NET_LABEL:
-        case NET_BUSLABELMEMBER:
-        case NET_PINLABEL:
-        case NET_GLOBBUSLABELMEMBER:
-            break;
+        netRanges.back().second = itemIdx + 1;
 
         // TODO(JE) Port this to the new system
-        case NET_PIN:
+        // Check if this pin has appeared before on a different net
+        if( item->m_Type == NET_PIN && item->m_Link )
         {
-            // Check if this pin has appeared before on a different net
-            if( item->m_Link )
+            auto ref = item->GetComponentParent()->GetRef( &item->m_SheetPath );
+            wxString pin_name = ref + "_" + item->m_PinNum;
+
+            if( pin_to_net_map.count( pin_name ) == 0 )
             {
-                auto ref = item->GetComponentParent()->GetRef( &item->m_SheetPath );
-                wxString pin_name = ref + "_" + item->m_PinNum;
+                pin_to_net_map[pin_name] = item->GetNetName();
+            }
+            else if( pin_to_net_map[pin_name] != item->GetNetName() )
+            {
+                SCH_MARKER* marker = new SCH_MARKER();
 
-                if( pin_to_net_map.count( pin_name ) == 0 )
-                {
-                    pin_to_net_map[pin_name] = item->GetNetName();
-                }
-                else if( pin_to_net_map[pin_name] != item->GetNetName() )
-                {
-                    SCH_MARKER* marker = new SCH_MARKER();
+                marker->SetTimeStamp( GetNewTimeStamp() );
+                marker->SetData( ERCE_DIFFERENT_UNIT_NET, item->m_Start,
+                    wxString::Format( _( "Pin %s on %s is connected to both %s and %s" ),
+                    item->m_PinNum, ref, pin_to_net_map[pin_name], item->GetNetName() ),
+                    item->m_Start );
+                marker->SetMarkerType( MARKER_BASE::MARKER_ERC );
+                marker->SetErrorLevel( MARKER_BASE::MARKER_SEVERITY_ERROR );
+
+                item->m_SheetPath.LastScreen()->Append( marker );
+            }
+        }
+    }
+
+    // Look for ERC problems between pins.  TestOthersItems() only modifies the items of the
+    // tested net, so the nets are tested in parallel.  The markers of each net are buffered
+    // and added to the screens in net order afterwards.
+    std::vector<ERC_MARKER_BUFFER> netMarkers( netRanges.size() );
+
+    size_t parallelThreadCount = std::min<size_t>( std::thread::hardware_concurrency(),
+            ( netRanges.size() + 3 ) / 4 );
 
-                    marker->SetTimeStamp( GetNewTimeStamp() );
-                    marker->SetData( ERCE_DIFFERENT_UNIT_NET, item->m_Start,
-                        wxString::Format( _( "Pin %s on %s is connected to both %s and %s" ),
-                        item->m_PinNum, ref, pin_to_net_map[pin_name], item->GetNetName() ),
-                        item->m_Start );
-                    marker->SetMarkerType( MARKER_BASE::MARKER_ERC );
-                    marker->SetErrorLevel( MARKER_BASE::MARKER_SEVERITY_ERROR );
+    std::atomic<size_t> nextNet( 0 );
+    std::vector<std::future<size_t>> returns( parallelThreadCount );
 
-                    item->m_SheetPath.LastScreen()->Append( marker );
+    auto pin_test_lambda = [&]() -> size_t
+    {
+        for( size_t netIdx = nextNet++; netIdx < netRanges.size(); netIdx = nextNet++ )
+        {
+            unsigned netStart = netRanges[netIdx].first;
+            int      minConn = NOC;
+
+            for( unsigned itemIdx = netStart; itemIdx < netRanges[netIdx].second; itemIdx++ )
+            {
+                if( objectsConnectedList->GetItemType( itemIdx ) == NET_PIN )
+                {
+                    TestOthersItems( objectsConnectedList.get(), itemIdx, netStart, &minConn,
+                                     &netMarkers[netIdx] );
                 }
             }
-
-            // Look for ERC problems between pins:
-            TestOthersItems( objectsConnectedList.get(), itemIdx, nextItemIdx, &MinConn );
-            break;
-        }
-        default:
-        break;
         }
 
-        lastItemIdx = itemIdx;
+        return 1;
+    };
+
+    if( parallelThreadCount == 1 )
+        pin_test_lambda();
+    else
+    {
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            returns[ii] = std::async( std::launch::async, pin_test_lambda );
+
+        // Finalize the threads
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            returns[ii].wait();
     }
 
+    for( auto& markers : netMarkers )
+        markers.Flush();
+
     // Test similar labels (i;e. labels which are identical when
     // using case insensitive comparisons)
     if( m_settings.check_similar_labels )
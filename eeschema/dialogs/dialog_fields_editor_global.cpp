@@ -36,6 +36,7 @@
 #include <class_library.h>
 #include <sch_edit_frame.h>
 #include <sch_reference_list.h>
+#include <sch_component_table.h>
 #include <tools/sch_editor_control.h>
 #include <kiface_i.h>
 #include <eda_doc.h>
@@ -187,14 +188,32 @@ protected:
 
 
 public:
-    FIELDS_EDITOR_GRID_DATA_MODEL( SCH_EDIT_FRAME* aFrame, SCH_REFERENCE_LIST& aComponentList ) :
+    FIELDS_EDITOR_GRID_DATA_MODEL( SCH_EDIT_FRAME* aFrame, const SCH_COMPONENT_TABLE& aTable ) :
             m_frame( aFrame ),
-            m_componentRefs( aComponentList ),
             m_edited( false ),
             m_sortColumn( 0 ),
             m_sortAscending( false )
     {
-        m_componentRefs.SplitReferences();
+        // The references of the table are already split, and its fields already read
+        for( unsigned row = 0; row < aTable.GetCount(); ++row )
+        {
+            SCH_REFERENCE ref = aTable.GetReference( row );
+
+            // Orphan components are not edited
+            if( !ref.GetLibPart() )
+                continue;
+
+            m_componentRefs.AddItem( ref );
+
+            std::map<wxString, wxString>& fieldStore = m_dataStore[ ref.GetComp()->GetTimeStamp() ];
+
+            // The first field of a given name wins, as in SCH_COMPONENT::GetFieldText()
+            for( int field = (int) aTable.GetFieldCount( row ) - 1; field >= 0; --field )
+            {
+                int column = aTable.GetFieldColumn( row, field );
+                fieldStore[ aTable.GetColumnName( column ) ] = aTable.GetFieldText( row, field );
+            }
+        }
     }
 
 
@@ -202,12 +221,12 @@ public:
     {
         m_fieldNames.push_back( aFieldName );
 
+        // Components without such a field have an empty value
         for( unsigned i = 0; i < m_componentRefs.GetCount(); ++i )
         {
-            SCH_COMPONENT* comp = m_componentRefs[ i ].GetComp();
-            timestamp_t compID = comp->GetTimeStamp();
+            timestamp_t compID = m_componentRefs[ i ].GetComp()->GetTimeStamp();
 
-            m_dataStore[ compID ][ aFieldName ] = comp->GetFieldText( aFieldName, m_frame );
+            m_dataStore[ compID ].emplace( aFieldName, wxEmptyString );
         }
     }
 
@@ -337,35 +356,72 @@ public:
     }
 
 
-    static bool cmp( const DATA_MODEL_ROW& lhGroup, const DATA_MODEL_ROW& rhGroup,
-                     FIELDS_EDITOR_GRID_DATA_MODEL* dataModel, int sortCol, bool ascending )
+    struct SORT_KEY
+    {
+        bool     m_Empty;
+        wxString m_Value;       ///< The value of the row in the sort column
+        wxString m_Ref;         ///< The reference of the first component of the row
+    };
+
+
+    static bool cmp( const SORT_KEY& lhKey, const SORT_KEY& rhKey, int sortCol, bool ascending )
     {
         // Empty rows always go to the bottom, whether ascending or descending
-        if( lhGroup.m_Refs.size() == 0 )
+        if( lhKey.m_Empty )
             return true;
-        else if( rhGroup.m_Refs.size() == 0 )
+        else if( rhKey.m_Empty )
             return false;
 
-        bool retVal;
+        // Descending order compares the other way round, so equal rows are never ordered
+        const SORT_KEY& lhs = ascending ? lhKey : rhKey;
+        const SORT_KEY& rhs = ascending ? rhKey : lhKey;
 
         // Primary sort key is sortCol; secondary is always REFERENCE (column 0)
 
-        wxString lhs = dataModel->GetValue( (DATA_MODEL_ROW&) lhGroup, sortCol );
-        wxString rhs = dataModel->GetValue( (DATA_MODEL_ROW&) rhGroup, sortCol );
+        if( lhs.m_Value == rhs.m_Value || sortCol == REFERENCE )
+            return UTIL::RefDesStringCompare( lhs.m_Ref, rhs.m_Ref ) < 0;
+        else
+            return ValueStringCompare( lhs.m_Value, rhs.m_Value ) < 0;
+    }
+
 
-        if( lhs == rhs || sortCol == REFERENCE )
+    /**
+     * Sorts \a aRows on the sort column.  The value of each row in the sort column is
+     * computed once, rather than for each comparison.
+     */
+    void sortRows( std::vector<DATA_MODEL_ROW>& aRows )
+    {
+        std::vector<SORT_KEY> keys( aRows.size() );
+        std::vector<size_t>   order( aRows.size() );
+
+        for( size_t i = 0; i < aRows.size(); ++i )
         {
-            wxString lhRef = lhGroup.m_Refs[ 0 ].GetRef() + lhGroup.m_Refs[ 0 ].GetRefNumber();
-            wxString rhRef = rhGroup.m_Refs[ 0 ].GetRef() + rhGroup.m_Refs[ 0 ].GetRefNumber();
-            retVal = UTIL::RefDesStringCompare( lhRef, rhRef ) < 0;
+            DATA_MODEL_ROW& row = aRows[ i ];
+
+            keys[ i ].m_Empty = row.m_Refs.empty();
+
+            if( !keys[ i ].m_Empty )
+            {
+                keys[ i ].m_Value = GetValue( row, m_sortColumn );
+                keys[ i ].m_Ref = row.m_Refs[ 0 ].GetRef() + row.m_Refs[ 0 ].GetRefNumber();
+            }
+
+            order[ i ] = i;
         }
-        else
-            retVal = ValueStringCompare( lhs, rhs ) < 0;
 
-        if( ascending )
-            return retVal;
-        else
-            return !retVal;
+        std::sort( order.begin(), order.end(),
+               [ & ]( size_t lhs, size_t rhs ) -> bool
+               {
+                   return cmp( keys[ lhs ], keys[ rhs ], m_sortColumn, m_sortAscending );
+               } );
+
+        std::vector<DATA_MODEL_ROW> sorted;
+        sorted.reserve( aRows.size() );
+
+        for( size_t i : order )
+            sorted.push_back( std::move( aRows[ i ] ) );
+
+        aRows.swap( sorted );
     }
 
 
@@ -378,13 +434,7 @@ public:
         m_sortAscending = ascending;
 
         CollapseForSort();
-
-        std::sort( m_rows.begin(), m_rows.end(),
-               [ this ]( const DATA_MODEL_ROW& lhs, const DATA_MODEL_ROW& rhs ) -> bool
-               {
-                   return cmp( lhs, rhs, this, m_sortColumn, m_sortAscending );
-               } );
-
+        sortRows( m_rows );
         ExpandAfterSort();
     }
 
@@ -400,41 +450,25 @@ public:
     }
 
 
-    bool groupMatch( const SCH_REFERENCE& lhRef, const SCH_REFERENCE& rhRef,
-                     wxDataViewListCtrl* fieldsCtrl )
+    /**
+     * @return the values of \a aRef compared to group the components: the reference prefix
+     * if grouping by reference, and the values of the other Group By fields.
+     */
+    std::vector<wxString> groupKey( const SCH_REFERENCE& aRef, bool aGroupByRef,
+                                    const std::vector<wxString>& aGroupFields )
     {
-        bool matchFound = false;
-
-        // First check the reference column.  This can be done directly out of the
-        // SCH_REFERENCEs as the references can't be edited in the grid.
-        if( fieldsCtrl->GetToggleValue( REFERENCE, GROUP_BY_COLUMN ) )
-        {
-            // if we're grouping by reference, then only the prefix must match
-            if( lhRef.GetRef() != rhRef.GetRef() )
-                return false;
-
-            matchFound = true;
-        }
-
-        timestamp_t lhRefID = lhRef.GetComp()->GetTimeStamp();
-        timestamp_t rhRefID = rhRef.GetComp()->GetTimeStamp();
-
-        // Now check all the other columns.  This must be done out of the dataStore
-        // for the refresh button to work after editing.
-        for( int i = REFERENCE + 1; i < fieldsCtrl->GetItemCount(); ++i )
-        {
-            if( !fieldsCtrl->GetToggleValue( i, GROUP_BY_COLUMN ) )
-                continue;
+        std::vector<wxString> key;
 
-            wxString fieldName = fieldsCtrl->GetTextValue( i, FIELD_NAME_COLUMN );
+        if( aGroupByRef )
+            key.push_back( aRef.GetRef() );
 
-            if( m_dataStore[ lhRefID ][ fieldName ] != m_dataStore[ rhRefID ][ fieldName ] )
-                return false;
+        // This must be done out of the dataStore for the refresh button to work after editing.
+        std::map<wxString, wxString>& fieldStore = m_dataStore[ aRef.GetComp()->GetTimeStamp() ];
 
-            matchFound = true;
-        }
+        for( const wxString& fieldName : aGroupFields )
+            key.push_back( fieldStore[ fieldName ] );
 
-        return matchFound;
+        return key;
     }
 
 
@@ -452,34 +486,73 @@ public:
 
         m_rows.clear();
 
+        // Two components are grouped if at least one Group By column is checked and they
+        // match on all the checked columns.  If grouping by reference, only the reference
+        // prefix must match.
+        bool                  groupByRef = fieldsCtrl->GetToggleValue( REFERENCE, GROUP_BY_COLUMN );
+        std::vector<wxString> groupFields;
+
+        for( int i = REFERENCE + 1; i < fieldsCtrl->GetItemCount(); ++i )
+        {
+            if( fieldsCtrl->GetToggleValue( i, GROUP_BY_COLUMN ) )
+                groupFields.push_back( fieldsCtrl->GetTextValue( i, FIELD_NAME_COLUMN ) );
+        }
+
+        bool grouping = groupComponentsBox->GetValue() && ( groupByRef || !groupFields.empty() );
+
+        // The first row whose first component is a unit of a given reference, and the first
+        // row whose first component has a given group key.  All group members must have
+        // identical refs, so a component fits into the first of these rows.
+        std::map<std::pair<wxString, wxString>, size_t> unitRows;
+        std::map<std::vector<wxString>, size_t>         groupRows;
+
         for( unsigned i = 0; i < m_componentRefs.GetCount(); ++i )
         {
-            SCH_REFERENCE ref = m_componentRefs[ i ];
-            bool matchFound = false;
+            SCH_REFERENCE         ref = m_componentRefs[ i ];
+            size_t                unitRow = m_rows.size();
+            size_t                groupRow = m_rows.size();
+            std::vector<wxString> key;
+
+            // See if we already have a row which this component fits into (see unitMatch())
+            std::pair<wxString, wxString> unit( ref.GetRef(), ref.GetRefNumber() );
 
-            // See if we already have a row which this component fits into
-            for( auto& row : m_rows )
+            if( unit.second != wxT( "?" ) )
             {
-                // all group members must have identical refs so just use the first one
-                SCH_REFERENCE rowRef = row.m_Refs[ 0 ];
+                auto it = unitRows.find( unit );
 
-                if( unitMatch( ref, rowRef ) )
-                {
-                    matchFound = true;
-                    row.m_Refs.push_back( ref );
-                    break;
-                }
-                else if (groupComponentsBox->GetValue() && groupMatch( ref, rowRef, fieldsCtrl ) )
-                {
-                    matchFound = true;
-                    row.m_Refs.push_back( ref );
-                    row.m_Flag = GROUP_COLLAPSED;
-                    break;
-                }
+                if( it != unitRows.end() )
+                    unitRow = it->second;
             }
 
-            if( !matchFound )
+            if( grouping )
+            {
+                key = groupKey( ref, groupByRef, groupFields );
+
+                auto it = groupRows.find( key );
+
+                if( it != groupRows.end() )
+                    groupRow = it->second;
+            }
+
+            if( unitRow < m_rows.size() && unitRow <= groupRow )
+            {
+                m_rows[ unitRow ].m_Refs.push_back( ref );
+            }
+            else if( groupRow < m_rows.size() )
+            {
+                m_rows[ groupRow ].m_Refs.push_back( ref );
+                m_rows[ groupRow ].m_Flag = GROUP_COLLAPSED;
+            }
+            else
+            {
+                if( unit.second != wxT( "?" ) )
+                    unitRows.emplace( unit, m_rows.size() );
+
+                if( grouping )
+                    groupRows.emplace( key, m_rows.size() );
+
                 m_rows.emplace_back( DATA_MODEL_ROW( ref, GROUP_SINGLETON ) );
+            }
         }
 
         if ( GetView() )
@@ -518,11 +591,7 @@ public:
         if( children.size() < 2 )
             return;
 
-        std::sort( children.begin(), children.end(),
-                   [ this ] ( const DATA_MODEL_ROW& lhs, const DATA_MODEL_ROW& rhs ) -> bool
-                   {
-                       return cmp( lhs, rhs, this, m_sortColumn, m_sortAscending );
-                   } );
+        sortRows( children );
 
         m_rows[ aRow ].m_Flag = GROUP_EXPANDED;
         m_rows.insert( m_rows.begin() + aRow + 1, children.begin(), children.end() );
@@ -669,9 +738,8 @@ DIALOG_FIELDS_EDITOR_GLOBAL::DIALOG_FIELDS_EDITOR_GLOBAL( SCH_EDIT_FRAME* parent
 {
     wxSize defaultDlgSize = ConvertDialogToPixels( wxSize( 600, 300 ) );
 
-    // Get all components from the list of schematic sheets
-    SCH_SHEET_LIST sheets( g_RootSheet );
-    sheets.GetComponents( m_componentRefs, false );
+    // Get all components and their fields from the component table of the schematic
+    const SCH_COMPONENT_TABLE& componentTable = m_parent->GetComponentTable();
 
     m_bRefresh->SetBitmap( KiBitmap( refresh_xpm ) );
 
@@ -695,9 +763,10 @@ DIALOG_FIELDS_EDITOR_GLOBAL::DIALOG_FIELDS_EDITOR_GLOBAL( SCH_EDIT_FRAME* parent
     // expander buttons... but it doesn't.  Fix by forcing the indent to 0.
     m_fieldsCtrl->SetIndent( 0 );
 
-    m_dataModel = new FIELDS_EDITOR_GRID_DATA_MODEL( m_parent, m_componentRefs );
+    m_dataModel = new FIELDS_EDITOR_GRID_DATA_MODEL( m_parent, componentTable );
 
-    LoadFieldNames();   // loads rows into m_fieldsCtrl and columns into m_dataModel
+    // loads rows into m_fieldsCtrl and columns into m_dataModel
+    LoadFieldNames( componentTable );
 
     // Now that the fields are loaded we can set the initial location of the splitter
     // based on the list width.  Again, SetWidth( wxCOL_WIDTH_AUTOSIZE ) fails us on GTK.
@@ -816,6 +885,11 @@ bool DIALOG_FIELDS_EDITOR_GLOBAL::TransferDataFromWindow()
     SCH_SHEET_PATH currentSheet = m_parent->GetCurrentSheet();
 
     m_dataModel->ApplyData();
+
+    // The fields of the components of all the sheets may have changed
+    SCH_SCREENS screens;
+    screens.InvalidateItemIndexes();
+
     m_parent->SyncView();
     m_parent->OnModify();
 
@@ -849,18 +923,24 @@ void DIALOG_FIELDS_EDITOR_GLOBAL::AddField( const wxString& aName,
  * Constructs the rows of m_fieldsCtrl and the columns of m_dataModel from a union of all
  * field names in use.
  */
-void DIALOG_FIELDS_EDITOR_GLOBAL::LoadFieldNames()
+void DIALOG_FIELDS_EDITOR_GLOBAL::LoadFieldNames( const SCH_COMPONENT_TABLE& aTable )
 {
+    std::set<int>      userColumns;
     std::set<wxString> userFieldNames;
 
-    for( unsigned i = 0; i < m_componentRefs.GetCount(); ++i )
+    for( unsigned row = 0; row < aTable.GetCount(); ++row )
     {
-        SCH_COMPONENT* comp = m_componentRefs[ i ].GetComp();
+        // Orphan components are not edited
+        if( !aTable.GetReference( row ).GetLibPart() )
+            continue;
 
-        for( int j = MANDATORY_FIELDS; j < comp->GetFieldCount(); ++j )
-            userFieldNames.insert( comp->GetField( j )->GetName() );
+        for( unsigned j = MANDATORY_FIELDS; j < aTable.GetFieldCount( row ); ++j )
+            userColumns.insert( aTable.GetFieldColumn( row, j ) );
     }
 
+    for( int column : userColumns )
+        userFieldNames.insert( aTable.GetColumnName( column ) );
+
     // Force References to always be shown
     m_config->Write( "SymbolFieldEditor/Show/Reference", true );
 
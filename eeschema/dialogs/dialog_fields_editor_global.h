@@ -27,9 +27,9 @@
 
 
 #include <dialog_fields_editor_global_base.h>
-#include <sch_reference_list.h>
 
 
+class SCH_COMPONENT_TABLE;
 class SCH_EDIT_FRAME;
 class FIELDS_EDITOR_GRID_DATA_MODEL;
 
@@ -48,11 +48,10 @@ private:
     int                            m_showColWidth;
     int                            m_groupByColWidth;
 
-    SCH_REFERENCE_LIST             m_componentRefs;
     FIELDS_EDITOR_GRID_DATA_MODEL* m_dataModel;
 
     void AddField( const wxString& aName, bool defaultShow, bool defaultSortBy );
-    void LoadFieldNames();
+    void LoadFieldNames( const SCH_COMPONENT_TABLE& aTable );
 
     void OnColSort( wxGridEvent& aEvent );
 
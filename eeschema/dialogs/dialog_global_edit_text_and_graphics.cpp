@@ -349,6 +349,8 @@ bool DIALOG_GLOBAL_EDIT_TEXT_AND_GRAPHICS::TransferDataFromWindow()
         {
             for( SCH_ITEM* item = screen->GetDrawItems(); item; item = item->Next() )
                 visitItem( sheetPath, item );
+
+            screen->InvalidateItemIndex();
         }
     }
 
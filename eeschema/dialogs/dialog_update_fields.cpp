@@ -80,7 +80,10 @@ bool DIALOG_UPDATE_FIELDS::TransferDataFromWindow()
 
     // Do it!
     for( auto component : m_components )
+    {
         updateFields( component );
+        m_frame->UpdateItemIndex( component );
+    }
 
     m_frame->SyncView();
     m_frame->GetCanvas()->Refresh();
@@ -338,7 +338,28 @@ int TestMultiunitFootprints( SCH_SHEET_LIST& aSheetList )
 }
 
 
-void Diagnose( NETLIST_OBJECT* aNetItemRef, NETLIST_OBJECT* aNetItemTst, int aMinConn, int aDiag )
+ERC_MARKER_BUFFER::~ERC_MARKER_BUFFER()
+{
+    // Markers not flushed to a screen are still owned by the buffer
+    for( auto& entry : m_markers )
+        delete entry.second;
+}
+
+
+void ERC_MARKER_BUFFER::Flush()
+{
+    for( auto& entry : m_markers )
+    {
+        entry.second->SetTimeStamp( GetNewTimeStamp() );
+        entry.first->Append( entry.second );
+    }
+
+    m_markers.clear();
+}
+
+
+void Diagnose( NETLIST_OBJECT* aNetItemRef, NETLIST_OBJECT* aNetItemTst, int aMinConn, int aDiag,
+               ERC_MARKER_BUFFER* aMarkers )
 {
     SCH_MARKER*     marker = NULL;
     SCH_SCREEN*     screen;
@@ -349,12 +370,20 @@ void Diagnose( NETLIST_OBJECT* aNetItemRef, NETLIST_OBJECT* aNetItemTst, int aMi
 
     /* Create new marker for ERC error. */
     marker = new SCH_MARKER();
-    marker->SetTimeStamp( GetNewTimeStamp() );
 
     marker->SetMarkerType( MARKER_BASE::MARKER_ERC );
     marker->SetErrorLevel( MARKER_BASE::MARKER_SEVERITY_WARNING );
     screen = aNetItemRef->m_SheetPath.LastScreen();
-    screen->Append( marker );
+
+    if( aMarkers )
+    {
+        aMarkers->Add( screen, marker );
+    }
+    else
+    {
+        marker->SetTimeStamp( GetNewTimeStamp() );
+        screen->Append( marker );
+    }
 
     wxString msg;
 
@@ -415,7 +444,7 @@ void Diagnose( NETLIST_OBJECT* aNetItemRef, NETLIST_OBJECT* aNetItemTst, int aMi
 
 
 void TestOthersItems( NETLIST_OBJECT_LIST* aList, unsigned aNetItemRef, unsigned aNetStart,
-                      int* aMinConnexion )
+                      int* aMinConnexion, ERC_MARKER_BUFFER* aMarkers )
 {
     unsigned netItemTst = aNetStart;
     ELECTRICAL_PINTYPE jj;
@@ -490,7 +519,7 @@ void TestOthersItems( NETLIST_OBJECT_LIST* aList, unsigned aNetItemRef, unsigned
                 }
 
                 if( seterr )
-                    Diagnose( aList->GetItem( aNetItemRef ), NULL, local_minconn, WAR );
+                    Diagnose( aList->GetItem( aNetItemRef ), NULL, local_minconn, WAR, aMarkers );
 
                 *aMinConnexion = DRV;   // inhibiting other messages of this
                                        // type for the net.
@@ -536,7 +565,7 @@ void TestOthersItems( NETLIST_OBJECT_LIST* aList, unsigned aNetItemRef, unsigned
                     {
                         Diagnose( aList->GetItem( aNetItemRef ),
                                   aList->GetItem( netItemTst ),
-                                  0, erc );
+                                  0, erc, aMarkers );
                         aList->SetConnectionType( netItemTst, NOCONNECT_SYMBOL_PRESENT );
                     }
                 }
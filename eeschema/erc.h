@@ -30,9 +30,14 @@
 #ifndef _ERC_H
 #define _ERC_H
 
+#include <utility>
+#include <vector>
+
 
 class NETLIST_OBJECT;
 class NETLIST_OBJECT_LIST;
+class SCH_MARKER;
+class SCH_SCREEN;
 class SCH_SHEET_LIST;
 
 /* For ERC markers: error types (used in diags, and to set the color):
@@ -82,6 +87,39 @@ enum ERCE_T
 #define NOC    0  // initial state of a net: no connection
 
 
+/**
+ * ERC_MARKER_BUFFER
+ * collects the markers created by ERC checks that run on worker threads.
+ *
+ * Appending to a SCH_SCREEN (and GetNewTimeStamp()) is not thread safe, so the checks only
+ * buffer their markers; Flush() then adds them to their screens from the calling thread.
+ * Flushing the buffers in a fixed order keeps the result independent of the thread count.
+ */
+class ERC_MARKER_BUFFER
+{
+public:
+    ERC_MARKER_BUFFER() {}
+    ERC_MARKER_BUFFER( const ERC_MARKER_BUFFER& ) = delete;
+    ERC_MARKER_BUFFER& operator=( const ERC_MARKER_BUFFER& ) = delete;
+
+    ~ERC_MARKER_BUFFER();
+
+    void Add( SCH_SCREEN* aScreen, SCH_MARKER* aMarker )
+    {
+        m_markers.emplace_back( aScreen, aMarker );
+    }
+
+    /**
+     * Timestamps the buffered markers and appends them to their screens, in the order
+     * they were added.
+     */
+    void Flush();
+
+private:
+    std::vector<std::pair<SCH_SCREEN*, SCH_MARKER*>> m_markers;
+};
+
+
 /**
  * Function WriteDiagnosticERC
  * save the ERC errors to \a aFullFileName.
@@ -94,9 +132,10 @@ bool WriteDiagnosticERC( EDA_UNITS_T aUnits, const wxString& aFullFileName );
  * Performs ERC testing and creates an ERC marker to show the ERC problem for aNetItemRef
  * or between aNetItemRef and aNetItemTst.
  *  if MinConn < 0: this is an error on labels
+ * The marker is added to \a aMarkers if given, otherwise directly to the screen.
  */
 void Diagnose( NETLIST_OBJECT* NetItemRef, NETLIST_OBJECT* NetItemTst,
-                      int MinConnexion, int Diag );
+                      int MinConnexion, int Diag, ERC_MARKER_BUFFER* aMarkers = nullptr );
 
 /**
  * Perform ERC testing for electrical conflicts between \a NetItemRef and other items
@@ -106,10 +145,13 @@ void Diagnose( NETLIST_OBJECT* NetItemRef, NETLIST_OBJECT* NetItemTst,
  * @param aNetStart = index in list of net objects of the first item
  * @param aMinConnexion = a pointer to a variable to store the minimal connection
  * found( NOD, DRV, NPI, NET_NC)
+ * @param aMarkers = the buffer receiving the markers, or nullptr to add them to the screens.
+ * Only the items of the net of \a aNetItemRef are modified, so different nets can be
+ * tested concurrently when the markers are buffered.
  */
 void TestOthersItems( NETLIST_OBJECT_LIST* aList,
                              unsigned aNetItemRef, unsigned aNetStart,
-                             int* aMinConnexion );
+                             int* aMinConnexion, ERC_MARKER_BUFFER* aMarkers = nullptr );
 
 /**
  * Function TestDuplicateSheetNames( )
@@ -30,11 +30,14 @@
 #include <class_library.h>
 #include <connection_graph.h>
 #include <refdes_utils.h>
+#include <sch_component_table.h>
 
 #include <class_library.h>
 #include <sch_base_frame.h>
 #include <symbol_lib_table.h>
 
+#include "netlist_writer.h"
+
 
 static bool sortPinsByNumber( LIB_PIN* aPin1, LIB_PIN* aPin2 );
 
@@ -55,28 +58,37 @@ bool NETLIST_EXPORTER_GENERIC::WriteNetlist( const wxString& aOutFileName, unsig
 
 XNODE* NETLIST_EXPORTER_GENERIC::makeRoot( int aCtl )
 {
-    XNODE*      xroot = node( "export" );
+    XNODE_NETLIST_WRITER writer;
+
+    writeRoot( writer, aCtl );
+
+    return writer.ReleaseRoot();
+}
 
-    xroot->AddAttribute( "version", "D" );
+
+void NETLIST_EXPORTER_GENERIC::writeRoot( NETLIST_WRITER& aWriter, int aCtl )
+{
+    aWriter.StartElement( "export" );
+    aWriter.AddAttribute( "version", "D" );
 
     if( aCtl & GNL_HEADER )
         // add the "design" header
-        xroot->AddChild( makeDesignHeader() );
+        writeDesignHeader( aWriter );
 
     if( aCtl & GNL_COMPONENTS )
-        xroot->AddChild( makeComponents() );
+        writeComponents( aWriter );
 
     if( aCtl & GNL_PARTS )
-        xroot->AddChild( makeLibParts() );
+        writeLibParts( aWriter );
 
     if( aCtl & GNL_LIBRARIES )
-        // must follow makeGenericLibParts()
-        xroot->AddChild( makeLibraries() );
+        // must follow writeLibParts()
+        writeLibraries( aWriter );
 
     if( aCtl & GNL_NETS )
-        xroot->AddChild( makeListOfNets() );
+        writeListOfNets( aWriter );
 
-    return xroot;
+    aWriter.EndElement();
 }
 
 
@@ -91,9 +103,12 @@ struct COMP_FIELDS
 };
 
 
-void NETLIST_EXPORTER_GENERIC::addComponentFields( XNODE* xcomp, SCH_COMPONENT* comp, SCH_SHEET_PATH* aSheet )
+void NETLIST_EXPORTER_GENERIC::addComponentFields( NETLIST_WRITER& aWriter,
+                                                   const SCH_COMPONENT_TABLE& aTable,
+                                                   unsigned aRow, const wxString& aRef )
 {
-    COMP_FIELDS fields;
+    COMP_FIELDS    fields;
+    SCH_COMPONENT* comp = aTable.GetReference( aRow ).GetComp();
 
     if( comp->GetUnitCount() > 1 )
     {
@@ -104,186 +119,187 @@ void NETLIST_EXPORTER_GENERIC::addComponentFields( XNODE* xcomp, SCH_COMPONENT*
         // any non blank fields in all units and use the first non-blank field
         // for each unique field name.
 
-        wxString    ref = comp->GetRef( aSheet );
-
-        SCH_SHEET_LIST sheetList( g_RootSheet );
         int minUnit = comp->GetUnit();
 
-        for( unsigned i = 0;  i < sheetList.size();  i++ )
+        // The components having this reference, in schematic order
+        for( unsigned row : aTable.GetUnitRows( aRef ) )
         {
-            for( EDA_ITEM* item = sheetList[i].LastDrawList();  item;  item = item->Next() )
-            {
-                if( item->Type() != SCH_COMPONENT_T )
-                    continue;
-
-                SCH_COMPONENT*  comp2 = (SCH_COMPONENT*) item;
-
-                wxString ref2 = comp2->GetRef( &sheetList[i] );
+            int unit = aTable.GetReference( row ).GetComp()->GetUnit();
 
-                if( ref2.CmpNoCase( ref ) != 0 )
-                    continue;
+            // The lowest unit number wins.  User should only set fields in any one unit.
+            // remark: an empty text is a void field (see SCH_FIELD::IsVoid())
+            const wxString& value = aTable.GetFieldText( row, VALUE );
 
-                int unit = comp2->GetUnit();
+            if( !value.IsEmpty() && ( unit < minUnit || fields.value.IsEmpty() ) )
+                fields.value = value;
 
-                // The lowest unit number wins.  User should only set fields in any one unit.
-                // remark: IsVoid() returns true for empty strings or the "~" string (empty field value)
-                if( !comp2->GetField( VALUE )->IsVoid()
-                        && ( unit < minUnit || fields.value.IsEmpty() ) )
-                    fields.value = comp2->GetField( VALUE )->GetText();
+            const wxString& footprint = aTable.GetFieldText( row, FOOTPRINT );
 
-                if( !comp2->GetField( FOOTPRINT )->IsVoid()
-                        && ( unit < minUnit || fields.footprint.IsEmpty() ) )
-                    fields.footprint = comp2->GetField( FOOTPRINT )->GetText();
+            if( !footprint.IsEmpty() && ( unit < minUnit || fields.footprint.IsEmpty() ) )
+                fields.footprint = footprint;
 
-                if( !comp2->GetField( DATASHEET )->IsVoid()
-                        && ( unit < minUnit || fields.datasheet.IsEmpty() ) )
-                    fields.datasheet = comp2->GetField( DATASHEET )->GetText();
+            const wxString& datasheet = aTable.GetFieldText( row, DATASHEET );
 
-                for( int fldNdx = MANDATORY_FIELDS;  fldNdx < comp2->GetFieldCount();  ++fldNdx )
-                {
-                    SCH_FIELD* f = comp2->GetField( fldNdx );
+            if( !datasheet.IsEmpty() && ( unit < minUnit || fields.datasheet.IsEmpty() ) )
+                fields.datasheet = datasheet;
 
-                    if( f->GetText().size()
-                        && ( unit < minUnit || fields.f.count( f->GetName() ) == 0 ) )
-                    {
-                        fields.f[ f->GetName() ] = f->GetText();
-                    }
-                }
+            for( unsigned fldNdx = MANDATORY_FIELDS;  fldNdx < aTable.GetFieldCount( row );
+                 ++fldNdx )
+            {
+                const wxString& name = aTable.GetColumnName( aTable.GetFieldColumn( row, fldNdx ) );
+                const wxString& text = aTable.GetFieldText( row, fldNdx );
 
-                minUnit = std::min( unit, minUnit );
+                if( text.size() && ( unit < minUnit || fields.f.count( name ) == 0 ) )
+                    fields.f[ name ] = text;
             }
+
+            minUnit = std::min( unit, minUnit );
         }
 
     }
     else
     {
-        fields.value = comp->GetField( VALUE )->GetText();
-        fields.footprint = comp->GetField( FOOTPRINT )->GetText();
-        fields.datasheet = comp->GetField( DATASHEET )->GetText();
+        fields.value = aTable.GetFieldText( aRow, VALUE );
+        fields.footprint = aTable.GetFieldText( aRow, FOOTPRINT );
+        fields.datasheet = aTable.GetFieldText( aRow, DATASHEET );
 
-        for( int fldNdx = MANDATORY_FIELDS; fldNdx < comp->GetFieldCount(); ++fldNdx )
+        for( unsigned fldNdx = MANDATORY_FIELDS; fldNdx < aTable.GetFieldCount( aRow ); ++fldNdx )
         {
-            SCH_FIELD*  f = comp->GetField( fldNdx );
+            const wxString& text = aTable.GetFieldText( aRow, fldNdx );
 
-            if( f->GetText().size() )
-                fields.f[ f->GetName() ] = f->GetText();
+            if( text.size() )
+                fields.f[ aTable.GetColumnName( aTable.GetFieldColumn( aRow, fldNdx ) ) ] = text;
         }
     }
 
     // Do not output field values blank in netlist:
     if( fields.value.size() )
-        xcomp->AddChild( node( "value", fields.value ) );
+        aWriter.AddElement( "value", fields.value );
     else    // value field always written in netlist
-        xcomp->AddChild( node( "value", "~" ) );
+        aWriter.AddElement( "value", "~" );
 
     if( fields.footprint.size() )
-        xcomp->AddChild( node( "footprint", fields.footprint ) );
+        aWriter.AddElement( "footprint", fields.footprint );
 
     if( fields.datasheet.size() )
-        xcomp->AddChild( node( "datasheet", fields.datasheet ) );
+        aWriter.AddElement( "datasheet", fields.datasheet );
 
     if( fields.f.size() )
     {
-        XNODE* xfields;
-        xcomp->AddChild( xfields = node( "fields" ) );
+        aWriter.StartElement( "fields" );
 
         // non MANDATORY fields are output alphabetically
         for( std::map< wxString, wxString >::const_iterator it = fields.f.begin();
              it != fields.f.end();  ++it )
         {
-            XNODE*  xfield;
-            xfields->AddChild( xfield = node( "field", it->second ) );
-            xfield->AddAttribute( "name", it->first );
+            aWriter.StartElement( "field" );
+            aWriter.AddAttribute( "name", it->first );
+            aWriter.AddContent( it->second );
+            aWriter.EndElement();
         }
+
+        aWriter.EndElement();
     }
 
 }
 
 
-XNODE* NETLIST_EXPORTER_GENERIC::makeComponents()
+void NETLIST_EXPORTER_GENERIC::writeComponents( NETLIST_WRITER& aWriter )
 {
-    XNODE*      xcomps = node( "components" );
+    aWriter.StartElement( "components" );
 
     wxString    timeStamp;
 
     m_ReferencesAlreadyFound.Clear();
 
-    SCH_SHEET_LIST sheetList( g_RootSheet );
+    // The component instances and their fields are read from the component table of the
+    // frame.  Its rows are in schematic order and have no power symbols.  The fields are
+    // checked again so that a change made without OnModify() is never exported, but only
+    // the components whose fields changed are read again.  Without a frame, a table is
+    // built for this export.
+    SCH_COMPONENT_TABLE localTable;
+
+    if( !m_frame )
+        localTable.Update( g_RootSheet );
+
+    const SCH_COMPONENT_TABLE& table = m_frame ? m_frame->GetComponentTable( true ) : localTable;
 
     // Output is xml, so there is no reason to remove spaces from the field values.
     // And XML element names need not be translated to various languages.
 
-    for( unsigned i = 0;  i < sheetList.size();  i++ )
+    for( unsigned row = 0;  row < table.GetCount();  row++ )
     {
-        for( EDA_ITEM* schItem = sheetList[i].LastDrawList();  schItem;  schItem = schItem->Next() )
-        {
-            SCH_COMPONENT*  comp = findNextComponent( schItem, &sheetList[i] );
+        const SCH_REFERENCE&  reference = table.GetReference( row );
+        SCH_COMPONENT*        comp = reference.GetComp();
+        const SCH_SHEET_PATH& sheet = reference.GetSheetPath();
+        LIB_PART*             part = reference.GetLibPart();
 
-            if( !comp )
-                break;  // No component left
+        // Same components as findNextComponent(): no orphan components, and only the first
+        // unit of the multi-unit components
+        if( !part )
+            continue;
 
-            schItem = comp;
+        wxString ref = comp->GetRef( &sheet );
 
-            XNODE* xcomp;  // current component being constructed
+        if( part->GetUnitCount() > 1 && m_ReferencesAlreadyFound.Lookup( ref ) )
+            continue;
 
-            // Output the component's elements in order of expected access frequency.
-            // This may not always look best, but it will allow faster execution
-            // under XSL processing systems which do sequential searching within
-            // an element.
+        // record the usage of this library component entry.
+        m_LibParts.insert( part );     // rejects non-unique pointers
 
-            xcomps->AddChild( xcomp = node( "comp" ) );
-            xcomp->AddAttribute( "ref", comp->GetRef( &sheetList[i] ) );
+        // Output the component's elements in order of expected access frequency.
+        // This may not always look best, but it will allow faster execution
+        // under XSL processing systems which do sequential searching within
+        // an element.
 
-            addComponentFields( xcomp, comp, &sheetList[i] );
+        aWriter.StartElement( "comp" );
+        aWriter.AddAttribute( "ref", ref );
 
-            XNODE*  xlibsource;
-            xcomp->AddChild( xlibsource = node( "libsource" ) );
+        addComponentFields( aWriter, table, row, ref );
 
-            // "logical" library name, which is in anticipation of a better search
-            // algorithm for parts based on "logical_lib.part" and where logical_lib
-            // is merely the library name minus path and extension.
-            PART_SPTR part = comp->GetPartRef().lock();
+        aWriter.StartElement( "libsource" );
 
-            if( part )
-                xlibsource->AddAttribute( "lib", part->GetLibId().GetLibNickname() );
+        // "logical" library name, which is in anticipation of a better search
+        // algorithm for parts based on "logical_lib.part" and where logical_lib
+        // is merely the library name minus path and extension.
+        aWriter.AddAttribute( "lib", part->GetLibId().GetLibNickname() );
 
-            // We only want the symbol name, not the full LIB_ID.
-            xlibsource->AddAttribute( "part", comp->GetLibId().GetLibItemName() );
+        // We only want the symbol name, not the full LIB_ID.
+        aWriter.AddAttribute( "part", comp->GetLibId().GetLibItemName() );
 
-            xlibsource->AddAttribute( "description", comp->GetDescription() );
+        aWriter.AddAttribute( "description", comp->GetDescription() );
+        aWriter.EndElement();
 
-            XNODE* xsheetpath;
+        aWriter.StartElement( "sheetpath" );
+        aWriter.AddAttribute( "names", sheet.PathHumanReadable() );
+        aWriter.AddAttribute( "tstamps", sheet.Path() );
+        aWriter.EndElement();
 
-            xcomp->AddChild( xsheetpath = node( "sheetpath" ) );
-            xsheetpath->AddAttribute( "names", sheetList[i].PathHumanReadable() );
-            xsheetpath->AddAttribute( "tstamps", sheetList[i].Path() );
+        timeStamp.Printf( "%8.8lX", (unsigned long)comp->GetTimeStamp() );
+        aWriter.AddElement( "tstamp", timeStamp );
 
-            timeStamp.Printf( "%8.8lX", (unsigned long)comp->GetTimeStamp() );
-            xcomp->AddChild( node( "tstamp", timeStamp ) );
-        }
+        aWriter.EndElement();
     }
 
-    return xcomps;
+    aWriter.EndElement();
 }
 
 
-XNODE* NETLIST_EXPORTER_GENERIC::makeDesignHeader()
+void NETLIST_EXPORTER_GENERIC::writeDesignHeader( NETLIST_WRITER& aWriter )
 {
     SCH_SCREEN* screen;
-    XNODE*     xdesign = node( "design" );
-    XNODE*     xtitleBlock;
-    XNODE*     xsheet;
-    XNODE*     xcomment;
     wxString   sheetTxt;
     wxFileName sourceFileName;
 
+    aWriter.StartElement( "design" );
+
     // the root sheet is a special sheet, call it source
-    xdesign->AddChild( node( "source", g_RootSheet->GetScreen()->GetFileName() ) );
+    aWriter.AddElement( "source", g_RootSheet->GetScreen()->GetFileName() );
 
-    xdesign->AddChild( node( "date", DateAndTime() ) );
+    aWriter.AddElement( "date", DateAndTime() );
 
     // which Eeschema tool
-    xdesign->AddChild( node( "tool", wxString( "Eeschema " ) + GetBuildVersion() ) );
+    aWriter.AddElement( "tool", wxString( "Eeschema " ) + GetBuildVersion() );
 
     /*
         Export the sheets information
@@ -294,97 +310,74 @@ XNODE* NETLIST_EXPORTER_GENERIC::makeDesignHeader()
     {
         screen = sheetList[i].LastScreen();
 
-        xdesign->AddChild( xsheet = node( "sheet" ) );
+        aWriter.StartElement( "sheet" );
 
         // get the string representation of the sheet index number.
         // Note that sheet->GetIndex() is zero index base and we need to increment the
         // number by one to make it human readable
         sheetTxt.Printf( "%u", i + 1 );
-        xsheet->AddAttribute( "number", sheetTxt );
-        xsheet->AddAttribute( "name", sheetList[i].PathHumanReadable() );
-        xsheet->AddAttribute( "tstamps", sheetList[i].Path() );
+        aWriter.AddAttribute( "number", sheetTxt );
+        aWriter.AddAttribute( "name", sheetList[i].PathHumanReadable() );
+        aWriter.AddAttribute( "tstamps", sheetList[i].Path() );
 
 
         TITLE_BLOCK tb = screen->GetTitleBlock();
 
-        xsheet->AddChild( xtitleBlock = node( "title_block" ) );
+        aWriter.StartElement( "title_block" );
 
-        xtitleBlock->AddChild( node( "title", tb.GetTitle() ) );
-        xtitleBlock->AddChild( node( "company", tb.GetCompany() ) );
-        xtitleBlock->AddChild( node( "rev", tb.GetRevision() ) );
-        xtitleBlock->AddChild( node( "date", tb.GetDate() ) );
+        aWriter.AddElement( "title", tb.GetTitle() );
+        aWriter.AddElement( "company", tb.GetCompany() );
+        aWriter.AddElement( "rev", tb.GetRevision() );
+        aWriter.AddElement( "date", tb.GetDate() );
 
         // We are going to remove the fileName directories.
         sourceFileName = wxFileName( screen->GetFileName() );
-        xtitleBlock->AddChild( node( "source", sourceFileName.GetFullName() ) );
-
-        xtitleBlock->AddChild( xcomment = node( "comment" ) );
-        xcomment->AddAttribute( "number", "1" );
-        xcomment->AddAttribute( "value", tb.GetComment( 0 ) );
-
-        xtitleBlock->AddChild( xcomment = node( "comment" ) );
-        xcomment->AddAttribute( "number", "2" );
-        xcomment->AddAttribute( "value", tb.GetComment( 1 ) );
+        aWriter.AddElement( "source", sourceFileName.GetFullName() );
 
-        xtitleBlock->AddChild( xcomment = node( "comment" ) );
-        xcomment->AddAttribute( "number", "3" );
-        xcomment->AddAttribute( "value", tb.GetComment( 2 ) );
-
-        xtitleBlock->AddChild( xcomment = node( "comment" ) );
-        xcomment->AddAttribute( "number", "4" );
-        xcomment->AddAttribute( "value", tb.GetComment( 3 ) );
-
-        xtitleBlock->AddChild( xcomment = node( "comment" ) );
-        xcomment->AddAttribute( "number", "5" );
-        xcomment->AddAttribute( "value", tb.GetComment( 4 ) );
-
-        xtitleBlock->AddChild( xcomment = node( "comment" ) );
-        xcomment->AddAttribute( "number", "6" );
-        xcomment->AddAttribute( "value", tb.GetComment( 5 ) );
-
-        xtitleBlock->AddChild( xcomment = node( "comment" ) );
-        xcomment->AddAttribute( "number", "7" );
-        xcomment->AddAttribute( "value", tb.GetComment( 6 ) );
+        for( int ii = 0; ii < 9; ii++ )
+        {
+            sheetTxt.Printf( "%d", ii + 1 );
 
-        xtitleBlock->AddChild( xcomment = node( "comment" ) );
-        xcomment->AddAttribute( "number", "8" );
-        xcomment->AddAttribute( "value", tb.GetComment( 7 ) );
+            aWriter.StartElement( "comment" );
+            aWriter.AddAttribute( "number", sheetTxt );
+            aWriter.AddAttribute( "value", tb.GetComment( ii ) );
+            aWriter.EndElement();
+        }
 
-        xtitleBlock->AddChild( xcomment = node( "comment" ) );
-        xcomment->AddAttribute( "number", "9" );
-        xcomment->AddAttribute( "value", tb.GetComment( 8 ) );
+        aWriter.EndElement();   // title_block
+        aWriter.EndElement();   // sheet
     }
 
-    return xdesign;
+    aWriter.EndElement();
 }
 
 
-XNODE* NETLIST_EXPORTER_GENERIC::makeLibraries()
+void NETLIST_EXPORTER_GENERIC::writeLibraries( NETLIST_WRITER& aWriter )
 {
-    XNODE*  xlibs = node( "libraries" );     // auto_ptr
+    aWriter.StartElement( "libraries" );
 
     for( std::set<wxString>::iterator it = m_libraries.begin(); it!=m_libraries.end();  ++it )
     {
         wxString    libNickname = *it;
-        XNODE*      xlibrary;
 
-        if( m_libTable->HasLibrary( libNickname ) )
+        if( m_libTable && m_libTable->HasLibrary( libNickname ) )
         {
-            xlibs->AddChild( xlibrary = node( "library" ) );
-            xlibrary->AddAttribute( "logical", libNickname );
-            xlibrary->AddChild( node( "uri",  m_libTable->GetFullURI( libNickname ) ) );
+            aWriter.StartElement( "library" );
+            aWriter.AddAttribute( "logical", libNickname );
+            aWriter.AddElement( "uri",  m_libTable->GetFullURI( libNickname ) );
+            aWriter.EndElement();
         }
 
         // @todo: add more fun stuff here
     }
 
-    return xlibs;
+    aWriter.EndElement();
 }
 
 
-XNODE* NETLIST_EXPORTER_GENERIC::makeLibParts()
+void NETLIST_EXPORTER_GENERIC::writeLibParts( NETLIST_WRITER& aWriter )
 {
-    XNODE*      xlibparts = node( "libparts" );   // auto_ptr
+    aWriter.StartElement( "libparts" );
 
     LIB_PINS    pinList;
     LIB_FIELDS  fieldList;
@@ -399,61 +392,65 @@ XNODE* NETLIST_EXPORTER_GENERIC::makeLibParts()
         if( !libNickname.IsEmpty() )
             m_libraries.insert( libNickname );  // inserts component's library if unique
 
-        XNODE* xlibpart;
-        xlibparts->AddChild( xlibpart = node( "libpart" ) );
-        xlibpart->AddAttribute( "lib", libNickname );
-        xlibpart->AddAttribute( "part", lcomp->GetName()  );
+        aWriter.StartElement( "libpart" );
+        aWriter.AddAttribute( "lib", libNickname );
+        aWriter.AddAttribute( "part", lcomp->GetName()  );
 
         if( lcomp->GetAliasCount() )
         {
             wxArrayString aliases = lcomp->GetAliasNames( false );
             if( aliases.GetCount() )
             {
-                XNODE* xaliases = node( "aliases" );
-                xlibpart->AddChild( xaliases );
+                aWriter.StartElement( "aliases" );
+
                 for( unsigned i=0;  i<aliases.GetCount();  ++i )
                 {
-                    xaliases->AddChild( node( "alias", aliases[i] ) );
+                    aWriter.AddElement( "alias", aliases[i] );
                 }
+
+                aWriter.EndElement();
             }
         }
 
         //----- show the important properties -------------------------
         if( !lcomp->GetAlias( 0 )->GetDescription().IsEmpty() )
-            xlibpart->AddChild( node( "description", lcomp->GetAlias( 0 )->GetDescription() ) );
+            aWriter.AddElement( "description", lcomp->GetAlias( 0 )->GetDescription() );
 
         if( !lcomp->GetAlias( 0 )->GetDocFileName().IsEmpty() )
-            xlibpart->AddChild( node( "docs",  lcomp->GetAlias( 0 )->GetDocFileName() ) );
+            aWriter.AddElement( "docs",  lcomp->GetAlias( 0 )->GetDocFileName() );
 
         // Write the footprint list
         if( lcomp->GetFootprints().GetCount() )
         {
-            XNODE*  xfootprints;
-            xlibpart->AddChild( xfootprints = node( "footprints" ) );
+            aWriter.StartElement( "footprints" );
 
             for( unsigned i=0; i<lcomp->GetFootprints().GetCount(); ++i )
             {
-                xfootprints->AddChild( node( "fp", lcomp->GetFootprints()[i] ) );
+                aWriter.AddElement( "fp", lcomp->GetFootprints()[i] );
             }
+
+            aWriter.EndElement();
         }
 
         //----- show the fields here ----------------------------------
         fieldList.clear();
         lcomp->GetFields( fieldList );
 
-        XNODE*     xfields;
-        xlibpart->AddChild( xfields = node( "fields" ) );
+        aWriter.StartElement( "fields" );
 
         for( unsigned i=0;  i<fieldList.size();  ++i )
         {
             if( !fieldList[i].GetText().IsEmpty() )
             {
-                XNODE*     xfield;
-                xfields->AddChild( xfield = node( "field", fieldList[i].GetText() ) );
-                xfield->AddAttribute( "name", fieldList[i].GetName(false) );
+                aWriter.StartElement( "field" );
+                aWriter.AddAttribute( "name", fieldList[i].GetName(false) );
+                aWriter.AddContent( fieldList[i].GetText() );
+                aWriter.EndElement();
             }
         }
 
+        aWriter.EndElement();
+
         //----- show the pins here ------------------------------------
         pinList.clear();
         lcomp->GetPins( pinList, 0, 0 );
@@ -478,35 +475,35 @@ XNODE* NETLIST_EXPORTER_GENERIC::makeLibParts()
 
         if( pinList.size() )
         {
-            XNODE*     pins;
+            aWriter.StartElement( "pins" );
 
-            xlibpart->AddChild( pins = node( "pins" ) );
             for( unsigned i=0; i<pinList.size();  ++i )
             {
-                XNODE*     pin;
-
-                pins->AddChild( pin = node( "pin" ) );
-                pin->AddAttribute( "num", pinList[i]->GetNumber() );
-                pin->AddAttribute( "name", pinList[i]->GetName() );
-                pin->AddAttribute( "type", pinList[i]->GetCanonicalElectricalTypeName() );
+                aWriter.StartElement( "pin" );
+                aWriter.AddAttribute( "num", pinList[i]->GetNumber() );
+                aWriter.AddAttribute( "name", pinList[i]->GetName() );
+                aWriter.AddAttribute( "type", pinList[i]->GetCanonicalElectricalTypeName() );
+                aWriter.EndElement();
 
                 // caution: construction work site here, drive slowly
             }
+
+            aWriter.EndElement();
         }
+
+        aWriter.EndElement();   // libpart
     }
 
-    return xlibparts;
+    aWriter.EndElement();
 }
 
 
-XNODE* NETLIST_EXPORTER_GENERIC::makeListOfNets( bool aUseGraph )
+void NETLIST_EXPORTER_GENERIC::writeListOfNets( NETLIST_WRITER& aWriter, bool aUseGraph )
 {
-    XNODE*      xnets = node( "nets" );      // auto_ptr if exceptions ever get used.
     wxString    netCodeTxt;
     wxString    netName;
     wxString    ref;
 
-    XNODE*      xnet = 0;
     int         netCode;
     int         lastNetCode = -1;
     int         sameNetcodeCount = 0;
@@ -519,6 +516,8 @@ XNODE* NETLIST_EXPORTER_GENERIC::makeListOfNets( bool aUseGraph )
         </net>
     */
 
+    aWriter.StartElement( "nets" );
+
     m_LibParts.clear();     // must call this function before using m_LibParts.
 
     if( aUseGraph )
@@ -530,14 +529,12 @@ XNODE* NETLIST_EXPORTER_GENERIC::makeListOfNets( bool aUseGraph )
             bool added = false;
 
             auto code = it.first;
-            auto subgraphs = it.second;
+            const auto& subgraphs = it.second;
             auto net_name = subgraphs[0]->GetNetName();
 
-            XNODE* xnode;
-
             for( auto subgraph : subgraphs )
             {
-                auto sheet = subgraph->m_sheet;
+                const auto& sheet = subgraph->m_sheet;
 
                 for( auto item : subgraph->m_items )
                 {
@@ -554,24 +551,30 @@ XNODE* NETLIST_EXPORTER_GENERIC::makeListOfNets( bool aUseGraph )
 
                         if( !added )
                         {
-                            xnets->AddChild( xnet = node( "net" ) );
+                            aWriter.StartElement( "net" );
                             netCodeTxt.Printf( "%d", code );
-                            xnet->AddAttribute( "code", netCodeTxt );
-                            xnet->AddAttribute( "name", net_name );
+                            aWriter.AddAttribute( "code", netCodeTxt );
+                            aWriter.AddAttribute( "name", net_name );
 
                             added = true;
                         }
 
-                        xnet->AddChild( xnode = node( "node" ) );
-                        xnode->AddAttribute( "ref", refText );
-                        xnode->AddAttribute( "pin", pinText );
+                        aWriter.StartElement( "node" );
+                        aWriter.AddAttribute( "ref", refText );
+                        aWriter.AddAttribute( "pin", pinText );
+                        aWriter.EndElement();
                     }
                 }
             }
+
+            if( added )
+                aWriter.EndElement();
         }
     }
     else
     {
+        bool netOpen = false;
+
         for( unsigned ii = 0; ii < m_masterList->size(); ii++ )
         {
             NETLIST_OBJECT* nitem = m_masterList->GetItem( ii );
@@ -600,31 +603,27 @@ XNODE* NETLIST_EXPORTER_GENERIC::makeListOfNets( bool aUseGraph )
 
             if( ++sameNetcodeCount == 1 )
             {
-                xnets->AddChild( xnet = node( "net" ) );
+                if( netOpen )
+                    aWriter.EndElement();
+
+                aWriter.StartElement( "net" );
                 netCodeTxt.Printf( "%d", netCode );
-                xnet->AddAttribute( "code", netCodeTxt );
-                xnet->AddAttribute( "name", netName );
+                aWriter.AddAttribute( "code", netCodeTxt );
+                aWriter.AddAttribute( "name", netName );
+                netOpen = true;
             }
 
-            XNODE*      xnode;
-            xnet->AddChild( xnode = node( "node" ) );
-            xnode->AddAttribute( "ref", ref );
-            xnode->AddAttribute( "pin",  nitem->GetPinNumText() );
+            aWriter.StartElement( "node" );
+            aWriter.AddAttribute( "ref", ref );
+            aWriter.AddAttribute( "pin",  nitem->GetPinNumText() );
+            aWriter.EndElement();
         }
-    }
 
-    return xnets;
-}
-
-
-XNODE* NETLIST_EXPORTER_GENERIC::node( const wxString& aName, const wxString& aTextualContent /* = wxEmptyString*/ )
-{
-    XNODE* n = new XNODE( wxXML_ELEMENT_NODE, aName );
-
-    if( aTextualContent.Len() > 0 )     // excludes wxEmptyString, the parameter's default value
-        n->AddChild( new XNODE( wxXML_TEXT_NODE, wxEmptyString, aTextualContent ) );
+        if( netOpen )
+            aWriter.EndElement();
+    }
 
-    return n;
+    aWriter.EndElement();
 }
 
 
@@ -34,13 +34,15 @@
 #include <sch_edit_frame.h>
 
 class CONNECTION_GRAPH;
+class NETLIST_WRITER;
+class SCH_COMPONENT_TABLE;
 class SYMBOL_LIB_TABLE;
 
 #define GENERIC_INTERMEDIATE_NETLIST_EXT wxT( "xml" )
 
 /**
  * Enum GNL
- * is a set of bit which control the totality of the tree built by makeRoot()
+ * is a set of bit which control the totality of the document written by writeRoot()
  */
 enum GNL_T
 {
@@ -64,15 +66,23 @@ private:
 
     SYMBOL_LIB_TABLE*     m_libTable;
 
+    SCH_EDIT_FRAME*       m_frame;
+
 protected:
     CONNECTION_GRAPH*     m_graph;
 
 public:
+    /**
+     * @param aFrame is the schematic editor frame.  It can be nullptr to export g_RootSheet
+     *               outside of the editor (e.g. in the tests): the library list is then
+     *               left empty, as there is no symbol library table.
+     */
     NETLIST_EXPORTER_GENERIC( SCH_EDIT_FRAME* aFrame,
                               NETLIST_OBJECT_LIST* aMasterList,
                               CONNECTION_GRAPH* aGraph = nullptr  ) :
         NETLIST_EXPORTER( aMasterList ),
-        m_libTable( aFrame->Prj().SchSymbolLibTable() ),
+        m_libTable( aFrame ? aFrame->Prj().SchSymbolLibTable() : nullptr ),
+        m_frame( aFrame ),
         m_graph( aGraph )
     {}
 
@@ -85,63 +95,63 @@ public:
 #define GNL_ALL     ( GNL_LIBRARIES | GNL_COMPONENTS | GNL_PARTS | GNL_HEADER | GNL_NETS )
 
 protected:
-   /**
-     * Function node
-     * is a convenience function that creates a new XNODE with an optional textual child.
-     * It also provides some insulation from a possible change in XML library.
-     *
-     * @param aName is the name to associate with a new node of type wxXML_ELEMENT_NODE.
-     * @param aTextualContent is optional, and if given is the text to include in a child
-     *   of the returned node, and has type wxXML_TEXT_NODE.
-     */
-    XNODE* node( const wxString& aName, const wxString& aTextualContent = wxEmptyString );
-
     /**
-     * Function makeGenericRoot
-     * builds the entire document tree for the generic export.  This is factored
-     * out here so we can write the tree in either S-expression file format
-     * or in XML if we put the tree built here into a wxXmlDocument.
+     * Function makeRoot
+     * builds the entire document tree for the generic export, to put it into
+     * a wxXmlDocument.
      * @param aCtl - a bitset or-ed together from GNL_ENUM values
      * @return XNODE* - the root nodes
      */
     XNODE* makeRoot( int aCtl = GNL_ALL );
 
     /**
-     * Function makeComponents
-     * @return XNODE* - returns a sub-tree holding all the schematic components.
+     * Function writeRoot
+     * writes the entire document for the generic export to \a aWriter.  This is
+     * factored out here so we can stream the document in S-expression file format,
+     * or build the tree of the XML format (see makeRoot()).
+     * @param aWriter - the destination of the document
+     * @param aCtl - a bitset or-ed together from GNL_ENUM values
      */
-    XNODE* makeComponents();
+    void writeRoot( NETLIST_WRITER& aWriter, int aCtl = GNL_ALL );
 
     /**
-     * Function makeDesignHeader
-     * fills out a project "design" header into an XML node.
-     * @return XNODE* - the design header
+     * Function writeComponents
+     * writes the element holding all the schematic components.
      */
-    XNODE* makeDesignHeader();
+    void writeComponents( NETLIST_WRITER& aWriter );
 
     /**
-     * Function makeLibParts
-     * fills out an XML node with the unique library parts and returns it.
-     * @return XNODE* - the library parts nodes
+     * Function writeDesignHeader
+     * writes the project "design" header element.
      */
-    XNODE* makeLibParts();
+    void writeDesignHeader( NETLIST_WRITER& aWriter );
 
     /**
-     * Function makeListOfNets
-     * fills out an XML node with a list of nets and returns it.
-     * @return XNODE* - the list of nets nodes
+     * Function writeLibParts
+     * writes the element holding the unique library parts.
      */
-    XNODE* makeListOfNets( bool aUseGraph = true );
+    void writeLibParts( NETLIST_WRITER& aWriter );
 
     /**
-     * Function makeLibraries
-     * fills out an XML node with a list of used libraries and returns it.
-     * Must have called makeGenericLibParts() before this function.
-     * @return XNODE* - the library nodes
+     * Function writeListOfNets
+     * writes the element holding the list of nets.
      */
-    XNODE* makeLibraries();
+    void writeListOfNets( NETLIST_WRITER& aWriter, bool aUseGraph = true );
 
-    void addComponentFields(  XNODE* xcomp, SCH_COMPONENT* comp, SCH_SHEET_PATH* aSheet );
+    /**
+     * Function writeLibraries
+     * writes the element holding the list of used libraries.
+     * Must have called writeLibParts() before this function.
+     */
+    void writeLibraries( NETLIST_WRITER& aWriter );
+
+    /**
+     * Function addComponentFields
+     * writes the fields of the component of row \a aRow of \a aTable.  The fields of a
+     * multi-unit component are gathered from all its units.
+     */
+    void addComponentFields( NETLIST_WRITER& aWriter, const SCH_COMPONENT_TABLE& aTable,
+                             unsigned aRow, const wxString& aRef );
 };
 
 #endif
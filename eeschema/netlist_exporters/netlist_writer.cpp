@@ -0,0 +1,151 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see CHANGELOG.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include "netlist_writer.h"
+
+#include <macros.h>
+#include <richio.h>
+#include <xnode.h>
+
+
+XNODE_NETLIST_WRITER::XNODE_NETLIST_WRITER() :
+        m_root( nullptr )
+{
+}
+
+
+XNODE_NETLIST_WRITER::~XNODE_NETLIST_WRITER()
+{
+    delete m_root;
+}
+
+
+void XNODE_NETLIST_WRITER::StartElement( const wxString& aName )
+{
+    XNODE* n = new XNODE( wxXML_ELEMENT_NODE, aName );
+
+    if( m_stack.empty() )
+    {
+        wxASSERT( !m_root );
+        m_root = n;
+    }
+    else
+    {
+        m_stack.back()->AddChild( n );
+    }
+
+    m_stack.push_back( n );
+}
+
+
+void XNODE_NETLIST_WRITER::AddAttribute( const wxString& aName, const wxString& aValue )
+{
+    wxASSERT( !m_stack.empty() );
+    m_stack.back()->AddAttribute( aName, aValue );
+}
+
+
+void XNODE_NETLIST_WRITER::AddContent( const wxString& aContent )
+{
+    wxASSERT( !m_stack.empty() );
+
+    if( aContent.Len() > 0 )
+        m_stack.back()->AddChild( new XNODE( wxXML_TEXT_NODE, wxEmptyString, aContent ) );
+}
+
+
+void XNODE_NETLIST_WRITER::EndElement()
+{
+    wxASSERT( !m_stack.empty() );
+    m_stack.pop_back();
+}
+
+
+XNODE* XNODE_NETLIST_WRITER::ReleaseRoot()
+{
+    wxASSERT( m_stack.empty() );
+
+    XNODE* root = m_root;
+    m_root = nullptr;
+    return root;
+}
+
+
+SEXPR_NETLIST_WRITER::SEXPR_NETLIST_WRITER( OUTPUTFORMATTER* aOutputFormatter ) :
+        m_out( aOutputFormatter ),
+        m_depth( 0 ),
+        m_pendingClose( false )
+{
+}
+
+
+void SEXPR_NETLIST_WRITER::StartElement( const wxString& aName )
+{
+    // Same layout as XNODE::Format(): an element followed by a sibling ends its line,
+    // and the first child element of an element starts on a new line.
+    if( m_pendingClose )
+        m_out->Print( 0, ")\n" );
+    else if( m_depth > 0 )
+        m_out->Print( 0, "\n" );
+
+    m_pendingClose = false;
+
+    m_out->Print( m_depth, "(%s", TO_UTF8( aName ) );
+    m_depth++;
+}
+
+
+void SEXPR_NETLIST_WRITER::AddAttribute( const wxString& aName, const wxString& aValue )
+{
+    m_out->Print( 0, " (%s %s)", TO_UTF8( aName ), m_out->Quotew( aValue ).c_str() );
+}
+
+
+void SEXPR_NETLIST_WRITER::AddContent( const wxString& aContent )
+{
+    if( aContent.Len() > 0 )
+        m_out->Print( 0, " %s", m_out->Quotew( aContent ).c_str() );
+}
+
+
+void SEXPR_NETLIST_WRITER::EndElement()
+{
+    wxASSERT( m_depth > 0 );
+
+    // The last child element of this element has no sibling
+    if( m_pendingClose )
+        m_out->Print( 0, ")" );
+
+    m_depth--;
+
+    // The root element never has a sibling
+    if( m_depth == 0 )
+    {
+        m_out->Print( 0, ")" );
+        m_pendingClose = false;
+    }
+    else
+    {
+        m_pendingClose = true;
+    }
+}
@@ -0,0 +1,122 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see CHANGELOG.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef NETLIST_WRITER_H
+#define NETLIST_WRITER_H
+
+#include <vector>
+
+#include <wx/string.h>
+
+class OUTPUTFORMATTER;
+class XNODE;
+
+
+/**
+ * Class NETLIST_WRITER
+ * receives the netlist document built by NETLIST_EXPORTER_GENERIC, one element at a time.
+ *
+ * The elements are given in document order.  The attributes and the text content of an
+ * element must be given before its first child element.
+ */
+class NETLIST_WRITER
+{
+public:
+    virtual ~NETLIST_WRITER() {}
+
+    virtual void StartElement( const wxString& aName ) = 0;
+
+    virtual void AddAttribute( const wxString& aName, const wxString& aValue ) = 0;
+
+    /**
+     * Adds a text content to the current element.  An empty content is ignored.
+     */
+    virtual void AddContent( const wxString& aContent ) = 0;
+
+    virtual void EndElement() = 0;
+
+    /**
+     * Function AddElement
+     * is a convenience function writing an element holding only an optional text content.
+     */
+    void AddElement( const wxString& aName, const wxString& aContent = wxEmptyString )
+    {
+        StartElement( aName );
+        AddContent( aContent );
+        EndElement();
+    }
+};
+
+
+/**
+ * Class XNODE_NETLIST_WRITER
+ * builds the netlist document as a XNODE tree, for the XML export.
+ */
+class XNODE_NETLIST_WRITER : public NETLIST_WRITER
+{
+public:
+    XNODE_NETLIST_WRITER();
+    ~XNODE_NETLIST_WRITER();
+
+    void StartElement( const wxString& aName ) override;
+    void AddAttribute( const wxString& aName, const wxString& aValue ) override;
+    void AddContent( const wxString& aContent ) override;
+    void EndElement() override;
+
+    /**
+     * @return the root of the document, owned by the caller.
+     */
+    XNODE* ReleaseRoot();
+
+private:
+    XNODE*              m_root;
+    std::vector<XNODE*> m_stack;     ///< The open elements
+};
+
+
+/**
+ * Class SEXPR_NETLIST_WRITER
+ * writes the netlist document as s-expressions directly to an OUTPUTFORMATTER.
+ *
+ * The output is the same as XNODE::Format() of the root of the XNODE tree of the
+ * document, but no tree is kept in memory.
+ */
+class SEXPR_NETLIST_WRITER : public NETLIST_WRITER
+{
+public:
+    SEXPR_NETLIST_WRITER( OUTPUTFORMATTER* aOutputFormatter );
+
+    void StartElement( const wxString& aName ) override;
+    void AddAttribute( const wxString& aName, const wxString& aValue ) override;
+    void AddContent( const wxString& aContent ) override;
+    void EndElement() override;
+
+private:
+    OUTPUTFORMATTER* m_out;
+    int              m_depth;           ///< Number of open elements
+    bool             m_pendingClose;    ///< The closing parenthesis of the last ended
+                                        ///< element is not written yet: it is followed by
+                                        ///< a newline if a sibling element follows
+};
+
+#endif
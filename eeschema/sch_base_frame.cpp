@@ -375,10 +375,36 @@ void SCH_BASE_FRAME::createCanvas()
 }
 
 
+void SCH_BASE_FRAME::UpdateItemIndex( EDA_ITEM* aItem )
+{
+    // The library items are not indexed, and the new items are not on a screen yet
+    if( !dynamic_cast<SCH_ITEM*>( aItem ) || aItem->IsNew() )
+        return;
+
+    // The item is usually on the current screen, but the items of the other sheets can be
+    // modified too.  The other screens are only searched if the item is not on the current
+    // one, whether its index is built or not.
+    if( GetScreen() && GetScreen()->UpdateItemIndex( aItem ) )
+        return;
+
+    SCH_SCREENS screens;
+
+    for( SCH_SCREEN* screen = screens.GetFirst(); screen; screen = screens.GetNext() )
+    {
+        if( screen->UpdateItemIndex( aItem ) )
+            return;
+    }
+}
+
+
 void SCH_BASE_FRAME::RefreshItem( EDA_ITEM* aItem, bool isAddOrDelete )
 {
     EDA_ITEM* parent = aItem->GetParent();
 
+    // The item may have been moved or resized
+    if( !isAddOrDelete )
+        UpdateItemIndex( aItem );
+
     if( aItem->Type() == SCH_SHEET_PIN_T )
     {
         // Sheet pins aren't in the view.  Refresh their parent.
@@ -301,6 +301,12 @@ public:
      */
     void RemoveFromScreen( EDA_ITEM* aItem, SCH_SCREEN* aScreen = nullptr );
 
+    /**
+     * Update the position of an item moved or modified in place in the spatial index of the
+     * screen it is on, which is not always the current screen.
+     */
+    void UpdateItemIndex( EDA_ITEM* aItem );
+
     /**
      * Mark an item for refresh.
      */
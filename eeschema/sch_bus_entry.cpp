@@ -187,54 +187,33 @@ void SCH_BUS_ENTRY_BASE::Rotate( wxPoint aPosition )
 }
 
 
-bool SCH_BUS_WIRE_ENTRY::UpdateDanglingState( std::vector<DANGLING_END_ITEM>& aItemList )
+bool SCH_BUS_WIRE_ENTRY::UpdateDanglingState( const DANGLING_END_INDEX& aIndex )
 {
     bool previousStateStart = m_isDanglingStart;
     bool previousStateEnd = m_isDanglingEnd;
 
     m_isDanglingStart = m_isDanglingEnd = true;
 
-    // Wires and buses are stored in the list as a pair, start and end. This
-    // variable holds the start position from one iteration so it can be used
-    // when the end position is found.
-    wxPoint seg_start;
-
     // Store the connection type and state for the start (0) and end (1)
     bool has_wire[2] = { false };
     bool has_bus[2] = { false };
 
-    for( DANGLING_END_ITEM& each_item : aItemList )
+    wxPoint ends[2] = { m_pos, m_End() };
+    std::vector<DANGLING_END_INDEX::SEGMENT> segments;
+
+    for( int ii = 0; ii < 2; ++ii )
     {
-        if( each_item.GetItem() == this )
-            continue;
+        aIndex.SegmentsAt( ends[ii], segments );
 
-        switch( each_item.GetType() )
+        for( const DANGLING_END_INDEX::SEGMENT& segment : segments )
         {
-        case WIRE_START_END:
-        case BUS_START_END:
-            seg_start = each_item.GetPosition();
-            break;
-
-        case WIRE_END_END:
-            if( IsPointOnSegment( seg_start, each_item.GetPosition(), m_pos ) )
-                has_wire[0] = true;
-
-            if( IsPointOnSegment( seg_start, each_item.GetPosition(), m_End() ) )
-                has_wire[1] = true;
-
-            break;
-
-        case BUS_END_END:
-            if( IsPointOnSegment( seg_start, each_item.GetPosition(), m_pos ) )
-                has_bus[0] = true;
-
-            if( IsPointOnSegment( seg_start, each_item.GetPosition(), m_End() ) )
-                has_bus[1] = true;
-
-            break;
+            if( segment.m_start->GetItem() == this )
+                continue;
 
-        default:
-            break;
+            if( segment.m_start->GetType() == WIRE_START_END )
+                has_wire[ii] = true;
+            else if( segment.m_start->GetType() == BUS_START_END )
+                has_bus[ii] = true;
         }
     }
 
@@ -253,38 +232,34 @@ bool SCH_BUS_WIRE_ENTRY::UpdateDanglingState( std::vector<DANGLING_END_ITEM>& aI
 }
 
 
-bool SCH_BUS_BUS_ENTRY::UpdateDanglingState( std::vector<DANGLING_END_ITEM>& aItemList )
+bool SCH_BUS_BUS_ENTRY::UpdateDanglingState( const DANGLING_END_INDEX& aIndex )
 {
     bool previousStateStart = m_isDanglingStart;
     bool previousStateEnd = m_isDanglingEnd;
 
     m_isDanglingStart = m_isDanglingEnd = true;
 
-    // Wires and buses are stored in the list as a pair, start and end. This
-    // variable holds the start position from one iteration so it can be used
-    // when the end position is found.
-    wxPoint seg_start;
+    std::vector<DANGLING_END_INDEX::SEGMENT> segments;
 
-    for( DANGLING_END_ITEM& each_item : aItemList )
+    auto isOnBus = [&]( const wxPoint& aPos ) -> bool
     {
-        if( each_item.GetItem() == this )
-            continue;
+        aIndex.SegmentsAt( aPos, segments );
 
-        switch( each_item.GetType() )
+        for( const DANGLING_END_INDEX::SEGMENT& segment : segments )
         {
-        case BUS_START_END:
-            seg_start = each_item.GetPosition();
-            break;
-        case BUS_END_END:
-            if( IsPointOnSegment( seg_start, each_item.GetPosition(), m_pos ) )
-                m_isDanglingStart = false;
-            if( IsPointOnSegment( seg_start, each_item.GetPosition(), m_End() ) )
-                m_isDanglingEnd = false;
-            break;
-        default:
-            break;
+            if( segment.m_start->GetItem() != this
+                    && segment.m_start->GetType() == BUS_START_END )
+                return true;
         }
-    }
+
+        return false;
+    };
+
+    if( isOnBus( m_pos ) )
+        m_isDanglingStart = false;
+
+    if( isOnBus( m_End() ) )
+        m_isDanglingEnd = false;
 
     return (previousStateStart != m_isDanglingStart) || (previousStateEnd != m_isDanglingEnd);
 }
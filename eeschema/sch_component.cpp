@@ -446,6 +446,10 @@ void SCH_COMPONENT::UpdatePins( const EE_COLLECTOR& aComponents )
 
 void SCH_COMPONENT::UpdatePins( SCH_SHEET_PATH* aSheet )
 {
+    // The connected items of the neighbors point to the pins, so the connectivity of the
+    // component must be updated when its pins are rebuilt
+    bool rebuilt = false;
+
     if( PART_SPTR part = m_part.lock() )
     {
         m_pinMap.clear();
@@ -467,6 +471,7 @@ void SCH_COMPONENT::UpdatePins( SCH_SHEET_PATH* aSheet )
                     m_pins.erase( m_pins.begin() + i, m_pins.end() );
 
                 m_pins.emplace_back( SCH_PIN( libPin, this ) );
+                rebuilt = true;
             }
 
             m_pinMap[ libPin ] = i;
@@ -476,12 +481,22 @@ void SCH_COMPONENT::UpdatePins( SCH_SHEET_PATH* aSheet )
 
             ++i;
         }
+
+        if( m_pins.size() > i )
+        {
+            m_pins.erase( m_pins.begin() + i, m_pins.end() );
+            rebuilt = true;
+        }
     }
     else
     {
+        rebuilt = !m_pins.empty();
         m_pins.clear();
         m_pinMap.clear();
     }
+
+    if( rebuilt )
+        SetConnectivityDirty();
 }
 
 
@@ -499,6 +514,7 @@ void SCH_COMPONENT::SetUnit( int aUnit )
     if( m_unit != aUnit )
     {
         m_unit = aUnit;
+        SetConnectivityDirty();
         SetModified();
     }
 }
@@ -515,6 +531,7 @@ void SCH_COMPONENT::SetConvert( int aConvert )
     if( m_convert != aConvert )
     {
         m_convert = aConvert;
+        SetConnectivityDirty();
         SetModified();
     }
 }
@@ -716,6 +733,8 @@ void SCH_COMPONENT::SetRef( const SCH_SHEET_PATH* sheet, const wxString& ref )
 
     // Power components have references starting with # and are not included in netlists
     m_isInNetlist = ! ref.StartsWith( wxT( "#" ) );
+
+    clearDefaultNetNames( sheet );
 }
 
 
@@ -1031,6 +1050,16 @@ void SCH_COMPONENT::SwapData( SCH_ITEM* aItem )
 }
 
 
+void SCH_COMPONENT::clearDefaultNetNames( const SCH_SHEET_PATH* aSheetPath )
+{
+    // The default net names of the pins are made from the reference
+    for( SCH_PIN& pin : m_pins )
+        pin.ClearDefaultNetName( aSheetPath );
+
+    SetConnectivityDirty();
+}
+
+
 void SCH_COMPONENT::ClearAnnotation( SCH_SHEET_PATH* aSheetPath )
 {
     wxArrayString  reference_fields;
@@ -1077,6 +1106,7 @@ void SCH_COMPONENT::ClearAnnotation( SCH_SHEET_PATH* aSheetPath )
     // But this call cannot made here.
     m_Fields[REFERENCE].SetText( defRef ); //for drawing.
 
+    clearDefaultNetNames( aSheetPath );
     SetModified();
 }
 
@@ -1539,7 +1569,7 @@ void SCH_COMPONENT::GetEndPoints( std::vector <DANGLING_END_ITEM>& aItemList )
 }
 
 
-bool SCH_COMPONENT::UpdateDanglingState( std::vector<DANGLING_END_ITEM>& aItemList )
+bool SCH_COMPONENT::UpdateDanglingState( const DANGLING_END_INDEX& aIndex )
 {
     bool changed = false;
 
@@ -1550,16 +1580,16 @@ bool SCH_COMPONENT::UpdateDanglingState( std::vector<DANGLING_END_ITEM>& aItemLi
 
         wxPoint pos = m_transform.TransformCoordinate( pin.GetPosition() ) + m_Pos;
 
-        for( DANGLING_END_ITEM& each_item : aItemList )
+        for( const DANGLING_END_ITEM* each_item : aIndex.ItemsAt( pos ) )
         {
             // Some people like to stack pins on top of each other in a symbol to indicate
             // internal connection. While technically connected, it is not particularly useful
             // to display them that way, so skip any pins that are in the same symbol as this
             // one.
-            if( each_item.GetParent() == this )
+            if( each_item->GetParent() == this )
                 continue;
 
-            switch( each_item.GetType() )
+            switch( each_item->GetType() )
             {
             case PIN_END:
             case LABEL_END:
@@ -1568,10 +1598,7 @@ bool SCH_COMPONENT::UpdateDanglingState( std::vector<DANGLING_END_ITEM>& aItemLi
             case WIRE_END_END:
             case NO_CONNECT_END:
             case JUNCTION_END:
-
-                if( pos == each_item.GetPosition() )
-                    pin.SetIsDangling( false );
-
+                pin.SetIsDangling( false );
                 break;
 
             default:
@@ -112,6 +112,12 @@ private:
 
     void Init( const wxPoint& pos = wxPoint( 0, 0 ) );
 
+    /**
+     * Forgets the default net names of the pins for \a aSheetPath (all the paths if nullptr)
+     * and marks the connectivity of the component dirty, after a change of its reference.
+     */
+    void clearDefaultNetNames( const SCH_SHEET_PATH* aSheetPath );
+
 public:
     SCH_COMPONENT( const wxPoint& pos = wxPoint( 0, 0 ), SCH_ITEM* aParent = NULL );
 
@@ -567,7 +573,7 @@ public:
      *
      * @return true if any pin's state has changed.
      */
-    bool UpdateDanglingState( std::vector<DANGLING_END_ITEM>& aItemList ) override;
+    bool UpdateDanglingState( const DANGLING_END_INDEX& aIndex ) override;
 
     wxPoint GetPinPhysicalPosition( const LIB_PIN* Pin ) const;
 
@@ -0,0 +1,179 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see CHANGELOG.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <sch_component_table.h>
+
+#include <sch_component.h>
+#include <sch_field.h>
+#include <sch_sheet.h>
+#include <sch_sheet_path.h>
+
+
+SCH_COMPONENT_TABLE::SCH_COMPONENT_TABLE() :
+        m_valid( false )
+{
+}
+
+
+void SCH_COMPONENT_TABLE::Update( SCH_SHEET* aRootSheet )
+{
+    // The library links of the components are updated when the symbol libraries change,
+    // which is not a change of the schematic, so they are checked on each use.
+    for( unsigned ii = 0; m_valid && ii < m_rows.size(); ii++ )
+    {
+        const SCH_REFERENCE& reference = m_rows[ii].m_Reference;
+
+        if( reference.GetLibPart() != reference.GetComp()->GetPartRef().lock().get() )
+            m_valid = false;
+    }
+
+    if( m_valid )
+        return;
+
+    SCH_REFERENCE_LIST references;
+    SCH_SHEET_LIST     sheets( aRootSheet );
+
+    sheets.GetComponents( references, false, true );
+
+    std::unordered_map<SCH_COMPONENT*, COMPONENT_FIELDS> fields;
+
+    m_rows.clear();
+    m_rows.reserve( references.GetCount() );
+    m_unitRows.clear();
+
+    for( unsigned ii = 0; ii < references.GetCount(); ii++ )
+    {
+        SCH_REFERENCE& reference = references[ii];
+        SCH_COMPONENT* comp = reference.GetComp();
+
+        // The full reference, before it is split into its prefix and number
+        wxString fullReference = reference.GetRef();
+
+        m_unitRows[ fullReference.Lower() ].push_back( ii );
+        reference.Split();
+
+        auto it = fields.find( comp );
+
+        if( it == fields.end() )
+        {
+            it = fields.emplace( comp, COMPONENT_FIELDS() ).first;
+
+            // Only the components changed since the last update have their fields read
+            auto cached = m_fields.find( comp );
+
+            if( cached != m_fields.end() && sameFields( comp, cached->second ) )
+                it->second = std::move( cached->second );
+            else
+                readFields( comp, it->second );
+        }
+
+        m_rows.push_back( { reference, fullReference, &it->second } );
+    }
+
+    // Swapping keeps the fields where the rows point to
+    m_fields.swap( fields );
+    m_valid = true;
+}
+
+
+const std::vector<unsigned>& SCH_COMPONENT_TABLE::GetUnitRows( const wxString& aReference ) const
+{
+    static const std::vector<unsigned> noRows;
+
+    auto it = m_unitRows.find( aReference.Lower() );
+
+    return it != m_unitRows.end() ? it->second : noRows;
+}
+
+
+const wxString& SCH_COMPONENT_TABLE::GetColumnText( unsigned aRow, int aColumn ) const
+{
+    static const wxString noText;
+
+    const COMPONENT_FIELDS& fields = *m_rows[ aRow ].m_Fields;
+
+    for( unsigned ii = 0; ii < fields.m_Columns.size(); ii++ )
+    {
+        if( fields.m_Columns[ii] == aColumn )
+            return GetFieldText( aRow, ii );
+    }
+
+    return noText;
+}
+
+
+int SCH_COMPONENT_TABLE::FindColumn( const wxString& aFieldName ) const
+{
+    auto it = m_columns.find( aFieldName );
+
+    return it != m_columns.end() ? it->second : -1;
+}
+
+
+int SCH_COMPONENT_TABLE::getColumn( const wxString& aFieldName )
+{
+    auto it = m_columns.find( aFieldName );
+
+    if( it != m_columns.end() )
+        return it->second;
+
+    m_columnNames.push_back( aFieldName );
+    m_columns[ aFieldName ] = m_columnNames.size() - 1;
+
+    return m_columnNames.size() - 1;
+}
+
+
+void SCH_COMPONENT_TABLE::readFields( SCH_COMPONENT* aComponent, COMPONENT_FIELDS& aFields )
+{
+    aFields.m_Columns.clear();
+    aFields.m_Texts.clear();
+
+    for( int ii = 0; ii < aComponent->GetFieldCount(); ii++ )
+    {
+        SCH_FIELD* field = aComponent->GetField( ii );
+
+        aFields.m_Columns.push_back( getColumn( field->GetName() ) );
+        aFields.m_Texts.push_back( field->GetText() );
+    }
+}
+
+
+bool SCH_COMPONENT_TABLE::sameFields( SCH_COMPONENT* aComponent,
+                                      const COMPONENT_FIELDS& aFields ) const
+{
+    if( (int) aFields.m_Texts.size() != aComponent->GetFieldCount() )
+        return false;
+
+    for( int ii = 0; ii < aComponent->GetFieldCount(); ii++ )
+    {
+        SCH_FIELD* field = aComponent->GetField( ii );
+
+        // The reference text is not read from the fields (see GetFieldText())
+        if( ( ii != REFERENCE && field->GetText() != aFields.m_Texts[ii] )
+                || field->GetName() != m_columnNames[ aFields.m_Columns[ii] ] )
+            return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,166 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see CHANGELOG.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef SCH_COMPONENT_TABLE_H
+#define SCH_COMPONENT_TABLE_H
+
+#include <sch_reference_list.h>
+
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+class SCH_SHEET;
+
+
+/**
+ * Class SCH_COMPONENT_TABLE
+ * is a cache of the component instances of a schematic hierarchy and of the fields of the
+ * components, shared by the symbol fields editor and the generic (BOM) netlist export.
+ *
+ * A row of the table is a component instance, as found by SCH_SHEET_LIST::GetComponents()
+ * without the power symbols but with the orphan components, in schematic order.  The field
+ * names are interned as columns, so the fields of a row are column numbers and texts.
+ *
+ * The table is only rebuilt by Update() after it was invalidated by a schematic change.
+ * The instances are then walked again, but a component whose fields did not change keeps
+ * its cached fields.  The text of the REFERENCE field depends on the sheet last shown
+ * (see SCH_SHEET_PATH::UpdateAllScreenReferences()), so the reference of each instance
+ * is used instead.
+ */
+class SCH_COMPONENT_TABLE
+{
+public:
+    SCH_COMPONENT_TABLE();
+
+    /**
+     * Marks the table as out of date, to be called after any change of the schematic.
+     */
+    void Invalidate() { m_valid = false; }
+
+    bool IsValid() const { return m_valid; }
+
+    /**
+     * Brings the table up to date with the schematic hierarchy of \a aRootSheet, if it was
+     * invalidated or if the library links of the components changed since.
+     */
+    void Update( SCH_SHEET* aRootSheet );
+
+    /**
+     * @return the number of rows (component instances) of the table.
+     */
+    unsigned GetCount() const { return m_rows.size(); }
+
+    /**
+     * @return the reference of the instance of row \a aRow, split into its prefix and
+     * number (see SCH_REFERENCE::Split()).  The library part is null for orphan components.
+     */
+    const SCH_REFERENCE& GetReference( unsigned aRow ) const
+    {
+        return m_rows[ aRow ].m_Reference;
+    }
+
+    /**
+     * @return the rows of the instances whose reference is \a aReference (not case sensitive),
+     * in schematic order: the units of a multi-unit component.
+     */
+    const std::vector<unsigned>& GetUnitRows( const wxString& aReference ) const;
+
+    /**
+     * @return the number of fields of the component of row \a aRow.  The first ones are
+     * the MANDATORY_FIELDS.
+     */
+    unsigned GetFieldCount( unsigned aRow ) const
+    {
+        return m_rows[ aRow ].m_Fields->m_Columns.size();
+    }
+
+    /**
+     * @return the column (the interned name) of the field \a aField of the component of
+     * row \a aRow.
+     */
+    int GetFieldColumn( unsigned aRow, unsigned aField ) const
+    {
+        return m_rows[ aRow ].m_Fields->m_Columns[ aField ];
+    }
+
+    /**
+     * @return the text of the field \a aField of the component of row \a aRow.  The text
+     * of the REFERENCE field is the reference of the instance, not the one last shown.
+     */
+    const wxString& GetFieldText( unsigned aRow, unsigned aField ) const
+    {
+        if( aField == REFERENCE )
+            return m_rows[ aRow ].m_FullReference;
+
+        return m_rows[ aRow ].m_Fields->m_Texts[ aField ];
+    }
+
+    /**
+     * @return the text of the first field of the component of row \a aRow having the name
+     * of the column \a aColumn, or an empty string when the component has no such field,
+     * as SCH_COMPONENT::GetFieldText() does.
+     */
+    const wxString& GetColumnText( unsigned aRow, int aColumn ) const;
+
+    int GetColumnCount() const { return m_columnNames.size(); }
+
+    const wxString& GetColumnName( int aColumn ) const { return m_columnNames[ aColumn ]; }
+
+    /**
+     * @return the column of the field name \a aFieldName, or -1 if no component of the
+     * table ever had such a field.
+     */
+    int FindColumn( const wxString& aFieldName ) const;
+
+private:
+    struct COMPONENT_FIELDS
+    {
+        std::vector<int>      m_Columns;     ///< The column of each field, in field order
+        std::vector<wxString> m_Texts;       ///< The text of each field, in field order
+    };
+
+    struct ROW
+    {
+        SCH_REFERENCE           m_Reference;
+        wxString                m_FullReference;  ///< Before the split, unit not included
+        const COMPONENT_FIELDS* m_Fields;    ///< The fields of the component, shared by
+                                             ///< all its instances
+    };
+
+    int getColumn( const wxString& aFieldName );
+
+    void readFields( SCH_COMPONENT* aComponent, COMPONENT_FIELDS& aFields );
+
+    bool sameFields( SCH_COMPONENT* aComponent, const COMPONENT_FIELDS& aFields ) const;
+
+    bool                                                  m_valid;
+    std::vector<ROW>                                      m_rows;
+    std::unordered_map<SCH_COMPONENT*, COMPONENT_FIELDS>  m_fields;
+    std::map<wxString, std::vector<unsigned>>             m_unitRows;    ///< By lower case
+                                                                         ///< reference
+    std::vector<wxString>                                 m_columnNames;
+    std::map<wxString, int>                               m_columns;
+};
+
+#endif
@@ -67,6 +67,7 @@
 #include <wildcards_and_files_ext.h>
 #include <connection_graph.h>
 #include <sch_painter.h>
+#include <sch_component_table.h>
 
 #include <gal/graphics_abstraction_layer.h>
 
@@ -227,7 +228,8 @@ END_EVENT_TABLE()
 SCH_EDIT_FRAME::SCH_EDIT_FRAME( KIWAY* aKiway, wxWindow* aParent ):
     SCH_BASE_FRAME( aKiway, aParent, FRAME_SCH, wxT( "Eeschema" ),
         wxDefaultPosition, wxDefaultSize, KICAD_DEFAULT_DRAWFRAME_STYLE, SCH_EDIT_FRAME_NAME ),
-    m_item_to_repeat( nullptr )
+    m_item_to_repeat( nullptr ),
+    m_componentTable( new SCH_COMPONENT_TABLE )
 {
     g_CurrentSheet = new SCH_SHEET_PATH();
     g_ConnectionGraph = new CONNECTION_GRAPH( this );
@@ -395,6 +397,9 @@ void SCH_EDIT_FRAME::SetSheetNumberAndCount()
 
     g_CurrentSheet->SetPageNumber( SheetNumber );
 
+    // The sheets, and so the component instances, may have changed
+    m_componentTable->Invalidate();
+
     for( screen = s_list.GetFirst(); screen != NULL; screen = s_list.GetNext() )
         screen->m_NumberOfScreens = sheet_count;
 
@@ -440,6 +445,7 @@ void SCH_EDIT_FRAME::CreateScreens()
     g_CurrentSheet->clear();
     g_CurrentSheet->push_back( g_RootSheet );
     g_ConnectionGraph->Reset();
+    m_componentTable->Invalidate();
 
     if( GetScreen() == NULL )
     {
@@ -621,6 +627,7 @@ void SCH_EDIT_FRAME::OnModify()
 {
     GetScreen()->SetModify();
     GetScreen()->SetSave();
+    m_componentTable->Invalidate();
 
     if( ADVANCED_CFG::GetCfg().m_realTimeConnectivity && CONNECTION_GRAPH::m_allowRealTime )
         RecalculateConnections( false );
@@ -629,6 +636,16 @@ void SCH_EDIT_FRAME::OnModify()
 }
 
 
+const SCH_COMPONENT_TABLE& SCH_EDIT_FRAME::GetComponentTable( bool aRecheck )
+{
+    if( aRecheck )
+        m_componentTable->Invalidate();
+
+    m_componentTable->Update( g_RootSheet );
+    return *m_componentTable;
+}
+
+
 void SCH_EDIT_FRAME::OnUpdatePCB( wxCommandEvent& event )
 {
     wxFileName fn = Prj().AbsolutePath( g_RootSheet->GetScreen()->GetFileName() );
@@ -1072,7 +1089,8 @@ void SCH_EDIT_FRAME::RecalculateConnections( bool aDoCleanup )
     timer.Stop();
     wxLogTrace( "CONN_PROFILE", "SchematicCleanUp() %0.4f ms", timer.msecs() );
 
-    g_ConnectionGraph->Recalculate( list, true );
+    // Without the cleanup, only the modified screens need their connectivity updated
+    g_ConnectionGraph->Recalculate( list, aDoCleanup );
 }
 
 
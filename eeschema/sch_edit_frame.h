@@ -38,6 +38,8 @@
 #include <tool/selection.h>
 #include <status_popup.h>
 
+#include <memory>
+
 class SCH_ITEM;
 class EDA_ITEM;
 class SCH_TEXT;
@@ -52,6 +54,7 @@ class DIALOG_SCH_FIND;
 class wxFindDialogEvent;
 class wxFindReplaceData;
 class RESCUER;
+class SCH_COMPONENT_TABLE;
 
 
 /// enum used in RotationMiroir()
@@ -112,6 +115,10 @@ private:
     SCH_ITEM*               m_item_to_repeat;     ///< Last item to insert by the repeat command.
     int                     m_repeatLabelDelta;   ///< Repeat label number increment step.
     SCH_ITEM*               m_undoItem;           ///< Copy of the current item being edited.
+
+    /// The components of the schematic and their fields, for the fields editor and the BOM.
+    std::unique_ptr<SCH_COMPONENT_TABLE> m_componentTable;
+
     wxString                m_netListerCommand;   ///< Command line to call a custom net list
                                                   ///< generator.
     int                     m_exec_flags;         ///< Flags of the wxExecute() function
@@ -296,6 +303,17 @@ public:
      */
     void OnModify() override;
 
+    /**
+     * Return the table of the component instances of the schematic and of their fields.
+     *
+     * The table is cached: it is only updated after a schematic change (see OnModify()).
+     *
+     * @param aRecheck is true to check the fields of every component again, for the exports
+     *                 which must not miss a change made without OnModify().  Only the
+     *                 components whose fields changed are read again.
+     */
+    const SCH_COMPONENT_TABLE& GetComponentTable( bool aRecheck = false );
+
     /**
      * Return a human-readable description of the current screen.
      */
@@ -1003,6 +1021,10 @@ public:
 
     /**
      * Generates the connection data for the entire schematic hierarchy.
+     *
+     * @param aDoCleanup is true to clean up the schematic and fully recalculate the
+     *                   connections, false to only relink the items of the modified
+     *                   screens (the subgraphs and net names are always rebuilt)
      */
     void RecalculateConnections( bool aDoCleanup = true );
 
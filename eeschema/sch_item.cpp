@@ -22,8 +22,11 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <algorithm>
+
 #include <fctsys.h>
 #include <common.h>
+#include <trigo.h>
 #include <gr_basic.h>
 #include <base_struct.h>
 #include <trace_helpers.h>
@@ -179,3 +182,79 @@ void SCH_ITEM::Plot( PLOTTER* aPlotter )
 {
     wxFAIL_MSG( wxT( "Plot() method not implemented for class " ) + GetClass() );
 }
+
+
+DANGLING_END_INDEX::DANGLING_END_INDEX( const std::vector<DANGLING_END_ITEM>& aItemList )
+{
+    for( size_t ii = 0; ii < aItemList.size(); ++ii )
+    {
+        const DANGLING_END_ITEM& item = aItemList[ii];
+
+        m_itemsByPos[ item.GetPosition() ].push_back( &item );
+
+        // Wires and buses are stored in the list as a pair, start and end
+        if( ( item.GetType() == WIRE_START_END || item.GetType() == BUS_START_END )
+                && ii + 1 < aItemList.size() )
+        {
+            SEGMENT segment = { &item, &aItemList[ii + 1] };
+            wxPoint start = segment.m_start->GetPosition();
+            wxPoint end = segment.m_end->GetPosition();
+
+            if( start.y == end.y )
+                m_horizontalSegments[ start.y ].push_back( segment );
+            else if( start.x == end.x )
+                m_verticalSegments[ start.x ].push_back( segment );
+            else
+                m_otherSegments.push_back( segment );
+        }
+    }
+}
+
+
+const std::vector<const DANGLING_END_ITEM*>& DANGLING_END_INDEX::ItemsAt(
+        const wxPoint& aPosition ) const
+{
+    static const std::vector<const DANGLING_END_ITEM*> empty;
+
+    auto it = m_itemsByPos.find( aPosition );
+
+    return it == m_itemsByPos.end() ? empty : it->second;
+}
+
+
+void DANGLING_END_INDEX::SegmentsAt( const wxPoint& aPosition,
+                                     std::vector<SEGMENT>& aSegments ) const
+{
+    aSegments.clear();
+
+    auto collect = [&]( const std::vector<SEGMENT>& aCandidates )
+    {
+        for( const SEGMENT& segment : aCandidates )
+        {
+            if( IsPointOnSegment( segment.m_start->GetPosition(), segment.m_end->GetPosition(),
+                                  aPosition ) )
+            {
+                aSegments.push_back( segment );
+            }
+        }
+    };
+
+    auto horizontal = m_horizontalSegments.find( aPosition.y );
+
+    if( horizontal != m_horizontalSegments.end() )
+        collect( horizontal->second );
+
+    auto vertical = m_verticalSegments.find( aPosition.x );
+
+    if( vertical != m_verticalSegments.end() )
+        collect( vertical->second );
+
+    collect( m_otherSegments );
+
+    // The start items are stored in the list, so their addresses give the list order
+    std::sort( aSegments.begin(), aSegments.end(),
+               []( const SEGMENT& a, const SEGMENT& b )
+               {
+                   return std::less<const DANGLING_END_ITEM*>()( a.m_start, b.m_start );
+               } );
+}
@@ -104,6 +104,47 @@ public:
 };
 
 
+/**
+ * Class DANGLING_END_INDEX
+ * indexes a list of DANGLING_END_ITEMs by position, so that testing the dangling state of
+ * an item only looks at the end items and the wire or bus segments found at its connection
+ * points instead of the whole list.
+ *
+ * The index points into the list, which must not be modified while the index is in use.
+ */
+class DANGLING_END_INDEX
+{
+public:
+    /// A wire or bus segment: a WIRE_START_END or BUS_START_END item and its end item
+    struct SEGMENT
+    {
+        const DANGLING_END_ITEM* m_start;
+        const DANGLING_END_ITEM* m_end;
+    };
+
+    DANGLING_END_INDEX( const std::vector<DANGLING_END_ITEM>& aItemList );
+
+    /**
+     * @return the end items located at \a aPosition, in list order.
+     */
+    const std::vector<const DANGLING_END_ITEM*>& ItemsAt( const wxPoint& aPosition ) const;
+
+    /**
+     * Fills \a aSegments with the wire and bus segments passing through \a aPosition
+     * (their ends included), in list order.
+     */
+    void SegmentsAt( const wxPoint& aPosition, std::vector<SEGMENT>& aSegments ) const;
+
+private:
+    std::unordered_map<wxPoint, std::vector<const DANGLING_END_ITEM*>> m_itemsByPos;
+
+    // Horizontal segments by Y coordinate, vertical ones by X coordinate
+    std::unordered_map<int, std::vector<SEGMENT>> m_horizontalSegments;
+    std::unordered_map<int, std::vector<SEGMENT>> m_verticalSegments;
+    std::vector<SEGMENT>                          m_otherSegments;
+};
+
+
 /**
  * Class SCH_ITEM
  * is a base class for any item which can be embedded within the SCHEMATIC
@@ -273,8 +314,9 @@ public:
     virtual void GetEndPoints( std::vector< DANGLING_END_ITEM >& aItemList ) {}
 
     /**
-     * Function IsDanglingStateChanged
-     * tests the schematic item to \a aItemList to check if it's dangling state has changed.
+     * Function UpdateDanglingState
+     * tests the schematic item to the end items of \a aIndex to check if it's dangling state
+     * has changed.
      *
      * Note that the return value only true when the state of the test has changed.  Use
      * the IsDangling() method to get the current dangling state of the item.  Some of
@@ -282,10 +324,10 @@ public:
      * always returns false.  Only override the method if the item can be tested for a
      * dangling state.
      *
-     * @param aItemList - List of items to test item against.
+     * @param aIndex - Index of the end items to test item against.
      * @return True if the dangling state has changed from it's current setting.
      */
-    virtual bool UpdateDanglingState( std::vector<DANGLING_END_ITEM>& aItemList ) { return false; }
+    virtual bool UpdateDanglingState( const DANGLING_END_INDEX& aIndex ) { return false; }
 
     virtual bool IsDangling() const { return false; }
 
@@ -536,7 +536,7 @@ void SCH_LINE::GetEndPoints( std::vector <DANGLING_END_ITEM>& aItemList )
 }
 
 
-bool SCH_LINE::UpdateDanglingState( std::vector<DANGLING_END_ITEM>& aItemList )
+bool SCH_LINE::UpdateDanglingState( const DANGLING_END_INDEX& aIndex )
 {
     bool previousStartState = m_startIsDangling;
     bool previousEndState = m_endIsDangling;
@@ -545,25 +545,26 @@ bool SCH_LINE::UpdateDanglingState( std::vector<DANGLING_END_ITEM>& aItemList )
 
     if( GetLayer() == LAYER_WIRE )
     {
-        for( DANGLING_END_ITEM item : aItemList )
+        auto isConnected = [&]( const wxPoint& aPos ) -> bool
         {
-            if( item.GetItem() == this )
-                continue;
+            for( const DANGLING_END_ITEM* item : aIndex.ItemsAt( aPos ) )
+            {
+                if( item->GetItem() == this )
+                    continue;
 
-            if(     item.GetType() == BUS_START_END ||
-                    item.GetType() == BUS_END_END  ||
-                    item.GetType() == BUS_ENTRY_END )
-                continue;
+                if(     item->GetType() == BUS_START_END ||
+                        item->GetType() == BUS_END_END  ||
+                        item->GetType() == BUS_ENTRY_END )
+                    continue;
 
-            if( m_start == item.GetPosition() )
-                m_startIsDangling = false;
+                return true;
+            }
 
-            if( m_end == item.GetPosition() )
-                m_endIsDangling = false;
+            return false;
+        };
 
-            if( (m_startIsDangling == false) && (m_endIsDangling == false) )
-                break;
-        }
+        m_startIsDangling = !isConnected( m_start );
+        m_endIsDangling = !isConnected( m_end );
     }
     else if( GetLayer() == LAYER_BUS || GetLayer() == LAYER_NOTES )
     {
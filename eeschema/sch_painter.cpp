@@ -133,8 +133,13 @@ static LIB_PART* dummy()
 }
 
 
+///> Number of oriented parts cached before the deleted parts are first pruned
+static const size_t MIN_ORIENTED_PARTS_PRUNE_SIZE = 64;
+
+
 SCH_PAINTER::SCH_PAINTER( GAL* aGal ) :
-    KIGFX::PAINTER (aGal)
+    KIGFX::PAINTER (aGal),
+    m_orientedPartsPruneSize( MIN_ORIENTED_PARTS_PRUNE_SIZE )
 { }
 
 
@@ -1263,29 +1268,94 @@ static void orientPart( LIB_PART* part, int orientation )
 }
 
 
+void SCH_PAINTER::pruneOrientedParts()
+{
+    for( auto it = m_orientedParts.begin(); it != m_orientedParts.end(); )
+    {
+        if( it->first.m_part.expired() )
+            it = m_orientedParts.erase( it );
+        else
+            ++it;
+    }
+
+    // Prune again once the cache has doubled, so the cost of the pruning stays proportional
+    // to the number of added copies
+    m_orientedPartsPruneSize = std::max( 2 * m_orientedParts.size(),
+                                         MIN_ORIENTED_PARTS_PRUNE_SIZE );
+}
+
+
+SCH_PAINTER::ORIENTED_PART& SCH_PAINTER::getOrientedPart( const PART_SPTR& aPart, int aUnit,
+                                                           int aConvert, int aOrientation )
+{
+    ORIENTED_PART_KEY key = { aPart, aUnit, aConvert, aOrientation };
+    auto              it = m_orientedParts.find( key );
+
+    if( it != m_orientedParts.end() )
+        return it->second;
+
+    if( m_orientedParts.size() >= m_orientedPartsPruneSize )
+        pruneOrientedParts();
+
+    ORIENTED_PART& oriented = m_orientedParts[ key ];
+
+    // Copy the source so we can re-orient it, without the items of the other units and body
+    // styles: each component only resets and walks the items it draws
+    oriented.m_part = std::make_shared<LIB_PART>( *aPart );
+    oriented.m_partFlags = oriented.m_part->GetFlags();
+
+    std::vector<LIB_ITEM*> otherItems;
+
+    for( auto& item : oriented.m_part->GetDrawItems() )
+    {
+        if( ( aUnit && item.GetUnit() && item.GetUnit() != aUnit )
+                || ( aConvert && item.GetConvert() && item.GetConvert() != aConvert ) )
+        {
+            otherItems.push_back( &item );
+        }
+    }
+
+    for( LIB_ITEM* item : otherItems )
+        oriented.m_part->RemoveDrawItem( item );
+
+    orientPart( oriented.m_part.get(), aOrientation );
+
+    for( auto& item : oriented.m_part->GetDrawItems() )
+        oriented.m_itemFlags.push_back( item.GetFlags() );
+
+    return oriented;
+}
+
+
 void SCH_PAINTER::draw( SCH_COMPONENT *aComp, int aLayer )
 {
     PART_SPTR originalPartSptr = aComp->GetPartRef().lock();
 
     // Use dummy part if the actual couldn't be found (or couldn't be locked).
-    LIB_PART* originalPart = originalPartSptr ? originalPartSptr.get() : dummy();
+    if( !originalPartSptr )
+        originalPartSptr = dummy()->SharedPtr();
 
-    // Copy the source so we can re-orient and translate it.
-    LIB_PART tempPart( *originalPart );
+    // The oriented copy of the part is shared by all the components of this part, unit, body
+    // style and orientation, only the flags of its items are set for this component.
+    ORIENTED_PART& oriented = getOrientedPart( originalPartSptr, aComp->GetUnit(),
+                                               aComp->GetConvert(), aComp->GetOrientation() );
+    LIB_PART*      tempPart = oriented.m_part.get();
 
-    tempPart.SetFlags( aComp->GetFlags() );
+    tempPart->ClearFlags();
+    tempPart->SetFlags( oriented.m_partFlags | aComp->GetFlags() );
 
-    orientPart( &tempPart, aComp->GetOrientation());
+    size_t itemIndex = 0;
 
-    for( auto& tempItem : tempPart.GetDrawItems() )
+    for( auto& tempItem : tempPart->GetDrawItems() )
     {
+        tempItem.ClearFlags();
+        tempItem.SetFlags( oriented.m_itemFlags[ itemIndex++ ] );
         tempItem.SetFlags( aComp->GetFlags() );     // SELECTED, HIGHLIGHTED, BRIGHTENED
-        tempItem.MoveTo( tempItem.GetPosition() + (wxPoint) mapCoords( aComp->GetPosition()));
     }
 
     // Copy the pin info from the component to the temp pins
     LIB_PINS tempPins;
-    tempPart.GetPins( tempPins, aComp->GetUnit(), aComp->GetConvert() );
+    tempPart->GetPins( tempPins, aComp->GetUnit(), aComp->GetConvert() );
     const SCH_PINS& compPins = aComp->GetPins();
 
     for( unsigned i = 0; i < tempPins.size() && i < compPins.size(); ++ i )
@@ -1300,7 +1370,13 @@ void SCH_PAINTER::draw( SCH_COMPONENT *aComp, int aLayer )
             tempPin->SetFlags( IS_DANGLING );
     }
 
-    draw( &tempPart, aLayer, false, aComp->GetUnit(), aComp->GetConvert() );
+    // The part is drawn around the origin, translated to the component position
+    m_gal->Save();
+    m_gal->Translate( aComp->GetPosition() );
+
+    draw( tempPart, aLayer, false, aComp->GetUnit(), aComp->GetConvert() );
+
+    m_gal->Restore();
 
     // The fields are SCH_COMPONENT-specific so don't need to be copied/oriented/translated
     std::vector<SCH_FIELD*> fields;
@@ -26,9 +26,14 @@
 #define __SCH_PAINTER_H
 
 #include <sch_component.h>
+#include <class_libentry.h>
 
 #include <painter.h>
 
+#include <map>
+#include <tuple>
+#include <vector>
+
 
 class LIB_RECTANGLE;
 class LIB_PIN;
@@ -172,7 +177,53 @@ private:
 
     void triLine ( const VECTOR2D &a, const VECTOR2D &b, const VECTOR2D &c );
 
+    /**
+     * A copy of the items of a unit and body style of a library part, oriented as a
+     * component.  It is shared by all the components of this part, unit, body style and
+     * orientation: each one draws it translated to its own position.
+     */
+    struct ORIENTED_PART
+    {
+        PART_SPTR                 m_part;         ///< The oriented copy
+        STATUS_FLAGS              m_partFlags;    ///< Flags of the library part
+        std::vector<STATUS_FLAGS> m_itemFlags;    ///< Flags of the library part items
+    };
+
+    struct ORIENTED_PART_KEY
+    {
+        PART_REF m_part;
+        int      m_unit;
+        int      m_convert;
+        int      m_orientation;
+
+        bool operator<( const ORIENTED_PART_KEY& aOther ) const
+        {
+            // The parts are compared by owner: the key of a deleted part cannot match a new
+            // part allocated at the same address
+            if( m_part.owner_before( aOther.m_part ) )
+                return true;
+
+            if( aOther.m_part.owner_before( m_part ) )
+                return false;
+
+            return std::tie( m_unit, m_convert, m_orientation )
+                    < std::tie( aOther.m_unit, aOther.m_convert, aOther.m_orientation );
+        }
+    };
+
+    ORIENTED_PART& getOrientedPart( const PART_SPTR& aPart, int aUnit, int aConvert,
+                                    int aOrientation );
+
+    ///> Removes the oriented copies of the deleted library parts
+    void pruneOrientedParts();
+
     SCH_RENDER_SETTINGS m_schSettings;
+
+    ///> Oriented copies of the library parts, by part, unit, body style and orientation
+    std::map<ORIENTED_PART_KEY, ORIENTED_PART> m_orientedParts;
+
+    ///> Size of m_orientedParts which triggers the next pruning
+    size_t m_orientedPartsPruneSize;
 };
 
 }; // namespace KIGFX
@@ -113,6 +113,17 @@ wxString SCH_PIN::GetDefaultNetName( const SCH_SHEET_PATH aPath )
 }
 
 
+void SCH_PIN::ClearDefaultNetName( const SCH_SHEET_PATH* aPath )
+{
+    std::lock_guard<std::mutex> lock( m_netmap_mutex );
+
+    if( aPath )
+        m_net_name_map.erase( *aPath );
+    else
+        m_net_name_map.clear();
+}
+
+
 wxPoint SCH_PIN::GetTransformedPosition() const
 {
     TRANSFORM t = GetParentComponent()->GetTransform();
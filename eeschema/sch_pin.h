@@ -65,6 +65,14 @@ public:
 
     wxString GetDefaultNetName( const SCH_SHEET_PATH aPath );
 
+    /**
+     * Forgets the cached default net name of the pin, when the reference of its component
+     * changed.
+     *
+     * @param aPath is the sheet path of the name to forget, or nullptr for all the paths
+     */
+    void ClearDefaultNetName( const SCH_SHEET_PATH* aPath );
+
     wxString GetSelectMenuText( EDA_UNITS_T aUnits ) const override;
     void GetMsgPanelInfo( EDA_UNITS_T aUnits, MSG_PANEL_ITEMS& aList ) override;
 
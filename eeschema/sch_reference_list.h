@@ -39,7 +39,9 @@
 #include <sch_component.h>
 #include <sch_text.h>
 
+#include <algorithm>
 #include <map>
+#include <numeric>
 
 class SCH_REFERENCE;
 class SCH_REFERENCE_LIST;
@@ -350,7 +352,7 @@ public:
      */
     void SortByXCoordinate()
     {
-        sort( componentFlatList.begin(), componentFlatList.end(), sortByXPosition );
+        sortList( sortByXPosition );
     }
 
     /**
@@ -369,7 +371,7 @@ public:
      */
     void SortByYCoordinate()
     {
-        sort( componentFlatList.begin(), componentFlatList.end(), sortByYPosition );
+        sortList( sortByYPosition );
     }
 
     /**
@@ -379,7 +381,7 @@ public:
      */
     void SortByTimeStamp()
     {
-        sort( componentFlatList.begin(), componentFlatList.end(), sortByTimeStamp );
+        sortList( sortByTimeStamp );
     }
 
     /**
@@ -399,7 +401,7 @@ public:
      */
     void SortByRefAndValue()
     {
-        sort( componentFlatList.begin(), componentFlatList.end(), sortByRefAndValue );
+        sortList( sortByRefAndValue );
     }
 
     /**
@@ -415,40 +417,9 @@ public:
      */
     void SortByReferenceOnly()
     {
-        sort( componentFlatList.begin(), componentFlatList.end(), sortByReferenceOnly );
+        sortList( sortByReferenceOnly );
     }
 
-    /**
-     * searches the sorted list of components for a another component with the same
-     * reference and a given part unit.  Use this method to manage components with
-     * multiple parts per package.
-     * @param aIndex = index in aComponentsList for of given SCH_REFERENCE item to test.
-     * @param aUnit = the given unit number to search
-     * @return index in aComponentsList if found or -1 if not found
-     */
-    int FindUnit( size_t aIndex, int aUnit );
-
-    /**
-     * Function GetRefsInUse
-     * adds all the reference designator numbers greater than \a aMinRefId to \a aIdList
-     * skipping the reference at \a aIndex.
-     * @param aIndex = the current component index to use for reference prefix filtering.
-     * @param aIdList = the buffer to fill
-     * @param aMinRefId = the min id value to store. all values < aMinRefId are ignored
-     */
-    void GetRefsInUse( int aIndex, std::vector< int >& aIdList, int aMinRefId );
-
-    /**
-     * Function GetLastReference
-     * returns the last used (greatest) reference number in the reference list
-     * for the prefix reference given by \a aIndex.  The component list must be
-     * sorted.
-     *
-     * @param aIndex The index of the reference item used for the search pattern.
-     * @param aMinValue The minimum value for the current search.
-     */
-    int GetLastReference( int aIndex, int aMinValue );
-
 #if defined(DEBUG)
     void Show( const char* aPrefix = "" )
     {
@@ -492,17 +463,32 @@ private:
     static bool sortByReferenceOnly( const SCH_REFERENCE& item1, const SCH_REFERENCE& item2 );
 
     /**
-     * Function CreateFirstFreeRefId
-     * searches for the first free reference number in \a aListId of reference numbers in use.
-     * This function just searches for a hole in a list of incremented numbers, this list must
-     * be sorted by increasing values and each value can be stored only once.  The new value
-     * is added to the list.
-     * @see BuildRefIdInUseList to prepare this list
-     * @param aIdList The buffer that contains the reference numbers in use.
-     * @param aFirstValue The first expected free value
-     * @return The first free (not yet used) value.
+     * Function sortList
+     * sorts componentFlatList with \a aCompare.  The positions of the references are sorted
+     * rather than the references themselves, which are expensive to copy, and each reference
+     * is then moved once to its place.  The sort is stable: references which compare equal
+     * keep their order, so the annotation does not depend on the sort implementation.
      */
-    int CreateFirstFreeRefId( std::vector<int>& aIdList, int aFirstValue );
+    template <typename COMPARE>
+    void sortList( COMPARE aCompare )
+    {
+        std::vector<unsigned> order( componentFlatList.size() );
+        std::iota( order.begin(), order.end(), 0 );
+
+        std::stable_sort( order.begin(), order.end(),
+                [&]( unsigned a, unsigned b )
+                {
+                    return aCompare( componentFlatList[a], componentFlatList[b] );
+                } );
+
+        std::vector<SCH_REFERENCE> sorted;
+        sorted.reserve( order.size() );
+
+        for( unsigned idx : order )
+            sorted.push_back( std::move( componentFlatList[idx] ) );
+
+        componentFlatList.swap( sorted );
+    }
 };
 
 #endif    // _SCH_REFERENCE_LIST_H_
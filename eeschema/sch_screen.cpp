@@ -56,6 +56,7 @@
 #include <lib_pin.h>
 #include <symbol_lib_table.h>
 #include <tool/common_tools.h>
+#include <geometry/rtree.h>
 
 #include <thread>
 #include <algorithm>
@@ -69,6 +70,12 @@
 
 #define EESCHEMA_FILE_STAMP   "EESchema"
 
+/* The pen widths and the hit test tolerances of the items are not all included in their
+ * bounding boxes, so the boxes are inflated by this margin (in internal units) in the
+ * item index.
+ */
+#define ITEM_INDEX_MARGIN     50
+
 /* Default zoom values. Limited to these values to keep a decent size
  * to menus
  */
@@ -101,6 +108,99 @@ static GRID_TYPE SchematicGridList[] = {
 };
 
 
+struct SCH_SCREEN::ITEM_INDEX
+{
+    struct ENTRY
+    {
+        int      m_rank;            ///< Order of the item in the draw list
+        EDA_RECT m_bbox;            ///< Box the item was inserted with
+    };
+
+    RTree<SCH_ITEM*, int, 2, double>     m_tree;
+    std::unordered_map<SCH_ITEM*, ENTRY> m_entries;
+    int                                  m_nextRank = 0;
+
+    static EDA_RECT indexBox( SCH_ITEM* aItem )
+    {
+        EDA_RECT bbox = aItem->GetBoundingBox();
+        bbox.Normalize();
+
+        // Component pins end outside of the body
+        std::vector<wxPoint> points;
+        aItem->GetConnectionPoints( points );
+
+        for( const wxPoint& point : points )
+            bbox.Merge( point );
+
+        // Sheet pins are found through their sheet
+        if( aItem->Type() == SCH_SHEET_T )
+        {
+            for( SCH_SHEET_PIN& pin : static_cast<SCH_SHEET*>( aItem )->GetPins() )
+            {
+                EDA_RECT pinBox = pin.GetBoundingBox();
+                pinBox.Normalize();
+                bbox.Merge( pinBox );
+            }
+        }
+
+        bbox.Inflate( ITEM_INDEX_MARGIN );
+        return bbox;
+    }
+
+    /// Items must be inserted in draw list order
+    void Insert( SCH_ITEM* aItem )
+    {
+        ENTRY entry = { m_nextRank++, indexBox( aItem ) };
+
+        insertBox( aItem, entry.m_bbox );
+        m_entries[ aItem ] = entry;
+    }
+
+    void Remove( SCH_ITEM* aItem )
+    {
+        auto it = m_entries.find( aItem );
+
+        if( it == m_entries.end() )
+            return;
+
+        // The item may have been moved since, so use the box it was inserted with
+        removeBox( aItem, it->second.m_bbox );
+        m_entries.erase( it );
+    }
+
+    /// Reinsert a modified item with its new box, at its place in the draw list order
+    bool Update( SCH_ITEM* aItem )
+    {
+        auto it = m_entries.find( aItem );
+
+        if( it == m_entries.end() )
+            return false;
+
+        removeBox( aItem, it->second.m_bbox );
+        it->second.m_bbox = indexBox( aItem );
+        insertBox( aItem, it->second.m_bbox );
+        return true;
+    }
+
+private:
+    void insertBox( SCH_ITEM* aItem, const EDA_RECT& aBox )
+    {
+        const int mmin[2] = { aBox.GetX(), aBox.GetY() };
+        const int mmax[2] = { aBox.GetRight(), aBox.GetBottom() };
+
+        m_tree.Insert( mmin, mmax, aItem );
+    }
+
+    void removeBox( SCH_ITEM* aItem, const EDA_RECT& aBox )
+    {
+        const int mmin[2] = { aBox.GetX(), aBox.GetY() };
+        const int mmax[2] = { aBox.GetRight(), aBox.GetBottom() };
+
+        m_tree.Remove( mmin, mmax, aItem );
+    }
+};
+
+
 SCH_SCREEN::SCH_SCREEN( KIWAY* aKiway ) :
     BASE_SCREEN( SCH_SCREEN_T ),
     KIWAY_HOLDER( aKiway, KIWAY_HOLDER::HOLDER_TYPE::SCREEN ),
@@ -155,6 +255,86 @@ void SCH_SCREEN::DecRefCount()
 }
 
 
+void SCH_SCREEN::Append( SCH_ITEM* aItem )
+{
+    m_drawList.Append( aItem );
+    --m_modification_sync;
+
+    if( m_itemIndex )
+        m_itemIndex->Insert( aItem );
+}
+
+
+void SCH_SCREEN::Append( DLIST< SCH_ITEM >& aList )
+{
+    m_drawList.Append( aList );
+    --m_modification_sync;
+
+    InvalidateItemIndex();
+}
+
+
+void SCH_SCREEN::InvalidateItemIndex()
+{
+    m_itemIndex.reset();
+}
+
+
+bool SCH_SCREEN::UpdateItemIndex( EDA_ITEM* aItem )
+{
+    // Pins, fields and sheet pins are indexed with their parent
+    if( aItem->Type() == SCH_PIN_T || aItem->Type() == SCH_FIELD_T
+            || aItem->Type() == SCH_SHEET_PIN_T )
+        aItem = aItem->GetParent();
+
+    SCH_ITEM* item = dynamic_cast<SCH_ITEM*>( aItem );
+
+    if( !item )
+        return false;
+
+    // Nothing to update if the index is not built yet, it will be built from the current
+    // positions of the items, but the item must still be found on this screen
+    if( !m_itemIndex )
+        return CheckIfOnDrawList( item );
+
+    return m_itemIndex->Update( item );
+}
+
+
+void SCH_SCREEN::queryItems( const wxPoint& aPosition, int aAccuracy,
+                             std::vector<SCH_ITEM*>& aItems ) const
+{
+    if( !m_itemIndex )
+    {
+        m_itemIndex.reset( new ITEM_INDEX );
+
+        for( SCH_ITEM* item = m_drawList.begin(); item; item = item->Next() )
+            m_itemIndex->Insert( item );
+    }
+
+    const int mmin[2] = { aPosition.x - aAccuracy, aPosition.y - aAccuracy };
+    const int mmax[2] = { aPosition.x + aAccuracy, aPosition.y + aAccuracy };
+
+    std::vector<std::pair<int, SCH_ITEM*>> found;
+    const auto& entries = m_itemIndex->m_entries;
+
+    auto visitor = [&found, &entries]( SCH_ITEM* aItem ) -> bool
+    {
+        found.emplace_back( entries.at( aItem ).m_rank, aItem );
+        return true;
+    };
+
+    m_itemIndex->m_tree.Search( mmin, mmax, visitor );
+
+    std::sort( found.begin(), found.end() );
+
+    aItems.clear();
+
+    for( const auto& entry : found )
+        aItems.push_back( entry.second );
+}
+
+
 void SCH_SCREEN::Append( SCH_SCREEN* aScreen )
 {
     wxCHECK_RET( aScreen, "Invalid screen object." );
@@ -166,6 +346,9 @@ void SCH_SCREEN::Append( SCH_SCREEN* aScreen )
     // This screen owns the objects now.  This prevents the object from being delete when
     // aSheet is deleted.
     aScreen->m_drawList.SetOwnership( false );
+
+    InvalidateItemIndex();
+    aScreen->InvalidateItemIndex();
 }
 
 
@@ -183,12 +366,16 @@ void SCH_SCREEN::Clear()
 void SCH_SCREEN::FreeDrawList()
 {
     m_drawList.DeleteAll();
+    InvalidateItemIndex();
 }
 
 
 void SCH_SCREEN::Remove( SCH_ITEM* aItem )
 {
     m_drawList.Remove( aItem );
+
+    if( m_itemIndex )
+        m_itemIndex->Remove( aItem );
 }
 
 
@@ -205,11 +392,12 @@ void SCH_SCREEN::DeleteItem( SCH_ITEM* aItem )
         SCH_SHEET* sheet = sheetPin->GetParent();
         wxCHECK_RET( sheet, wxT( "Sheet label parent not properly set, bad programmer!" ) );
         sheet->RemovePin( sheetPin );
+        InvalidateItemIndex();
         return;
     }
     else
     {
-        m_drawList.Remove( aItem );
+        Remove( aItem );
         delete aItem;
     }
 }
@@ -234,8 +422,11 @@ bool SCH_SCREEN::CheckIfOnDrawList( SCH_ITEM* aItem )
 SCH_ITEM* SCH_SCREEN::GetItem( const wxPoint& aPosition, int aAccuracy, KICAD_T aType ) const
 {
     KICAD_T types[] = { aType, EOT };
+    std::vector<SCH_ITEM*> candidates;
 
-    for( SCH_ITEM* item = m_drawList.begin(); item; item = item->Next() )
+    queryItems( aPosition, aAccuracy, candidates );
+
+    for( SCH_ITEM* item : candidates )
     {
         switch( item->Type() )
         {
@@ -299,6 +490,7 @@ void SCH_SCREEN::ReplaceWires( DLIST< SCH_ITEM >& aWireList )
     }
 
     m_drawList.Append( aWireList );
+    InvalidateItemIndex();
 }
 
 
@@ -353,8 +545,11 @@ bool SCH_SCREEN::IsJunctionNeeded( const wxPoint& aPosition, bool aNew )
     int     pin_count = 0;
 
     std::vector<SCH_LINE*> lines[ sizeof( layers ) ];
+    std::vector<SCH_ITEM*> candidates;
 
-    for( SCH_ITEM* item = m_drawList.begin(); item; item = item->Next() )
+    queryItems( aPosition, 0, candidates );
+
+    for( SCH_ITEM* item : candidates )
     {
         if( item->GetEditFlags() & STRUCT_DELETED )
             continue;
@@ -520,6 +715,9 @@ void SCH_SCREEN::UpdateSymbolLinks( bool aForce )
         // even if the libraries don't change.
         else
             SCH_COMPONENT::UpdatePins( c );
+
+        // The component boxes depend on their symbol
+        InvalidateItemIndex();
     }
 }
 
@@ -620,11 +818,23 @@ void SCH_SCREEN::ClearDrawingState()
 LIB_PIN* SCH_SCREEN::GetPin( const wxPoint& aPosition, SCH_COMPONENT** aComponent,
                              bool aEndPointOnly ) const
 {
-    SCH_ITEM*       item;
     SCH_COMPONENT*  component = NULL;
     LIB_PIN*        pin = NULL;
 
-    for( item = m_drawList.begin(); item; item = item->Next() )
+    std::vector<SCH_ITEM*> candidates;
+
+    if( aEndPointOnly )
+    {
+        queryItems( aPosition, 0, candidates );
+    }
+    else
+    {
+        // The pin names and numbers may not be included in the indexed boxes
+        for( SCH_ITEM* item = m_drawList.begin(); item; item = item->Next() )
+            candidates.push_back( item );
+    }
+
+    for( SCH_ITEM* item : candidates )
     {
         if( item->Type() != SCH_COMPONENT_T )
             continue;
@@ -693,8 +903,11 @@ SCH_SHEET* SCH_SCREEN::GetSheet( const wxString& aName )
 SCH_SHEET_PIN* SCH_SCREEN::GetSheetLabel( const wxPoint& aPosition )
 {
     SCH_SHEET_PIN* sheetPin = NULL;
+    std::vector<SCH_ITEM*> candidates;
 
-    for( SCH_ITEM* item = m_drawList.begin(); item; item = item->Next() )
+    queryItems( aPosition, 0, candidates );
+
+    for( SCH_ITEM* item : candidates )
     {
         if( item->Type() != SCH_SHEET_T )
             continue;
@@ -712,10 +925,12 @@ SCH_SHEET_PIN* SCH_SCREEN::GetSheetLabel( const wxPoint& aPosition )
 
 int SCH_SCREEN::CountConnectedItems( const wxPoint& aPos, bool aTestJunctions ) const
 {
-    SCH_ITEM* item;
     int       count = 0;
+    std::vector<SCH_ITEM*> candidates;
 
-    for( item = m_drawList.begin(); item; item = item->Next() )
+    queryItems( aPos, 0, candidates );
+
+    for( SCH_ITEM* item : candidates )
     {
         if( item->Type() == SCH_JUNCTION_T  && !aTestJunctions )
             continue;
@@ -787,9 +1002,11 @@ bool SCH_SCREEN::TestDanglingEnds()
     for( item = m_drawList.begin(); item; item = item->Next() )
         item->GetEndPoints( endPoints );
 
+    DANGLING_END_INDEX index( endPoints );
+
     for( item = m_drawList.begin(); item; item = item->Next() )
     {
-        if( item->UpdateDanglingState( endPoints ) )
+        if( item->UpdateDanglingState( index ) )
             hasStateChanged = true;
     }
 
@@ -800,8 +1017,11 @@ bool SCH_SCREEN::TestDanglingEnds()
 SCH_LINE* SCH_SCREEN::GetWireOrBus( const wxPoint& aPosition )
 {
     static KICAD_T types[] = { SCH_LINE_LOCATE_WIRE_T, SCH_LINE_LOCATE_BUS_T, EOT };
+    std::vector<SCH_ITEM*> candidates;
 
-    for( SCH_ITEM* item = m_drawList.begin(); item; item = item->Next() )
+    queryItems( aPosition, 0, candidates );
+
+    for( SCH_ITEM* item : candidates )
     {
         if( item->IsType( types ) && item->HitTest( aPosition ) )
             return (SCH_LINE*) item;
@@ -814,7 +1034,11 @@ SCH_LINE* SCH_SCREEN::GetWireOrBus( const wxPoint& aPosition )
 SCH_LINE* SCH_SCREEN::GetLine( const wxPoint& aPosition, int aAccuracy, int aLayer,
                                SCH_LINE_TEST_T aSearchType )
 {
-    for( SCH_ITEM* item = m_drawList.begin(); item; item = item->Next() )
+    std::vector<SCH_ITEM*> candidates;
+
+    queryItems( aPosition, aAccuracy, candidates );
+
+    for( SCH_ITEM* item : candidates )
     {
         if( item->Type() != SCH_LINE_T )
             continue;
@@ -847,7 +1071,11 @@ SCH_LINE* SCH_SCREEN::GetLine( const wxPoint& aPosition, int aAccuracy, int aLay
 
 SCH_TEXT* SCH_SCREEN::GetLabel( const wxPoint& aPosition, int aAccuracy )
 {
-    for( SCH_ITEM* item = m_drawList.begin(); item; item = item->Next() )
+    std::vector<SCH_ITEM*> candidates;
+
+    queryItems( aPosition, aAccuracy, candidates );
+
+    for( SCH_ITEM* item : candidates )
     {
         switch( item->Type() )
         {
@@ -1074,6 +1302,13 @@ void SCH_SCREENS::ClearAnnotation()
 }
 
 
+void SCH_SCREENS::InvalidateItemIndexes()
+{
+    for( size_t i = 0;  i < m_screens.size();  i++ )
+        m_screens[i]->InvalidateItemIndex();
+}
+
+
 void SCH_SCREENS::ClearAnnotationOfNewSheetPaths( SCH_SHEET_LIST& aInitialSheetPathList )
 {
     // Clear the annotation for the components inside new sheetpaths
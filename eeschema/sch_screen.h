@@ -25,6 +25,7 @@
 #ifndef SCREEN_H
 #define SCREEN_H
 
+#include <memory>
 #include <unordered_set>
 #include <macros.h>
 #include <dlist.h>
@@ -94,6 +95,17 @@ private:
     /// List of bus aliases stored in this screen
     std::unordered_set< std::shared_ptr< BUS_ALIAS > > m_aliases;
 
+    /// Spatial index of m_drawList used by the position queries, built on demand
+    struct ITEM_INDEX;
+    mutable std::unique_ptr<ITEM_INDEX> m_itemIndex;
+
+    /**
+     * Fill \a aItems with the items of m_drawList whose bounding box is within \a aAccuracy
+     * of \a aPosition, in draw list order.
+     */
+    void queryItems( const wxPoint& aPosition, int aAccuracy,
+                     std::vector<SCH_ITEM*>& aItems ) const;
+
 public:
 
     /**
@@ -151,11 +163,7 @@ public:
      */
     SCH_ITEM* GetDrawItems() const                          { return m_drawList.begin(); }
 
-    void Append( SCH_ITEM* aItem )
-    {
-        m_drawList.Append( aItem );
-        --m_modification_sync;
-    }
+    void Append( SCH_ITEM* aItem );
 
     /**
      * Copy the contents of \a aScreen into this #SCH_SCREEN object.
@@ -174,11 +182,28 @@ public:
      *
      * @param aList A reference to a #DLIST containing the #SCH_ITEM to add to the sheet.
      */
-    void Append( DLIST< SCH_ITEM >& aList )
-    {
-        m_drawList.Append( aList );
-        --m_modification_sync;
-    }
+    void Append( DLIST< SCH_ITEM >& aList );
+
+    /**
+     * Invalidate the spatial index used by the position queries (GetItem(), GetLine(),
+     * IsJunctionNeeded(), etc.).  It is rebuilt by the next query.
+     *
+     * Adding and removing items through this class keeps the index up to date.  It must be
+     * invalidated when many items of the screen are modified in place, see UpdateItemIndex()
+     * for a single item.
+     */
+    void InvalidateItemIndex();
+
+    /**
+     * Update the box of \a aItem in the spatial index, after it was moved or otherwise
+     * modified in place.  The pins, fields and sheet pins update the box of their parent.
+     *
+     * If the index is not built yet, there is nothing to update, and only the items of this
+     * screen are looked for.
+     *
+     * @return true if the item is on this screen, false otherwise.
+     */
+    bool UpdateItemIndex( EDA_ITEM* aItem );
 
     /**
      * Delete all draw items and clears the project settings.
@@ -507,6 +532,12 @@ public:
      */
     void ClearAnnotation();
 
+    /**
+     * Invalidate the spatial index of all the screens, after items of several screens were
+     * modified in place.
+     */
+    void InvalidateItemIndexes();
+
     /**
      * Clear the annotation for the components inside new sheetpaths
      * when a complex hierarchy is modified and new sheetpaths added
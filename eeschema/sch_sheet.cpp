@@ -785,12 +785,12 @@ void SCH_SHEET::GetEndPoints( std::vector <DANGLING_END_ITEM>& aItemList )
 }
 
 
-bool SCH_SHEET::UpdateDanglingState( std::vector<DANGLING_END_ITEM>& aItemList )
+bool SCH_SHEET::UpdateDanglingState( const DANGLING_END_INDEX& aIndex )
 {
     bool changed = false;
 
     for( SCH_SHEET_PIN& pinsheet : GetPins() )
-        changed |= pinsheet.UpdateDanglingState( aItemList );
+        changed |= pinsheet.UpdateDanglingState( aIndex );
 
     return changed;
 }
@@ -208,6 +208,10 @@ void SCH_SHEET_PATH::UpdateAllScreenReferences()
 
         t = t->Next();
     }
+
+    // The references and the units of the components of this sheet path changed their boxes
+    if( LastScreen() )
+        LastScreen()->InvalidateItemIndex();
 }
 
 
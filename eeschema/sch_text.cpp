@@ -330,7 +330,7 @@ void SCH_TEXT::GetEndPoints( std::vector <DANGLING_END_ITEM>& aItemList )
 }
 
 
-bool SCH_TEXT::UpdateDanglingState( std::vector<DANGLING_END_ITEM>& aItemList )
+bool SCH_TEXT::UpdateDanglingState( const DANGLING_END_INDEX& aIndex )
 {
     // Normal text labels cannot be tested for dangling ends.
     if( Type() == SCH_TEXT_T )
@@ -340,70 +340,60 @@ bool SCH_TEXT::UpdateDanglingState( std::vector<DANGLING_END_ITEM>& aItemList )
     m_isDangling = true;
     m_connectionType = CONNECTION_NONE;
 
-    for( unsigned ii = 0; ii < aItemList.size(); ii++ )
-    {
-        DANGLING_END_ITEM& item = aItemList[ii];
+    const DANGLING_END_ITEM* pointItem = nullptr;
 
-        if( item.GetItem() == this )
+    for( const DANGLING_END_ITEM* item : aIndex.ItemsAt( GetTextPos() ) )
+    {
+        if( item->GetItem() == this )
             continue;
 
-        switch( item.GetType() )
+        switch( item->GetType() )
         {
         case PIN_END:
         case LABEL_END:
         case SHEET_LABEL_END:
         case NO_CONNECT_END:
-            if( GetTextPos() == item.GetPosition() )
-            {
-                m_isDangling = false;
-
-                if( item.GetType() != PIN_END )
-                    m_connected_items.insert( static_cast< SCH_ITEM* >( item.GetItem() ) );
-            }
-
-            break;
-
-
-        case BUS_START_END:
-            m_connectionType = CONNECTION_BUS;
-            // fall through
-
-        case WIRE_START_END:
-        {
-            // These schematic items have created 2 DANGLING_END_ITEM one per end.  But being
-            // a paranoid programmer, I'll check just in case.
-            ii++;
-
-            wxCHECK_MSG( ii < aItemList.size(), previousState != m_isDangling,
-                         wxT( "Dangling end type list overflow.  Bad programmer!" ) );
-
-            DANGLING_END_ITEM & nextItem = aItemList[ii];
-            m_isDangling = !IsPointOnSegment( item.GetPosition(), nextItem.GetPosition(), GetTextPos() );
-
-            if( !m_isDangling )
-            {
-                if( m_connectionType != CONNECTION_BUS )
-                    m_connectionType = CONNECTION_NET;
-
-                // Add the line to the connected items, since it won't be picked
-                // up by a search of intersecting connection points
-                auto sch_item = static_cast< SCH_ITEM* >( item.GetItem() );
-                AddConnectionTo( sch_item );
-                sch_item->AddConnectionTo( this );
-            }
-        }
+            pointItem = item;
             break;
 
         default:
             break;
         }
 
-        if( !m_isDangling )
+        if( pointItem )
             break;
     }
 
-    if( m_isDangling )
-        m_connectionType = CONNECTION_NONE;
+    // Labels also connect anywhere on a wire or bus segment
+    std::vector<DANGLING_END_INDEX::SEGMENT> segments;
+    aIndex.SegmentsAt( GetTextPos(), segments );
+
+    const DANGLING_END_INDEX::SEGMENT* segment = segments.empty() ? nullptr : &segments[0];
+
+    // The first of both in list order is the one connected to
+    if( segment && pointItem
+            && std::less<const DANGLING_END_ITEM*>()( pointItem, segment->m_start ) )
+        segment = nullptr;
+
+    if( segment )
+    {
+        m_isDangling = false;
+        m_connectionType = ( segment->m_start->GetType() == BUS_START_END ) ? CONNECTION_BUS
+                                                                            : CONNECTION_NET;
+
+        // Add the line to the connected items, since it won't be picked
+        // up by a search of intersecting connection points
+        auto sch_item = static_cast< SCH_ITEM* >( segment->m_start->GetItem() );
+        AddConnectionTo( sch_item );
+        sch_item->AddConnectionTo( this );
+    }
+    else if( pointItem )
+    {
+        m_isDangling = false;
+
+        if( pointItem->GetType() != PIN_END )
+            m_connected_items.insert( static_cast< SCH_ITEM* >( pointItem->GetItem() ) );
+    }
 
     return previousState != m_isDangling;
 }
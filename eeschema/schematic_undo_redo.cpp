@@ -33,6 +33,7 @@
 #include <sch_line.h>
 #include <sch_no_connect.h>
 #include <sch_component.h>
+#include <sch_component_table.h>
 #include <sch_sheet.h>
 #include <sch_bitmap.h>
 #include <sch_view.h>
@@ -261,6 +262,9 @@ void SCH_EDIT_FRAME::SaveCopyInUndoList( const PICKED_ITEMS_LIST& aItemsList,
 
 void SCH_EDIT_FRAME::PutDataInPreviousState( PICKED_ITEMS_LIST* aList, bool aRedoCommand )
 {
+    // Rolled back changes are not followed by OnModify()
+    m_componentTable->Invalidate();
+
     // Undo in the reverse order of list creation: (this can allow stacked changes like the
     // same item can be changed and deleted in the same complex command).
     for( int ii = aList->GetCount() - 1; ii >= 0; ii-- )
@@ -345,6 +349,8 @@ void SCH_EDIT_FRAME::PutDataInPreviousState( PICKED_ITEMS_LIST* aList, bool aRed
                 break;
             }
 
+            // The connectivity is only updated for the screens having dirty items
+            item->SetConnectivityDirty();
             AddToScreen( item );
         }
     }
@@ -753,6 +753,7 @@ bool SCH_EDIT_FRAME::EditSheet( SCH_SHEET* aSheet, SCH_SHEET_PATH* aHierarchy,
         *aClearAnnotationNewItems = clearAnnotation;
 
     GetCanvas()->GetView()->Update( aSheet );
+    UpdateItemIndex( aSheet );
 
     OnModify();
 
@@ -0,0 +1,264 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * https://www.gnu.org/licenses/gpl-3.0.html
+ * or you may search the http://www.gnu.org website for the version 3 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include "sim_batch_runner.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <string>
+#include <thread>
+
+#include <widgets/progress_reporter.h>
+
+#include <wx/ffile.h>
+#include <wx/filename.h>
+#include <wx/utils.h>
+
+
+SIM_BATCH_RUNNER::SIM_BATCH_RUNNER( const wxString& aNetlist, const wxString& aOutputDir ) :
+        m_outputDir( aOutputDir ),
+        m_simulator( wxT( "ngspice" ) ),
+        m_cancelled( false )
+{
+    size_t start = 0;
+
+    while( start < aNetlist.Len() )
+    {
+        size_t end = aNetlist.find( '\n', start );
+
+        if( end == wxString::npos )
+            end = aNetlist.Len();
+
+        wxString line = aNetlist.Mid( start, end - start );
+
+        if( line.EndsWith( wxT( "\r" ) ) )
+            line.RemoveLast();
+
+        m_netlist.push_back( line );
+        start = end + 1;
+    }
+}
+
+
+void SIM_BATCH_RUNNER::AddRun( const wxString& aName, const std::vector<wxString>& aDirectives )
+{
+    m_runs.push_back( { aName, aDirectives, false } );
+}
+
+
+void SIM_BATCH_RUNNER::AddParamSweep( const wxString& aParam, const std::vector<wxString>& aValues )
+{
+    for( size_t ii = 0; ii < aValues.size(); ii++ )
+    {
+        AddRun( wxString::Format( "%u_%s_%s", (unsigned) ii, aParam, aValues[ii] ),
+                { wxString::Format( ".param %s=%s", aParam, aValues[ii] ) } );
+    }
+}
+
+
+wxString SIM_BATCH_RUNNER::GetRunNetlist( size_t aRun ) const
+{
+    // The directives of the run go before the last .end line
+    size_t endLine = m_netlist.size();
+
+    for( size_t ii = m_netlist.size(); ii > 0; ii-- )
+    {
+        if( m_netlist[ii - 1].Strip( wxString::both ).IsSameAs( wxT( ".end" ), false ) )
+        {
+            endLine = ii - 1;
+            break;
+        }
+    }
+
+    wxString netlist;
+
+    for( size_t ii = 0; ii < endLine; ii++ )
+        netlist << m_netlist[ii] << '\n';
+
+    for( const wxString& directive : m_runs[aRun].m_directives )
+        netlist << directive << '\n';
+
+    if( endLine == m_netlist.size() )
+    {
+        netlist << wxT( ".end\n" );
+    }
+    else
+    {
+        for( size_t ii = endLine; ii < m_netlist.size(); ii++ )
+            netlist << m_netlist[ii] << '\n';
+    }
+
+    return netlist;
+}
+
+
+wxString SIM_BATCH_RUNNER::getRunFile( size_t aRun, const wxString& aExtension ) const
+{
+    return wxFileName( m_outputDir, m_runs[aRun].m_name, aExtension ).GetFullPath();
+}
+
+
+wxString SIM_BATCH_RUNNER::GetNetlistFile( size_t aRun ) const
+{
+    return getRunFile( aRun, wxT( "cir" ) );
+}
+
+
+wxString SIM_BATCH_RUNNER::GetRawFile( size_t aRun ) const
+{
+    return getRunFile( aRun, wxT( "raw" ) );
+}
+
+
+wxString SIM_BATCH_RUNNER::GetLogFile( size_t aRun ) const
+{
+    return getRunFile( aRun, wxT( "log" ) );
+}
+
+
+int SIM_BATCH_RUNNER::Run( PROGRESS_REPORTER* aReporter )
+{
+    for( RUN& run : m_runs )
+        run.m_success = false;
+
+    m_cancelled = false;
+
+    if( !wxFileName::DirExists( m_outputDir )
+            && !wxFileName::Mkdir( m_outputDir, wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL ) )
+        return (int) m_runs.size();
+
+    // The netlists are written and the command lines are built here: the threads only
+    // execute them.  The arguments are passed to ngspice as they are, without a shell.
+    std::vector<std::vector<std::string>> commands( m_runs.size() );
+
+    for( size_t ii = 0; ii < m_runs.size(); ii++ )
+    {
+        wxFFile file( GetNetlistFile( ii ), wxT( "wb" ) );
+
+        if( !file.IsOpened() || !file.Write( GetRunNetlist( ii ), wxConvUTF8 ) )
+            continue;
+
+        file.Close();
+
+        // Do not mistake the results of a previous run for the ones of this run
+        if( wxFileExists( GetRawFile( ii ) ) )
+            wxRemoveFile( GetRawFile( ii ) );
+
+        commands[ii] = { std::string( m_simulator.fn_str() ), "-b",
+                         "-r", std::string( GetRawFile( ii ).fn_str() ),
+                         "-o", std::string( GetLogFile( ii ).fn_str() ),
+                         std::string( GetNetlistFile( ii ).fn_str() ) };
+    }
+
+    std::vector<long>   status( m_runs.size(), -1 );
+    std::atomic<size_t> nextRun( 0 );
+    std::atomic<bool>   cancelled( false );
+
+    if( aReporter )
+        aReporter->SetMaxProgress( (int) m_runs.size() );
+
+    auto run_lambda = [&]() -> size_t
+    {
+        size_t num = 0;
+
+        for( size_t ii = nextRun++; ii < commands.size() && !cancelled; ii = nextRun++ )
+        {
+            if( !commands[ii].empty() )
+            {
+#if wxCHECK_VERSION( 3, 1, 0 )
+                std::vector<const char*> argv;
+#else
+                // wxExecute() only accepts a non const array before wxWidgets 3.1
+                std::vector<char*> argv;
+#endif
+
+                for( std::string& arg : commands[ii] )
+                    argv.push_back( &arg[0] );
+
+                argv.push_back( nullptr );
+
+                status[ii] = wxExecute( argv.data(),
+                                        wxEXEC_SYNC | wxEXEC_NOEVENTS | wxEXEC_HIDE_CONSOLE );
+                num++;
+            }
+
+            if( aReporter )
+            {
+                aReporter->AdvanceProgress();
+
+#if !wxCHECK_VERSION( 3, 1, 0 )
+                // The runs are executed by the main thread, which refreshes the reporter
+                if( !aReporter->KeepRefreshing() )
+                    cancelled = true;
+#endif
+            }
+        }
+
+        return num;
+    };
+
+#if wxCHECK_VERSION( 3, 1, 0 )
+    // Synchronous commands can be executed from any thread, so the runs are executed by
+    // worker threads and this thread only refreshes the progress reporter
+    size_t parallelThreadCount = std::max<size_t>( 1,
+            std::min<size_t>( std::thread::hardware_concurrency(), m_runs.size() ) );
+
+    std::vector<std::future<size_t>> returns( parallelThreadCount );
+
+    for( size_t ii = 0; ii < parallelThreadCount; ii++ )
+        returns[ii] = std::async( std::launch::async, run_lambda );
+
+    for( size_t ii = 0; ii < parallelThreadCount; ii++ )
+    {
+        // Here we balance returns with a 100ms timeout to allow UI updating
+        std::future_status threadStatus;
+
+        do
+        {
+            if( aReporter && !aReporter->KeepRefreshing() )
+                cancelled = true;
+
+            threadStatus = returns[ii].wait_for( std::chrono::milliseconds( 100 ) );
+        } while( threadStatus != std::future_status::ready );
+    }
+#else
+    // wxExecute() can only be called from the main thread
+    run_lambda();
+#endif
+
+    m_cancelled = cancelled;
+
+    int failures = 0;
+
+    for( size_t ii = 0; ii < m_runs.size(); ii++ )
+    {
+        m_runs[ii].m_success = ( status[ii] == 0 ) && wxFileExists( GetRawFile( ii ) );
+
+        if( !m_runs[ii].m_success )
+            failures++;
+    }
+
+    return failures;
+}
@@ -0,0 +1,117 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * https://www.gnu.org/licenses/gpl-3.0.html
+ * or you may search the http://www.gnu.org website for the version 3 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef SIM_BATCH_RUNNER_H
+#define SIM_BATCH_RUNNER_H
+
+#include <vector>
+
+#include <wx/string.h>
+
+class PROGRESS_REPORTER;
+
+/**
+ * Class SIM_BATCH_RUNNER
+ * runs a set of simulations of a netlist without the simulator GUI: parameter sweeps,
+ * corner cases...
+ *
+ * The netlist is exported once, each run only adds its own directives to it.  Each run is
+ * a separate ngspice process in batch mode, which writes the vectors of the simulation to a
+ * binary raw file (see SIM_RAW_FILE) rather than keeping them in memory.  The processes do
+ * not share the global state of the ngspice shared library, so with wxWidgets 3.1 or later
+ * as many runs as there are cores are executed concurrently by worker threads, while the
+ * calling thread keeps the progress reporter refreshed.  Older versions can only execute a
+ * process from the main thread, so the runs are then executed one by one, and Run() must
+ * be called from the main thread.
+ */
+class SIM_BATCH_RUNNER
+{
+public:
+    struct RUN
+    {
+        wxString              m_name;          ///< Name of the run and of its files
+        std::vector<wxString> m_directives;    ///< Lines added to the netlist by the run
+        bool                  m_success;       ///< The run produced its raw file
+    };
+
+    /**
+     * @param aNetlist is the netlist to simulate, including the simulation command, as
+     *                 exported by NETLIST_EXPORTER_PSPICE_SIM.
+     * @param aOutputDir is the directory of the netlist, raw and log files of the runs.
+     */
+    SIM_BATCH_RUNNER( const wxString& aNetlist, const wxString& aOutputDir );
+
+    /**
+     * Sets the ngspice executable, "ngspice" (searched in the path) by default.
+     */
+    void SetSimulator( const wxString& aCommand ) { m_simulator = aCommand; }
+
+    /**
+     * Adds a run of the netlist with additional directives (.param, .temp, .lib...).
+     */
+    void AddRun( const wxString& aName, const std::vector<wxString>& aDirectives );
+
+    /**
+     * Adds a run for each value of a parameter, named "<step>_<param>_<value>" (the step is
+     * the index of the value, so repeated values do not share their files).  The parameter
+     * must not be defined by the netlist itself.
+     */
+    void AddParamSweep( const wxString& aParam, const std::vector<wxString>& aValues );
+
+    const std::vector<RUN>& GetRuns() const { return m_runs; }
+
+    /**
+     * @return the netlist of the run \a aRun: the directives of the run are added before
+     * the .end line.
+     */
+    wxString GetRunNetlist( size_t aRun ) const;
+
+    wxString GetNetlistFile( size_t aRun ) const;
+    wxString GetRawFile( size_t aRun ) const;
+    wxString GetLogFile( size_t aRun ) const;
+
+    /**
+     * Function Run
+     * writes the netlists of the runs and executes them, and waits for the end of the runs.
+     * @param aReporter is an optional progress reporter, advanced after each run.  It must
+     *                  be refreshed from the calling thread (see PROGRESS_REPORTER).  When
+     *                  it is cancelled, the runs already started are completed but no other
+     *                  run is started.
+     * @return the number of failed (or cancelled) runs.
+     */
+    int Run( PROGRESS_REPORTER* aReporter = nullptr );
+
+    ///> Returns true if the last Run() was cancelled by its progress reporter
+    bool IsCancelled() const { return m_cancelled; }
+
+private:
+    wxString getRunFile( size_t aRun, const wxString& aExtension ) const;
+
+    std::vector<wxString> m_netlist;       ///< Lines of the netlist
+    wxString              m_outputDir;
+    wxString              m_simulator;
+    std::vector<RUN>      m_runs;
+    bool                  m_cancelled;
+};
+
+#endif /* SIM_BATCH_RUNNER_H */
@@ -24,7 +24,12 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <wx/ffile.h>
+#include <wx/filename.h>
 #include <wx/stc/stc.h>
+#include <wx/stdpaths.h>
+#include <wx/textdlg.h>
+#include <wx/tokenzr.h>
 
 #include <sch_edit_frame.h>
 #include <eeschema_id.h>
@@ -33,6 +38,7 @@
 #include <bitmaps.h>
 #include <wildcards_and_files_ext.h>
 #include <widgets/tuner_slider.h>
+#include <widgets/progress_reporter.h>
 #include <dialogs/dialog_signal_list.h>
 #include "netlist_exporter_pspice_sim.h"
 #include <pgm_base.h>
@@ -40,6 +46,8 @@
 #include "sim_plot_panel.h"
 #include "spice_simulator.h"
 #include "spice_reporter.h"
+#include "sim_batch_runner.h"
+#include "sim_raw_file.h"
 #include <menus_helpers.h>
 #include <tool/tool_manager.h>
 #include <tools/ee_actions.h>
@@ -199,6 +207,19 @@ SIM_PLOT_FRAME::SIM_PLOT_FRAME( KIWAY* aKiway, wxWindow* aParent )
     Bind( wxEVT_COMMAND_MENU_SELECTED, &SIM_PLOT_FRAME::onShowNetlist, this, m_showNetlist->GetId() );
     Bind( wxEVT_COMMAND_MENU_SELECTED, &SIM_PLOT_FRAME::onSettings,    this, m_settings->GetId() );
 
+    // The parameter sweep follows the tuning of the component values
+    size_t tunePos;
+
+    if( m_simulationMenu->FindChildItem( m_tuneValue->GetId(), &tunePos ) )
+    {
+        wxMenuItem* paramSweep = m_simulationMenu->Insert( tunePos + 1, wxID_ANY,
+                _( "Parameter Sweep..." ),
+                _( "Simulates the current plot for several values of a parameter" ) );
+
+        Bind( wxEVT_COMMAND_MENU_SELECTED, &SIM_PLOT_FRAME::onParamSweep, this,
+              paramSweep->GetId() );
+    }
+
     m_toolBar->Realize();
     m_plotNotebook->SetPageText( 0, _( "Welcome!" ) );
 
@@ -472,6 +493,21 @@ void SIM_PLOT_FRAME::RemoveTuner( TUNER_SLIDER* aTuner, bool aErase )
 }
 
 
+void SIM_PLOT_FRAME::SaveTunerValue( SCH_COMPONENT* aComponent, const wxString& aValue )
+{
+    if( m_schematicFrame == NULL )
+    {
+        aComponent->GetField( VALUE )->SetText( aValue );
+        return;
+    }
+
+    m_schematicFrame->SaveCopyInUndoList( aComponent, UR_CHANGED );
+    aComponent->GetField( VALUE )->SetText( aValue );
+    m_schematicFrame->RefreshItem( aComponent );
+    m_schematicFrame->OnModify();
+}
+
+
 SIM_PLOT_PANEL* SIM_PLOT_FRAME::CurrentPlot() const
 {
     wxWindow* curPage = m_plotNotebook->GetCurrentPage();
@@ -1214,6 +1250,189 @@ void SIM_PLOT_FRAME::onTune( wxCommandEvent& event )
     m_schematicFrame->Raise();
 }
 
+/**
+ * Finds a simulator vector in a raw file: depending on its version, ngspice writes the node
+ * voltages with or without "V()".
+ */
+static int findRawFileVector( const SIM_RAW_FILE& aFile, const wxString& aSpiceVector )
+{
+    int index = aFile.FindVector( aSpiceVector.ToStdString() );
+
+    if( index < 0 && aSpiceVector.Upper().StartsWith( "V(" ) && aSpiceVector.EndsWith( ")" ) )
+        index = aFile.FindVector( aSpiceVector.Mid( 2, aSpiceVector.Len() - 3 ).ToStdString() );
+
+    return index;
+}
+
+
+void SIM_PLOT_FRAME::onParamSweep( wxCommandEvent& event )
+{
+    // Number of points of a trace of the sweep: more would not be visible
+    const size_t SWEEP_TRACE_POINTS = 2000;
+
+    SIM_PLOT_PANEL* plotPanel = CurrentPlot();
+
+    if( IsSimulationRunning() )
+        return;
+
+    if( !plotPanel || !m_exporter || plotPanel->GetType() != m_exporter->GetSimType()
+            || m_plots[plotPanel].m_traces.empty() )
+    {
+        DisplayInfoMessage( this, _( "You need to run simulation and add signals first." ) );
+        return;
+    }
+
+    wxTextEntryDialog paramDlg( this,
+            _( "Parameter name, used as {name} in the component values.\n"
+               "The schematic must not define it." ), _( "Parameter Sweep" ) );
+
+    if( paramDlg.ShowModal() != wxID_OK )
+        return;
+
+    wxString param = paramDlg.GetValue().Trim().Trim( false );
+
+    wxTextEntryDialog valuesDlg( this, _( "Values of the parameter, separated by spaces:" ),
+                                 _( "Parameter Sweep" ) );
+
+    if( param.IsEmpty() || valuesDlg.ShowModal() != wxID_OK )
+        return;
+
+    std::vector<wxString> values;
+    wxStringTokenizer tokenizer( valuesDlg.GetValue(), " \t;" );
+
+    while( tokenizer.HasMoreTokens() )
+        values.push_back( tokenizer.GetNextToken() );
+
+    if( values.empty() )
+        return;
+
+    // The netlist of the current plot is exported once for all the runs
+    STRING_FORMATTER formatter;
+
+    if( !m_settingsDlg )
+        m_settingsDlg = new DIALOG_SIM_SETTINGS( this );
+
+    updateNetlistExporter();
+    m_exporter->SetSimCommand( m_plots[plotPanel].m_simCommand );
+
+    if( !m_exporter->Format( &formatter, m_settingsDlg->GetNetlistOptions() ) )
+    {
+        DisplayError( this, _( "There were errors during netlist export, aborted." ) );
+        return;
+    }
+
+    // The runs are separate ngspice processes, which write their vectors to raw files
+    wxFileName outputDir( wxStandardPaths::Get().GetTempDir(), wxEmptyString );
+    outputDir.AppendDir( wxString::Format( "kicad_sim_sweep_%lu", wxGetProcessId() ) );
+
+    SIM_BATCH_RUNNER runner( formatter.GetString(), outputDir.GetPath() );
+    runner.AddParamSweep( param, values );
+
+    {
+        WX_PROGRESS_REPORTER reporter( this, _( "Parameter Sweep" ), 1 );
+
+        reporter.Report( wxString::Format( _( "Running %d simulations..." ),
+                                           (int) runner.GetRuns().size() ) );
+        runner.Run( &reporter );
+    }
+
+    if( runner.IsCancelled() )
+    {
+        wxFileName::Rmdir( outputDir.GetPath(), wxPATH_RMDIR_RECURSIVE );
+        return;
+    }
+
+    // Each signal is swept once, even if a previous sweep added traces for it.  The raw files
+    // give the magnitude of the AC vectors, not their phase.
+    std::map<wxString, TRACE_DESC> signals;
+
+    for( const auto& trace : m_plots[plotPanel].m_traces )
+    {
+        if( !( trace.second.GetType() & SPT_AC_PHASE ) )
+            signals.emplace( trace.second.GetTitle(), trace.second );
+    }
+
+    int failures = 0;
+
+    for( size_t ii = 0; ii < runner.GetRuns().size(); ii++ )
+    {
+        SIM_RAW_FILE rawFile;
+
+        if( !runner.GetRuns()[ii].m_success || !rawFile.Open( runner.GetRawFile( ii ) ) )
+        {
+            // The files of the runs are deleted at the end of the sweep, so keep the errors
+            wxFFile  logFile( runner.GetLogFile( ii ), wxT( "rb" ) );
+            wxString log;
+
+            if( logFile.IsOpened() )
+                logFile.ReadAll( &log );
+
+            m_simConsole->AppendText( wxString::Format( _( "Parameter sweep: run %s failed\n" ),
+                                                        runner.GetRuns()[ii].m_name ) );
+            m_simConsole->AppendText( log );
+            failures++;
+            continue;
+        }
+
+        std::vector<int> indices;
+        std::vector<const TRACE_DESC*> descriptors;
+
+        for( const auto& signal : signals )
+        {
+            const TRACE_DESC& descriptor = signal.second;
+            int index = findRawFileVector( rawFile, m_exporter->GetSpiceVector(
+                    descriptor.GetName(), descriptor.GetType(), descriptor.GetParam() ) );
+
+            // The first vector is the x axis
+            if( index > 0 )
+            {
+                indices.push_back( index );
+                descriptors.push_back( &descriptor );
+            }
+        }
+
+        // Large simulations are decimated while they are read, keeping their peaks
+        std::vector<SIM_DECIMATOR> plots;
+
+        if( !rawFile.ReadPlots( 0, indices, SWEEP_TRACE_POINTS, plots ) )
+        {
+            m_simConsole->AppendText( wxString::Format( _( "Parameter sweep: cannot read the "
+                                                           "results of run %s\n" ),
+                                                        runner.GetRuns()[ii].m_name ) );
+            failures++;
+            continue;
+        }
+
+        for( size_t jj = 0; jj < plots.size(); jj++ )
+        {
+            const TRACE_DESC& descriptor = *descriptors[jj];
+            wxString name = wxString::Format( "%s (%s = %s)", descriptor.GetTitle(), param,
+                                              values[ii] );
+
+            if( plotPanel->AddTrace( name, plots[jj].GetX().size(), plots[jj].GetX().data(),
+                                     plots[jj].GetY().data(), descriptor.GetType() ) )
+            {
+                m_plots[plotPanel].m_traces.insert( std::make_pair( name, descriptor ) );
+            }
+        }
+    }
+
+    // The raw files of large simulations are big, do not leave them in the temporary directory
+    wxFileName::Rmdir( outputDir.GetPath(), wxPATH_RMDIR_RECURSIVE );
+
+    if( failures )
+    {
+        m_simConsole->AppendText( wxString::Format( _( "Parameter sweep: %d of %d runs failed\n" ),
+                                                    failures, (int) runner.GetRuns().size() ) );
+        m_simConsole->SetInsertionPointEnd();
+    }
+
+    updateSignalList();
+    plotPanel->UpdateAll();
+    plotPanel->ResetScales();
+}
+
+
 void SIM_PLOT_FRAME::onShowNetlist( wxCommandEvent& event )
 {
     class NETLIST_VIEW_DIALOG : public wxDialog
@@ -151,6 +151,13 @@ public:
      */
     void RemoveTuner( TUNER_SLIDER* aTuner, bool aErase = true );
 
+    /**
+     * @brief Stores the value of a tuned component in the schematic, as an undoable change.
+     * @param aComponent is the tuned component.
+     * @param aValue is the new value field text.
+     */
+    void SaveTunerValue( SCH_COMPONENT* aComponent, const wxString& aValue );
+
     /**
      * @brief Returns the currently opened plot panel (or NULL if there is none).
      */
@@ -270,6 +277,7 @@ private:
     void onAddSignal( wxCommandEvent& event );
     void onProbe( wxCommandEvent& event );
     void onTune( wxCommandEvent& event );
+    void onParamSweep( wxCommandEvent& event );
     void onShowNetlist( wxCommandEvent& event );
 
     void onClose( wxCloseEvent& aEvent );
@@ -0,0 +1,336 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * https://www.gnu.org/licenses/gpl-3.0.html
+ * or you may search the http://www.gnu.org website for the version 3 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include "sim_raw_file.h"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+#include <common.h>
+#include <wx/filefn.h>
+
+
+SIM_DECIMATOR::SIM_DECIMATOR( size_t aPointCount, size_t aMaxPoints ) :
+        m_bucketCount( 0 ),
+        m_minX( 0.0 ), m_minY( 0.0 ),
+        m_maxX( 0.0 ), m_maxY( 0.0 ),
+        m_minFirst( true )
+{
+    // Each bucket gives at most two points
+    size_t buckets = std::max<size_t>( aMaxPoints / 2, 1 );
+
+    m_bucketSize = std::max<size_t>( ( aPointCount + buckets - 1 ) / buckets, 1 );
+
+    m_x.reserve( std::min( aPointCount, aMaxPoints ) );
+    m_y.reserve( std::min( aPointCount, aMaxPoints ) );
+}
+
+
+void SIM_DECIMATOR::Add( double aX, double aY )
+{
+    // Buckets of up to two points keep all of them
+    if( m_bucketSize <= 2 )
+    {
+        m_x.push_back( aX );
+        m_y.push_back( aY );
+        return;
+    }
+
+    if( m_bucketCount == 0 )
+    {
+        m_minX = m_maxX = aX;
+        m_minY = m_maxY = aY;
+        m_minFirst = true;
+    }
+    else if( aY < m_minY )
+    {
+        m_minX = aX;
+        m_minY = aY;
+        m_minFirst = false;
+    }
+    else if( aY > m_maxY )
+    {
+        m_maxX = aX;
+        m_maxY = aY;
+        m_minFirst = true;
+    }
+
+    if( ++m_bucketCount == m_bucketSize )
+        flushBucket();
+}
+
+
+void SIM_DECIMATOR::Finish()
+{
+    flushBucket();
+}
+
+
+void SIM_DECIMATOR::flushBucket()
+{
+    if( m_bucketCount == 0 )
+        return;
+
+    // A flat bucket gives a single point
+    if( m_minX == m_maxX && m_minY == m_maxY )
+    {
+        m_x.push_back( m_minX );
+        m_y.push_back( m_minY );
+    }
+    else if( m_minFirst )
+    {
+        m_x.push_back( m_minX );
+        m_y.push_back( m_minY );
+        m_x.push_back( m_maxX );
+        m_y.push_back( m_maxY );
+    }
+    else
+    {
+        m_x.push_back( m_maxX );
+        m_y.push_back( m_maxY );
+        m_x.push_back( m_minX );
+        m_y.push_back( m_minY );
+    }
+
+    m_bucketCount = 0;
+}
+
+
+/**
+ * Reads a line of a raw file header, without its end of line.
+ * @return false at the end of the file.
+ */
+static bool readLine( FILE* aFile, std::string& aLine )
+{
+    int c;
+
+    aLine.clear();
+
+    while( ( c = fgetc( aFile ) ) != EOF && c != '\n' )
+        aLine += (char) c;
+
+    if( !aLine.empty() && aLine.back() == '\r' )
+        aLine.pop_back();
+
+    return c != EOF || !aLine.empty();
+}
+
+
+SIM_RAW_FILE::SIM_RAW_FILE() :
+        m_dataOffset( 0 ),
+        m_binary( true ),
+        m_complex( false ),
+        m_pointCount( 0 )
+{
+}
+
+
+SIM_RAW_FILE::~SIM_RAW_FILE()
+{
+    close();
+}
+
+
+void SIM_RAW_FILE::close()
+{
+    if( m_file.IsOpened() )
+        m_file.Close();
+
+    m_vectors.clear();
+    m_pointCount = 0;
+}
+
+
+bool SIM_RAW_FILE::Open( const wxString& aFileName )
+{
+    close();
+
+    if( !wxFileExists( aFileName ) || !m_file.Open( aFileName, wxT( "rb" ) ) )
+        return false;
+
+    std::string line;
+    size_t      vectorCount = 0;
+
+    while( readLine( m_file.fp(), line ) )
+    {
+        size_t colon = line.find( ':' );
+
+        if( colon == std::string::npos )
+            continue;
+
+        std::string key = line.substr( 0, colon );
+        std::string value = line.substr( colon + 1 );
+
+        if( key == "Plotname" )
+        {
+            m_plotName = wxString::FromUTF8( value.c_str() ).Trim( false );
+        }
+        else if( key == "Flags" )
+        {
+            m_complex = value.find( "complex" ) != std::string::npos;
+        }
+        else if( key == "No. Variables" )
+        {
+            vectorCount = strtoul( value.c_str(), nullptr, 10 );
+        }
+        else if( key == "No. Points" )
+        {
+            m_pointCount = strtoul( value.c_str(), nullptr, 10 );
+        }
+        else if( key == "Variables" )
+        {
+            // One line by vector: index, name and type
+            for( size_t ii = 0; ii < vectorCount; ii++ )
+            {
+                std::istringstream vector;
+                int                index;
+                std::string        name;
+
+                if( !readLine( m_file.fp(), line ) )
+                    break;
+
+                vector.str( line );
+
+                if( !( vector >> index >> name ) )
+                    break;
+
+                m_vectors.push_back( name );
+            }
+        }
+        else if( key == "Binary" || key == "Values" )
+        {
+            m_binary = ( key == "Binary" );
+            // The values of large simulations can go beyond 2 GB, 64 bit offsets are used
+            m_dataOffset = m_file.Tell();
+            m_point.resize( m_vectors.size() * ( m_complex ? 2 : 1 ) );
+
+            if( m_dataOffset != wxInvalidOffset && !m_vectors.empty()
+                    && m_vectors.size() == vectorCount )
+                return true;
+
+            break;
+        }
+    }
+
+    close();
+    return false;
+}
+
+
+int SIM_RAW_FILE::FindVector( const std::string& aName ) const
+{
+    for( size_t ii = 0; ii < m_vectors.size(); ii++ )
+    {
+        if( wxString( m_vectors[ii] ).CmpNoCase( aName ) == 0 )
+            return (int) ii;
+    }
+
+    return -1;
+}
+
+
+bool SIM_RAW_FILE::readPoint()
+{
+    if( m_binary )
+        return fread( m_point.data(), sizeof( double ), m_point.size(), m_file.fp() )
+                == m_point.size();
+
+    // Ascii values: the index of the point, then a value by line, complex values
+    // being written as "real,imaginary"
+    double index;
+
+    if( fscanf( m_file.fp(), " %lf", &index ) != 1 )
+        return false;
+
+    for( size_t ii = 0; ii < m_vectors.size(); ii++ )
+    {
+        if( m_complex )
+        {
+            if( fscanf( m_file.fp(), " %lf , %lf", &m_point[2 * ii], &m_point[2 * ii + 1] ) != 2 )
+                return false;
+        }
+        else if( fscanf( m_file.fp(), " %lf", &m_point[ii] ) != 1 )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+bool SIM_RAW_FILE::ReadPlots( int aXIndex, const std::vector<int>& aYIndices, size_t aMaxPoints,
+                              std::vector<SIM_DECIMATOR>& aPlots )
+{
+    aPlots.clear();
+
+    if( !m_file.IsOpened() )
+        return false;
+
+    int vectorCount = (int) m_vectors.size();
+
+    if( aXIndex < 0 || aXIndex >= vectorCount )
+        return false;
+
+    for( int index : aYIndices )
+    {
+        if( index < 0 || index >= vectorCount )
+            return false;
+    }
+
+    auto value = [&]( int aIndex ) -> double
+    {
+        if( m_complex )
+            return std::hypot( m_point[2 * aIndex], m_point[2 * aIndex + 1] );
+
+        return m_point[aIndex];
+    };
+
+    // The ascii values are written in the "C" locale
+    LOCALE_IO toggle;
+
+    if( !m_file.Seek( m_dataOffset ) )
+        return false;
+
+    aPlots.reserve( aYIndices.size() );
+
+    for( size_t ii = 0; ii < aYIndices.size(); ii++ )
+        aPlots.emplace_back( m_pointCount, aMaxPoints );
+
+    for( size_t point = 0; point < m_pointCount; point++ )
+    {
+        if( !readPoint() )
+            return false;
+
+        double x = value( aXIndex );
+
+        for( size_t ii = 0; ii < aYIndices.size(); ii++ )
+            aPlots[ii].Add( x, value( aYIndices[ii] ) );
+    }
+
+    for( SIM_DECIMATOR& plot : aPlots )
+        plot.Finish();
+
+    return true;
+}
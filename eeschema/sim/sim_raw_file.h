@@ -0,0 +1,137 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * https://www.gnu.org/licenses/gpl-3.0.html
+ * or you may search the http://www.gnu.org website for the version 3 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef SIM_RAW_FILE_H
+#define SIM_RAW_FILE_H
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <wx/ffile.h>
+#include <wx/string.h>
+
+/**
+ * Class SIM_DECIMATOR
+ * reduces a plot to a given number of points while it is read, without keeping the full
+ * vectors in memory.
+ *
+ * The points are grouped in consecutive buckets, and only the points with the minimum and
+ * the maximum value of each bucket are kept, so the peaks of the plot are preserved.
+ */
+class SIM_DECIMATOR
+{
+public:
+    /**
+     * @param aPointCount is the number of points of the plot.
+     * @param aMaxPoints is the maximum number of points to keep (at least 2).
+     */
+    SIM_DECIMATOR( size_t aPointCount, size_t aMaxPoints );
+
+    ///> Adds the next point of the plot
+    void Add( double aX, double aY );
+
+    ///> Ends the plot: must be called after the last point is added
+    void Finish();
+
+    const std::vector<double>& GetX() const { return m_x; }
+    const std::vector<double>& GetY() const { return m_y; }
+
+private:
+    void flushBucket();
+
+    size_t m_bucketSize;     ///< Number of points of a bucket
+    size_t m_bucketCount;    ///< Number of points in the current bucket
+    double m_minX, m_minY;   ///< Point with the minimum value of the current bucket
+    double m_maxX, m_maxY;   ///< Point with the maximum value of the current bucket
+    bool   m_minFirst;       ///< The minimum comes before the maximum in the current bucket
+
+    std::vector<double> m_x;
+    std::vector<double> m_y;
+};
+
+
+/**
+ * Class SIM_RAW_FILE
+ * reads the first plot of a spice raw file, as written by "ngspice -b -r".
+ *
+ * Both the binary and the ascii raw files are handled.  The values are streamed from the
+ * file: only the requested plots, decimated, are kept in memory.
+ */
+class SIM_RAW_FILE
+{
+public:
+    SIM_RAW_FILE();
+    ~SIM_RAW_FILE();
+
+    /**
+     * Function Open
+     * opens a raw file and reads its header.
+     * @return true if the file is a valid raw file.
+     */
+    bool Open( const wxString& aFileName );
+
+    const wxString& GetPlotName() const { return m_plotName; }
+
+    ///> Returns the names of the vectors of the plot, the first one is the x axis
+    const std::vector<std::string>& GetVectors() const { return m_vectors; }
+
+    /**
+     * @return the index of a vector (names are not case sensitive), or -1 if the plot has no
+     * vector aName.
+     */
+    int FindVector( const std::string& aName ) const;
+
+    size_t GetPointCount() const { return m_pointCount; }
+
+    bool IsComplex() const { return m_complex; }
+
+    /**
+     * Function ReadPlots
+     * reads the vectors \a aYIndices against the vector \a aXIndex in a single pass over the
+     * file, each one decimated to at most \a aMaxPoints points.  The magnitude of complex
+     * values is used.
+     * @param aPlots receives a decimated plot for each index of \a aYIndices.
+     * @return false if the file is truncated or invalid.
+     */
+    bool ReadPlots( int aXIndex, const std::vector<int>& aYIndices, size_t aMaxPoints,
+                    std::vector<SIM_DECIMATOR>& aPlots );
+
+private:
+    ///> Reads the values of the next point of the plot to m_point
+    bool readPoint();
+
+    void close();
+
+    wxFFile                  m_file;
+    wxFileOffset             m_dataOffset;    ///< Position of the values in the file
+    bool                     m_binary;
+    bool                     m_complex;
+    size_t                   m_pointCount;
+    wxString                 m_plotName;
+    std::vector<std::string> m_vectors;
+    std::vector<double>      m_point;         ///< Values of the current point, two by vector
+                                              ///< (real and imaginary parts) if complex
+};
+
+#endif /* SIM_RAW_FILE_H */
@@ -114,6 +114,10 @@ void SCH_EDITOR_CONTROL::BackAnnotateFootprints( const std::string& aChangedSetO
 
     if( isChanged )
     {
+        // The footprint fields of the components of all the sheets may have changed
+        SCH_SCREENS screens;
+        screens.InvalidateItemIndexes();
+
         m_frame->SyncView();
         m_frame->GetCanvas()->Refresh();
         m_frame->OnModify();
@@ -241,6 +245,10 @@ int SCH_EDITOR_CONTROL::ImportFPAssignments( const TOOL_EVENT& aEvent )
         return 0;
     }
 
+    // The footprint fields of the components of all the sheets may have changed
+    SCH_SCREENS screens;
+    screens.InvalidateItemIndexes();
+
     m_frame->SyncView();
     m_frame->GetCanvas()->Refresh();
     m_frame->OnModify();
@@ -567,6 +567,7 @@ void EE_POINT_EDITOR::updateItem() const
                 connection->SetEndPoint( line->GetPosition() );
 
             getView()->Update( connection, KIGFX::GEOMETRY );
+            m_frame->UpdateItemIndex( connection );
         }
 
         connection = (SCH_LINE*) ( m_editPoints->Point( LINE_END ).GetConnection() );
@@ -579,6 +580,7 @@ void EE_POINT_EDITOR::updateItem() const
                 connection->SetEndPoint( line->GetEndPoint() );
 
             getView()->Update( connection, KIGFX::GEOMETRY );
+            m_frame->UpdateItemIndex( connection );
         }
 
         break;
@@ -105,6 +105,10 @@ protected:
     {
         KICAD_T itemType = aItem->Type();
 
+        // The item may have been moved or resized
+        if( !m_isLibEdit )
+            m_frame->UpdateItemIndex( aItem );
+
         if( itemType == SCH_PIN_T || itemType == SCH_FIELD_T || itemType == SCH_SHEET_PIN_T )
             getView()->Update( aItem->GetParent() );
 
@@ -315,6 +315,7 @@ int SCH_EDITOR_CONTROL::ReplaceAndFindNext( const TOOL_EVENT& aEvent )
     if( item && item->Matches( *data, nullptr ) )
     {
         item->Replace( *data, g_CurrentSheet );
+        m_frame->UpdateItemIndex( item );
         FindNext( ACTIONS::findNext.MakeEvent() );
     }
 
@@ -338,6 +339,7 @@ int SCH_EDITOR_CONTROL::ReplaceAll( const TOOL_EVENT& aEvent )
              item = nextMatch( screen, item, data ) )
         {
             item->Replace( *data, schematic.FindSheetForScreen( screen ) );
+            screen->UpdateItemIndex( item );
         }
     }
 
@@ -138,7 +138,7 @@ void TUNER_SLIDER::onClose( wxCommandEvent& event )
 void TUNER_SLIDER::onSave( wxCommandEvent& event )
 {
     /// @todo it will crash when component is removed; completely remove m_component
-    m_component->GetField( VALUE )->SetText( m_value.ToOrigString() );
+    m_frame->SaveTunerValue( m_component, m_value.ToOrigString() );
 }
 
 
@@ -83,6 +83,22 @@ public:
      */
     int m_coroutineStackSize;
 
+    /**
+     * Show the per-frame redraw statistics of the VIEW on GAL canvases
+     */
+    bool m_showRedrawStats;
+
+    /**
+     * Keep the non-cached layers as raster tiles with the software (Cairo) renderer
+     */
+    bool m_cairoTileCache;
+
+    /**
+     * Search the autoplaced footprint positions on a coarse grid first, then refine
+     * around the best ones
+     */
+    bool m_coarseAutoplaceSearch;
+
     /**
      * Helper to determine if legacy canvas is allowed (according to platform
      * and config)
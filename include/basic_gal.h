@@ -25,6 +25,8 @@
 #ifndef BASIC_GAL_H
 #define BASIC_GAL_H
 
+#include <mutex>
+
 #include <eda_rect.h>
 
 #include <gal/stroke_font.h>
@@ -167,4 +169,8 @@ private:
 
 extern BASIC_GAL basic_gal;
 
+/// basic_gal holds the attributes and the output of the text being drawn or measured;
+/// lock this mutex while using it, since texts can be plotted from several threads
+extern std::recursive_mutex basic_gal_mutex;
+
 #endif      // define BASIC_GAL_H
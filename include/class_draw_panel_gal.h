@@ -197,6 +197,12 @@ public:
      */
     void OnEvent( wxEvent& aEvent );
 
+    /**
+     * Show or hide the redraw statistics of the last frame (see KIGFX::VIEW::GetRedrawStats())
+     * in the top left corner of the canvas.
+     */
+    void SetShowRedrawStats( bool aShow ) { m_showRedrawStats = aShow; }
+
 protected:
     virtual void onPaint( wxPaintEvent& WXUNUSED( aEvent ) );
     void onSize( wxSizeEvent& aEvent );
@@ -206,6 +212,9 @@ protected:
     void onShowTimer( wxTimerEvent& aEvent );
     void onSetCursor( wxSetCursorEvent& event );
 
+    ///> Draws the redraw statistics of the last frame over the view
+    void drawRedrawStats();
+
     static const int MinRefreshPeriod = 17;             ///< 60 FPS.
 
     wxCursor                 m_currentCursor;    /// Current mouse cursor shape id.
@@ -252,6 +261,9 @@ protected:
     /// Flag to indicate whether the panel should take focus at certain times (when moused over,
     /// and on various mouse/key events)
     bool                     m_stealsFocus;
+
+    /// Flag to draw the redraw statistics over the view
+    bool                     m_showRedrawStats;
 };
 
 #endif
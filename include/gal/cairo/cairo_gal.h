@@ -188,6 +188,28 @@ public:
     /// @copydoc GAL::ClearCache()
     virtual void ClearCache() override;
 
+    // --------------------------------------------
+    // Raster tile methods
+    // ---------------------------------------------
+
+    /// @copydoc GAL::HasRasterTiles()
+    virtual bool HasRasterTiles() const override { return true; }
+
+    /// @copydoc GAL::CreateTile()
+    virtual int CreateTile( int aSize ) override;
+
+    /// @copydoc GAL::BeginTile()
+    virtual void BeginTile( int aTileNumber, const VECTOR2D& aScreenOrigin ) override;
+
+    /// @copydoc GAL::EndTile()
+    virtual void EndTile() override;
+
+    /// @copydoc GAL::DrawTile()
+    virtual void DrawTile( int aTileNumber, const VECTOR2I& aScreenOrigin ) override;
+
+    /// @copydoc GAL::DeleteTile()
+    virtual void DeleteTile( int aTileNumber ) override;
+
     // --------------------------------------------------------
     // Handling the world <-> screen transformation
     // --------------------------------------------------------
@@ -291,6 +313,18 @@ protected:
     unsigned int                groupCounter;       ///< Counter used for generating keys for groups
     GROUP*                      currentGroup;       ///< Currently used group
 
+    // Variables for the raster tiles
+    typedef struct
+    {
+        cairo_surface_t* surface;
+        cairo_t*         context;
+    } TILE;
+
+    std::map<int, TILE>         tiles;              ///< Raster tiles
+    int                         tileCounter;        ///< Counter used for generating tile numbers
+    cairo_t*                    tileTargetContext;  ///< Context to restore after drawing a tile
+    cairo_matrix_t              tileTargetMatrix;   ///< World to screen matrix of the target
+
     double lineWidth;
     double linePixelWidth;
     double lineWidthInPixels;
@@ -598,6 +598,49 @@ public:
      */
     virtual void ClearCache() {};
 
+    // --------------------------------------------
+    // Raster tile methods
+    // ---------------------------------------------
+
+    /**
+     * @brief Returns true if the GAL can draw into raster tiles, see CreateTile().
+     */
+    virtual bool HasRasterTiles() const { return false; };
+
+    /**
+     * @brief Create a square raster tile.
+     *
+     * @param aSize is the tile size in pixels.
+     * @return the tile number, or -1 if tiles are not supported.
+     */
+    virtual int CreateTile( int aSize ) { return -1; };
+
+    /**
+     * @brief Redirect the drawing to a tile, which is cleared first.
+     *
+     * @param aTileNumber is the tile number.
+     * @param aScreenOrigin is the current screen position of the tile top left corner.
+     */
+    virtual void BeginTile( int aTileNumber, const VECTOR2D& aScreenOrigin ) {};
+
+    /// @brief End drawing into a tile, drawing goes to the current target again.
+    virtual void EndTile() {};
+
+    /**
+     * @brief Paint a tile on the current target.
+     *
+     * @param aTileNumber is the tile number.
+     * @param aScreenOrigin is the screen position of the tile top left corner.
+     */
+    virtual void DrawTile( int aTileNumber, const VECTOR2I& aScreenOrigin ) {};
+
+    /**
+     * @brief Delete a tile from the memory.
+     *
+     * @param aTileNumber is the tile number.
+     */
+    virtual void DeleteTile( int aTileNumber ) {};
+
     // --------------------------------------------------------
     // Handling the world <-> screen transformation
     // --------------------------------------------------------
@@ -359,6 +359,16 @@ public:
      */
     virtual bool Draw( const VIEW_ITEM* aItem, int aLayer ) = 0;
 
+    /**
+     * Function PrepareDraw
+     * Precomputes the data needed to draw an item (e.g. polygon triangulations) without using
+     * the GAL, so the following Draw() calls only have to emit the geometry.
+     * VIEW calls it for many items at once from several threads, so an implementation must
+     * not modify anything but the item it is given.
+     * @param aItem is the item that is going to be drawn.
+     */
+    virtual void PrepareDraw( const VIEW_ITEM* aItem ) {}
+
 protected:
     /// Instance of graphic abstraction layer that gives an interface to call
     /// commands used to draw (eg. DrawLine, DrawCircle, etc.)
@@ -32,6 +32,10 @@
 #ifndef PLOT_COMMON_H_
 #define PLOT_COMMON_H_
 
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <unordered_map>
 #include <vector>
 #include <math/box2.h>
 #include <gr_text.h>
@@ -88,6 +92,50 @@ enum PlotDashType {
     PLOTDASHTYPE_DASHDOT,
 };
 
+/**
+ * Class PLOT_WRITER
+ * formats a piece of plot file text in a local buffer and writes it to the file in one go.
+ *
+ * Plot files are mostly long runs of coordinates, and formatting them with fprintf()
+ * (format string parsing, locale lookups) is the main cost of a plot.  The number
+ * formatting here is hand-rolled but gives the same text as the printf() conversion
+ * given for each method, so the plot files do not change.
+ * The text is written when the buffer is full, by Flush() and on destruction, so a
+ * temporary can be used for a single line:
+ *   PLOT_WRITER( outputFile ).Char( 'X' ).Int( x ).Char( 'Y' ).Int( y ).Text( "D01*\n" );
+ */
+class PLOT_WRITER
+{
+public:
+    PLOT_WRITER( FILE* aFile ) : m_file( aFile ), m_len( 0 ) {}
+
+    ~PLOT_WRITER() { Flush(); }
+
+    /// Same as printf( "%.*d", aMinDigits, aValue ), i.e. "%02d" for aMinDigits = 2
+    PLOT_WRITER& Int( long long aValue, int aMinDigits = 1 );
+
+    /// Same as printf( "%g", aValue )
+    PLOT_WRITER& Double( double aValue );
+
+    /// Same as printf( "%.0f", aValue )
+    PLOT_WRITER& Rounded( double aValue );
+
+    PLOT_WRITER& Char( char aChar );
+
+    PLOT_WRITER& Text( const char* aText );
+
+    void Flush();
+
+private:
+    /// @return room for aLen chars at the end of the buffer, flushing it if needed
+    char* reserve( size_t aLen );
+
+    FILE*  m_file;
+    size_t m_len;
+    char   m_buf[512];
+};
+
+
 /**
  * Base plotter engine class. General rule: all the interface with the caller
  * is done in IU, the IU size is specified with SetViewport. Internal and
@@ -542,6 +590,16 @@ protected:
 
     double GetDashGapLenIU() const;
 
+    /**
+     * Gives aFile, just opened, a large write buffer owned by the plotter, so that the
+     * many small writes of a plot do not each end in a system call.
+     * The buffer lives as long as the plotter: aFile must be closed before the plotter
+     * is deleted.
+     * @param aWorkFile = true for a work file which is open at the same time as
+     * outputFile (each of them needs its own buffer)
+     */
+    void setFileBuffer( FILE* aFile, bool aWorkFile = false );
+
 protected:      // variables used in most of plotters:
     /// Plot scale - chosen by the user (even implicitly with 'fit in a4')
     double        plotScale;
@@ -584,6 +642,11 @@ protected:      // variables used in most of plotters:
     wxSize        paperSize;
 
     wxArrayString m_headerExtraLines;  /// a set of string to print in header file
+
+private:
+    /// The write buffers of outputFile and of the work file, see setFileBuffer()
+    std::unique_ptr<char[]> m_outputFileBuffer;
+    std::unique_ptr<char[]> m_workFileBuffer;
 };
 
 
@@ -837,6 +900,8 @@ public:
         pageTreeHandle = 0;
     }
 
+    virtual ~PDF_PLOTTER();
+
     virtual PlotFormat GetPlotterType() const override
     {
         return PLOT_FORMAT_PDF;
@@ -1054,6 +1119,7 @@ public:
         AT_REGULAR_POLY10,  // Regular polygon 10 vertices, with rotation
         AT_REGULAR_POLY11,  // Regular polygon 11 vertices, with rotation
         AT_REGULAR_POLY12,  // Regular polygon 12 vertices, with rotation
+        AT_OUTLINE_MACRO,   // Aperture macro made of outline primitives (custom pads)
     };
 
     void SetSize( const wxSize& aSize )
@@ -1114,6 +1180,10 @@ public:
     // code number ( >= 10 )
     int           m_DCode;
 
+    // for AT_OUTLINE_MACRO: the primitives of the aperture macro, i.e. the text
+    // between the %AM name line and the closing %
+    std::string   m_MacroBody;
+
     // the attribute attached to this aperture
     // Only one attribute is allowed by aperture
     // 0 = no specific aperture attribute
@@ -1125,6 +1195,7 @@ class GERBER_PLOTTER : public PLOTTER
 {
 public:
     GERBER_PLOTTER();
+    virtual ~GERBER_PLOTTER();
 
     virtual PlotFormat GetPlotterType() const override
     {
@@ -1253,6 +1324,13 @@ public:
     void UseX2format( bool aEnable ) { m_useX2format = aEnable; }
     void UseX2NetAttributes( bool aEnable ) { m_useNetAttributes = aEnable; }
 
+    /**
+     * Flash the filled custom pads with an aperture macro, defined once for all the
+     * pads having the same shape, instead of plotting each of them as regions.
+     * Boards with many identical custom pads give much smaller files.
+     */
+    void UseApertureMacros( bool aEnable ) { m_useApertureMacros = aEnable; }
+
     /**
      * calling this function allows one to define the beginning of a group
      * of drawing items (used in X2 format with netlist attributes)
@@ -1318,6 +1396,20 @@ protected:
     std::vector<APERTURE>::iterator getAperture( const wxSize& aSize,
                     APERTURE::APERTURE_TYPE aType, int aApertureAttribute );
 
+    /**
+     * Pick an existing AT_OUTLINE_MACRO aperture or create a new one, matching the
+     * macro body and the attribute.
+     * write the DCode selection on gerber file
+     */
+    void selectOutlineAperture( const std::string& aMacroBody, int aApertureAttribute );
+
+    /**
+     * Flash aPolygons at aPadPos with an AT_OUTLINE_MACRO aperture (see UseApertureMacros)
+     * @return false if the shape cannot be an outline macro (it has holes or too many
+     * corners): nothing is plotted, and the caller must plot it as regions
+     */
+    bool flashOutlineMacro( const wxPoint& aPadPos, SHAPE_POLY_SET* aPolygons, void* aData );
+
     // the attributes dictionary created/modifed by %TO, attached the objects, when they are created
     // by D01, D03 G36/G37 commands
     // standard attributes are .P, .C and .N
@@ -1342,6 +1434,33 @@ protected:
     std::vector<APERTURE>           apertures;
     std::vector<APERTURE>::iterator currentAperture;
 
+    /// Key of m_apertureIndex: the type, size and attribute of an aperture
+    struct APERTURE_KEY
+    {
+        int m_Type;
+        int m_SizeX;
+        int m_SizeY;
+        int m_Attribute;
+
+        bool operator==( const APERTURE_KEY& aOther ) const
+        {
+            return m_Type == aOther.m_Type && m_SizeX == aOther.m_SizeX
+                   && m_SizeY == aOther.m_SizeY && m_Attribute == aOther.m_Attribute;
+        }
+    };
+
+    struct APERTURE_KEY_HASH
+    {
+        size_t operator()( const APERTURE_KEY& aKey ) const;
+    };
+
+    /// Index in apertures of the standard apertures, to avoid a search for each item
+    std::unordered_map<APERTURE_KEY, size_t, APERTURE_KEY_HASH> m_apertureIndex;
+
+    /// Index in apertures of the AT_OUTLINE_MACRO apertures, the key is the attribute
+    /// followed by the macro body
+    std::unordered_map<std::string, size_t> m_outlineApertureIndex;
+
     bool     m_gerberUnitInch;  // true if the gerber units are inches, false for mm
     int      m_gerberUnitFmt;   // number of digits in mantissa.
                                 // usually 6 in Inches and 5 or 6  in mm
@@ -1350,6 +1469,7 @@ protected:
                                 // If false (X1 format), these attributes will be added as comments.
     bool    m_useNetAttributes; // In recent gerber files, netlist info can be added.
                                 // It will be added if this param is true, using X2 or X1 format
+    bool    m_useApertureMacros;// Flash custom pads with aperture macros (see UseApertureMacros)
 };
 
 
@@ -121,6 +121,17 @@ KICAD_PLUGIN_EXPORT char const* GetFileFilter( int aIndex );
  */
 KICAD_PLUGIN_EXPORT bool CanRender( void );
 
+/**
+ * Function CanLoadConcurrently
+ * is optional; plugins which do not export it are assumed to be unable to load
+ * several models at once
+ *
+ * @return true if Load() may be invoked from several threads at the same time;
+ * the caller sets the "C" numeric locale for the duration of such loads, and
+ * Load() must then leave the locale alone (setlocale() is not thread safe)
+ */
+KICAD_PLUGIN_EXPORT bool CanLoadConcurrently( void );
+
 /**
  * reads a model file and creates a generic display structure
  *
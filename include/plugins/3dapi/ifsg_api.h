@@ -83,6 +83,34 @@ namespace S3D
     SGLIB_API SGNODE* ReadCache( const char* aFileName, void* aPluginMgr,
         bool (*aTagCheck)( const char*, void* ) );
 
+    /**
+     * Function WriteModelCache
+     * writes the render data of a model to a flat binary cache file; the
+     * materials and the vertex, normal, texture coordinate, color and index
+     * arrays of each mesh are stored as contiguous native arrays so the file
+     * can be read back (or memory mapped) without any parsing
+     *
+     * @param aFileName is the name of the file to write
+     * @param aModel is the render data to be written
+     * @param aPluginInfo is the PluginName:Version tag of the plugin which loaded the model
+     * @return true on success
+     */
+    SGLIB_API bool WriteModelCache( const char* aFileName, const S3DMODEL* aModel,
+        const char* aPluginInfo );
+
+    /**
+     * Function ReadModelCache
+     * reads a flat binary cache file written by WriteModelCache()
+     *
+     * @param aFileName is the name of the flat cache file to be read
+     * @param aPluginMgr and aTagCheck are used as in ReadCache() to reject files
+     * written by an incompatible plugin; aTagCheck may be NULL
+     * @return NULL on failure, otherwise a new S3DMODEL which must be freed
+     * with Destroy3DModel()
+     */
+    SGLIB_API S3DMODEL* ReadModelCache( const char* aFileName, void* aPluginMgr,
+        bool (*aTagCheck)( const char*, void* ) );
+
     /**
      * Function WriteVRML
      * writes out the given node and its subnodes to a VRML2 file
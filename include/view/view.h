@@ -42,6 +42,48 @@ class GAL;
 class VIEW_ITEM;
 class VIEW_GROUP;
 class VIEW_RTREE;
+class VIEW_TILE_CACHE;
+
+/**
+ * Struct VIEW_REDRAW_STATS
+ * Counters collected while drawing one frame, to find out where the frame time goes.
+ * Item counters are counted per item and per layer.
+ */
+struct VIEW_REDRAW_STATS
+{
+    VIEW_REDRAW_STATS()
+    {
+        Clear();
+    }
+
+    void Clear()
+    {
+        layersDrawn = 0;
+        itemsQueried = 0;
+        itemsHidden = 0;
+        itemsCulledLOD = 0;
+        itemsDrawnCached = 0;
+        itemsDrawnImmediate = 0;
+        itemsRecached = 0;
+        tilesRendered = 0;
+        tilesPainted = 0;
+        updateTime = 0.0;
+        redrawTime = 0.0;
+    }
+
+    int    layersDrawn;          ///< Number of layers drawn
+    int    itemsQueried;         ///< Items returned by the layer R-tree queries
+    int    itemsHidden;          ///< Items skipped because they are not renderable
+    int    itemsCulledLOD;       ///< Items skipped because of their level of detail
+    int    itemsDrawnCached;     ///< Items drawn from their cached GAL group
+    int    itemsDrawnImmediate;  ///< Items drawn in immediate mode
+    int    itemsRecached;        ///< Items whose geometry was (re)built in a cached GAL group
+    int    tilesRendered;        ///< Raster tiles rendered, see VIEW::SetUseTileCache()
+    int    tilesPainted;         ///< Raster tiles painted on the screen
+    double updateTime;           ///< Time spent in VIEW::UpdateItems(), in milliseconds
+    double redrawTime;           ///< Time spent in VIEW::Redraw(), in milliseconds
+};
+
 
 /**
  * Class VIEW.
@@ -405,6 +447,9 @@ public:
             // Target has to be redrawn after changing its visibility
             MarkTargetDirty( m_layers[aLayer].target );
             m_layers[aLayer].visible = aVisible;
+
+            // The level of detail of items may depend on other layers visibility
+            InvalidateTiles();
         }
     }
 
@@ -539,6 +584,16 @@ public:
      */
     void RecacheAllItems();
 
+    /**
+     * Function GetRedrawStats()
+     * Returns the statistics of the last frame, i.e. the items updated by UpdateItems()
+     * and drawn by the last call to Redraw().
+     */
+    const VIEW_REDRAW_STATS& GetRedrawStats() const
+    {
+        return m_lastRedrawStats;
+    }
+
     /**
      * Function IsDynamic()
      * Tells if the VIEW is dynamic (ie. can be changed, for example displaying PCBs in a window)
@@ -603,6 +658,27 @@ public:
         }
     }
 
+    /**
+     * Function SetUseTileCache()
+     * Enables drawing the non-cached layers as raster tiles, kept between frames and only
+     * rendered again when the items they contain are modified. Used only if the GAL supports
+     * tiles (see GAL::HasRasterTiles()), it makes panning fast with a software renderer.
+     */
+    void SetUseTileCache( bool aEnable );
+
+    bool IsUsingTileCache() const
+    {
+        return m_tileCache != nullptr;
+    }
+
+    /**
+     * Function InvalidateTiles()
+     * Deletes the raster tiles of a layer, or of all layers if aLayer is negative.
+     * To be called when the drawing of items changes without them being updated
+     * (e.g. after a change of the painter settings).
+     */
+    void InvalidateTiles( int aLayer = -1 );
+
     /**
      * Function MarkDirty()
      * Forces redraw of view on the next rendering.
@@ -749,6 +825,15 @@ protected:
      */
     void draw( VIEW_ITEM* aItem, int aLayer, bool aImmediate = false );
 
+    ///> Returns true if a layer is drawn using raster tiles
+    bool useTiles( const VIEW_LAYER& aLayer ) const;
+
+    ///> Paints a layer using the raster tiles, rendering the missing ones
+    void redrawTiles( const VIEW_LAYER& aLayer );
+
+    ///> Deletes the raster tiles covering an item
+    void invalidateTiles( VIEW_ITEM* aItem );
+
     /**
      * Function draw()
      * Draws an item on all layers that the item uses.
@@ -790,6 +875,15 @@ protected:
     /// Updates all informations needed to draw an item
     void updateItemGeometry( VIEW_ITEM* aItem, int aLayer );
 
+    /**
+     * Function prepareItems()
+     * Lets the painter precompute the shapes of the items about to be recached
+     * (see PAINTER::PrepareDraw()). The items are independent, so they are prepared
+     * in parallel, leaving only the GAL calls to the serial recaching pass.
+     * @param aItems are the items that are going to be updated.
+     */
+    void prepareItems( const std::vector<VIEW_ITEM*>& aItems );
+
     /// Updates bounding box of an item
     void updateBbox( VIEW_ITEM* aItem );
 
@@ -871,6 +965,15 @@ protected:
     /// m_printMode > 0 is a printing mode (currently means "we are in printing mode")
     int m_printMode;
 
+    /// Statistics of the frame being drawn
+    VIEW_REDRAW_STATS m_redrawStats;
+
+    /// Statistics of the last frame drawn
+    VIEW_REDRAW_STATS m_lastRedrawStats;
+
+    /// Raster tiles of the non-cached layers, if enabled
+    std::unique_ptr<VIEW_TILE_CACHE> m_tileCache;
+
     VIEW( const VIEW& ) = delete;
 };
 } // namespace KIGFX
@@ -0,0 +1,195 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef __VIEW_TILE_CACHE_H
+#define __VIEW_TILE_CACHE_H
+
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+#include <math/box2.h>
+#include <math/matrix3x3.h>
+
+namespace KIGFX
+{
+class GAL;
+
+/**
+ * Class VIEW_TILE_CACHE
+ * keeps the raster tiles rendered by a GAL supporting them (see GAL::CreateTile()), so VIEW
+ * can redraw non-cached layers by painting the tiles instead of drawing every item again.
+ *
+ * Tiles are square blocks of pixels of a single layer. They are laid on a grid that depends
+ * only on the zoom level (the linear part of the world to screen transform), not on the view
+ * center, so panning reuses them. Only the tiles where something was drawn are kept.
+ * The tiles painted in the current frame are always kept, and the tiles of the previous
+ * frames (of all the zoom levels) are kept within a memory budget, after which the least
+ * recently used ones are deleted.
+ * A tile is invalidated when an item whose bounding box intersects it is modified.
+ */
+class VIEW_TILE_CACHE
+{
+public:
+    /**
+     * @param aTileSize is the size of a tile side, in pixels.
+     * @param aMemoryBudget is the memory used by the tiles kept in addition to the ones of the
+     * current frame, in bytes.
+     */
+    VIEW_TILE_CACHE( int aTileSize = 256, size_t aMemoryBudget = 64 * 1024 * 1024 );
+    ~VIEW_TILE_CACHE();
+
+    ///> Margin around the area drawn in a tile, in pixels, so items whose drawing slightly
+    ///> exceeds their bounding box are not cut at the tile borders
+    static constexpr int TILE_MARGIN = 2;
+
+    /// Identifies a tile: layer, zoom level and position on the tile grid
+    struct TILE_KEY
+    {
+        int layer;
+        int zoom;
+        int x;
+        int y;
+
+        bool operator==( const TILE_KEY& aOther ) const
+        {
+            return layer == aOther.layer && zoom == aOther.zoom
+                    && x == aOther.x && y == aOther.y;
+        }
+    };
+
+    /**
+     * Function SetGAL()
+     * Sets the GAL owning the tiles. The tiles of the previous GAL are forgotten without
+     * being deleted, as the previous GAL may not exist anymore.
+     */
+    void SetGAL( GAL* aGal );
+
+    int GetTileSize() const
+    {
+        return m_tileSize;
+    }
+
+    /**
+     * Function GetZoomLevel()
+     * Returns the zoom level identifier matching a world to screen transform, a new one
+     * is created if needed.
+     */
+    int GetZoomLevel( const MATRIX3x3D& aWorldScreenMatrix );
+
+    /**
+     * Function BeginFrame()
+     * Starts a new frame: the tiles used from now on cannot be deleted until the next frame
+     * begins.
+     * @param aWorkingSet is the number of tiles the frame may use (the tiles visible on the
+     * screen times the number of layers drawn with tiles), it is kept in addition to the
+     * memory budget.
+     */
+    void BeginFrame( size_t aWorkingSet );
+
+    /**
+     * Function Find()
+     * Looks for a tile and marks it as the most recently used one.
+     * @param aGalTile receives the GAL tile number.
+     * @return true if the tile is in the cache.
+     */
+    bool Find( const TILE_KEY& aKey, int& aGalTile );
+
+    /**
+     * Function Add()
+     * Stores a newly rendered tile, deleting the least recently used ones of the previous
+     * frames if the cache is full. Empty tiles must not be stored.
+     * @param aGalTile is the GAL tile number.
+     * @param aWorldBox is the area covered by the tile, in world coordinates.
+     */
+    void Add( const TILE_KEY& aKey, int aGalTile, const BOX2I& aWorldBox );
+
+    /**
+     * Function Invalidate()
+     * Deletes the tiles of a layer intersecting an area, at all zoom levels.
+     */
+    void Invalidate( int aLayer, const BOX2I& aWorldBox );
+
+    /**
+     * Function InvalidateLayer()
+     * Deletes all the tiles of a layer.
+     */
+    void InvalidateLayer( int aLayer );
+
+    /**
+     * Function Clear()
+     * Deletes all the tiles.
+     */
+    void Clear();
+
+    size_t GetTileCount() const
+    {
+        return m_tiles.size();
+    }
+
+private:
+    struct TILE_KEY_HASH
+    {
+        size_t operator()( const TILE_KEY& aKey ) const
+        {
+            size_t seed = std::hash<int>()( aKey.layer );
+            seed ^= std::hash<int>()( aKey.zoom ) + 0x9e3779b9 + ( seed << 6 ) + ( seed >> 2 );
+            seed ^= std::hash<int>()( aKey.x ) + 0x9e3779b9 + ( seed << 6 ) + ( seed >> 2 );
+            seed ^= std::hash<int>()( aKey.y ) + 0x9e3779b9 + ( seed << 6 ) + ( seed >> 2 );
+            return seed;
+        }
+    };
+
+    struct TILE
+    {
+        int                           galTile;     ///< GAL tile number
+        BOX2I                         worldBox;    ///< Area covered by the tile
+        unsigned                      frame;       ///< Last frame using the tile
+        std::list<TILE_KEY>::iterator lruEntry;    ///< Position in the LRU list
+    };
+
+    /// Linear part of a world to screen transform, identified by its index
+    struct ZOOM_LEVEL
+    {
+        double m[2][2];
+        int    tileCount;
+    };
+
+    typedef std::unordered_map<TILE_KEY, TILE, TILE_KEY_HASH> TILE_MAP;
+
+    ///> Removes a tile, deleting its raster data
+    TILE_MAP::iterator remove( TILE_MAP::iterator aTile );
+
+    GAL*                    m_gal;
+    int                     m_tileSize;
+    size_t                  m_memoryBudget;
+    size_t                  m_maxTiles;     ///< Working set of the frame and memory budget
+    unsigned                m_frame;        ///< Current frame number
+    TILE_MAP                m_tiles;
+    std::list<TILE_KEY>     m_lru;          ///< Tiles, the most recently used first
+    std::vector<ZOOM_LEVEL> m_zoomLevels;
+};
+
+} // namespace KIGFX
+
+#endif
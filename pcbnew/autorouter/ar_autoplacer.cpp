@@ -45,12 +45,23 @@
 #include "ar_cell.h"
 #include "ar_autoplacer.h"
 
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <thread>
+
 #define AR_GAIN            16
 #define AR_KEEPOUT_MARGIN  500
 #define AR_ABORT_PLACEMENT -1
 
 #define STEP_AR_MM 1.0
 
+// Coarse to fine search: the coarse grid is AR_COARSE_SEARCH_FACTOR times the placement grid,
+// and the full resolution grid is searched around the AR_COARSE_SEARCH_CANDIDATES best
+// coarse positions
+#define AR_COARSE_SEARCH_FACTOR     4
+#define AR_COARSE_SEARCH_CANDIDATES 8
+
 /* Penalty (cost) for CntRot90 and CntRot180:
  * CntRot90 and CntRot180 are from 0 (rotation allowed) to 10 (rotation not allowed)
  */
@@ -82,6 +93,7 @@ AR_AUTOPLACER::AR_AUTOPLACER( BOARD* aBoard )
     m_progressReporter = nullptr;
     m_refreshCallback = nullptr;
     m_minCost = 0.0;
+    m_coarseToFineSearch = false;
 }
 
 
@@ -150,8 +162,7 @@ int AR_AUTOPLACER::genPlacementRoutingMatrix()
 
 bool AR_AUTOPLACER::fillMatrix()
 {
-    std::vector <int> x_coordinates;
-    bool success = true;
+    std::atomic<bool> success( true );
     int step = m_matrix.m_GridRouting;
     wxPoint coord_orgin = m_matrix.GetBrdCoordOrigin(); // Board coordinate of matruix cell (0,0)
 
@@ -161,24 +172,28 @@ bool AR_AUTOPLACER::fillMatrix()
     const SHAPE_LINE_CHAIN& outline = brd_shape.Outline(0);
     const BOX2I& rect = outline.BBox();
 
-    // Creates the horizontal segments
+    // Each horizontal scan line fills its own matrix row, so lines are independent
+    // and can be handled by separate threads.
     // Calculate the y limits of the area
-    for( int refy = rect.GetY(), endy = rect.GetBottom(); refy < endy; refy += step )
+    int    firsty = rect.GetY();
+    size_t lineCount = rect.GetBottom() > firsty ? ( rect.GetBottom() - firsty + step - 1 ) / step
+                                                 : 0;
+
+    m_matrix.SetCellOperation( AR_MATRIX::WRITE_CELL );
+
+    auto scan_lambda = [&]( size_t aLine ) -> bool
     {
+        std::vector <int> x_coordinates;
+        int refy = firsty + (int) aLine * step;
+
         // The row index (vertical position) of current line scan inside the placement matrix
         int idy = (refy - coord_orgin.y) / step;
 
-        // Ensure we are still inside the placement matrix
-        if( idy >= m_matrix.m_Nrows )
-            break;
-
         // Ensure we are inside the placement matrix
-        if( idy <= 0 )
-            continue;
+        if( idy <= 0 || idy >= m_matrix.m_Nrows )
+            return true;
 
         // find all intersection points of an infinite line with polyline sides
-        x_coordinates.clear();
-
         for( int v = 0; v < outline.PointCount(); v++ )
         {
 
@@ -232,10 +247,7 @@ bool AR_AUTOPLACER::fillMatrix()
         // An even number of coordinates is expected, because a segment has 2 ends.
         // An if this algorithm always works, it must always find an even count.
         if( ( x_coordinates.size() & 1 ) != 0 )
-        {
-            success = false;
-            break;
-        }
+            return false;
 
         // Fill cells having the same Y coordinate
         int iimax = x_coordinates.size() - 1;
@@ -244,26 +256,63 @@ bool AR_AUTOPLACER::fillMatrix()
         {
             int seg_start_x = x_coordinates[ii] - coord_orgin.x;
             int seg_end_x = x_coordinates[ii + 1] - coord_orgin.x;
+
             // Fill cells at y coord = idy,
             // and at x cood >= seg_start_x and <= seg_end_x
+            int idx_start = seg_start_x / step;
+            int idx_end = seg_end_x / step;
 
-            for( int idx = seg_start_x / step; idx < m_matrix.m_Ncols; idx++ )
-            {
-                if( idx * step > seg_end_x )
-                    break;
+            if( idx_start * step < seg_start_x )
+                idx_start++;
 
-                if( idx * step >= seg_start_x )
-                    m_matrix.SetCell( idy, idx, AR_SIDE_BOTTOM, CELL_IS_ZONE );
-            }
+            if( idx_end * step > seg_end_x )
+                idx_end--;
+
+            idx_start = std::max( idx_start, 0 );
+            idx_end = std::min( idx_end, m_matrix.m_Ncols - 1 );
+
+            m_matrix.WriteCellSpan( idy, idx_start, idx_end, AR_SIDE_BOTTOM, CELL_IS_ZONE );
+        }
+
+        return true;
+    };
 
+    // A scan line is only a few span writes: give each thread at least 64 of them
+    size_t parallelThreadCount = std::min<size_t>( std::thread::hardware_concurrency(),
+                                                   ( lineCount + 63 ) / 64 );
+    std::atomic<size_t> nextLine( 0 );
+    std::vector<std::future<size_t>> returns( parallelThreadCount );
+
+    auto fill_lambda = [&]() -> size_t
+    {
+        size_t num = 0;
+
+        for( size_t i = nextLine++; i < lineCount && success; i = nextLine++ )
+        {
+            if( !scan_lambda( i ) )
+                success = false;
+
+            num++;
         }
-    }   // End examine segments in one area
+
+        return num;
+    };
+
+    if( parallelThreadCount <= 1 )
+        fill_lambda();
+    else
+    {
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            returns[ii] = std::async( std::launch::async, fill_lambda );
+
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            returns[ii].wait();
+    }
 
     return success;
 }
 
 
-
 void AR_AUTOPLACER::rotateModule( MODULE* module, double angle, bool incremental )
 {
     if( module == NULL )
@@ -466,19 +515,17 @@ int AR_AUTOPLACER::testRectangle( const EDA_RECT& aRect, int side )
     if( col_max >= ( m_matrix.m_Ncols - 1 ) )
         col_max = m_matrix.m_Ncols - 1;
 
-    for( int row = row_min; row <= row_max; row++ )
-    {
-        for( int col = col_min; col <= col_max; col++ )
-        {
-            unsigned int data = m_matrix.GetCell( row, col, side );
+    if( row_min > row_max || col_min > col_max )
+        return AR_FREE_CELL;
 
-            if( ( data & CELL_IS_ZONE ) == 0 )
-                return AR_OUT_OF_BOARD;
+    // Every cell must be inside the board, and none must be used by a module
+    int cellCount = ( row_max - row_min + 1 ) * ( col_max - col_min + 1 );
 
-            if( (data & CELL_IS_MODULE) )
-                return AR_OCCUIPED_BY_MODULE;
-        }
-    }
+    if( m_matrix.CountZoneCells( row_min, col_min, row_max, col_max, side ) != cellCount )
+        return AR_OUT_OF_BOARD;
+
+    if( m_matrix.CountModuleCells( row_min, col_min, row_max, col_max, side ) != 0 )
+        return AR_OCCUIPED_BY_MODULE;
 
     return AR_FREE_CELL;
 }
@@ -535,19 +582,11 @@ unsigned int AR_AUTOPLACER::calculateKeepOutArea( const EDA_RECT& aRect, int sid
     if( col_max >= ( m_matrix.m_Ncols - 1 ) )
         col_max = m_matrix.m_Ncols - 1;
 
-    unsigned int keepOutCost = 0;
-
-    for( int row = row_min; row <= row_max; row++ )
-    {
-        for( int col = col_min; col <= col_max; col++ )
-        {
-            // m_matrix.GetDist returns the "cost" of the cell
-            // at position (row, col)
-            // in autoplace this is the cost of the cell, if it is
-            // inside aRect
-            keepOutCost += m_matrix.GetDist( row, col, side );
-        }
-    }
+    // m_matrix.GetDist returns the "cost" of the cell
+    // at position (row, col)
+    // in autoplace this is the cost of the cell, if it is
+    // inside aRect
+    unsigned int keepOutCost = m_matrix.SumDist( row_min, col_min, row_max, col_max, side );
 
     return keepOutCost;
 }
@@ -570,8 +609,6 @@ int AR_AUTOPLACER::testModuleOnBoard( MODULE* aModule, bool TstOtherSide, const
     EDA_RECT    fpBBox = aModule->GetFootprintRect();
     fpBBox.Move( -aOffset );
 
-    buildFpAreas( aModule, 0 );
-
     int diag = //testModuleByPolygon( aModule, side, aOffset );
         testRectangle( fpBBox, side );
 //printf("test %p diag %d\n", aModule, diag);fflush(0);
@@ -594,11 +631,59 @@ int AR_AUTOPLACER::testModuleOnBoard( MODULE* aModule, bool TstOtherSide, const
 }
 
 
+void AR_AUTOPLACER::evaluatePlacements( MODULE* aModule, bool aTstOtherSide,
+                                        const std::vector<wxPoint>& aPositions,
+                                        std::vector<double>& aScores )
+{
+    wxPoint mod_pos = aModule->GetPosition();
+
+    aScores.assign( aPositions.size(), -1.0 );
+
+    // The matrix, the board and the footprint are only read during the scan,
+    // so candidate positions can be evaluated concurrently.
+    // Each position is a full keep out and ratsnest evaluation, so 32 of them are
+    // enough to pay for a thread
+    size_t parallelThreadCount = std::min<size_t>( std::thread::hardware_concurrency(),
+                                                   ( aPositions.size() + 31 ) / 32 );
+    std::atomic<size_t> nextPosition( 0 );
+    std::vector<std::future<size_t>> returns( parallelThreadCount );
+
+    auto eval_lambda = [&]() -> size_t
+    {
+        size_t num = 0;
+
+        for( size_t i = nextPosition++; i < aPositions.size(); i = nextPosition++ )
+        {
+            wxPoint moduleOffset = mod_pos - aPositions[i];
+            int keepOutCost = testModuleOnBoard( aModule, aTstOtherSide, moduleOffset );
+
+            if( keepOutCost >= 0 )    // i.e. if the module can be put here
+                aScores[i] = computePlacementRatsnestCost( aModule, moduleOffset ) + keepOutCost;
+
+            num++;
+        }
+
+        return num;
+    };
+
+    if( parallelThreadCount <= 1 )
+        eval_lambda();
+    else
+    {
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            returns[ii] = std::async( std::launch::async, eval_lambda );
+
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            returns[ii].wait();
+    }
+}
+
+
 int AR_AUTOPLACER::getOptimalModulePlacement(MODULE* aModule)
 {
     int     error = 1;
     wxPoint LastPosOK;
-    double  min_cost, curr_cost, Score;
+    double  min_cost;
     bool    TstOtherSide;
 
     aModule->CalculateBoundingBox();
@@ -622,9 +707,6 @@ int AR_AUTOPLACER::getOptimalModulePlacement(MODULE* aModule)
     initialPos.x    -= initialPos.x % m_matrix.m_GridRouting;
     initialPos.y    -= initialPos.y % m_matrix.m_GridRouting;
 
-    m_curPosition = initialPos;
-    auto moduleOffset = mod_pos - m_curPosition;
-
     /* Examine pads, and set TstOtherSide to true if a footprint
      * has at least 1 pad through.
      */
@@ -644,43 +726,107 @@ int AR_AUTOPLACER::getOptimalModulePlacement(MODULE* aModule)
         }
     }
 
-    fpBBox.SetOrigin( fpBBoxOrg + m_curPosition );
+    // The footprint areas do not depend on the candidate position: build them once,
+    // before the (multi-threaded) scan
+    buildFpAreas( aModule, 0 );
 
     min_cost = -1.0;
-//    m_frame->SetStatusText( wxT( "Score ??, pos ??" ) );
 
+    // Keep the best score of aPositions. Candidates are examined in scan order
+    // and the last one wins on equal scores, so the result does not depend on
+    // the number of threads used to evaluate them.
+    auto select_best = [&]( const std::vector<wxPoint>& aPositions,
+                            const std::vector<double>& aScores )
+    {
+        for( size_t ii = 0; ii < aPositions.size(); ii++ )
+        {
+            if( aScores[ii] < 0 )
+                continue;
+
+            error = 0;
+
+            if( ( min_cost >= aScores[ii] ) || ( min_cost < 0 ) )
+            {
+                LastPosOK   = aPositions[ii];
+                min_cost    = aScores[ii];
+            }
+        }
+    };
 
-    for( ; m_curPosition.x < xylimit.x; m_curPosition.x += m_matrix.m_GridRouting )
+    int step = m_matrix.m_GridRouting;
+
+    if( m_coarseToFineSearch )
+        step *= AR_COARSE_SEARCH_FACTOR;
+
+    std::vector<wxPoint> positions;
+    std::vector<double>  scores;
+
+    for( int x = initialPos.x; x < xylimit.x; x += step )
+    {
+        for( int y = initialPos.y; y < xylimit.y; y += step )
+            positions.emplace_back( x, y );
+    }
+
+    evaluatePlacements( aModule, TstOtherSide, positions, scores );
+
+    if( !m_coarseToFineSearch )
+    {
+        select_best( positions, scores );
+    }
+    else
     {
-        m_curPosition.y = initialPos.y;
+        // Keep the best coarse candidates, and search the full resolution grid around them
+        std::vector<size_t> coarseBest;
 
-        for( ; m_curPosition.y < xylimit.y; m_curPosition.y += m_matrix.m_GridRouting )
+        for( size_t ii = 0; ii < positions.size(); ii++ )
         {
+            if( scores[ii] >= 0 )
+                coarseBest.push_back( ii );
+        }
 
-            fpBBox.SetOrigin( fpBBoxOrg + m_curPosition );
-            moduleOffset = mod_pos - m_curPosition;
-            int keepOutCost = testModuleOnBoard( aModule, TstOtherSide, moduleOffset );
+        size_t keptCount = std::min<size_t>( coarseBest.size(), AR_COARSE_SEARCH_CANDIDATES );
 
-            if( keepOutCost >= 0 )    // i.e. if the module can be put here
+        std::partial_sort( coarseBest.begin(), coarseBest.begin() + keptCount, coarseBest.end(),
+                [&]( size_t a, size_t b )
+                {
+                    return scores[a] < scores[b] || ( scores[a] == scores[b] && a < b );
+                } );
+
+        coarseBest.resize( keptCount );
+
+        std::vector<std::pair<int, int>> finePositions;
+        int radius = ( AR_COARSE_SEARCH_FACTOR - 1 ) * m_matrix.m_GridRouting;
+
+        for( size_t idx : coarseBest )
+        {
+            const wxPoint& center = positions[idx];
+
+            for( int x = center.x - radius; x <= center.x + radius; x += m_matrix.m_GridRouting )
             {
-                error = 0;
-                // m_frame->build_ratsnest_module( aModule ); // fixme
-                curr_cost   = computePlacementRatsnestCost( aModule, moduleOffset );
-                Score       = curr_cost + keepOutCost;
+                if( x < initialPos.x || x >= xylimit.x )
+                    continue;
 
-                if( (min_cost >= Score ) || (min_cost < 0 ) )
+                for( int y = center.y - radius; y <= center.y + radius;
+                        y += m_matrix.m_GridRouting )
                 {
-                    LastPosOK   = m_curPosition;
-                    min_cost    = Score;
-                    wxString msg;
-/*                    msg.Printf( wxT( "Score %g, pos %s, %s" ),
-                                min_cost,
-                                GetChars( ::CoordinateToString( LastPosOK.x ) ),
-                                GetChars( ::CoordinateToString( LastPosOK.y ) ) );
-                    m_frame->SetStatusText( msg );*/
+                    if( y >= initialPos.y && y < xylimit.y )
+                        finePositions.emplace_back( x, y );
                 }
             }
         }
+
+        // Remove duplicates of overlapping windows, and restore the scan order
+        std::sort( finePositions.begin(), finePositions.end() );
+        finePositions.erase( std::unique( finePositions.begin(), finePositions.end() ),
+                             finePositions.end() );
+
+        positions.clear();
+
+        for( const auto& pos : finePositions )
+            positions.emplace_back( pos.first, pos.second );
+
+        evaluatePlacements( aModule, TstOtherSide, positions, scores );
+        select_best( positions, scores );
     }
 
     // Regeneration of the modified variable.
@@ -953,6 +1099,8 @@ AR_RESULT AR_AUTOPLACER::AutoplaceModules( std::vector<MODULE*> aModules,
             genModuleOnRoutingMatrix( m );
     }
 
+    m_matrix.BuildSummedAreaTables();
+
 
     int         cnt = 0;
     wxString    msg;
@@ -1080,6 +1228,7 @@ end_of_tst:
 
         module->CalculateBoundingBox();
         genModuleOnRoutingMatrix( module );
+        m_matrix.BuildSummedAreaTables();
         module->SetIsPlaced( true );
         module->SetNeedsPlaced( false );
         drawPlacementRoutingMatrix();
@@ -70,6 +70,16 @@ public:
         m_gridSize = aGrid;
     }
 
+    /**
+     * Enable the coarse to fine placement search: candidate positions are first
+     * evaluated on a coarse grid, then on the placement grid only around the best
+     * coarse positions. Much faster on large boards, but can miss the optimal position.
+     */
+    void SetCoarseToFineSearch( bool aEnable )
+    {
+        m_coarseToFineSearch = aEnable;
+    }
+
     /**
      * Set a VIEW overlay to draw items during a autoplace session.
      */
@@ -103,11 +113,22 @@ private:
     bool         fillMatrix();
     void         genModuleOnRoutingMatrix( MODULE* Module );
 
+    // testRectangle and calculateKeepOutArea use the summed-area tables of m_matrix,
+    // so m_matrix.BuildSummedAreaTables() must be called after any matrix change.
     int          testRectangle( const EDA_RECT& aRect, int side );
     int          testModuleByPolygon( MODULE* aModule,int aSide, const wxPoint& aOffset );
     unsigned int calculateKeepOutArea( const EDA_RECT& aRect, int side );
     int          testModuleOnBoard( MODULE* aModule, bool TstOtherSide, const wxPoint& aOffset );
     int          getOptimalModulePlacement( MODULE* aModule );
+
+    /**
+     * Compute the placement score of aModule at each position of aPositions
+     * (positions are evaluated concurrently).
+     * aScores[i] is the score of aPositions[i], or -1 if the module cannot be put there.
+     */
+    void         evaluatePlacements( MODULE* aModule, bool aTstOtherSide,
+                                     const std::vector<wxPoint>& aPositions,
+                                     std::vector<double>& aScores );
     double       computePlacementRatsnestCost( MODULE* aModule, const wxPoint& aOffset );
 
     /**
@@ -143,6 +164,7 @@ private:
     wxPoint m_moduleOffset;
     double  m_minCost;
     int     m_gridSize;
+    bool    m_coarseToFineSearch;
 
     std::shared_ptr<KIGFX::VIEW_OVERLAY>    m_overlay;
     std::unique_ptr<CONNECTIVITY_DATA>      m_connectivity;
@@ -36,12 +36,16 @@
 #include <class_pad.h>
 #include <class_track.h>
 
+#include <cmath>
+#include <future>
+
 AR_MATRIX::AR_MATRIX()
 {
     m_BoardSide[0] = m_BoardSide[1] = nullptr;
     m_DistSide[0] = m_DistSide[1] = nullptr;
     m_DirSide[0] = m_DirSide[1] = nullptr;
     m_opWriteCell = nullptr;
+    m_opCell = WRITE_CELL;
     m_InitMatrixDone = false;
     m_Nrows = 0;
     m_Ncols = 0;
@@ -165,6 +169,10 @@ void AR_MATRIX::UnInitRoutingMatrix()
             delete m_BoardSide[ii];
             m_BoardSide[ii] = nullptr;
         }
+
+        m_zoneSAT[ii].clear();
+        m_moduleSAT[ii].clear();
+        m_distSAT[ii].clear();
     }
 
     m_Nrows = m_Ncols = 0;
@@ -173,6 +181,8 @@ void AR_MATRIX::UnInitRoutingMatrix()
 // Initialize m_opWriteCell member to make the aLogicOp
 void AR_MATRIX::SetCellOperation( AR_MATRIX::CELL_OP aLogicOp )
 {
+    m_opCell = aLogicOp;
+
     switch( aLogicOp )
     {
     default:
@@ -189,6 +199,144 @@ void AR_MATRIX::SetCellOperation( AR_MATRIX::CELL_OP aLogicOp )
 }
 
 
+void AR_MATRIX::WriteCellSpan( int aRow, int aColStart, int aColEnd, int aSide, MATRIX_CELL aCell )
+{
+    if( aColStart > aColEnd )
+        return;
+
+    MATRIX_CELL* p = m_BoardSide[aSide] + aRow * m_Ncols;
+
+    switch( m_opCell )
+    {
+    default:
+    case WRITE_CELL:
+        memset( p + aColStart, aCell, ( aColEnd - aColStart + 1 ) * sizeof( MATRIX_CELL ) );
+        break;
+
+    case WRITE_OR_CELL:
+        for( int col = aColStart; col <= aColEnd; col++ )
+            p[col] |= aCell;
+        break;
+
+    case WRITE_XOR_CELL:
+        for( int col = aColStart; col <= aColEnd; col++ )
+            p[col] ^= aCell;
+        break;
+
+    case WRITE_AND_CELL:
+        for( int col = aColStart; col <= aColEnd; col++ )
+            p[col] &= aCell;
+        break;
+
+    case WRITE_ADD_CELL:
+        for( int col = aColStart; col <= aColEnd; col++ )
+            p[col] += aCell;
+        break;
+    }
+}
+
+
+void AR_MATRIX::BuildSummedAreaTables()
+{
+    const int stride = m_Ncols + 1;
+    const size_t tableSize = (size_t) ( m_Nrows + 1 ) * stride;
+
+    auto build_lambda = [&]( int aSide ) -> size_t
+    {
+        std::vector<int>&     zoneSAT = m_zoneSAT[aSide];
+        std::vector<int>&     moduleSAT = m_moduleSAT[aSide];
+        std::vector<int64_t>& distSAT = m_distSAT[aSide];
+
+        // Row 0 and column 0 are the zero padding
+        zoneSAT.assign( tableSize, 0 );
+        moduleSAT.assign( tableSize, 0 );
+        distSAT.assign( tableSize, 0 );
+
+        const MATRIX_CELL* cells = m_BoardSide[aSide];
+        const DIST_CELL*   dists = m_DistSide[aSide];
+
+        for( int row = 0; row < m_Nrows; row++ )
+        {
+            int     zoneRow = 0;
+            int     moduleRow = 0;
+            int64_t distRow = 0;
+
+            size_t above = (size_t) row * stride;
+            size_t curr = above + stride;
+
+            for( int col = 0; col < m_Ncols; col++ )
+            {
+                MATRIX_CELL cell = cells[row * m_Ncols + col];
+
+                zoneRow += ( cell & CELL_IS_ZONE ) ? 1 : 0;
+                moduleRow += ( cell & CELL_IS_MODULE ) ? 1 : 0;
+                distRow += dists[row * m_Ncols + col];
+
+                zoneSAT[curr + col + 1] = zoneSAT[above + col + 1] + zoneRow;
+                moduleSAT[curr + col + 1] = moduleSAT[above + col + 1] + moduleRow;
+                distSAT[curr + col + 1] = distSAT[above + col + 1] + distRow;
+            }
+        }
+
+        return 1;
+    };
+
+    std::vector<std::future<size_t>> returns;
+
+    for( int side = 0; side < AR_MAX_ROUTING_LAYERS_COUNT; side++ )
+    {
+        if( m_BoardSide[side] && m_DistSide[side] )
+            returns.push_back( std::async( std::launch::async, build_lambda, side ) );
+        else
+        {
+            m_zoneSAT[side].clear();
+            m_moduleSAT[side].clear();
+            m_distSAT[side].clear();
+        }
+    }
+
+    for( auto& ret : returns )
+        ret.wait();
+}
+
+
+/* Returns the sum of the summed-area table aTable over the cell rectangle
+ * aRowMin..aRowMax, aColMin..aColMax (inclusive)
+ */
+template <typename T>
+static T rectSum( const std::vector<T>& aTable, int aStride, int aRowMin, int aColMin,
+                  int aRowMax, int aColMax )
+{
+    if( aTable.empty() || aRowMin > aRowMax || aColMin > aColMax )
+        return 0;
+
+    return aTable[( aRowMax + 1 ) * aStride + aColMax + 1]
+         - aTable[aRowMin * aStride + aColMax + 1]
+         - aTable[( aRowMax + 1 ) * aStride + aColMin]
+         + aTable[aRowMin * aStride + aColMin];
+}
+
+
+int AR_MATRIX::CountZoneCells( int aRowMin, int aColMin, int aRowMax, int aColMax,
+                               int aSide ) const
+{
+    return rectSum( m_zoneSAT[aSide], m_Ncols + 1, aRowMin, aColMin, aRowMax, aColMax );
+}
+
+
+int AR_MATRIX::CountModuleCells( int aRowMin, int aColMin, int aRowMax, int aColMax,
+                                 int aSide ) const
+{
+    return rectSum( m_moduleSAT[aSide], m_Ncols + 1, aRowMin, aColMin, aRowMax, aColMax );
+}
+
+
+int64_t AR_MATRIX::SumDist( int aRowMin, int aColMin, int aRowMax, int aColMax, int aSide ) const
+{
+    return rectSum( m_distSAT[aSide], m_Ncols + 1, aRowMin, aColMin, aRowMax, aColMax );
+}
+
+
 /* return the value stored in a cell
  */
 AR_MATRIX::MATRIX_CELL AR_MATRIX::GetCell( int aRow, int aCol, int aSide )
@@ -539,15 +687,16 @@ void AR_MATRIX::drawSegmentQcq( int ux0, int uy0, int ux1, int uy1, int lg, LAYE
 
     //printf("col_min %d max %d row_min %d max %d\n", col_min, col_max, row_min, row_max);
 
-    for( col = col_min; col <= col_max; col++ )
+    // Scan row by row, so consecutive writes hit consecutive cells of the matrix
+    for( row = row_min; row <= row_max; row++ )
     {
-        int64_t cxr;
-        cxr = ( col * m_GridRouting ) - ux0;
+        int64_t cyr;
+        cyr = ( row * m_GridRouting ) - uy0;
 
-        for( row = row_min; row <= row_max; row++ )
+        for( col = col_min; col <= col_max; col++ )
         {
-            cy = ( row * m_GridRouting ) - uy0;
-            cx = cxr;
+            cx = ( col * m_GridRouting ) - ux0;
+            cy = cyr;
             RotatePoint( &cx, &cy, angle );
 
             if( abs( cy ) > lg )
@@ -629,12 +778,11 @@ void AR_MATRIX::traceCircle( int ux0, int uy0, int ux1, int uy1, int lg, LAYER_N
 void AR_MATRIX::traceFilledCircle(
         int cx, int cy, int radius, LSET aLayerMask, int color, AR_MATRIX::CELL_OP op_logic )
 {
-    int    row, col;
+    int    row;
     int    ux0, uy0, ux1, uy1;
     int    row_max, col_max, row_min, col_min;
     int    trace = 0;
     double fdistmin, fdistx, fdisty;
-    int    tstwrite = 0;
     int    distmin;
 
     if( aLayerMask[m_routeLayerBottom] )
@@ -685,32 +833,66 @@ void AR_MATRIX::traceFilledCircle(
     if( col_min > col_max )
         col_max = col_min;
 
-    fdistmin = (double) distmin * distmin;
-
-    for( row = row_min; row <= row_max; row++ )
+    // Fill the cells whose center is strictly closer than sqrt( aDist2 ) to the circle
+    // center. The cells inside the circle are contiguous on each row, so they are
+    // written as one span per row.
+    auto fillCircleSpans = [&]( double aDist2 ) -> bool
     {
-        fdisty = (double) ( cy - ( row * m_GridRouting ) );
-        fdisty *= fdisty;
+        bool written = false;
 
-        for( col = col_min; col <= col_max; col++ )
+        for( row = row_min; row <= row_max; row++ )
         {
-            fdistx = (double) ( cx - ( col * m_GridRouting ) );
-            fdistx *= fdistx;
+            fdisty = (double) ( cy - ( row * m_GridRouting ) );
+            fdisty *= fdisty;
+
+            if( aDist2 <= fdisty )
+                continue;
+
+            auto inCircle = [&]( int aCol ) -> bool
+            {
+                fdistx = (double) ( cx - ( aCol * m_GridRouting ) );
+                return ( fdistx * fdistx + fdisty ) < aDist2;
+            };
 
-            if( fdistmin <= ( fdistx + fdisty ) )
+            double halfChord = sqrt( aDist2 - fdisty );
+            int    spanStart = (int) ceil( ( cx - halfChord ) / m_GridRouting );
+            int    spanEnd = (int) floor( ( cx + halfChord ) / m_GridRouting );
+
+            spanStart = Clamp( col_min, spanStart, col_max + 1 );
+            spanEnd = Clamp( col_min - 1, spanEnd, col_max );
+
+            // Fix rounding errors at the span ends, so the result is exactly
+            // the same as a cell by cell test
+            while( spanStart <= spanEnd && !inCircle( spanStart ) )
+                spanStart++;
+
+            while( spanStart > col_min && inCircle( spanStart - 1 ) )
+                spanStart--;
+
+            while( spanEnd >= spanStart && !inCircle( spanEnd ) )
+                spanEnd--;
+
+            while( spanEnd < col_max && inCircle( spanEnd + 1 ) )
+                spanEnd++;
+
+            if( spanStart > spanEnd )
                 continue;
 
             if( trace & 1 )
-                WriteCell( row, col, AR_SIDE_BOTTOM, color );
+                WriteCellSpan( row, spanStart, spanEnd, AR_SIDE_BOTTOM, color );
 
             if( trace & 2 )
-                WriteCell( row, col, AR_SIDE_TOP, color );
+                WriteCellSpan( row, spanStart, spanEnd, AR_SIDE_TOP, color );
 
-            tstwrite = 1;
+            written = true;
         }
-    }
 
-    if( tstwrite )
+        return written;
+    };
+
+    fdistmin = (double) distmin * distmin;
+
+    if( fillCircleSpans( fdistmin ) )
         return;
 
     /* If no cell has been written, it affects the 4 neighboring diagonal
@@ -719,26 +901,7 @@ void AR_MATRIX::traceFilledCircle(
     distmin = m_GridRouting / 2 + 1;
     fdistmin = ( (double) distmin * distmin ) * 2; // Distance to center point diagonally
 
-    for( row = row_min; row <= row_max; row++ )
-    {
-        fdisty = (double) ( cy - ( row * m_GridRouting ) );
-        fdisty *= fdisty;
-
-        for( col = col_min; col <= col_max; col++ )
-        {
-            fdistx = (double) ( cx - ( col * m_GridRouting ) );
-            fdistx *= fdistx;
-
-            if( fdistmin <= ( fdistx + fdisty ) )
-                continue;
-
-            if( trace & 1 )
-                WriteCell( row, col, AR_SIDE_BOTTOM, color );
-
-            if( trace & 2 )
-                WriteCell( row, col, AR_SIDE_TOP, color );
-        }
-    }
+    fillCircleSpans( fdistmin );
 }
 
 
@@ -882,7 +1045,7 @@ void AR_MATRIX::TraceFilledRectangle( int ux0, int uy0, int ux1, int uy1, double
 void AR_MATRIX::TraceFilledRectangle( int ux0, int uy0, int ux1, int uy1, LSET aLayerMask,
         int color, AR_MATRIX::CELL_OP op_logic )
 {
-    int row, col;
+    int row;
     int row_min, row_max, col_min, col_max;
     int trace = 0;
 
@@ -929,14 +1092,11 @@ void AR_MATRIX::TraceFilledRectangle( int ux0, int uy0, int ux1, int uy1, LSET a
 
     for( row = row_min; row <= row_max; row++ )
     {
-        for( col = col_min; col <= col_max; col++ )
-        {
-            if( trace & 1 )
-                WriteCell( row, col, AR_SIDE_BOTTOM, color );
+        if( trace & 1 )
+            WriteCellSpan( row, col_min, col_max, AR_SIDE_BOTTOM, color );
 
-            if( trace & 2 )
-                WriteCell( row, col, AR_SIDE_TOP, color );
-        }
+        if( trace & 2 )
+            WriteCellSpan( row, col_min, col_max, AR_SIDE_TOP, color );
     }
 }
 
@@ -29,6 +29,9 @@
 #ifndef __AR_MATRIX_H
 #define __AR_MATRIX_H
 
+#include <cstdint>
+#include <vector>
+
 #include <eda_rect.h>
 #include <layers_id_colors_and_visibility.h>
 
@@ -69,11 +72,6 @@ public:
     PCB_LAYER_ID m_routeLayerTop;
     PCB_LAYER_ID m_routeLayerBottom;
 
-private:
-    // a pointer to the current selected cell operation
-    void ( AR_MATRIX::*m_opWriteCell )( int aRow, int aCol, int aSide, MATRIX_CELL aCell );
-
-public:
     enum CELL_OP
     {
         WRITE_CELL = 0,
@@ -83,6 +81,21 @@ public:
         WRITE_ADD_CELL = 4
     };
 
+private:
+    // a pointer to the current selected cell operation
+    void ( AR_MATRIX::*m_opWriteCell )( int aRow, int aCol, int aSide, MATRIX_CELL aCell );
+
+    // the current selected cell operation, used by the row span writer
+    CELL_OP m_opCell;
+
+    // Summed-area tables, one per side, (m_Nrows + 1) x (m_Ncols + 1) entries.
+    // Entry (r + 1, c + 1) holds the count (or sum) over cells (0..r, 0..c).
+    std::vector<int>     m_zoneSAT[AR_MAX_ROUTING_LAYERS_COUNT];   // cells having CELL_IS_ZONE
+    std::vector<int>     m_moduleSAT[AR_MAX_ROUTING_LAYERS_COUNT]; // cells having CELL_IS_MODULE
+    std::vector<int64_t> m_distSAT[AR_MAX_ROUTING_LAYERS_COUNT];   // sum of distance cells
+
+public:
+
     AR_MATRIX();
     ~AR_MATRIX();
 
@@ -91,6 +104,35 @@ public:
         ( *this.*m_opWriteCell )( aRow, aCol, aSide, aCell );
     }
 
+    /**
+     * Function WriteCellSpan
+     * applies the current cell operation (see SetCellOperation) to the cells
+     * aColStart ... aColEnd (inclusive) of row aRow.
+     * The operation is selected once for the whole span, so the inner loops are
+     * plain array loops the compiler can vectorize.
+     */
+    void WriteCellSpan( int aRow, int aColStart, int aColEnd, int aSide, MATRIX_CELL aCell );
+
+    /**
+     * Function BuildSummedAreaTables
+     * (re)builds the summed-area tables of the cell and distance maps of each side.
+     * Must be called after the matrix was modified and before using
+     * CountZoneCells, CountModuleCells or SumDist.
+     * Each side is built in its own thread.
+     */
+    void BuildSummedAreaTables();
+
+    /**
+     * Functions CountZoneCells, CountModuleCells and SumDist
+     * return in O(1) the number of cells having CELL_IS_ZONE (resp. CELL_IS_MODULE) set,
+     * or the sum of distance cells, inside the cell rectangle
+     * aRowMin ... aRowMax, aColMin ... aColMax (inclusive) of aSide.
+     * They use the summed-area tables, see BuildSummedAreaTables().
+     */
+    int     CountZoneCells( int aRowMin, int aColMin, int aRowMax, int aColMax, int aSide ) const;
+    int     CountModuleCells( int aRowMin, int aColMin, int aRowMax, int aColMax, int aSide ) const;
+    int64_t SumDist( int aRowMin, int aColMin, int aRowMax, int aColMax, int aSide ) const;
+
     /**
      * function GetBrdCoordOrigin
      * @return the board coordinate corresponding to the
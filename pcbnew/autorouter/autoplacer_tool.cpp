@@ -22,6 +22,7 @@
  */
 
 
+#include <advanced_config.h>
 #include <board_commit.h>
 #include <class_draw_panel_gal.h>
 #include <confirm.h>
@@ -88,6 +89,7 @@ int AUTOPLACE_TOOL::autoplace( std::vector<MODULE*>& aModules, bool aPlaceOffboa
     BOARD_COMMIT commit( frame() );
 
     autoplacer.SetOverlay( overlay );
+    autoplacer.SetCoarseToFineSearch( ADVANCED_CFG::GetCfg().m_coarseAutoplaceSearch );
     fparent = frame();
     std::function<int( MODULE* aModule )> callback = refreshCallback;
     autoplacer.SetRefreshCallback( callback );
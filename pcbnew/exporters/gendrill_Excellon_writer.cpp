@@ -76,7 +76,7 @@ EXCELLON_WRITER::EXCELLON_WRITER( BOARD* aPcb )
 }
 
 
-void EXCELLON_WRITER::CreateDrillandMapFilesSet( const wxString& aPlotDirectory,
+bool EXCELLON_WRITER::CreateDrillandMapFilesSet( const wxString& aPlotDirectory,
                                                  bool aGenDrill, bool aGenMap,
                                                  REPORTER * aReporter )
 {
@@ -118,7 +118,8 @@ void EXCELLON_WRITER::CreateDrillandMapFilesSet( const wxString& aPlotDirectory,
                         msg.Printf( _( "** Unable to create %s **\n" ), GetChars( fullFilename ) );
                         aReporter->Report( msg );
                     }
-                    break;
+
+                    return false;
                 }
                 else
                 {
@@ -135,7 +136,9 @@ void EXCELLON_WRITER::CreateDrillandMapFilesSet( const wxString& aPlotDirectory,
     }
 
     if( aGenMap )
-        CreateMapFilesSet( aPlotDirectory, aReporter );
+        return CreateMapFilesSet( aPlotDirectory, aReporter );
+
+    return true;
 }
 
 
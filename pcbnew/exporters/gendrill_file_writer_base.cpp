@@ -291,7 +291,7 @@ const wxString GENDRILL_WRITER_BASE::getDrillFileName( DRILL_LAYER_PAIR aPair, b
     return ret;
 }
 
-void GENDRILL_WRITER_BASE::CreateMapFilesSet( const wxString& aPlotDirectory,
+bool GENDRILL_WRITER_BASE::CreateMapFilesSet( const wxString& aPlotDirectory,
                                               REPORTER * aReporter )
 {
     wxFileName  fn;
@@ -333,7 +333,7 @@ void GENDRILL_WRITER_BASE::CreateMapFilesSet( const wxString& aPlotDirectory,
                     aReporter->Report( msg );
                 }
 
-                return;
+                return false;
             }
             else
             {
@@ -345,6 +345,8 @@ void GENDRILL_WRITER_BASE::CreateMapFilesSet( const wxString& aPlotDirectory,
             }
         }
     }
+
+    return true;
 }
 
 
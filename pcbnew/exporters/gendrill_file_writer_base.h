@@ -204,8 +204,9 @@ public:
      * filenames are computed from the board name, and layers id
      * @param aPlotDirectory = the output folder
      * @param aReporter = a REPORTER to return activity or any message (can be NULL)
+     * @return false if a file could not be created
      */
-    void CreateMapFilesSet( const wxString& aPlotDirectory,
+    bool CreateMapFilesSet( const wxString& aPlotDirectory,
                             REPORTER* aReporter = NULL );
 
     /**
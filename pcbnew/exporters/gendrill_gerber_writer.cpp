@@ -59,7 +59,7 @@ GERBER_WRITER::GERBER_WRITER( BOARD* aPcb )
 }
 
 
-void GERBER_WRITER::CreateDrillandMapFilesSet( const wxString& aPlotDirectory,
+bool GERBER_WRITER::CreateDrillandMapFilesSet( const wxString& aPlotDirectory,
                                                  bool aGenDrill, bool aGenMap,
                                                  REPORTER * aReporter )
 {
@@ -104,7 +104,8 @@ void GERBER_WRITER::CreateDrillandMapFilesSet( const wxString& aPlotDirectory,
                         msg.Printf( _( "** Unable to create %s **\n" ), fullFilename );
                         aReporter->Report( msg );
                     }
-                    break;
+
+                    return false;
                 }
                 else
                 {
@@ -120,7 +121,9 @@ void GERBER_WRITER::CreateDrillandMapFilesSet( const wxString& aPlotDirectory,
     }
 
     if( aGenMap )
-        CreateMapFilesSet( aPlotDirectory, aReporter );
+        return CreateMapFilesSet( aPlotDirectory, aReporter );
+
+    return true;
 }
 
 // A helper class to transform an oblong hole to a segment
@@ -38,6 +38,7 @@
 #include <class_marker_pcb.h>
 #include <pcb_base_frame.h>
 #include <confirm.h>
+#include <advanced_config.h>
 
 #include <gal/graphics_abstraction_layer.h>
 
@@ -111,6 +112,9 @@ PCB_DRAW_PANEL_GAL::PCB_DRAW_PANEL_GAL( wxWindow* aParentWindow, wxWindowID aWin
     m_view = new KIGFX::PCB_VIEW( true );
     m_view->SetGAL( m_gal );
 
+    // Only used if the GAL supports it, i.e. with the Cairo canvas
+    m_view->SetUseTileCache( ADVANCED_CFG::GetCfg().m_cairoTileCache );
+
     m_painter.reset( new KIGFX::PCB_PAINTER( m_gal ) );
     m_view->SetPainter( m_painter.get() );
 
@@ -704,6 +704,7 @@ void PCB_LAYER_WIDGET::OnRenderEnable( int aId, bool isEnabled )
     else if( aId == LAYER_RATSNEST )
     {
         // don't touch the layers. ratsnest is enabled on per-item basis.
+        myframe->GetCanvas()->GetView()->InvalidateTiles( LAYER_RATSNEST );
         myframe->GetCanvas()->GetView()->MarkTargetDirty( KIGFX::TARGET_NONCACHED );
         myframe->GetCanvas()->GetView()->SetLayerVisible( aId, true );
 
@@ -375,6 +375,55 @@ bool PCB_PAINTER::Draw( const VIEW_ITEM* aItem, int aLayer )
 }
 
 
+void PCB_PAINTER::PrepareDraw( const VIEW_ITEM* aItem )
+{
+    // Only the OpenGL GAL draws filled polygons using their cached triangulation
+    if( !m_gal->IsOpenGlEngine() )
+        return;
+
+    const EDA_ITEM* item = dynamic_cast<const EDA_ITEM*>( aItem );
+
+    if( !item )
+        return;
+
+    switch( item->Type() )
+    {
+    case PCB_LINE_T:
+    case PCB_MODULE_EDGE_T:
+    {
+        DRAWSEGMENT* segment = const_cast<DRAWSEGMENT*>( static_cast<const DRAWSEGMENT*>( item ) );
+
+        if( segment->GetShape() == S_POLYGON )
+        {
+            SHAPE_POLY_SET& shape = segment->GetPolyShape();
+
+            if( shape.OutlineCount() && !shape.IsTriangulationUpToDate() )
+                shape.CacheTriangulation();
+        }
+
+        break;
+    }
+
+    case PCB_ZONE_AREA_T:
+    {
+        const ZONE_CONTAINER* zone = static_cast<const ZONE_CONTAINER*>( item );
+
+        if( m_pcbSettings.m_displayZone != PCB_RENDER_SETTINGS::DZ_HIDE_FILLED
+                && zone->GetFilledPolysList().OutlineCount()
+                && !zone->GetFilledPolysList().IsTriangulationUpToDate() )
+        {
+            const_cast<ZONE_CONTAINER*>( zone )->CacheTriangulation();
+        }
+
+        break;
+    }
+
+    default:
+        break;
+    }
+}
+
+
 void PCB_PAINTER::draw( const TRACK* aTrack, int aLayer )
 {
     VECTOR2D start( aTrack->GetStart() );
@@ -97,6 +97,7 @@ PCB_PLOT_PARAMS::PCB_PLOT_PARAMS()
     m_includeGerberNetlistInfo   = false;
     m_createGerberJobFile        = false;
     m_gerberPrecision            = gbrDefaultPrecision;
+    m_useGerberApertureMacros    = false;
     m_excludeEdgeLayer           = true;
     m_lineWidth                  = g_DrawDefaultLineThickness;
     m_plotFrameRef               = false;
@@ -176,6 +177,10 @@ void PCB_PLOT_PARAMS::Format( OUTPUTFORMATTER* aFormatter,
         aFormatter->Print( aNestLevel+1, "(%s %d)\n",
                            getTokenName( T_gerberprecision ), m_gerberPrecision );
 
+    if( m_useGerberApertureMacros )    // save this option only if it is set, same reason
+        aFormatter->Print( aNestLevel+1, "(%s %s)\n",
+                           getTokenName( T_usegerberaperturemacros ), trueStr );
+
     aFormatter->Print( aNestLevel+1, "(%s %s)\n", getTokenName( T_excludeedgelayer ),
                        m_excludeEdgeLayer ? trueStr : falseStr );
     aFormatter->Print( aNestLevel+1, "(%s %f)\n", getTokenName( T_linewidth ),
@@ -249,6 +254,8 @@ bool PCB_PLOT_PARAMS::IsSameAs( const PCB_PLOT_PARAMS &aPcbPlotParams, bool aCom
         return false;
     if( m_gerberPrecision != aPcbPlotParams.m_gerberPrecision )
         return false;
+    if( m_useGerberApertureMacros != aPcbPlotParams.m_useGerberApertureMacros )
+        return false;
     if( m_excludeEdgeLayer != aPcbPlotParams.m_excludeEdgeLayer )
         return false;
     if( m_lineWidth != aPcbPlotParams.m_lineWidth )
@@ -422,6 +429,10 @@ void PCB_PLOT_PARAMS_PARSER::Parse( PCB_PLOT_PARAMS* aPcbPlotParams )
                 parseInt( gbrDefaultPrecision-1, gbrDefaultPrecision);
             break;
 
+        case T_usegerberaperturemacros:
+            aPcbPlotParams->m_useGerberApertureMacros = parseBool();
+            break;
+
         case T_psa4output:
             aPcbPlotParams->m_A4Output = parseBool();
             break;
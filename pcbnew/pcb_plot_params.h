@@ -122,6 +122,10 @@ private:
     /// 5 is the minimal value for professional boards.
     int         m_gerberPrecision;
 
+    /// Flash the custom pads with aperture macros shared by the identical pads,
+    /// instead of plotting them as regions
+    bool        m_useGerberApertureMacros;
+
     /// Plot gerbers using auxiliary (drill) origin instead of absolue coordinates
     bool        m_useAuxOrigin;
 
@@ -273,6 +277,9 @@ public:
     void        SetGerberPrecision( int aPrecision );
     int         GetGerberPrecision() const { return m_gerberPrecision; }
 
+    void        SetUseGerberApertureMacros( bool aUse ) { m_useGerberApertureMacros = aUse; }
+    bool        GetUseGerberApertureMacros() const { return m_useGerberApertureMacros; }
+
     /** Default precision of coordinates in Gerber files.
      * when units are in mm (7 in inches, but Pcbnew uses mm).
      * 6 is the internal resolution of Pcbnew, so the default is 6
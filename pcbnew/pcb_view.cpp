@@ -116,5 +116,8 @@ void PCB_VIEW::UpdateDisplayOptions( PCB_DISPLAY_OPTIONS* aOptions )
     auto    settings    = static_cast<KIGFX::PCB_RENDER_SETTINGS*>( painter->GetSettings() );
 
     settings->LoadDisplayOptions( aOptions, settings->GetShowPageLimits() );
+
+    // Items drawn as raster tiles have to be rendered again with the new options
+    InvalidateTiles();
 }
 }
@@ -43,6 +43,12 @@
 #include <macros.h>
 #include <build_version.h>
 #include <gbr_metadata.h>
+#include <exporters/gendrill_Excellon_writer.h>
+#include <exporters/gendrill_gerber_writer.h>
+
+#include <atomic>
+#include <future>
+#include <thread>
 
 
 const wxString GetGerberProtelExtension( LAYER_NUM aLayer )
@@ -490,6 +496,127 @@ bool PLOT_CONTROLLER::PlotLayer()
 }
 
 
+bool PLOT_CONTROLLER::PlotLayers( LSET aLayers, PlotFormat aFormat )
+{
+    return plotLayers( aLayers, aFormat, nullptr );
+}
+
+
+bool PLOT_CONTROLLER::PlotLayers( LSET aLayers, PlotFormat aFormat,
+                                  EXCELLON_WRITER* aDrillWriter, bool aGenMap, REPORTER* aReporter )
+{
+    return plotLayers( aLayers, aFormat,
+            [aDrillWriter, aGenMap, aReporter]( const wxString& aPlotDir )
+            {
+                return aDrillWriter->CreateDrillandMapFilesSet( aPlotDir, true, aGenMap,
+                                                                aReporter );
+            } );
+}
+
+
+bool PLOT_CONTROLLER::PlotLayers( LSET aLayers, PlotFormat aFormat,
+                                  GERBER_WRITER* aDrillWriter, bool aGenMap, REPORTER* aReporter )
+{
+    return plotLayers( aLayers, aFormat,
+            [aDrillWriter, aGenMap, aReporter]( const wxString& aPlotDir )
+            {
+                return aDrillWriter->CreateDrillandMapFilesSet( aPlotDir, true, aGenMap,
+                                                                aReporter );
+            } );
+}
+
+
+bool PLOT_CONTROLLER::plotLayers( LSET aLayers, PlotFormat aFormat,
+                                  std::function<bool( const wxString& )> aDrillJob )
+{
+    // The locale is process wide: keep it as C/POSIX for the whole job, worker threads
+    // included
+    LOCALE_IO toggle;
+
+    ClosePlot();
+    GetPlotOptions().SetFormat( aFormat );
+
+    wxFileName outputDir = wxFileName::DirName( GetPlotOptions().GetOutputDirectory() );
+    wxString   boardFilename = m_board->GetFileName();
+
+    if( !EnsureFileDirectoryExists( &outputDir, boardFilename ) )
+        return false;
+
+    bool success = true;
+    std::vector<std::pair<PCB_LAYER_ID, PLOTTER*>> plots;
+
+    // Start the plots serially: this plots the frame reference and reads some board
+    // data which is not safe to build from several threads (the board bounding box)
+    for( LSEQ seq = aLayers.UIOrder(); seq; ++seq )
+    {
+        PCB_LAYER_ID layer = *seq;
+        wxFileName   fn( boardFilename );
+        wxString     fileExt = GetDefaultPlotExtension( aFormat );
+
+        if( aFormat == PLOT_FORMAT_GERBER && GetPlotOptions().GetUseGerberProtelExtensions() )
+            fileExt = GetGerberProtelExtension( layer );
+
+        BuildPlotFileName( &fn, outputDir.GetPath(), m_board->GetLayerName( layer ), fileExt );
+
+        PLOTTER* plotter = StartPlotBoard( m_board, &GetPlotOptions(), layer, fn.GetFullPath(),
+                                           wxEmptyString );
+
+        if( plotter )
+            plots.emplace_back( layer, plotter );
+        else
+            success = false;
+    }
+
+    // The board is only read while plotting, so each layer can be plotted in its own
+    // thread, into its own plotter. The drill job (if any) is the first one since it
+    // is usually the longest one.
+    size_t jobCount = plots.size() + ( aDrillJob ? 1 : 0 );
+    size_t firstPlot = aDrillJob ? 1 : 0;
+    std::atomic<size_t> nextJob( 0 );
+    std::atomic<bool>   drillSuccess( true );
+
+    auto plot_lambda = [&]() -> size_t
+    {
+        size_t num = 0;
+
+        for( size_t i = nextJob++; i < jobCount; i = nextJob++ )
+        {
+            if( i < firstPlot )
+            {
+                if( !aDrillJob( outputDir.GetPath() ) )
+                    drillSuccess = false;
+            }
+            else
+            {
+                std::pair<PCB_LAYER_ID, PLOTTER*>& plot = plots[i - firstPlot];
+
+                PlotOneBoardLayer( m_board, plot.second, plot.first, GetPlotOptions() );
+                plot.second->EndPlot();
+            }
+
+            num++;
+        }
+
+        return num;
+    };
+
+    size_t parallelThreadCount = std::min<size_t>(
+            std::max<size_t>( std::thread::hardware_concurrency(), 2 ), jobCount );
+    std::vector<std::future<size_t>> returns( parallelThreadCount );
+
+    for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+        returns[ii] = std::async( std::launch::async, plot_lambda );
+
+    for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+        returns[ii].wait();
+
+    for( std::pair<PCB_LAYER_ID, PLOTTER*>& plot : plots )
+        delete plot.second;
+
+    return success && drillSuccess;
+}
+
+
 void PLOT_CONTROLLER::SetColorMode( bool aColorMode )
 {
     if( !m_plotter )
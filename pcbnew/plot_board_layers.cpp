@@ -355,7 +355,9 @@ void PlotStandardLayer( BOARD *aBoard, PLOTTER* aPlotter,
             wxSize extraSize = margin * 2;
             extraSize.x += width_adj;
             extraSize.y += width_adj;
-            wxSize deltaSize = pad->GetDelta(); // has meaning only for trapezoidal pads
+            // The pad is plotted from a copy set to the plot size and delta, so the board
+            // pad itself is never modified (the layers can be plotted concurrently)
+            D_PAD tmppad( *pad );
 
             if( pad->GetShape() == PAD_SHAPE_TRAPEZOID )
             {   // The easy way is to use BuildPadPolygon to calculate
@@ -388,7 +390,7 @@ void PlotStandardLayer( BOARD *aBoard, PLOTTER* aPlotter,
                 else
                     delta.y = coord[1].x - coord[0].x;
 
-                pad->SetDelta( delta );
+                tmppad.SetDelta( delta );
             }
             else
                 padPlotsSize = pad->GetSize() + extraSize;
@@ -405,30 +407,28 @@ void PlotStandardLayer( BOARD *aBoard, PLOTTER* aPlotter,
             if( pad->GetLayerSet()[F_Cu] )
                 color = color.LegacyMix( aBoard->Colors().GetItemColor( LAYER_PAD_FR ) );
 
-            // Temporary set the pad size to the required plot size:
-            wxSize tmppadsize = pad->GetSize();
-
+            // Set the pad size to the required plot size:
             switch( pad->GetShape() )
             {
             case PAD_SHAPE_CIRCLE:
             case PAD_SHAPE_OVAL:
-                pad->SetSize( padPlotsSize );
+                tmppad.SetSize( padPlotsSize );
 
                 if( aPlotOpt.GetSkipPlotNPTH_Pads() &&
                     ( aPlotOpt.GetDrillMarksType() == PCB_PLOT_PARAMS::NO_DRILL_SHAPE ) &&
-                    ( pad->GetSize() == pad->GetDrillSize() ) &&
-                    ( pad->GetAttribute() == PAD_ATTRIB_HOLE_NOT_PLATED ) )
+                    ( tmppad.GetSize() == tmppad.GetDrillSize() ) &&
+                    ( tmppad.GetAttribute() == PAD_ATTRIB_HOLE_NOT_PLATED ) )
                     break;
 
-                itemplotter.PlotPad( pad, color, plotMode );
+                itemplotter.PlotPad( &tmppad, color, plotMode );
                 break;
 
             case PAD_SHAPE_TRAPEZOID:
             case PAD_SHAPE_RECT:
             case PAD_SHAPE_ROUNDRECT:
             case PAD_SHAPE_CHAMFERED_RECT:
-                pad->SetSize( padPlotsSize );
-                itemplotter.PlotPad( pad, color, plotMode );
+                tmppad.SetSize( padPlotsSize );
+                itemplotter.PlotPad( &tmppad, color, plotMode );
                 break;
 
             case PAD_SHAPE_CUSTOM:
@@ -457,9 +457,6 @@ void PlotStandardLayer( BOARD *aBoard, PLOTTER* aPlotter,
             }
                 break;
             }
-
-            pad->SetSize( tmppadsize );     // Restore the pad size
-            pad->SetDelta( deltaSize );
         }
 
         aPlotter->EndBlock( NULL );
@@ -1104,6 +1101,7 @@ PLOTTER* StartPlotBoard( BOARD *aBoard, PCB_PLOT_PARAMS *aPlotOpts, int aLayer,
             GERBER_PLOTTER* gbrplotter = static_cast <GERBER_PLOTTER*> ( plotter );
             gbrplotter->UseX2format( useX2mode );
             gbrplotter->UseX2NetAttributes( plotOpts.GetIncludeGerberNetlistInfo() );
+            gbrplotter->UseApertureMacros( plotOpts.GetUseGerberApertureMacros() );
 
             // Attributes can be added using X2 format or as comment (X1 format)
             AddGerberX2Attribute( plotter, aBoard, aLayer, not useX2mode );
@@ -40,6 +40,7 @@
 #include <class_pcb_target.h>
 #include <class_dimension.h>
 #include <convert_basic_shapes_to_polygon.h>
+#include <bezier_curves.h>
 
 #include <pcbnew.h>
 #include <pcbplot.h>
@@ -753,8 +754,13 @@ void BRDITEMS_PLOTTER::PlotDrawSegment( DRAWSEGMENT* aSeg )
     case S_CURVE:
         {
             m_plotter->SetCurrentLineWidth( thickness, &gbr_metadata );
-            aSeg->RebuildBezierToSegmentsPointsList( aSeg->GetWidth() );
-            const std::vector<wxPoint>& bezierPoints = aSeg->GetBezierPoints();
+            // Build the segment list locally rather than with RebuildBezierToSegmentsPointsList(),
+            // which would modify the board item
+            std::vector<wxPoint> ctrlPoints = { aSeg->GetStart(), aSeg->GetBezControl1(),
+                                                aSeg->GetBezControl2(), aSeg->GetEnd() };
+            std::vector<wxPoint> bezierPoints;
+            BEZIER_POLY converter( ctrlPoints );
+            converter.GetPoly( bezierPoints, aSeg->GetWidth() );
 
             for( unsigned i = 1; i < bezierPoints.size(); i++ )
             {
@@ -30,11 +30,16 @@
 #ifndef PLOTCONTROLLER_H_
 #define PLOTCONTROLLER_H_
 
+#include <functional>
+
 #include <pcb_plot_params.h>
 #include <layers_id_colors_and_visibility.h>
 
 class PLOTTER;
 class BOARD;
+class EXCELLON_WRITER;
+class GERBER_WRITER;
+class REPORTER;
 
 
 /**
@@ -84,6 +89,31 @@ public:
      */
     bool PlotLayer();
 
+    /**
+     * Plot each layer of aLayers to its own plot file, using the current plot options.
+     * The plot file names are built from the board file name and the layer names,
+     * like the plot dialog does. The current plot, if any, is closed first.
+     * The plot files are opened one after the other, then the layers are plotted
+     * concurrently, each one by its own plotter.
+     * @param aLayers is the set of layers to plot
+     * @param aFormat is the plot file format
+     * @return false if a plot file could not be created
+     */
+    bool PlotLayers( LSET aLayers, PlotFormat aFormat );
+
+    /**
+     * Same as above, and create the drill files (and the drill map files if aGenMap
+     * is true) in the plot output directory with aDrillWriter, concurrently with the
+     * layers. aDrillWriter must be set up (format, options) by the caller.
+     * @param aReporter receives the messages of the drill writer (can be NULL).  It is
+     * called from the drill thread only, and must not be used elsewhere during the plot.
+     * @return false if a plot file or a drill file could not be created
+     */
+    bool PlotLayers( LSET aLayers, PlotFormat aFormat, EXCELLON_WRITER* aDrillWriter,
+                     bool aGenMap = false, REPORTER* aReporter = NULL );
+    bool PlotLayers( LSET aLayers, PlotFormat aFormat, GERBER_WRITER* aDrillWriter,
+                     bool aGenMap = false, REPORTER* aReporter = NULL );
+
     /**
      * @return the current plot full filename, set by OpenPlotfile
      */
@@ -108,6 +138,16 @@ public:
     bool GetColorMode();
 
 private:
+#ifndef SWIG
+    /**
+     * Plot the layers of aLayers, each one in its own thread, and run aDrillJob
+     * (if not empty) in another thread with the plot output directory as argument.
+     * aDrillJob returns false if it failed.
+     */
+    bool plotLayers( LSET aLayers, PlotFormat aFormat,
+                     std::function<bool( const wxString& )> aDrillJob );
+#endif
+
     /// the layer to plot
     LAYER_NUM m_plotLayer;
 
@@ -26,6 +26,7 @@
 #include <iostream>
 #include <sstream>
 #include <cmath>
+#include <cstring>
 #include <string>
 #include <map>
 #include <wx/filename.h>
@@ -74,15 +75,28 @@ static SCENEGRAPH* vrmlToSG( VRML_LAYER& vpcb, int idxColor, SGNODE* aParent, do
 
 class LOCALESWITCH
 {
+    // Store the user locale name, to restore this locale later, in dtor;
+    // empty if the "C" locale was already set
+    std::string m_locale;
+
 public:
     LOCALESWITCH()
     {
-        setlocale( LC_NUMERIC, "C" );
+        // when the models are loaded concurrently the caller sets the "C" locale
+        // once for all the threads, which must not call setlocale() again
+        const char* locale = setlocale( LC_NUMERIC, 0 );
+
+        if( locale && strcmp( locale, "C" ) != 0 )
+        {
+            m_locale = locale;
+            setlocale( LC_NUMERIC, "C" );
+        }
     }
 
     ~LOCALESWITCH()
     {
-        setlocale( LC_NUMERIC, "" );
+        if( !m_locale.empty() )
+            setlocale( LC_NUMERIC, m_locale.c_str() );
     }
 };
 
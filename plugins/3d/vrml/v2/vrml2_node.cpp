@@ -30,6 +30,7 @@
 #include <iostream>
 #include <sstream>
 #include <algorithm>
+#include <mutex>
 #include <wx/log.h>
 
 #include "vrml2_node.h"
@@ -40,6 +41,7 @@ static std::set< std::string > badNames;
 typedef std::pair< std::string, WRL2NODES > NODEITEM;
 typedef std::map< std::string, WRL2NODES > NODEMAP;
 static NODEMAP nodenames;
+static std::once_flag nodenamesInit;
 
 
 WRL2NODE::WRL2NODE()
@@ -48,7 +50,9 @@ WRL2NODE::WRL2NODE()
     m_Parent = NULL;
     m_Type = WRL2_END;
 
-    if( badNames.empty() )
+    // the name tables are shared by all nodes and the plugin may be used
+    // from several threads at once
+    std::call_once( nodenamesInit, []()
     {
         badNames.insert( "DEF" );
         badNames.insert( "EXTERNPROTO" );
@@ -64,10 +68,7 @@ WRL2NODE::WRL2NODE()
         badNames.insert( "eventOut" );
         badNames.insert( "exposedField" );
         badNames.insert( "field" );
-    }
 
-    if( nodenames.empty() )
-    {
         nodenames.insert( NODEITEM( "Anchor", WRL2_ANCHOR ) );
         nodenames.insert( NODEITEM( "Appearance", WRL2_APPEARANCE ) );
         nodenames.insert( NODEITEM( "Audioclip", WRL2_AUDIOCLIP ) );
@@ -122,7 +123,7 @@ WRL2NODE::WRL2NODE()
         nodenames.insert( NODEITEM( "ViewPoint", WRL2_VIEWPOINT ) );
         nodenames.insert( NODEITEM( "VisibilitySensor", WRL2_VISIBILITYSENSOR ) );
         nodenames.insert( NODEITEM( "WorldInfo", WRL2_WORLDINFO ) );
-    }
+    } );
 
     return;
 }
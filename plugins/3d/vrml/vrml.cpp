@@ -32,6 +32,7 @@
  */
 
 #include <locale.h>
+#include <string.h>
 #include <wx/log.h>
 #include <wx/filename.h>
 #include "richio.h"
@@ -156,21 +157,37 @@ bool CanRender( void )
 }
 
 
+bool CanLoadConcurrently( void )
+{
+    // each model is parsed into its own node tree
+    return true;
+}
+
+
 class LOCALESWITCH
 {
-    // Store the user locale name, to restore this locale later, in dtor
+    // Store the user locale name, to restore this locale later, in dtor;
+    // empty if the "C" locale was already set
     std::string m_locale;
 
 public:
     LOCALESWITCH()
     {
-        m_locale = setlocale( LC_NUMERIC, 0 );
-        setlocale( LC_NUMERIC, "C" );
+        // when the models are loaded concurrently the caller sets the "C" locale
+        // once for all the threads, which must not call setlocale() again
+        const char* locale = setlocale( LC_NUMERIC, 0 );
+
+        if( locale && strcmp( locale, "C" ) != 0 )
+        {
+            m_locale = locale;
+            setlocale( LC_NUMERIC, "C" );
+        }
     }
 
     ~LOCALESWITCH()
     {
-        setlocale( LC_NUMERIC, m_locale.c_str() );
+        if( !m_locale.empty() )
+            setlocale( LC_NUMERIC, m_locale.c_str() );
     }
 };
 
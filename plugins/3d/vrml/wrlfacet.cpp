@@ -330,7 +330,8 @@ float FACET::CalcFaceNormal()
 }
 
 
-void FACET::CalcVertexNormal( int aIndex, std::list< FACET* > &aFacetList, float aCreaseLimit )
+void FACET::CalcVertexNormal( int aIndex, FACET* const* aFacetList, size_t aFacetCount,
+    float aCreaseLimit )
 {
     if( vertices.size() < 3 )
         return;
@@ -358,30 +359,24 @@ void FACET::CalcVertexNormal( int aIndex, std::list< FACET* > &aFacetList, float
             norms[idx] = vnweight[idx];
 
             // iterate over adjacent facets
-            std::list< FACET* >::iterator sF = aFacetList.begin();
-            std::list< FACET* >::iterator eF = aFacetList.end();
-
-            while( sF != eF )
+            for( size_t i = 0; i < aFacetCount; ++i )
             {
-                if( this == *sF )
-                {
-                    ++sF;
+                FACET* facet = aFacetList[i];
+
+                if( this == facet )
                     continue;
-                }
 
                 // check the crease angle limit
-                (*sF)->GetFaceNormal( fp[1] );
+                facet->GetFaceNormal( fp[1] );
 
                 float thrs = VCalcCosAngle( fp[0], face_normal, fp[1] );
 
-                if( aCreaseLimit <= thrs && (*sF)->GetWeightedNormal( aIndex, fp[1] ) )
+                if( aCreaseLimit <= thrs && facet->GetWeightedNormal( aIndex, fp[1] ) )
                 {
                     norms[idx].x += fp[1].x;
                     norms[idx].y += fp[1].y;
                     norms[idx].z += fp[1].z;
                 }
-
-                ++sF;
             }
 
             // normalize the vector
@@ -645,22 +640,41 @@ bool FACET::GetData( std::vector< WRLVEC3F >& aVertexList, std::vector< WRLVEC3F
 }
 
 
-void FACET::CollectVertices( std::vector< std::list< FACET* > >& aFacetList )
+void FACET::CountVertices( std::vector< int >& aFacetCount )
 {
     // check if this facet may contribute anything at all
     if( vertices.size() < 3 )
         return;
 
     // note: in principle this should never be invoked
-    if( (maxIdx + 1) >= (int)aFacetList.size() )
-        aFacetList.resize( maxIdx + 1 );
+    if( (maxIdx + 1) >= (int)aFacetCount.size() )
+        aFacetCount.resize( maxIdx + 1, 0 );
+
+    std::vector< int >::iterator sI = indices.begin();
+    std::vector< int >::iterator eI = indices.end();
+
+    while( sI != eI )
+    {
+        ++aFacetCount[*sI];
+        ++sI;
+    }
+
+    return;
+}
+
+
+void FACET::CollectVertices( std::vector< FACET* >& aFacetList, std::vector< int >& aNextSlot )
+{
+    // check if this facet may contribute anything at all
+    if( vertices.size() < 3 )
+        return;
 
     std::vector< int >::iterator sI = indices.begin();
     std::vector< int >::iterator eI = indices.end();
 
     while( sI != eI )
     {
-        aFacetList[*sI].push_back( this );
+        aFacetList[ aNextSlot[*sI]++ ] = this;
         ++sI;
     }
 
@@ -716,9 +730,12 @@ SGNODE* SHAPE::CalcShape( SGNODE* aParent, SGNODE* aColor, WRL1_ORDER aVertexOrd
     if( facets.empty() || !facets.front()->HasMinPoints() )
         return NULL;
 
-    std::vector< std::list< FACET* > > flist;
+    // the facets common to each index are stored in a single array; the facets
+    // of index i are flist[ fstart[i] ] ... flist[ fstart[i + 1] - 1 ]
+    std::vector< FACET* > flist;
+    std::vector< int > fstart;
 
-    // determine the max. index and size flist as appropriate
+    // determine the max. index and size the index arrays as appropriate
     std::list< FACET* >::iterator sF = facets.begin();
     std::list< FACET* >::iterator eF = facets.end();
 
@@ -746,31 +763,46 @@ SGNODE* SHAPE::CalcShape( SGNODE* aParent, SGNODE* aColor, WRL1_ORDER aVertexOrd
     if( maxIdx < 3 )
         return NULL;
 
-    flist.resize( maxIdx );
+    // count the facets common to each index
+    std::vector< int > fcount( maxIdx, 0 );
 
-    // create the lists of facets common to indices
     sF = facets.begin();
 
     while( sF != eF )
     {
         (*sF)->Renormalize( tV );
-        (*sF)->CollectVertices( flist );
+        (*sF)->CountVertices( fcount );
         ++sF;
     }
 
-    // calculate the normals
-    size_t vs = flist.size();
+    size_t vs = fcount.size();
+    fstart.resize( vs + 1 );
+    fstart[0] = 0;
+
+    for( size_t i = 0; i < vs; ++i )
+        fstart[i + 1] = fstart[i] + fcount[i];
+
+    // create the lists of facets common to indices; the facets are stored in the
+    // same order as in the facet list so the normals are summed up in that order
+    flist.resize( fstart[vs] );
+    fcount.assign( fstart.begin(), fstart.end() - 1 );
+
+    sF = facets.begin();
 
+    while( sF != eF )
+    {
+        (*sF)->CollectVertices( flist, fcount );
+        ++sF;
+    }
+
+    // calculate the normals
     for( size_t i = 0; i < vs; ++i )
     {
-        sF = flist[i].begin();
-        eF = flist[i].end();
+        FACET* const* sList = flist.data() + fstart[i];
+        size_t nList = fstart[i + 1] - fstart[i];
 
-        while( sF != eF )
-        {
-            (*sF)->CalcVertexNormal( i, flist[i], aCreaseLimit );
-            ++sF;
-        }
+        for( size_t j = 0; j < nList; ++j )
+            sList[j]->CalcVertexNormal( i, sList, nList, aCreaseLimit );
     }
 
     std::vector< WRLVEC3F > vertices;
@@ -91,9 +91,11 @@ public:
      * calculates the weighted normal for the given vertex
      *
      * @param aIndex is the VRML file's Vertex Index for the vertex to be processed
-     * @param aFacetList is the list of all faces which share this vertex
+     * @param aFacetList is the array of all faces which share this vertex
+     * @param aFacetCount is the number of entries in aFacetList
      */
-    void CalcVertexNormal( int aIndex, std::list< FACET* >& aFacetList, float aCreaseAngle );
+    void CalcVertexNormal( int aIndex, FACET* const* aFacetList, size_t aFacetCount,
+        float aCreaseAngle );
 
     /**
      * Function GetWeightedNormal
@@ -129,12 +131,19 @@ public:
         return maxIdx;
     }
 
+    /**
+     * Function CountVertices
+     * increments the entry of aFacetCount for each of the internal vertex indices
+     */
+    void CountVertices( std::vector< int >& aFacetCount );
+
     /**
      * Function CollectVertices
-     * adds a pointer to this object at each position within aFacetList
-     * referenced by the internal vertex indices
+     * adds a pointer to this object to aFacetList for each of the internal
+     * vertex indices; the pointer is stored at the position given by the entry
+     * of aNextSlot for that index, which is then incremented
      */
-    void CollectVertices( std::vector< std::list< FACET* > >& aFacetList );
+    void CollectVertices( std::vector< FACET* >& aFacetList, std::vector< int >& aNextSlot );
 };
 
 
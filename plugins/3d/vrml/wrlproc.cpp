@@ -21,6 +21,8 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <cstdlib>
+#include <climits>
 #include <iostream>
 #include <sstream>
 #include <wx/filename.h>
@@ -717,6 +719,156 @@ bool WRLPROC::ReadString( std::string& aSFString )
 }
 
 
+// a number ends at white space, a comma, a bracket or a brace
+static inline bool isNumberEnd( char aChar )
+{
+    return aChar <= 0x20 || ',' == aChar || '[' == aChar || ']' == aChar
+           || '{' == aChar || '}' == aChar;
+}
+
+
+bool WRLPROC::parseFloat( float& aValue )
+{
+    const char* start = m_buf.c_str() + m_bufpos;
+    char c = *start;
+
+    // strtof() would also accept "inf", "nan" and leading blanks
+    if( !( ( c >= '0' && c <= '9' ) || '-' == c || '+' == c || '.' == c ) )
+    {
+        m_error = "invalid character in SFFloat";
+        return false;
+    }
+
+    char* end = NULL;
+    aValue = strtof( start, &end );
+
+    if( end == start || !isNumberEnd( *end ) )
+    {
+        m_error = "invalid character in SFFloat";
+        return false;
+    }
+
+    m_bufpos += end - start;
+
+    // the comma is a special instance of blank space
+    if( m_bufpos < m_buf.size() && ',' == m_buf[m_bufpos] )
+        ++m_bufpos;
+
+    return true;
+}
+
+
+bool WRLPROC::parseInt( int& aValue )
+{
+    const char* start = m_buf.c_str() + m_bufpos;
+    const char* digits = start;
+
+    if( '-' == *digits || '+' == *digits )
+        ++digits;
+
+    if( *digits < '0' || *digits > '9' )
+    {
+        m_error = "invalid character in SFInt";
+        return false;
+    }
+
+    // Rules: "0x" + "0-9, A-F" - VRML is case sensitive but in
+    // this instance we do no enforce case.
+    int base = 10;
+
+    if( '0' == digits[0] && ( 'x' == digits[1] || 'X' == digits[1] ) )
+        base = 16;
+
+    char* end = NULL;
+    long value = strtol( start, &end, base );
+
+    if( end == start || !isNumberEnd( *end ) || value < INT_MIN || value > INT_MAX )
+    {
+        m_error = "invalid character in SFInt";
+        return false;
+    }
+
+    aValue = (int) value;
+    m_bufpos += end - start;
+
+    if( m_bufpos < m_buf.size() && ',' == m_buf[m_bufpos] )
+        ++m_bufpos;
+
+    return true;
+}
+
+
+bool WRLPROC::scanFloats( std::vector< float >& aValues )
+{
+    size_t ssize = m_buf.size();
+
+    while( m_bufpos < ssize )
+    {
+        char c = m_buf[m_bufpos];
+
+        if( c <= 0x20 || ',' == c )
+        {
+            ++m_bufpos;
+            continue;
+        }
+
+        // a comment extends to the end of the line
+        if( '#' == c )
+        {
+            m_bufpos = ssize;
+            break;
+        }
+
+        if( ']' == c )
+            break;
+
+        float value;
+
+        if( !parseFloat( value ) )
+            return false;
+
+        aValues.push_back( value );
+    }
+
+    return true;
+}
+
+
+bool WRLPROC::scanInts( std::vector< int >& aValues )
+{
+    size_t ssize = m_buf.size();
+
+    while( m_bufpos < ssize )
+    {
+        char c = m_buf[m_bufpos];
+
+        if( c <= 0x20 || ',' == c )
+        {
+            ++m_bufpos;
+            continue;
+        }
+
+        if( '#' == c )
+        {
+            m_bufpos = ssize;
+            break;
+        }
+
+        if( ']' == c )
+            break;
+
+        int value;
+
+        if( !parseInt( value ) )
+            return false;
+
+        aValues.push_back( value );
+    }
+
+    return true;
+}
+
+
 bool WRLPROC::ReadSFBool( bool& aSFBool )
 {
     if( !EatSpace() )
@@ -811,9 +963,7 @@ bool WRLPROC::ReadSFFloat( float& aSFFloat )
             break;
     }
 
-    std::string tmp;
-
-    if( !ReadGlob( tmp ) )
+    if( !parseFloat( aSFFloat ) )
     {
         std::ostringstream ostr;
         ostr << __FILE__ << ":" << __FUNCTION__ << ":" << __LINE__ << "\n";
@@ -826,23 +976,6 @@ bool WRLPROC::ReadSFFloat( float& aSFFloat )
         return false;
     }
 
-    std::istringstream istr;
-    istr.str( tmp );
-    istr >> aSFFloat;
-
-    if( istr.fail() || !istr.eof() )
-    {
-        std::ostringstream ostr;
-        ostr << __FILE__ << ":" << __FUNCTION__ << ":" << __LINE__ << "\n";
-        ostr << " * [INFO] failed on file '" << m_filename << "'\n";
-        ostr << " * [INFO] line " << fileline << ", char " << linepos << " -- ";
-        ostr << "line " << m_fileline << ", char " << m_bufpos << "\n";
-        ostr << " * [INFO] invalid character in SFFloat";
-        m_error = ostr.str();
-
-        return false;
-    }
-
     return true;
 }
 
@@ -871,43 +1004,14 @@ bool WRLPROC::ReadSFInt( int& aSFInt32 )
             break;
     }
 
-    std::string tmp;
-
-    if( !ReadGlob( tmp ) )
-    {
-        std::ostringstream ostr;
-        ostr << __FILE__ << ":" << __FUNCTION__ << ":" << __LINE__ << "\n";
-        ostr << " * [INFO] failed on file '" << m_filename << "'\n";
-        ostr << " * [INFO] line " << fileline<< ", char " << linepos << " -- ";
-        ostr << "line " << m_fileline << ", char " << m_bufpos << "\n";
-        ostr << " * [INFO] " << m_error;
-        m_error = ostr.str();
-
-        return false;
-    }
-
-    if( std::string::npos != tmp.find( "0x" ) )
-    {
-        // Rules: "0x" + "0-9, A-F" - VRML is case sensitive but in
-        // this instance we do no enforce case.
-        std::stringstream sstr;
-        sstr << std::hex << tmp;
-        sstr >> aSFInt32;
-        return true;
-    }
-
-    std::istringstream istr;
-    istr.str( tmp );
-    istr >> aSFInt32;
-
-    if( istr.fail() || !istr.eof() )
+    if( !parseInt( aSFInt32 ) )
     {
         std::ostringstream ostr;
         ostr << __FILE__ << ":" << __FUNCTION__ << ":" << __LINE__ << "\n";
         ostr << " * [INFO] failed on file '" << m_filename << "'\n";
         ostr << " * [INFO] line " << fileline << ", char " << linepos << " -- ";
         ostr << "line " << m_fileline << ", char " << m_bufpos << "\n";
-        ostr << " * [INFO] invalid character in SFInt";
+        ostr << " * [INFO] " << m_error;
         m_error = ostr.str();
 
         return false;
@@ -1089,20 +1193,30 @@ bool WRLPROC::ReadSFVec3f( WRLVEC3F& aSFVec3f )
             break;
     }
 
-    std::string tmp;
-
     float tcol[3];
 
     for( int i = 0; i < 3; ++i )
     {
-        if( !ReadGlob( tmp ) )
+        while( true )
+        {
+            if( !EatSpace() )
+                return false;
+
+            // if the text is the start of a comment block, clear the buffer and loop
+            if( '#' == m_buf[m_bufpos] )
+                m_buf.clear();
+            else
+                break;
+        }
+
+        if( !parseFloat( tcol[i] ) )
         {
             std::ostringstream ostr;
             ostr << __FILE__ << ":" << __FUNCTION__ << ":" << __LINE__ << "\n";
             ostr << " * [INFO] failed on file '" << m_filename << "'\n";
             ostr << " * [INFO] line " << fileline << ", char " << linepos << " -- ";
             ostr << "line " << m_fileline << ", char " << m_bufpos << "\n";
-            ostr << " * [INFO] " << m_error;
+            ostr << " * [INFO] invalid character in space delimited triplet";
             m_error = ostr.str();
 
             return false;
@@ -1114,24 +1228,6 @@ bool WRLPROC::ReadSFVec3f( WRLVEC3F& aSFVec3f )
 
         if( ',' == m_buf[m_bufpos] )
             Pop();
-
-        std::istringstream istr;
-        istr.str( tmp );
-        istr >> tcol[i];
-
-        if( istr.fail() || !istr.eof() )
-        {
-            std::ostringstream ostr;
-            ostr << __FILE__ << ":" << __FUNCTION__ << ":" << __LINE__ << "\n";
-            ostr << " * [INFO] failed on file '" << m_filename << "'\n";
-            ostr << " * [INFO] line " << fileline << ", char " << linepos << " -- ";
-            ostr << "line " << m_fileline << ", char " << m_bufpos << "\n";
-            ostr << " * [INFO] invalid character in space delimited triplet";
-            m_error = ostr.str();
-
-            return false;
-        }
-
     }
 
     aSFVec3f.x = tcol[0];
@@ -1324,6 +1420,9 @@ bool WRLPROC::ReadMFColor( std::vector< WRLVEC3F >& aMFColor )
 
     ++m_bufpos;
 
+    // convert the values line by line directly from the line buffer
+    std::vector< float > values;
+
     while( true )
     {
         if( !EatSpace() )
@@ -1332,7 +1431,7 @@ bool WRLPROC::ReadMFColor( std::vector< WRLVEC3F >& aMFColor )
         if( ']' == m_buf[m_bufpos] )
             break;
 
-        if( !ReadSFColor( lcolor ) )
+        if( !scanFloats( values ) )
         {
             std::ostringstream ostr;
             ostr << __FILE__ << ":" << __FUNCTION__ << ":" << __LINE__ << "\n";
@@ -1344,28 +1443,44 @@ bool WRLPROC::ReadMFColor( std::vector< WRLVEC3F >& aMFColor )
 
             return false;
         }
+    }
 
-        aMFColor.push_back( lcolor );
+    if( values.size() % 3 )
+    {
+        std::ostringstream ostr;
+        ostr << __FILE__ << ":" << __FUNCTION__ << ":" << __LINE__ << "\n";
+        ostr << " * [INFO] failed on file '" << m_filename << "'\n";
+        ostr << " * [INFO] line " << fileline << ", char " << linepos << " -- ";
+        ostr << "line " << m_fileline << ", char " << m_bufpos << "\n";
+        ostr << " * [INFO] incomplete triplet in list";
+        m_error = ostr.str();
 
-        if( !EatSpace() )
+        return false;
+    }
+
+    aMFColor.reserve( values.size() / 3 );
+
+    for( size_t i = 0; i < values.size(); i += 3 )
+    {
+        lcolor.x = values[i];
+        lcolor.y = values[i + 1];
+        lcolor.z = values[i + 2];
+
+        if( lcolor.x < 0.0 || lcolor.x > 1.0 || lcolor.y < 0.0 || lcolor.y > 1.0
+            || lcolor.z < 0.0 || lcolor.z > 1.0 )
         {
             std::ostringstream ostr;
             ostr << __FILE__ << ":" << __FUNCTION__ << ":" << __LINE__ << "\n";
             ostr << " * [INFO] failed on file '" << m_filename << "'\n";
             ostr << " * [INFO] line " << fileline << ", char " << linepos << " -- ";
             ostr << "line " << m_fileline << ", char " << m_bufpos << "\n";
-            ostr << " * [INFO] could not check characters after the string";
+            ostr << " * [INFO] invalid RGB value in color triplet";
             m_error = ostr.str();
 
             return false;
         }
 
-        if( ']' == m_buf[m_bufpos] )
-            break;
-
-        if( ',' == m_buf[m_bufpos] )
-            Pop();
-
+        aMFColor.push_back( lcolor );
     }
 
     ++m_bufpos;
@@ -1436,6 +1551,7 @@ bool WRLPROC::ReadMFFloat( std::vector< float >& aMFFloat )
 
     ++m_bufpos;
 
+    // convert the values line by line directly from the line buffer
     while( true )
     {
         if( !EatSpace() )
@@ -1444,7 +1560,7 @@ bool WRLPROC::ReadMFFloat( std::vector< float >& aMFFloat )
         if( ']' == m_buf[m_bufpos] )
             break;
 
-        if( !ReadSFFloat( temp ) )
+        if( !scanFloats( aMFFloat ) )
         {
             std::ostringstream ostr;
             ostr << __FILE__ << ":" << __FUNCTION__ << ":" << __LINE__ << "\n";
@@ -1456,28 +1572,6 @@ bool WRLPROC::ReadMFFloat( std::vector< float >& aMFFloat )
 
             return false;
         }
-
-        aMFFloat.push_back( temp );
-
-        if( !EatSpace() )
-        {
-            std::ostringstream ostr;
-            ostr << __FILE__ << ":" << __FUNCTION__ << ":" << __LINE__ << "\n";
-            ostr << " * [INFO] failed on file '" << m_filename << "'\n";
-            ostr << " * [INFO] line " << fileline << ", char " << linepos << " -- ";
-            ostr << "line " << m_fileline << ", char " << m_bufpos << "\n";
-            ostr << " * [INFO] could not check characters after the string";
-            m_error = ostr.str();
-
-            return false;
-        }
-
-        if( ']' == m_buf[m_bufpos] )
-            break;
-
-        if( ',' == m_buf[m_bufpos] )
-            Pop();
-
     }
 
     ++m_bufpos;
@@ -1548,6 +1642,7 @@ bool WRLPROC::ReadMFInt( std::vector< int >& aMFInt32 )
 
     ++m_bufpos;
 
+    // convert the values line by line directly from the line buffer
     while( true )
     {
         if( !EatSpace() )
@@ -1556,7 +1651,7 @@ bool WRLPROC::ReadMFInt( std::vector< int >& aMFInt32 )
         if( ']' == m_buf[m_bufpos] )
             break;
 
-        if( !ReadSFInt( temp ) )
+        if( !scanInts( aMFInt32 ) )
         {
             std::ostringstream ostr;
             ostr << __FILE__ << ":" << __FUNCTION__ << ":" << __LINE__ << "\n";
@@ -1568,28 +1663,6 @@ bool WRLPROC::ReadMFInt( std::vector< int >& aMFInt32 )
 
             return false;
         }
-
-        aMFInt32.push_back( temp );
-
-        if( !EatSpace() )
-        {
-            std::ostringstream ostr;
-            ostr << __FILE__ << ":" << __FUNCTION__ << ":" << __LINE__ << "\n";
-            ostr << " * [INFO] failed on file '" << m_filename << "'\n";
-            ostr << " * [INFO] line " << fileline << ", char " << linepos << " -- ";
-            ostr << "line " << m_fileline << ", char " << m_bufpos << "\n";
-            ostr << " * [INFO] could not check characters after the string";
-            m_error = ostr.str();
-
-            return false;
-        }
-
-        if( ']' == m_buf[m_bufpos] )
-            break;
-
-        if( ',' == m_buf[m_bufpos] )
-            Pop();
-
     }
 
     ++m_bufpos;
@@ -1884,6 +1957,9 @@ bool WRLPROC::ReadMFVec3f( std::vector< WRLVEC3F >& aMFVec3f )
 
     ++m_bufpos;
 
+    // convert the values line by line directly from the line buffer
+    std::vector< float > values;
+
     while( true )
     {
         if( !EatSpace() )
@@ -1892,7 +1968,7 @@ bool WRLPROC::ReadMFVec3f( std::vector< WRLVEC3F >& aMFVec3f )
         if( ']' == m_buf[m_bufpos] )
             break;
 
-        if( !ReadSFVec3f( lvec3f ) )
+        if( !scanFloats( values ) )
         {
             std::ostringstream ostr;
             ostr << __FILE__ << ":" << __FUNCTION__ << ":" << __LINE__ << "\n";
@@ -1904,31 +1980,30 @@ bool WRLPROC::ReadMFVec3f( std::vector< WRLVEC3F >& aMFVec3f )
 
             return false;
         }
+    }
 
-        aMFVec3f.push_back( lvec3f );
-
-        if( !EatSpace() )
-        {
-            std::ostringstream ostr;
-            ostr << __FILE__ << ":" << __FUNCTION__ << ":" << __LINE__ << "\n";
-            ostr << " * [INFO] failed on file '" << m_filename << "'\n";
-            ostr << " * [INFO] line " << fileline << ", char " << linepos << " -- ";
-            ostr << "line " << m_fileline << ", char " << m_bufpos << "\n";
-            ostr << " * [INFO] could not check characters after the string";
-            m_error = ostr.str();
-
-            return false;
-        }
+    if( values.size() % 3 )
+    {
+        std::ostringstream ostr;
+        ostr << __FILE__ << ":" << __FUNCTION__ << ":" << __LINE__ << "\n";
+        ostr << " * [INFO] failed on file '" << m_filename << "'\n";
+        ostr << " * [INFO] line " << fileline << ", char " << linepos << " -- ";
+        ostr << "line " << m_fileline << ", char " << m_bufpos << "\n";
+        ostr << " * [INFO] incomplete triplet in list";
+        m_error = ostr.str();
 
-        if( !EatSpace() )
-            return false;
+        return false;
+    }
 
-        if( ']' == m_buf[m_bufpos] )
-            break;
+    aMFVec3f.reserve( values.size() / 3 );
 
-        if( ',' == m_buf[m_bufpos] )
-            Pop();
+    for( size_t i = 0; i < values.size(); i += 3 )
+    {
+        lvec3f.x = values[i];
+        lvec3f.y = values[i + 1];
+        lvec3f.z = values[i + 2];
 
+        aMFVec3f.push_back( lvec3f );
     }
 
     ++m_bufpos;
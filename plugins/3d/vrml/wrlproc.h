@@ -58,6 +58,17 @@ private:
     // parameters are updated as appropriate.
     bool getRawLine( void );
 
+    // parseFloat and parseInt convert the number starting at m_bufpos directly
+    // from the line buffer and move past it and a directly following comma;
+    // they fail if the text up to the next delimiter is not a number
+    bool parseFloat( float& aValue );
+    bool parseInt( int& aValue );
+
+    // scanFloats and scanInts append all numbers on the rest of the current
+    // line to aValues; they stop at the end of the line, at a comment or at ']'
+    bool scanFloats( std::vector< float >& aValues );
+    bool scanInts( std::vector< int >& aValues );
+
 public:
     WRLPROC( LINE_READER* aLineReader );
     ~WRLPROC();
@@ -43,6 +43,7 @@ KICAD_PLUGIN_LDR_3D::KICAD_PLUGIN_LDR_3D()
     m_getNFilters = NULL;
     m_getFileFilter = NULL;
     m_canRender = NULL;
+    m_canLoadConcurrently = NULL;
     m_load = NULL;
 
     return;
@@ -94,6 +95,13 @@ bool KICAD_PLUGIN_LDR_3D::Open( const wxString& aFullFileName )
     LINK_ITEM( m_canRender, PLUGIN_3D_CAN_RENDER, "CanRender" );
     LINK_ITEM( m_load, PLUGIN_3D_LOAD, "Load" );
 
+    // optional function; older plugins do not provide it
+    if( m_PluginLoader.HasSymbol( wxT( "CanLoadConcurrently" ) ) )
+    {
+        LINK_ITEM( m_canLoadConcurrently, PLUGIN_3D_CAN_LOAD_CONCURRENTLY,
+                   "CanLoadConcurrently" );
+    }
+
     #ifdef DEBUG
         bool fail = false;
 
@@ -249,6 +257,7 @@ void KICAD_PLUGIN_LDR_3D::Close( void )
     m_getNFilters = NULL;
     m_getFileFilter = NULL;
     m_canRender = NULL;
+    m_canLoadConcurrently = NULL;
     m_load = NULL;
     close();
 
@@ -426,31 +435,52 @@ bool KICAD_PLUGIN_LDR_3D::CanRender( void )
 }
 
 
+bool KICAD_PLUGIN_LDR_3D::CanLoadConcurrently( void )
+{
+    if( !ok && !reopen() )
+        return false;
+
+    if( NULL == m_canLoadConcurrently )
+        return false;
+
+    return m_canLoadConcurrently();
+}
+
+
 SCENEGRAPH* KICAD_PLUGIN_LDR_3D::Load( char const* aFileName )
 {
-    m_error.clear();
+    PLUGIN_3D_LOAD load;
 
-    if( !ok && !reopen() )
     {
-        if( m_error.empty() )
-            m_error = "[INFO] no open plugin / plugin could not be opened";
+        // only the loader state is guarded; the load itself runs unlocked
+        std::lock_guard<std::mutex> lock( m_lock );
 
-        return NULL;
-    }
+        m_error.clear();
 
-    if( NULL == m_load )
-    {
-        m_error = "[BUG] Load is not linked";
+        if( !ok && !reopen() )
+        {
+            if( m_error.empty() )
+                m_error = "[INFO] no open plugin / plugin could not be opened";
 
-        #ifdef DEBUG
-        std::ostringstream ostr;
-        ostr << __FILE__ << ": " << __FUNCTION__ << ": " << __LINE__ << "\n";
-        ostr << " * " << m_error;
-        wxLogTrace( MASK_PLUGINLDR, "%s\n", ostr.str().c_str() );
-        #endif
+            return NULL;
+        }
 
-        return NULL;
+        if( NULL == m_load )
+        {
+            m_error = "[BUG] Load is not linked";
+
+            #ifdef DEBUG
+            std::ostringstream ostr;
+            ostr << __FILE__ << ": " << __FUNCTION__ << ": " << __LINE__ << "\n";
+            ostr << " * " << m_error;
+            wxLogTrace( MASK_PLUGINLDR, "%s\n", ostr.str().c_str() );
+            #endif
+
+            return NULL;
+        }
+
+        load = m_load;
     }
 
-    return m_load( aFileName );
+    return load( aFileName );
 }
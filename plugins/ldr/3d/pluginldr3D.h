@@ -30,6 +30,7 @@
 #ifndef PLUGINLDR3D_H
 #define PLUGINLDR3D_H
 
+#include <mutex>
 #include "../pluginldr.h"
 
 class SCENEGRAPH;
@@ -45,6 +46,8 @@ typedef char const* (*PLUGIN_3D_GET_FILE_FILTER) ( int aIndex );
 
 typedef bool (*PLUGIN_3D_CAN_RENDER) ( void );
 
+typedef bool (*PLUGIN_3D_CAN_LOAD_CONCURRENTLY) ( void );
+
 typedef SCENEGRAPH* (*PLUGIN_3D_LOAD) ( char const* aFileName );
 
 
@@ -57,8 +60,12 @@ private:
     PLUGIN_3D_GET_N_FILTERS         m_getNFilters;
     PLUGIN_3D_GET_FILE_FILTER       m_getFileFilter;
     PLUGIN_3D_CAN_RENDER            m_canRender;
+    PLUGIN_3D_CAN_LOAD_CONCURRENTLY m_canLoadConcurrently;  // optional
     PLUGIN_3D_LOAD                  m_load;
 
+    // guards the plugin state when Load() is invoked from several threads
+    std::mutex m_lock;
+
 public:
     KICAD_PLUGIN_LDR_3D();
     virtual ~KICAD_PLUGIN_LDR_3D();
@@ -84,6 +91,9 @@ public:
 
     bool CanRender( void );
 
+    // returns false if the plugin does not export CanLoadConcurrently()
+    bool CanLoadConcurrently( void );
+
     SCENEGRAPH* Load( char const* aFileName );
 };
 
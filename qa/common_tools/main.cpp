@@ -25,7 +25,9 @@
 
 #include "tools/coroutines/coroutine_tools.h"
 #include "tools/io_benchmark/io_benchmark.h"
+#include "tools/plot_bench/plot_bench.h"
 #include "tools/sexpr_parser/sexpr_parse.h"
+#include "tools/vrml_bench/vrml_bench.h"
 
 /**
  * List of registered tools.
@@ -36,7 +38,9 @@
 const static std::vector<KI_TEST::UTILITY_PROGRAM*> known_tools = {
     &coroutine_tool,
     &io_benchmark_tool,
+    &plot_bench_tool,
     &sexpr_parser_tool,
+    &vrml_bench_tool,
 };
 
 
@@ -0,0 +1,202 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see CHANGELOG.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include "plot_bench.h"
+
+#include <wx/wx.h>
+#include <wx/filename.h>
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <memory>
+
+#include <common.h>
+#include <convert_to_biu.h>
+#include <plotter.h>
+
+
+using CLOCK = std::chrono::steady_clock;
+using TIME_PT = std::chrono::time_point<CLOCK>;
+
+
+// Number of corners of each synthetic zone polygon
+static const int CORNERS_PER_POLY = 64;
+
+
+/**
+ * Build a set of polygons looking like a zone fill: a grid of round islands
+ * (as the zone fill around pads), having about aVertexCount corners in total.
+ */
+static std::vector< std::vector<wxPoint> > makeSyntheticZone( long aVertexCount )
+{
+    const int pitch = Millimeter2iu( 2.0 );
+    const int radius = pitch * 2 / 5;
+    long      polyCount = std::max( 1L, aVertexCount / CORNERS_PER_POLY );
+    long      columns = std::max( 1L, (long) std::sqrt( (double) polyCount ) );
+
+    std::vector< std::vector<wxPoint> > polys( polyCount );
+
+    for( long ii = 0; ii < polyCount; ++ii )
+    {
+        wxPoint center( Millimeter2iu( 10.0 ) + ( ii % columns ) * pitch,
+                        Millimeter2iu( 10.0 ) + ( ii / columns ) * pitch );
+
+        for( int jj = 0; jj <= CORNERS_PER_POLY; ++jj )
+        {
+            double angle = 2.0 * M_PI * jj / CORNERS_PER_POLY;
+
+            // A slightly jagged outline, so the coordinates are not too regular
+            int r = radius - ( jj % 3 ) * radius / 50;
+
+            polys[ii].push_back( center + wxPoint( KiROUND( r * std::cos( angle ) ),
+                                                   KiROUND( r * std::sin( angle ) ) ) );
+        }
+    }
+
+    return polys;
+}
+
+
+static long long elapsedMs( const TIME_PT& aStart, const TIME_PT& aEnd )
+{
+    using std::chrono::milliseconds;
+    using std::chrono::duration_cast;
+
+    return (long long) duration_cast<milliseconds>( aEnd - aStart ).count();
+}
+
+
+/**
+ * Plot the polygons with aPlotter to aFileName, filled and then as outlines.
+ * @return the plot time in ms, or -1 if the file cannot be created
+ */
+static long long plotZone( PLOTTER* aPlotter, const wxString& aFileName,
+                           const std::vector< std::vector<wxPoint> >& aPolys )
+{
+    LOCALE_IO toggle;     // Plot files use '.' as decimal separator
+
+    TIME_PT start = CLOCK::now();
+
+    aPlotter->SetPageSettings( PAGE_INFO( PAGE_INFO::A3 ) );
+    aPlotter->SetViewport( wxPoint( 0, 0 ), IU_PER_MILS/10, 1.0, false );
+    // Has meaning only for gerber plotter. Must be called only after SetViewport
+    aPlotter->SetGerberCoordinatesFormat( 6 );
+    aPlotter->SetDefaultLineWidth( Millimeter2iu( 0.1 ) );
+    aPlotter->SetCreator( wxT( "plot_bench" ) );
+
+    if( !aPlotter->OpenFile( aFileName ) )
+        return -1;
+
+    aPlotter->StartPlot();
+
+    for( const std::vector<wxPoint>& poly : aPolys )
+        aPlotter->PlotPoly( poly, FILLED_SHAPE, 0 );
+
+    aPlotter->SetCurrentLineWidth( Millimeter2iu( 0.1 ) );
+
+    for( const std::vector<wxPoint>& poly : aPolys )
+    {
+        aPlotter->MoveTo( poly[0] );
+
+        for( size_t ii = 1; ii < poly.size() - 1; ++ii )
+            aPlotter->LineTo( poly[ii] );
+
+        aPlotter->FinishTo( poly.back() );
+    }
+
+    aPlotter->EndPlot();
+
+    return elapsedMs( start, CLOCK::now() );
+}
+
+
+int plot_bench_func( int argc, char* argv[] )
+{
+    auto& os = std::cout;
+
+    if( argc < 3 )
+    {
+        os << "Usage: " << argv[0] << " <OUTPUT DIR> <VERTEX COUNT>\n\n";
+        os << "Plots a synthetic zone of about VERTEX COUNT corners with each plotter\n";
+        os << "(filled polygons and outlines) and reports the plot time of each format.\n";
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    wxString outputDir( argv[1] );
+    long     vertexCount = 0;
+    wxString( argv[2] ).ToLong( &vertexCount );
+
+    if( vertexCount < CORNERS_PER_POLY || !wxFileName::DirExists( outputDir ) )
+    {
+        os << "Invalid output directory or vertex count" << std::endl;
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    std::vector< std::vector<wxPoint> > polys = makeSyntheticZone( vertexCount );
+
+    os << "Plot Bench Mark Util" << std::endl;
+    os << "  Polygons:       " << polys.size() << std::endl;
+    os << "  Vertices:       " << polys.size() * ( CORNERS_PER_POLY + 1 ) << std::endl;
+    os << std::endl;
+
+    struct PLOT_CASE
+    {
+        std::unique_ptr<PLOTTER> m_plotter;
+        const char*              m_name;
+    };
+
+    PLOT_CASE cases[] = {
+        { std::unique_ptr<PLOTTER>( new GERBER_PLOTTER() ), "gbr" },
+        { std::unique_ptr<PLOTTER>( new PS_PLOTTER() ), "ps" },
+        { std::unique_ptr<PLOTTER>( new PDF_PLOTTER() ), "pdf" },
+        { std::unique_ptr<PLOTTER>( new SVG_PLOTTER() ), "svg" },
+        { std::unique_ptr<PLOTTER>( new DXF_PLOTTER() ), "dxf" },
+        { std::unique_ptr<PLOTTER>( new HPGL_PLOTTER() ), "plt" },
+    };
+
+    for( PLOT_CASE& plotCase : cases )
+    {
+        wxFileName fn( outputDir, "plot_bench", plotCase.m_name );
+        long long  ms = plotZone( plotCase.m_plotter.get(), fn.GetFullPath(), polys );
+
+        if( ms < 0 )
+        {
+            os << "Cannot create " << fn.GetFullPath() << std::endl;
+            return KI_TEST::RET_CODES::TOOL_SPECIFIC;
+        }
+
+        os << wxString::Format( "%-30s %llu bytes in %u ms", fn.GetFullName(),
+                (unsigned long long) fn.GetSize().GetValue(), (unsigned) ms )
+           << std::endl;
+    }
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+KI_TEST::UTILITY_PROGRAM plot_bench_tool = {
+    "plot_bench",
+    "Benchmark the plotters on a zone-heavy plot",
+    plot_bench_func,
+};
@@ -0,0 +1,202 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see CHANGELOG.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include "vrml_bench.h"
+
+#include <wx/wx.h>
+#include <richio.h>
+
+#include <chrono>
+#include <iostream>
+#include <sstream>
+
+#include <wrlproc.h>
+#include <wrlfacet.h>
+
+
+using CLOCK = std::chrono::steady_clock;
+using TIME_PT = std::chrono::time_point<CLOCK>;
+
+
+/**
+ * Build the text of a synthetic VRML2 model of a aSize x aSize grid: the
+ * list of the grid points followed by the coordinate index list of the two
+ * triangles of each grid cell, formatted the way model generators do it.
+ */
+static std::string makeSyntheticModel( int aSize )
+{
+    std::ostringstream ostr;
+
+    ostr << "#VRML V2.0 utf8\n";
+    ostr << "[\n";
+
+    for( int row = 0; row < aSize; ++row )
+    {
+        for( int col = 0; col < aSize; ++col )
+        {
+            ostr << col * 0.01 << " " << row * 0.01 << " " << ( ( row + col ) % 7 ) * 0.001
+                 << ( ( col % 4 == 3 ) ? ",\n" : ", " );
+        }
+    }
+
+    ostr << "]\n";
+    ostr << "[\n";
+
+    for( int row = 0; row + 1 < aSize; ++row )
+    {
+        for( int col = 0; col + 1 < aSize; ++col )
+        {
+            int p0 = row * aSize + col;
+            int p1 = p0 + 1;
+            int p2 = p0 + aSize + 1;
+            int p3 = p0 + aSize;
+
+            ostr << p0 << "," << p1 << "," << p2 << ",-1,";
+            ostr << p0 << "," << p2 << "," << p3 << ",-1,\n";
+        }
+    }
+
+    ostr << "]\n";
+
+    return ostr.str();
+}
+
+
+static long long elapsedMs( const TIME_PT& aStart, const TIME_PT& aEnd )
+{
+    using std::chrono::milliseconds;
+    using std::chrono::duration_cast;
+
+    return (long long) duration_cast<milliseconds>( aEnd - aStart ).count();
+}
+
+
+int vrml_bench_func( int argc, char* argv[] )
+{
+    auto& os = std::cout;
+
+    if( argc < 3 )
+    {
+        os << "Usage: " << argv[0] << " <GRID SIZE> <REPS>\n\n";
+        os << "Parses a synthetic VRML model of a GRID SIZE x GRID SIZE point grid\n";
+        os << "and calculates the normals of its faces REPS times.\n";
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    long size = 0;
+    long reps = 0;
+    wxString( argv[1] ).ToLong( &size );
+    wxString( argv[2] ).ToLong( &reps );
+
+    if( size < 2 || reps < 1 )
+    {
+        os << "Invalid grid size or repetitions" << std::endl;
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    std::string model = makeSyntheticModel( size );
+
+    os << "VRML Bench Mark Util" << std::endl;
+    os << "  Grid size:      " << (int) size << std::endl;
+    os << "  Model size:     " << model.size() << " bytes" << std::endl;
+    os << "  Repetitions:    " << (int) reps << std::endl;
+    os << std::endl;
+
+    std::vector< WRLVEC3F > points;
+    std::vector< int > coordIndex;
+    long long parseMs = 0;
+
+    for( long i = 0; i < reps; ++i )
+    {
+        STRING_LINE_READER reader( model, "vrml_bench" );
+        WRLPROC proc( &reader );
+
+        TIME_PT start = CLOCK::now();
+
+        if( !proc.ReadMFVec3f( points ) || !proc.ReadMFInt( coordIndex ) )
+        {
+            os << "Parse error: " << proc.GetError() << std::endl;
+            return KI_TEST::RET_CODES::TOOL_SPECIFIC;
+        }
+
+        parseMs += elapsedMs( start, CLOCK::now() );
+    }
+
+    os << wxString::Format( "%-30s %u points, %u indices in %u ms", "ReadMFVec3f, ReadMFInt",
+            (unsigned) points.size(), (unsigned) coordIndex.size(), (unsigned) parseMs )
+       << std::endl;
+
+    long long shapeMs = 0;
+    unsigned facetCount = 0;
+
+    for( long i = 0; i < reps; ++i )
+    {
+        SHAPE shape;
+        FACET* facet = NULL;
+        facetCount = 0;
+
+        for( size_t j = 0; j < coordIndex.size(); ++j )
+        {
+            int idx = coordIndex[j];
+
+            if( idx < 0 )
+            {
+                facet = NULL;
+                continue;
+            }
+
+            if( !facet )
+            {
+                facet = shape.NewFacet();
+                ++facetCount;
+            }
+
+            facet->AddVertex( points[idx], idx );
+        }
+
+        TIME_PT start = CLOCK::now();
+        SGNODE* node = shape.CalcShape( NULL, NULL, ORD_CCW, 0.74317f, true );
+        shapeMs += elapsedMs( start, CLOCK::now() );
+
+        if( !node )
+        {
+            os << "Failed to calculate the shape" << std::endl;
+            return KI_TEST::RET_CODES::TOOL_SPECIFIC;
+        }
+
+        S3D::DestroyNode( node );
+    }
+
+    os << wxString::Format( "%-30s %u facets in %u ms", "SHAPE::CalcShape", facetCount,
+            (unsigned) shapeMs )
+       << std::endl;
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+KI_TEST::UTILITY_PROGRAM vrml_bench_tool = {
+    "vrml_bench",
+    "Benchmark the VRML plugin parser and normal calculation",
+    vrml_bench_func,
+};
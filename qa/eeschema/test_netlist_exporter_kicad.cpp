@@ -0,0 +1,209 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see CHANGELOG.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file
+ * Test suite for the KiCad netlist exporter: the netlist of a test schematic must match
+ * a reference netlist
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include "eeschema_test_utils.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <class_library.h>
+#include <connection_graph.h>
+#include <ee_collectors.h>
+#include <kiway.h>
+#include <netlist_object.h>
+#include <richio.h>
+#include <sch_component.h>
+#include <sch_io_mgr.h>
+#include <sch_screen.h>
+#include <sch_sheet.h>
+#include <symbol_lib_table.h>
+
+#include <sexpr/sexpr.h>
+#include <sexpr/sexpr_parser.h>
+
+// Code under test
+#include <netlist_exporter_kicad.h>
+
+
+/**
+ * @return the name of a netlist element, or an empty string if aNode is not an element.
+ */
+static std::string elementName( const SEXPR::SEXPR& aNode )
+{
+    if( !aNode.IsList() || aNode.GetNumberOfChildren() == 0 || !aNode.GetChild( 0 )->IsSymbol() )
+        return std::string();
+
+    return aNode.GetChild( 0 )->GetSymbol();
+}
+
+
+/**
+ * Format a netlist without what depends on the machine, the time or the order of the
+ * connection graph: the source file, date and tool of the design, and the net codes are
+ * removed, and the nets and the nodes of each net are sorted.
+ */
+static std::string canonicalNetlist( const SEXPR::SEXPR& aNode )
+{
+    std::string name = elementName( aNode );
+
+    if( name.empty() )
+        return aNode.AsString();
+
+    std::vector<std::string> children;
+
+    for( size_t ii = 1; ii < aNode.GetNumberOfChildren(); ii++ )
+    {
+        const SEXPR::SEXPR& child = *aNode.GetChild( ii );
+        std::string         childName = elementName( child );
+
+        if( name == "design" && ( childName == "source" || childName == "date"
+                                  || childName == "tool" ) )
+            continue;
+
+        if( name == "net" && childName == "code" )
+            continue;
+
+        children.push_back( canonicalNetlist( child ) );
+    }
+
+    if( name == "nets" || name == "net" )
+        std::sort( children.begin(), children.end() );
+
+    std::string result = "(" + name;
+
+    for( const std::string& child : children )
+        result += " " + child;
+
+    return result + ")\n";
+}
+
+
+class TEST_NETLIST_EXPORTER_KICAD_FIXTURE
+{
+public:
+    TEST_NETLIST_EXPORTER_KICAD_FIXTURE() : m_savedRootSheet( g_RootSheet )
+    {
+    }
+
+    ~TEST_NETLIST_EXPORTER_KICAD_FIXTURE()
+    {
+        g_RootSheet = m_savedRootSheet;
+    }
+
+    /**
+     * @return the file aFileName of the netlists test data directory.
+     */
+    wxFileName getTestFile( const wxString& aFileName )
+    {
+        wxFileName fn = KI_TEST::GetEeschemaTestDataDir();
+        fn.AppendDir( "netlists" );
+        fn.SetFullName( aFileName );
+
+        return fn;
+    }
+
+    /**
+     * Load the schematic aName.sch of the test data as the root sheet, its components
+     * being linked to the symbols of its cache library aName-cache.lib.
+     */
+    void loadSchematic( const wxString& aName )
+    {
+        SCH_PLUGIN::SCH_PLUGIN_RELEASER pi( SCH_IO_MGR::FindPlugin( SCH_IO_MGR::SCH_LEGACY ) );
+
+        m_rootSheet.reset( pi->Load( getTestFile( aName + ".sch" ).GetFullPath(), &Kiway ) );
+        g_RootSheet = m_rootSheet.get();
+
+        m_cacheLib.reset( PART_LIB::LoadLibrary(
+                getTestFile( aName + "-cache.lib" ).GetFullPath() ) );
+
+        EE_TYPE_COLLECTOR components;
+
+        components.Collect( m_rootSheet->GetScreen()->GetDrawItems(),
+                            EE_COLLECTOR::ComponentsOnly );
+        SCH_COMPONENT::ResolveAll( components, m_libTable, m_cacheLib.get() );
+    }
+
+    /**
+     * @return the netlist of the root sheet, without the symbol library parts.
+     */
+    std::string formatNetlist()
+    {
+        CONNECTION_GRAPH graph( nullptr );
+
+        graph.Recalculate( SCH_SHEET_LIST( g_RootSheet ), true );
+
+        STRING_FORMATTER       formatter;
+        NETLIST_EXPORTER_KICAD exporter( nullptr, new NETLIST_OBJECT_LIST(), &graph );
+
+        exporter.Format( &formatter, GNL_HEADER | GNL_COMPONENTS | GNL_NETS );
+
+        return formatter.GetString();
+    }
+
+    SCH_SHEET*                 m_savedRootSheet;
+    SYMBOL_LIB_TABLE           m_libTable;
+    std::unique_ptr<PART_LIB>  m_cacheLib;
+    std::unique_ptr<SCH_SHEET> m_rootSheet;
+};
+
+
+/**
+ * Declare the test suite
+ */
+BOOST_FIXTURE_TEST_SUITE( NetlistExporterKicad, TEST_NETLIST_EXPORTER_KICAD_FIXTURE )
+
+
+/**
+ * The netlist of a small schematic must match the reference netlist: the title block has
+ * its nine comments, the components their fields, and each net element is closed after
+ * its nodes
+ */
+BOOST_AUTO_TEST_CASE( Reference )
+{
+    loadSchematic( "netlist_test" );
+
+    BOOST_REQUIRE( m_cacheLib );
+
+    SEXPR::PARSER                 parser;
+    std::unique_ptr<SEXPR::SEXPR> netlist = parser.Parse( formatNetlist() );
+    std::unique_ptr<SEXPR::SEXPR> expected = parser.ParseFromFile(
+            getTestFile( "netlist_test.net" ).GetFullPath().ToStdString() );
+
+    BOOST_REQUIRE( netlist );
+    BOOST_REQUIRE( expected );
+
+    BOOST_CHECK_EQUAL( canonicalNetlist( *netlist ), canonicalNetlist( *expected ) );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
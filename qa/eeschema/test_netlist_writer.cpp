@@ -0,0 +1,54 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see CHANGELOG.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file
+ * Test suite for the netlist document writers: the streamed s-expression output
+ * must be the same as the formatted XNODE tree
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <eeschema_utils/netlist_writer_utils.h>
+
+
+BOOST_AUTO_TEST_SUITE( NetlistWriter )
+
+
+/**
+ * Check the streamed output of small documents against the XNODE tree
+ */
+BOOST_AUTO_TEST_CASE( SameAsTree )
+{
+    for( int count : { 0, 1, 2, 5 } )
+    {
+        BOOST_TEST_CONTEXT( "Count: " << count )
+        {
+            BOOST_CHECK_EQUAL( KI_TEST::FormatTestNetlistStream( count ),
+                               KI_TEST::FormatTestNetlistTree( count ) );
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,135 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see CHANGELOG.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file
+ * Test suite for the cached table of the components of a schematic and of their fields
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <eeschema_utils/schematic_construction_utils.h>
+
+// Code under test
+#include <sch_component_table.h>
+
+#include <sch_component.h>
+
+
+class TEST_SCH_COMPONENT_TABLE_FIXTURE : public KI_TEST::SCHEMATIC_TEST_DESIGN
+{
+public:
+    /**
+     * @return the text of the field aName of the component of row aRow of the table.
+     */
+    wxString fieldText( unsigned aRow, const wxString& aName )
+    {
+        return m_table.GetColumnText( aRow, m_table.FindColumn( aName ) );
+    }
+
+    SCH_COMPONENT_TABLE m_table;
+};
+
+
+/**
+ * Declare the test suite
+ */
+BOOST_FIXTURE_TEST_SUITE( SchComponentTable, TEST_SCH_COMPONENT_TABLE_FIXTURE )
+
+
+/**
+ * The rows are the component instances, without the power symbols, and the units of a
+ * multi-unit component are found by reference
+ */
+BOOST_AUTO_TEST_CASE( Rows )
+{
+    SCH_COMPONENT* resistor = AddComponent( m_resistor, "R1", 1, "10k" );
+    AddComponent( m_resistor, "#PWR01", 1, "GND" );
+    AddComponent( m_quadOpAmp, "U1", 1, "LM324" );
+    AddComponent( m_quadOpAmp, "U1", 2, "LM324" );
+
+    SetField( resistor, "MPN", "RC0603" );
+
+    m_table.Update( &m_root );
+
+    BOOST_REQUIRE( m_table.IsValid() );
+    BOOST_REQUIRE_EQUAL( m_table.GetCount(), 3u );
+
+    // The references are split
+    BOOST_CHECK_EQUAL( m_table.GetReference( 0 ).GetRef(), "R" );
+    BOOST_CHECK_EQUAL( m_table.GetReference( 0 ).GetRefNumber(), "1" );
+    BOOST_CHECK_EQUAL( m_table.GetReference( 2 ).GetUnit(), 2 );
+
+    BOOST_CHECK_EQUAL( m_table.GetFieldText( 0, VALUE ), "10k" );
+    BOOST_CHECK_EQUAL( m_table.GetFieldText( 2, REFERENCE ), "U1" );
+    BOOST_CHECK_EQUAL( fieldText( 0, "MPN" ), "RC0603" );
+    BOOST_CHECK_EQUAL( fieldText( 1, "MPN" ), "" );
+    BOOST_CHECK_EQUAL( m_table.FindColumn( "Manufacturer" ), -1 );
+
+    std::vector<unsigned> units = m_table.GetUnitRows( "u1" );
+
+    BOOST_REQUIRE_EQUAL( units.size(), 2u );
+    BOOST_CHECK_EQUAL( units[0], 1u );
+    BOOST_CHECK_EQUAL( units[1], 2u );
+    BOOST_CHECK_EQUAL( m_table.GetUnitRows( "#PWR01" ).size(), 0u );
+}
+
+
+/**
+ * The table is only updated after it was invalidated
+ */
+BOOST_AUTO_TEST_CASE( Invalidation )
+{
+    SCH_COMPONENT* resistor = AddComponent( m_resistor, "R1", 1, "10k" );
+    AddComponent( m_resistor, "R2", 1, "1k" );
+
+    m_table.Update( &m_root );
+
+    resistor->GetField( VALUE )->SetText( "22k" );
+    AddComponent( m_resistor, "R3", 1, "100" );
+
+    m_table.Update( &m_root );
+
+    BOOST_CHECK_EQUAL( m_table.GetCount(), 2u );
+    BOOST_CHECK_EQUAL( m_table.GetFieldText( 0, VALUE ), "10k" );
+
+    m_table.Invalidate();
+    m_table.Update( &m_root );
+
+    BOOST_REQUIRE_EQUAL( m_table.GetCount(), 3u );
+    BOOST_CHECK_EQUAL( m_table.GetFieldText( 0, VALUE ), "22k" );
+    BOOST_CHECK_EQUAL( m_table.GetFieldText( 1, VALUE ), "1k" );
+    BOOST_CHECK_EQUAL( m_table.GetFieldText( 2, VALUE ), "100" );
+
+    // The shown reference text of a shared screen depends on the current sheet, the
+    // instance reference is used instead
+    resistor->GetField( REFERENCE )->SetText( "R7" );
+    m_table.Invalidate();
+    m_table.Update( &m_root );
+
+    BOOST_CHECK_EQUAL( m_table.GetFieldText( 0, REFERENCE ), "R1" );
+    BOOST_CHECK_EQUAL( fieldText( 0, "Reference" ), "R1" );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
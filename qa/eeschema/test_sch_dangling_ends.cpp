@@ -0,0 +1,116 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see CHANGELOG.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file
+ * Test suite for the dangling end tests of schematic items, using DANGLING_END_INDEX
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+// Code under test
+#include <sch_item.h>
+
+#include <sch_line.h>
+#include <sch_text.h>
+
+
+static SCH_LINE* makeWire( const wxPoint& aStart, const wxPoint& aEnd, int aLayer = LAYER_WIRE )
+{
+    SCH_LINE* line = new SCH_LINE( aStart, aLayer );
+    line->SetEndPoint( aEnd );
+    return line;
+}
+
+
+BOOST_AUTO_TEST_SUITE( SchDanglingEnds )
+
+
+/**
+ * Check the end items and segments found at a given position
+ */
+BOOST_AUTO_TEST_CASE( IndexLookup )
+{
+    std::unique_ptr<SCH_LINE> horizontal( makeWire( wxPoint( 0, 0 ), wxPoint( 1000, 0 ) ) );
+    std::unique_ptr<SCH_LINE> diagonal( makeWire( wxPoint( 0, 0 ), wxPoint( 1000, 1000 ) ) );
+    std::unique_ptr<SCH_LINE> bus(
+            makeWire( wxPoint( 500, -500 ), wxPoint( 500, 500 ), LAYER_BUS ) );
+
+    std::vector<DANGLING_END_ITEM> endPoints;
+    horizontal->GetEndPoints( endPoints );
+    diagonal->GetEndPoints( endPoints );
+    bus->GetEndPoints( endPoints );
+
+    DANGLING_END_INDEX index( endPoints );
+
+    BOOST_CHECK_EQUAL( index.ItemsAt( wxPoint( 0, 0 ) ).size(), 2 );
+    BOOST_CHECK_EQUAL( index.ItemsAt( wxPoint( 1000, 0 ) ).size(), 1 );
+    BOOST_CHECK_EQUAL( index.ItemsAt( wxPoint( 10, 10 ) ).size(), 0 );
+
+    std::vector<DANGLING_END_INDEX::SEGMENT> segments;
+
+    index.SegmentsAt( wxPoint( 500, 0 ), segments );
+    BOOST_REQUIRE_EQUAL( segments.size(), 2 );
+    BOOST_CHECK_EQUAL( segments[0].m_start->GetItem(), horizontal.get() );
+    BOOST_CHECK_EQUAL( segments[1].m_start->GetItem(), bus.get() );
+
+    index.SegmentsAt( wxPoint( 250, 250 ), segments );
+    BOOST_REQUIRE_EQUAL( segments.size(), 1 );
+    BOOST_CHECK_EQUAL( segments[0].m_start->GetItem(), diagonal.get() );
+
+    index.SegmentsAt( wxPoint( 250, 10 ), segments );
+    BOOST_CHECK_EQUAL( segments.size(), 0 );
+}
+
+
+/**
+ * Check the dangling state of wires and labels
+ */
+BOOST_AUTO_TEST_CASE( WiresAndLabels )
+{
+    std::unique_ptr<SCH_LINE>  first( makeWire( wxPoint( 0, 0 ), wxPoint( 1000, 0 ) ) );
+    std::unique_ptr<SCH_LINE>  second( makeWire( wxPoint( 1000, 0 ), wxPoint( 1000, 1000 ) ) );
+    std::unique_ptr<SCH_LABEL> onWire( new SCH_LABEL( wxPoint( 500, 0 ), "A" ) );
+    std::unique_ptr<SCH_LABEL> alone( new SCH_LABEL( wxPoint( 500, 500 ), "B" ) );
+
+    std::vector<SCH_ITEM*> items = { first.get(), second.get(), onWire.get(), alone.get() };
+    std::vector<DANGLING_END_ITEM> endPoints;
+
+    for( SCH_ITEM* item : items )
+        item->GetEndPoints( endPoints );
+
+    DANGLING_END_INDEX index( endPoints );
+
+    for( SCH_ITEM* item : items )
+        item->UpdateDanglingState( index );
+
+    BOOST_CHECK( first->IsStartDangling() );
+    BOOST_CHECK( !first->IsEndDangling() );
+    BOOST_CHECK( !second->IsStartDangling() );
+    BOOST_CHECK( second->IsEndDangling() );
+
+    BOOST_CHECK( !onWire->IsDangling() );
+    BOOST_CHECK( alone->IsDangling() );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
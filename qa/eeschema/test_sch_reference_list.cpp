@@ -0,0 +1,175 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see CHANGELOG.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file
+ * Test suite for the annotation of a SCH_REFERENCE_LIST
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <eeschema_utils/schematic_construction_utils.h>
+
+// Code under test
+#include <sch_reference_list.h>
+
+#include <sch_component.h>
+
+
+class TEST_SCH_REFERENCE_LIST_FIXTURE : public KI_TEST::SCHEMATIC_TEST_DESIGN
+{
+public:
+    /**
+     * Add a component at (aX, 0) to the root sheet and to the reference list.
+     * @param aRef is the reference of the component, the prefix followed by '?' if it is
+     *             not annotated.
+     * @param aUnit is the unit of the component.
+     * @param aSheetNumber is the number of the sheet of the reference.
+     */
+    void addComponent( LIB_PART& aPart, const wxString& aRef, int aX, int aUnit = 1,
+                       int aSheetNumber = 1 )
+    {
+        SCH_COMPONENT* comp = AddComponent( aPart, aRef, aUnit, wxEmptyString, aX );
+
+        SCH_REFERENCE reference( comp, &aPart, m_path );
+        reference.SetSheetNumber( aSheetNumber );
+        m_refs.AddItem( reference );
+    }
+
+    void annotate( bool aUseSheetNum = false, int aSheetIntervalId = 0,
+                   const SCH_MULTI_UNIT_REFERENCE_MAP& aLockedUnitMap =
+                           SCH_MULTI_UNIT_REFERENCE_MAP() )
+    {
+        m_refs.SplitReferences();
+        m_refs.SortByXCoordinate();
+        m_refs.Annotate( aUseSheetNum, aSheetIntervalId, 0, aLockedUnitMap );
+    }
+
+    /**
+     * @return the full reference (unit included) of the aIndex reference of the list.
+     */
+    wxString fullRef( int aIndex )
+    {
+        SCH_REFERENCE& ref = m_refs[aIndex];
+
+        return wxString::Format( "%s%s.%d", ref.GetRef(), ref.GetRefNumber(), ref.GetUnit() );
+    }
+
+    SCH_REFERENCE_LIST m_refs;
+};
+
+
+/**
+ * Declare the test suite
+ */
+BOOST_FIXTURE_TEST_SUITE( SchReferenceList, TEST_SCH_REFERENCE_LIST_FIXTURE )
+
+
+/**
+ * New references fill the holes left by the annotated ones
+ */
+BOOST_AUTO_TEST_CASE( SingleUnit )
+{
+    addComponent( m_resistor, "R?", 0 );
+    addComponent( m_resistor, "R2", 1 );
+    addComponent( m_resistor, "R?", 2 );
+    addComponent( m_resistor, "R?", 3 );
+
+    annotate();
+
+    BOOST_CHECK_EQUAL( fullRef( 0 ), "R1.1" );
+    BOOST_CHECK_EQUAL( fullRef( 1 ), "R2.1" );
+    BOOST_CHECK_EQUAL( fullRef( 2 ), "R3.1" );
+    BOOST_CHECK_EQUAL( fullRef( 3 ), "R4.1" );
+}
+
+
+/**
+ * New multi-unit components fill the free units of the same package first, including
+ * the units of a package annotated before
+ */
+BOOST_AUTO_TEST_CASE( MultiUnit )
+{
+    addComponent( m_quadOpAmp, "U?", 0 );
+    addComponent( m_quadOpAmp, "U?", 1 );
+    addComponent( m_quadOpAmp, "U?", 2 );
+    addComponent( m_quadOpAmp, "U?", 3 );
+    addComponent( m_quadOpAmp, "U?", 4 );
+
+    annotate();
+
+    BOOST_CHECK_EQUAL( fullRef( 0 ), "U1.1" );
+    BOOST_CHECK_EQUAL( fullRef( 1 ), "U1.2" );
+    BOOST_CHECK_EQUAL( fullRef( 2 ), "U1.3" );
+    BOOST_CHECK_EQUAL( fullRef( 3 ), "U1.4" );
+    BOOST_CHECK_EQUAL( fullRef( 4 ), "U2.1" );
+}
+
+
+/**
+ * The units of a locked package keep their unit and share a reference number, the other
+ * components get their own package
+ */
+BOOST_AUTO_TEST_CASE( LockedUnits )
+{
+    SCH_MULTI_UNIT_REFERENCE_MAP lockedUnits;
+
+    // The first and last components were the units 3 and 1 of U5
+    addComponent( m_quadOpAmp, "U?", 0, 3 );
+    lockedUnits["U5"].AddItem( m_refs[0] );
+
+    addComponent( m_quadOpAmp, "U?", 1 );
+
+    addComponent( m_quadOpAmp, "U?", 2, 1 );
+    lockedUnits["U5"].AddItem( m_refs[2] );
+
+    annotate( false, 0, lockedUnits );
+
+    BOOST_CHECK_EQUAL( fullRef( 0 ), "U1.3" );
+    BOOST_CHECK_EQUAL( fullRef( 1 ), "U2.1" );
+    BOOST_CHECK_EQUAL( fullRef( 2 ), "U1.1" );
+}
+
+
+/**
+ * The numbering of each sheet starts at the sheet number times the sheet interval,
+ * whatever the order of the components on the sheets
+ */
+BOOST_AUTO_TEST_CASE( SheetNumbers )
+{
+    addComponent( m_resistor, "R?", 0, 1, 2 );
+    addComponent( m_resistor, "R?", 1, 1, 1 );
+    addComponent( m_resistor, "R?", 2, 1, 2 );
+    addComponent( m_resistor, "R?", 3, 1, 1 );
+
+    annotate( true, 100 );
+
+    // The references are sorted by sheet number, then by position
+    BOOST_CHECK_EQUAL( fullRef( 0 ), "R101.1" );
+    BOOST_CHECK_EQUAL( fullRef( 1 ), "R102.1" );
+    BOOST_CHECK_EQUAL( fullRef( 2 ), "R201.1" );
+    BOOST_CHECK_EQUAL( fullRef( 3 ), "R202.1" );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
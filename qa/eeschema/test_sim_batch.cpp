@@ -0,0 +1,166 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see CHANGELOG.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file
+ * Test suite for the batch simulations: run netlists, raw files and plot decimation
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+// Code under test
+#include <sim/sim_batch_runner.h>
+#include <sim/sim_raw_file.h>
+
+#include <algorithm>
+#include <cstdio>
+
+#include <wx/filefn.h>
+#include <wx/filename.h>
+
+
+/**
+ * Write a raw file of a transient simulation: time, a sine "v(out)" and a ramp "i(v1)".
+ */
+static void writeRawFile( const wxString& aFileName, bool aBinary, size_t aPoints )
+{
+    FILE* file = wxFopen( aFileName, "wb" );
+
+    BOOST_REQUIRE( file );
+
+    fprintf( file, "Title: test circuit\n" );
+    fprintf( file, "Date: Thu Jan  1 00:00:00  2019\n" );
+    fprintf( file, "Plotname: Transient Analysis\n" );
+    fprintf( file, "Flags: real\n" );
+    fprintf( file, "No. Variables: 3\n" );
+    fprintf( file, "No. Points: %u\n", (unsigned) aPoints );
+    fprintf( file, "Variables:\n" );
+    fprintf( file, "\t0\ttime\ttime\n" );
+    fprintf( file, "\t1\tv(out)\tvoltage\n" );
+    fprintf( file, "\t2\ti(v1)\tcurrent\n" );
+    fprintf( file, aBinary ? "Binary:\n" : "Values:\n" );
+
+    for( size_t ii = 0; ii < aPoints; ii++ )
+    {
+        double point[3] = { ii * 1e-6, ( ii % 4 == 1 ) ? 1.0 : ( ii % 4 == 3 ) ? -1.0 : 0.0,
+                            (double) ii };
+
+        if( aBinary )
+            fwrite( point, sizeof( double ), 3, file );
+        else
+            fprintf( file, " %u\t%.15e\n\t%.15e\n\t%.15e\n\n", (unsigned) ii, point[0], point[1],
+                     point[2] );
+    }
+
+    fclose( file );
+}
+
+
+BOOST_AUTO_TEST_SUITE( SimBatch )
+
+
+/**
+ * The directives of a run are inserted before the .end line of the netlist
+ */
+BOOST_AUTO_TEST_CASE( RunNetlist )
+{
+    SIM_BATCH_RUNNER runner( ".title test\nR1 in out {rval}\n.tran 1u 1m\n.end\n", "." );
+
+    runner.AddParamSweep( "rval", { "1k", "10k", "1k" } );
+
+    BOOST_REQUIRE_EQUAL( runner.GetRuns().size(), 3u );
+    BOOST_CHECK_EQUAL( runner.GetRuns()[1].m_name, "1_rval_10k" );
+
+    // A repeated value does not overwrite the files of the previous run
+    BOOST_CHECK( runner.GetRawFile( 0 ) != runner.GetRawFile( 2 ) );
+    BOOST_CHECK_EQUAL( runner.GetRunNetlist( 0 ),
+                       ".title test\nR1 in out {rval}\n.tran 1u 1m\n.param rval=1k\n.end\n" );
+}
+
+
+/**
+ * Read the plots of binary and ascii raw files, without decimation
+ */
+BOOST_AUTO_TEST_CASE( ReadRawFile )
+{
+    for( bool binary : { true, false } )
+    {
+        BOOST_TEST_CONTEXT( "Binary: " << binary )
+        {
+            wxString fileName = wxFileName::CreateTempFileName( "kicad_sim" );
+            writeRawFile( fileName, binary, 10 );
+
+            SIM_RAW_FILE raw;
+            BOOST_REQUIRE( raw.Open( fileName ) );
+
+            BOOST_CHECK_EQUAL( raw.GetPlotName(), "Transient Analysis" );
+            BOOST_CHECK_EQUAL( raw.GetPointCount(), 10u );
+            BOOST_CHECK_EQUAL( raw.IsComplex(), false );
+            BOOST_CHECK_EQUAL( raw.FindVector( "V(OUT)" ), 1 );
+            BOOST_CHECK_EQUAL( raw.FindVector( "v(in)" ), -1 );
+
+            std::vector<SIM_DECIMATOR> plots;
+            BOOST_REQUIRE( raw.ReadPlots( 0, { 2, 1 }, 100, plots ) );
+            BOOST_REQUIRE_EQUAL( plots.size(), 2u );
+            BOOST_REQUIRE_EQUAL( plots[0].GetY().size(), 10u );
+            BOOST_CHECK_CLOSE( plots[0].GetX()[9], 9e-6, 1e-9 );
+            BOOST_CHECK_EQUAL( plots[0].GetY()[9], 9.0 );
+            BOOST_CHECK_EQUAL( plots[1].GetY()[3], -1.0 );
+
+            wxRemoveFile( fileName );
+        }
+    }
+}
+
+
+/**
+ * A decimated plot keeps the peaks of the full plot
+ */
+BOOST_AUTO_TEST_CASE( Decimation )
+{
+    const size_t count = 100000;
+
+    SIM_DECIMATOR sine( count, 1000 );
+    SIM_DECIMATOR ramp( count, 1000 );
+
+    for( size_t ii = 0; ii < count; ii++ )
+    {
+        sine.Add( ii, ( ii % 4 == 1 ) ? 1.0 : ( ii % 4 == 3 ) ? -1.0 : 0.0 );
+        ramp.Add( ii, ii );
+    }
+
+    sine.Finish();
+    ramp.Finish();
+
+    BOOST_CHECK_LE( sine.GetY().size(), 1000u );
+    BOOST_CHECK_EQUAL( *std::min_element( sine.GetY().begin(), sine.GetY().end() ), -1.0 );
+    BOOST_CHECK_EQUAL( *std::max_element( sine.GetY().begin(), sine.GetY().end() ), 1.0 );
+
+    // The points stay in order, from the first one to the last one
+    BOOST_CHECK( std::is_sorted( ramp.GetX().begin(), ramp.GetX().end() ) );
+    BOOST_CHECK_EQUAL( ramp.GetY().front(), 0.0 );
+    BOOST_CHECK_EQUAL( ramp.GetY().back(), (double) ( count - 1 ) );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
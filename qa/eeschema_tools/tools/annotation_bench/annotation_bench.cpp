@@ -0,0 +1,132 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include "annotation_bench.h"
+
+#include <iostream>
+#include <set>
+
+#include <common.h>
+#include <profile.h>
+
+#include <wx/cmdline.h>
+
+#include <sch_component.h>
+#include <sch_reference_list.h>
+
+#include <eeschema_utils/schematic_construction_utils.h>
+
+
+static const wxCmdLineEntryDesc g_cmdLineDesc[] = {
+    { wxCMD_LINE_SWITCH, "h", "help", _( "displays help on the command line parameters" ).mb_str(),
+            wxCMD_LINE_VAL_NONE, wxCMD_LINE_OPTION_HELP },
+    { wxCMD_LINE_OPTION, "c", "count", _( "number of components (default 20000)" ).mb_str(),
+            wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_NONE }
+};
+
+
+/**
+ * Tool-specific return codes
+ */
+enum ANNOTATION_BENCH_RET_CODES
+{
+    DUPLICATE_REFERENCES = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+};
+
+
+int annotation_bench_main_func( int argc, char** argv )
+{
+    wxMessageOutput::Set( new wxMessageOutputStderr );
+    wxCmdLineParser cl_parser( argc, argv );
+    cl_parser.SetDesc( g_cmdLineDesc );
+    cl_parser.AddUsageText(
+            _( "This program annotates a generated schematic of resistors, a third of them "
+               "already annotated, and reports the annotation time." ) );
+
+    int cmd_parsed_ok = cl_parser.Parse();
+    if( cmd_parsed_ok != 0 )
+    {
+        // Help and invalid input both stop here
+        return ( cmd_parsed_ok == -1 ) ? KI_TEST::RET_CODES::OK : KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    long count = 20000;
+
+    cl_parser.Found( "count", &count );
+
+    if( count < 1 )
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+
+    KI_TEST::SCHEMATIC_TEST_DESIGN design;
+    SCH_REFERENCE_LIST             refs;
+
+    for( long ii = 0; ii < count; ii++ )
+    {
+        wxString ref = ii % 3 ? wxString( "R?" ) : wxString::Format( "R%ld", 3 * count - ii );
+
+        SCH_COMPONENT* comp = design.AddComponent( design.m_resistor, ref, 1, wxEmptyString, ii );
+        SCH_REFERENCE  reference( comp, &design.m_resistor, design.m_path );
+
+        refs.AddItem( reference );
+    }
+
+    PROF_COUNTER timer;
+    refs.SplitReferences();
+    refs.SortByXCoordinate();
+    refs.Annotate( false, 0, 0, SCH_MULTI_UNIT_REFERENCE_MAP() );
+    timer.Stop();
+
+    // Each reference number must be used once
+    std::set<long> numbers;
+
+    for( unsigned ii = 0; ii < refs.GetCount(); ii++ )
+    {
+        long number = 0;
+
+        if( refs[ii].GetRefNumber().ToLong( &number ) )
+            numbers.insert( number );
+    }
+
+    std::cout << "Annotated " << count << " components in " << timer.msecs() << " ms"
+              << std::endl;
+
+    if( numbers.size() != (size_t) count )
+    {
+        std::cerr << "Duplicate or missing references: " << numbers.size()
+                  << " reference numbers" << std::endl;
+        return ANNOTATION_BENCH_RET_CODES::DUPLICATE_REFERENCES;
+    }
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+/*
+ * Define the tool interface
+ */
+KI_TEST::UTILITY_PROGRAM annotation_bench_tool = {
+    "annotation_bench",
+    "Benchmark the annotation of a large schematic",
+    annotation_bench_main_func,
+};
@@ -0,0 +1,126 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include "component_table_bench.h"
+
+#include <iostream>
+
+#include <common.h>
+#include <profile.h>
+
+#include <wx/cmdline.h>
+
+#include <sch_component.h>
+#include <sch_component_table.h>
+
+#include <eeschema_utils/schematic_construction_utils.h>
+
+
+static const wxCmdLineEntryDesc g_cmdLineDesc[] = {
+    { wxCMD_LINE_SWITCH, "h", "help", _( "displays help on the command line parameters" ).mb_str(),
+            wxCMD_LINE_VAL_NONE, wxCMD_LINE_OPTION_HELP },
+    { wxCMD_LINE_OPTION, "c", "count", _( "number of components (default 20000)" ).mb_str(),
+            wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_NONE }
+};
+
+
+/**
+ * Tool-specific return codes
+ */
+enum COMPONENT_TABLE_BENCH_RET_CODES
+{
+    WRONG_TABLE = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+};
+
+
+int component_table_bench_main_func( int argc, char** argv )
+{
+    wxMessageOutput::Set( new wxMessageOutputStderr );
+    wxCmdLineParser cl_parser( argc, argv );
+    cl_parser.SetDesc( g_cmdLineDesc );
+    cl_parser.AddUsageText(
+            _( "This program builds the component table of a generated schematic of resistors "
+               "with several fields, then updates it after a change of one field, and reports "
+               "the times of both updates." ) );
+
+    int cmd_parsed_ok = cl_parser.Parse();
+    if( cmd_parsed_ok != 0 )
+    {
+        // Help and invalid input both stop here
+        return ( cmd_parsed_ok == -1 ) ? KI_TEST::RET_CODES::OK : KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    long count = 20000;
+
+    cl_parser.Found( "count", &count );
+
+    if( count < 1 )
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+
+    KI_TEST::SCHEMATIC_TEST_DESIGN design;
+    SCH_COMPONENT_TABLE            table;
+    std::vector<SCH_COMPONENT*>    components;
+
+    for( long ii = 0; ii < count; ii++ )
+    {
+        components.push_back( design.AddComponent( design.m_resistor,
+                                                   wxString::Format( "R%ld", ii + 1 ), 1,
+                                                   wxString::Format( "%ldk", ii % 100 ) ) );
+        design.SetField( components.back(), "MPN", wxString::Format( "RC%ld", ii % 100 ) );
+        design.SetField( components.back(), "Manufacturer", "Yageo" );
+    }
+
+    PROF_COUNTER fullTimer;
+    table.Update( &design.m_root );
+    fullTimer.Stop();
+
+    design.SetField( components[ count / 2 ], "MPN", "changed" );
+
+    PROF_COUNTER updateTimer;
+    table.Invalidate();
+    table.Update( &design.m_root );
+    updateTimer.Stop();
+
+    std::cout << "Component table of " << count << " components: " << fullTimer.msecs()
+              << " ms, updated in " << updateTimer.msecs() << " ms" << std::endl;
+
+    if( table.GetCount() != (unsigned) count
+            || table.GetColumnText( count / 2, table.FindColumn( "MPN" ) ) != "changed" )
+    {
+        std::cerr << "The updated table does not match the schematic" << std::endl;
+        return COMPONENT_TABLE_BENCH_RET_CODES::WRONG_TABLE;
+    }
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+/*
+ * Define the tool interface
+ */
+KI_TEST::UTILITY_PROGRAM component_table_bench_tool = {
+    "component_table_bench",
+    "Benchmark the update of the component table of a large schematic",
+    component_table_bench_main_func,
+};
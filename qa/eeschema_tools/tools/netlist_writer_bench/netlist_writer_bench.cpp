@@ -0,0 +1,108 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include "netlist_writer_bench.h"
+
+#include <iostream>
+#include <string>
+
+#include <common.h>
+#include <profile.h>
+
+#include <wx/cmdline.h>
+
+#include <eeschema_utils/netlist_writer_utils.h>
+
+
+static const wxCmdLineEntryDesc g_cmdLineDesc[] = {
+    { wxCMD_LINE_SWITCH, "h", "help", _( "displays help on the command line parameters" ).mb_str(),
+            wxCMD_LINE_VAL_NONE, wxCMD_LINE_OPTION_HELP },
+    { wxCMD_LINE_OPTION, "c", "count", _( "number of components and nets (default 20000)" )
+            .mb_str(), wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_NONE }
+};
+
+
+/**
+ * Tool-specific return codes
+ */
+enum NETLIST_WRITER_BENCH_RET_CODES
+{
+    OUTPUT_MISMATCH = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+};
+
+
+int netlist_writer_bench_main_func( int argc, char** argv )
+{
+    wxMessageOutput::Set( new wxMessageOutputStderr );
+    wxCmdLineParser cl_parser( argc, argv );
+    cl_parser.SetDesc( g_cmdLineDesc );
+    cl_parser.AddUsageText(
+            _( "This program writes a generated netlist with the XNODE tree writer and with the "
+               "streamed s-expression writer, checks both outputs are the same and reports "
+               "the time of each writer." ) );
+
+    int cmd_parsed_ok = cl_parser.Parse();
+    if( cmd_parsed_ok != 0 )
+    {
+        // Help and invalid input both stop here
+        return ( cmd_parsed_ok == -1 ) ? KI_TEST::RET_CODES::OK : KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    long count = 20000;
+
+    cl_parser.Found( "count", &count );
+
+    if( count < 0 )
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+
+    PROF_COUNTER treeTimer;
+    std::string  tree = KI_TEST::FormatTestNetlistTree( count );
+    treeTimer.Stop();
+
+    PROF_COUNTER streamTimer;
+    std::string  stream = KI_TEST::FormatTestNetlistStream( count );
+    streamTimer.Stop();
+
+    std::cout << "Netlist of " << count << " components, " << tree.size() << " bytes: XNODE tree "
+              << treeTimer.msecs() << " ms, streamed " << streamTimer.msecs() << " ms"
+              << std::endl;
+
+    if( stream != tree )
+    {
+        std::cerr << "The streamed netlist differs from the XNODE tree" << std::endl;
+        return NETLIST_WRITER_BENCH_RET_CODES::OUTPUT_MISMATCH;
+    }
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+/*
+ * Define the tool interface
+ */
+KI_TEST::UTILITY_PROGRAM netlist_writer_bench_tool = {
+    "netlist_writer_bench",
+    "Benchmark the netlist writers on a large netlist",
+    netlist_writer_bench_main_func,
+};
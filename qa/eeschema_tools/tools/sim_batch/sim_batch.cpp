@@ -0,0 +1,209 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include "sim_batch.h"
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <common.h>
+#include <profile.h>
+
+#include <wx/cmdline.h>
+#include <wx/ffile.h>
+#include <wx/tokenzr.h>
+
+#include <sim/sim_batch_runner.h>
+#include <sim/sim_raw_file.h>
+
+
+static const wxCmdLineEntryDesc g_cmdLineDesc[] = {
+    { wxCMD_LINE_SWITCH, "h", "help", _( "displays help on the command line parameters" ).mb_str(),
+            wxCMD_LINE_VAL_NONE, wxCMD_LINE_OPTION_HELP },
+    { wxCMD_LINE_OPTION, "o", "output", _( "output directory of the runs" ).mb_str(),
+            wxCMD_LINE_VAL_STRING, wxCMD_LINE_OPTION_MANDATORY },
+    { wxCMD_LINE_OPTION, "p", "param", _( "name of the swept parameter" ).mb_str(),
+            wxCMD_LINE_VAL_STRING, wxCMD_LINE_OPTION_MANDATORY },
+    { wxCMD_LINE_OPTION, "v", "vectors",
+            _( "comma separated list of the reported vectors (default: all)" ).mb_str(),
+            wxCMD_LINE_VAL_STRING },
+    { wxCMD_LINE_OPTION, "n", "points",
+            _( "maximum number of points read by vector (default 1000)" ).mb_str(),
+            wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_OPTION, "s", "simulator", _( "ngspice executable (default ngspice)" ).mb_str(),
+            wxCMD_LINE_VAL_STRING },
+    { wxCMD_LINE_PARAM, nullptr, nullptr, _( "netlist file" ).mb_str(), wxCMD_LINE_VAL_STRING },
+    { wxCMD_LINE_PARAM, nullptr, nullptr, _( "parameter values" ).mb_str(),
+            wxCMD_LINE_VAL_STRING, wxCMD_LINE_PARAM_MULTIPLE },
+    { wxCMD_LINE_NONE }
+};
+
+
+/**
+ * Tool-specific return codes
+ */
+enum SIM_BATCH_RET_CODES
+{
+    LOAD_FAILED = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+    RUN_FAILED,
+};
+
+
+int sim_batch_main_func( int argc, char** argv )
+{
+    wxMessageOutput::Set( new wxMessageOutputStderr );
+    wxCmdLineParser cl_parser( argc, argv );
+    cl_parser.SetDesc( g_cmdLineDesc );
+    cl_parser.AddUsageText(
+            _( "This program runs a spice netlist once for each value of a parameter, with "
+               "ngspice in batch mode, and reports the range of the vectors of each run. "
+               "The netlist uses the parameter as {name} and must not define it." ) );
+
+    int cmd_parsed_ok = cl_parser.Parse();
+    if( cmd_parsed_ok != 0 )
+    {
+        // Help and invalid input both stop here
+        return ( cmd_parsed_ok == -1 ) ? KI_TEST::RET_CODES::OK : KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    wxString output;
+    wxString param;
+    wxString vectorNames;
+    wxString simulator;
+    long     maxPoints = 1000;
+
+    cl_parser.Found( "output", &output );
+    cl_parser.Found( "param", &param );
+    cl_parser.Found( "vectors", &vectorNames );
+    cl_parser.Found( "points", &maxPoints );
+
+    if( maxPoints < 2 )
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+
+    std::vector<wxString> values;
+
+    for( size_t ii = 1; ii < cl_parser.GetParamCount(); ii++ )
+        values.push_back( cl_parser.GetParam( ii ) );
+
+    wxFFile  netlistFile( cl_parser.GetParam( 0 ), "rb" );
+    wxString netlist;
+
+    if( !netlistFile.IsOpened() || !netlistFile.ReadAll( &netlist, wxConvUTF8 ) )
+    {
+        std::cerr << "Cannot read the netlist " << cl_parser.GetParam( 0 ) << std::endl;
+        return SIM_BATCH_RET_CODES::LOAD_FAILED;
+    }
+
+    SIM_BATCH_RUNNER runner( netlist, output );
+
+    if( cl_parser.Found( "simulator", &simulator ) )
+        runner.SetSimulator( simulator );
+
+    runner.AddParamSweep( param, values );
+
+    PROF_COUNTER timer;
+    int          failures = runner.Run();
+    timer.Stop();
+
+    std::cout << runner.GetRuns().size() << " runs in " << timer.msecs() << " ms, " << failures
+              << " failed" << std::endl;
+
+    for( size_t ii = 0; ii < runner.GetRuns().size(); ii++ )
+    {
+        const SIM_BATCH_RUNNER::RUN& run = runner.GetRuns()[ii];
+        SIM_RAW_FILE                 rawFile;
+
+        std::cout << run.m_name << ": ";
+
+        if( !run.m_success || !rawFile.Open( runner.GetRawFile( ii ) ) )
+        {
+            std::cout << "failed, see " << runner.GetLogFile( ii ) << std::endl;
+            continue;
+        }
+
+        // The first vector is the x axis of the plot
+        std::vector<int> indices;
+
+        if( vectorNames.IsEmpty() )
+        {
+            for( size_t jj = 1; jj < rawFile.GetVectors().size(); jj++ )
+                indices.push_back( (int) jj );
+        }
+        else
+        {
+            wxStringTokenizer tokenizer( vectorNames, "," );
+
+            while( tokenizer.HasMoreTokens() )
+            {
+                wxString name = tokenizer.GetNextToken().Trim().Trim( false );
+                int      index = rawFile.FindVector( name.ToStdString() );
+
+                if( index < 0 )
+                    std::cerr << "No vector " << name << " in " << runner.GetRawFile( ii )
+                              << std::endl;
+                else
+                    indices.push_back( index );
+            }
+        }
+
+        std::vector<SIM_DECIMATOR> plots;
+
+        if( !rawFile.ReadPlots( 0, indices, (size_t) maxPoints, plots ) )
+        {
+            std::cout << "invalid raw file " << runner.GetRawFile( ii ) << std::endl;
+            failures++;
+            continue;
+        }
+
+        std::cout << rawFile.GetPlotName() << ", " << rawFile.GetPointCount() << " points"
+                  << std::endl;
+
+        // The decimation keeps the peaks of the plots, so their range is exact
+        for( size_t jj = 0; jj < plots.size(); jj++ )
+        {
+            const std::vector<double>& y = plots[jj].GetY();
+
+            if( y.empty() )
+                continue;
+
+            auto range = std::minmax_element( y.begin(), y.end() );
+
+            std::cout << "    " << rawFile.GetVectors()[indices[jj]] << ": " << *range.first
+                      << " .. " << *range.second << std::endl;
+        }
+    }
+
+    return failures ? SIM_BATCH_RET_CODES::RUN_FAILED : KI_TEST::RET_CODES::OK;
+}
+
+
+/*
+ * Define the tool interface
+ */
+KI_TEST::UTILITY_PROGRAM sim_batch_tool = {
+    "sim_batch",
+    "Run a parameter sweep of a spice netlist with ngspice in batch mode",
+    sim_batch_main_func,
+};
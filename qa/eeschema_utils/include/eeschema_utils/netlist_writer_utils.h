@@ -0,0 +1,55 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef QA_EESCHEMA_UTILS_NETLIST_WRITER_UTILS__H
+#define QA_EESCHEMA_UTILS_NETLIST_WRITER_UTILS__H
+
+#include <string>
+
+#include <netlist_writer.h>
+
+/**
+ * @file netlist_writer_utils.h
+ * A generated netlist-like document for the tests and benchmarks of the netlist writers
+ */
+namespace KI_TEST
+{
+/**
+ * Write a netlist-like document with aCount components and nets.
+ */
+void WriteTestNetlist( NETLIST_WRITER& aWriter, int aCount );
+
+/**
+ * Format the document of WriteTestNetlist() from the XNODE tree built by a
+ * XNODE_NETLIST_WRITER.
+ */
+std::string FormatTestNetlistTree( int aCount );
+
+/**
+ * Format the document of WriteTestNetlist() streamed by a SEXPR_NETLIST_WRITER.
+ */
+std::string FormatTestNetlistStream( int aCount );
+
+} // namespace KI_TEST
+
+#endif // QA_EESCHEMA_UTILS_NETLIST_WRITER_UTILS__H
@@ -0,0 +1,74 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef QA_EESCHEMA_UTILS_SCHEMATIC_CONSTRUCTION_UTILS__H
+#define QA_EESCHEMA_UTILS_SCHEMATIC_CONSTRUCTION_UTILS__H
+
+#include <class_libentry.h>
+#include <sch_sheet.h>
+#include <sch_sheet_path.h>
+
+class SCH_COMPONENT;
+
+/**
+ * @file schematic_construction_utils.h
+ * Construction utilities for the schematics of the Eeschema tests and QA programs
+ */
+namespace KI_TEST
+{
+/**
+ * A schematic made of a root sheet, and a resistor and a quad op-amp symbol to place
+ * on it.
+ */
+class SCHEMATIC_TEST_DESIGN
+{
+public:
+    SCHEMATIC_TEST_DESIGN();
+
+    /**
+     * Add a component at (aX, 0) to the root sheet, which owns it.
+     *
+     * @param aRef   the reference of the component, the prefix followed by '?' if it is
+     *               not annotated
+     * @param aUnit  the unit of the component
+     * @param aValue the value of the component, the name of the symbol if empty
+     * @param aX     the x position of the component
+     */
+    SCH_COMPONENT* AddComponent( LIB_PART& aPart, const wxString& aRef, int aUnit = 1,
+                                 const wxString& aValue = wxEmptyString, int aX = 0 );
+
+    /**
+     * Set the text of the field aName of a component, the field being added if it
+     * does not exist.
+     */
+    void SetField( SCH_COMPONENT* aComp, const wxString& aName, const wxString& aText );
+
+    LIB_PART       m_resistor;
+    LIB_PART       m_quadOpAmp;
+    SCH_SHEET      m_root;
+    SCH_SHEET_PATH m_path;
+};
+
+} // namespace KI_TEST
+
+#endif // QA_EESCHEMA_UTILS_SCHEMATIC_CONSTRUCTION_UTILS__H
@@ -0,0 +1,124 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <eeschema_utils/netlist_writer_utils.h>
+
+#include <memory>
+
+#include <richio.h>
+#include <xnode.h>
+
+namespace KI_TEST
+{
+
+void WriteTestNetlist( NETLIST_WRITER& aWriter, int aCount )
+{
+    aWriter.StartElement( "export" );
+    aWriter.AddAttribute( "version", "D" );
+
+    aWriter.StartElement( "design" );
+    aWriter.AddElement( "source", "/tmp/a project/test.sch" );
+    aWriter.AddElement( "tool", "Eeschema \"test\"" );
+    aWriter.EndElement();
+
+    aWriter.StartElement( "components" );
+
+    for( int ii = 0; ii < aCount; ii++ )
+    {
+        aWriter.StartElement( "comp" );
+        aWriter.AddAttribute( "ref", wxString::Format( "R%d", ii + 1 ) );
+        aWriter.AddElement( "value", ii % 2 ? "10k" : "~" );
+
+        aWriter.StartElement( "fields" );
+        aWriter.StartElement( "field" );
+        aWriter.AddAttribute( "name", "Field (1)" );
+        aWriter.AddContent( "some value" );
+        aWriter.EndElement();
+        aWriter.EndElement();
+
+        aWriter.StartElement( "libsource" );
+        aWriter.AddAttribute( "lib", "Device" );
+        aWriter.AddAttribute( "part", "R" );
+        aWriter.AddAttribute( "description", "" );
+        aWriter.EndElement();
+
+        aWriter.AddElement( "tstamp", wxString::Format( "%8.8X", ii ) );
+        aWriter.EndElement();
+    }
+
+    aWriter.EndElement();
+
+    // Elements without attributes nor children
+    aWriter.AddElement( "libparts" );
+    aWriter.AddElement( "libraries", "" );
+
+    aWriter.StartElement( "nets" );
+
+    for( int ii = 0; ii < aCount; ii++ )
+    {
+        aWriter.StartElement( "net" );
+        aWriter.AddAttribute( "code", wxString::Format( "%d", ii + 1 ) );
+        aWriter.AddAttribute( "name", wxString::Format( "Net-(R%d-Pad1)", ii + 1 ) );
+
+        for( int pin = 1; pin <= 2; pin++ )
+        {
+            aWriter.StartElement( "node" );
+            aWriter.AddAttribute( "ref", wxString::Format( "R%d", ii + 1 ) );
+            aWriter.AddAttribute( "pin", wxString::Format( "%d", pin ) );
+            aWriter.EndElement();
+        }
+
+        aWriter.EndElement();
+    }
+
+    aWriter.EndElement();
+
+    aWriter.EndElement();
+}
+
+
+std::string FormatTestNetlistTree( int aCount )
+{
+    STRING_FORMATTER     formatter;
+    XNODE_NETLIST_WRITER writer;
+
+    WriteTestNetlist( writer, aCount );
+
+    std::unique_ptr<XNODE> root( writer.ReleaseRoot() );
+    root->Format( &formatter, 0 );
+
+    return formatter.GetString();
+}
+
+
+std::string FormatTestNetlistStream( int aCount )
+{
+    STRING_FORMATTER     formatter;
+    SEXPR_NETLIST_WRITER writer( &formatter );
+
+    WriteTestNetlist( writer, aCount );
+
+    return formatter.GetString();
+}
+
+} // namespace KI_TEST
@@ -0,0 +1,70 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <eeschema_utils/schematic_construction_utils.h>
+
+#include <sch_component.h>
+#include <sch_screen.h>
+
+namespace KI_TEST
+{
+
+SCHEMATIC_TEST_DESIGN::SCHEMATIC_TEST_DESIGN() : m_resistor( "R" ), m_quadOpAmp( "LM324" )
+{
+    m_resistor.GetReferenceField().SetText( "R" );
+
+    m_quadOpAmp.GetReferenceField().SetText( "U" );
+    m_quadOpAmp.SetUnitCount( 4 );
+
+    m_root.SetScreen( new SCH_SCREEN( nullptr ) );
+    m_path.push_back( &m_root );
+}
+
+
+SCH_COMPONENT* SCHEMATIC_TEST_DESIGN::AddComponent( LIB_PART& aPart, const wxString& aRef,
+                                                    int aUnit, const wxString& aValue, int aX )
+{
+    SCH_COMPONENT* comp = new SCH_COMPONENT( aPart, LIB_ID( "lib", aPart.GetName() ), &m_path,
+                                             aUnit, 0, wxPoint( aX, 0 ) );
+    comp->SetRef( &m_path, aRef );
+
+    if( !aValue.IsEmpty() )
+        comp->GetField( VALUE )->SetText( aValue );
+
+    m_root.GetScreen()->Append( comp );
+    return comp;
+}
+
+
+void SCHEMATIC_TEST_DESIGN::SetField( SCH_COMPONENT* aComp, const wxString& aName,
+                                      const wxString& aText )
+{
+    SCH_FIELD* field = aComp->FindField( aName );
+
+    if( !field )
+        field = aComp->AddField( SCH_FIELD( wxPoint( 0, 0 ), -1, aComp, aName ) );
+
+    field->SetText( aText );
+}
+
+} // namespace KI_TEST
@@ -25,8 +25,12 @@
 
 #include "tools/drc_tool/drc_tool.h"
 #include "tools/pcb_parser/pcb_parser_tool.h"
+#include "tools/plot_job/plot_job.h"
 #include "tools/polygon_generator/polygon_generator.h"
 #include "tools/polygon_triangulation/polygon_triangulation.h"
+#include "tools/raytrace_bench/raytrace_bench.h"
+#include "tools/redraw_bench/redraw_bench.h"
+#include "tools/render_3d/render_3d.h"
 
 /**
  * List of registered tools.
@@ -37,8 +41,12 @@
 const static std::vector<KI_TEST::UTILITY_PROGRAM*> known_tools = {
     &drc_tool,
     &pcb_parser_tool,
+    &plot_job_tool,
     &polygon_generator_tool,
     &polygon_triangulation_tool,
+    &raytrace_bench_tool,
+    &redraw_bench_tool,
+    &render_3d_tool,
 };
 
 
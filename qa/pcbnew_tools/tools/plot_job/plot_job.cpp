@@ -0,0 +1,233 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see CHANGELOG.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include "plot_job.h"
+
+#include <iostream>
+#include <string>
+
+#include <common.h>
+#include <profile.h>
+#include <reporter.h>
+
+#include <wx/cmdline.h>
+#include <wx/tokenzr.h>
+
+#include <class_board.h>
+#include <plotcontroller.h>
+#include <exporters/gendrill_Excellon_writer.h>
+#include <exporters/gendrill_gerber_writer.h>
+
+#include <pcbnew_utils/board_file_utils.h>
+
+
+static const wxCmdLineEntryDesc g_cmdLineDesc[] = {
+    { wxCMD_LINE_SWITCH, "h", "help", _( "displays help on the command line parameters" ).mb_str(),
+            wxCMD_LINE_VAL_NONE, wxCMD_LINE_OPTION_HELP },
+    { wxCMD_LINE_SWITCH, "v", "verbose", _( "print the plot time" ).mb_str() },
+    { wxCMD_LINE_OPTION, "o", "output", _( "output directory" ).mb_str(), wxCMD_LINE_VAL_STRING,
+            wxCMD_LINE_OPTION_MANDATORY },
+    { wxCMD_LINE_OPTION, "f", "format",
+            _( "plot format: gerber (default), pdf, svg, dxf, ps or hpgl" ).mb_str(),
+            wxCMD_LINE_VAL_STRING },
+    { wxCMD_LINE_OPTION, "l", "layers",
+            _( "comma separated list of layer names (default: the board plot settings)" )
+            .mb_str(), wxCMD_LINE_VAL_STRING },
+    { wxCMD_LINE_OPTION, "d", "drill", _( "drill file format: excellon or gerber" ).mb_str(),
+            wxCMD_LINE_VAL_STRING },
+    { wxCMD_LINE_SWITCH, "m", "map", _( "also create the drill map files (PDF)" ).mb_str() },
+    { wxCMD_LINE_PARAM, nullptr, nullptr, _( "input file" ).mb_str(), wxCMD_LINE_VAL_STRING,
+            wxCMD_LINE_PARAM_OPTIONAL },
+    { wxCMD_LINE_NONE }
+};
+
+
+/**
+ * Tool-specific return codes
+ */
+enum PLOT_JOB_RET_CODES
+{
+    LOAD_FAILED = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+    PLOT_FAILED,
+};
+
+
+static bool parsePlotFormat( const wxString& aName, PlotFormat& aFormat )
+{
+    if( aName == "gerber" )
+        aFormat = PLOT_FORMAT_GERBER;
+    else if( aName == "pdf" )
+        aFormat = PLOT_FORMAT_PDF;
+    else if( aName == "svg" )
+        aFormat = PLOT_FORMAT_SVG;
+    else if( aName == "dxf" )
+        aFormat = PLOT_FORMAT_DXF;
+    else if( aName == "ps" )
+        aFormat = PLOT_FORMAT_POST;
+    else if( aName == "hpgl" )
+        aFormat = PLOT_FORMAT_HPGL;
+    else
+        return false;
+
+    return true;
+}
+
+
+int plot_job_main_func( int argc, char** argv )
+{
+    wxMessageOutput::Set( new wxMessageOutputStderr );
+    wxCmdLineParser cl_parser( argc, argv );
+    cl_parser.SetDesc( g_cmdLineDesc );
+    cl_parser.AddUsageText(
+            _( "This program loads a PCB file and plots the given layers, each to its own "
+               "file, and optionally the drill files. The files are plotted concurrently." ) );
+
+    int cmd_parsed_ok = cl_parser.Parse();
+    if( cmd_parsed_ok != 0 )
+    {
+        // Help and invalid input both stop here
+        return ( cmd_parsed_ok == -1 ) ? KI_TEST::RET_CODES::OK : KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    const bool verbose = cl_parser.Found( "verbose" );
+    const bool genMap = cl_parser.Found( "map" );
+
+    wxString   output;
+    wxString   formatName = "gerber";
+    wxString   layerNames;
+    wxString   drillFormat;
+    PlotFormat format;
+
+    cl_parser.Found( "output", &output );
+    cl_parser.Found( "format", &formatName );
+    cl_parser.Found( "layers", &layerNames );
+    cl_parser.Found( "drill", &drillFormat );
+
+    if( !parsePlotFormat( formatName, format ) )
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+
+    if( !drillFormat.IsEmpty() && drillFormat != "excellon" && drillFormat != "gerber" )
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+
+    std::string filename;
+
+    if( cl_parser.GetParamCount() )
+        filename = cl_parser.GetParam( 0 ).ToStdString();
+
+    std::unique_ptr<BOARD> board = KI_TEST::ReadBoardFromFileOrStream( filename );
+
+    if( !board )
+        return PLOT_JOB_RET_CODES::LOAD_FAILED;
+
+    // The plot file names are built from the board file name
+    board->SetFileName( filename.empty() ? wxString( "board.kicad_pcb" ) : wxString( filename ) );
+
+    PLOT_CONTROLLER plotController( board.get() );
+    PCB_PLOT_PARAMS& plotOpts = plotController.GetPlotOptions();
+
+    plotOpts = board->GetPlotOptions();
+    plotOpts.SetOutputDirectory( output );
+
+    LSET layers = plotOpts.GetLayerSelection();
+
+    if( !layerNames.IsEmpty() )
+    {
+        layers.reset();
+
+        wxStringTokenizer tokenizer( layerNames, "," );
+
+        while( tokenizer.HasMoreTokens() )
+        {
+            wxString     name = tokenizer.GetNextToken().Trim().Trim( false );
+            PCB_LAYER_ID layer = board->GetLayerID( name );
+
+            if( layer == UNDEFINED_LAYER )
+            {
+                std::cerr << "Unknown layer: " << name << std::endl;
+                return KI_TEST::RET_CODES::BAD_CMDLINE;
+            }
+
+            layers.set( layer );
+        }
+    }
+
+    PROF_COUNTER timer;
+    bool         success;
+    wxString     drillMessages;
+
+    WX_STRING_REPORTER drillReporter( &drillMessages );
+
+    if( drillFormat == "excellon" )
+    {
+        EXCELLON_WRITER drillWriter( board.get() );
+        drillWriter.SetFormat( true );
+        drillWriter.SetOptions( false, false, board->GetAuxOrigin(), false );
+        drillWriter.SetMapFileFormat( PLOT_FORMAT_PDF );
+
+        success = plotController.PlotLayers( layers, format, &drillWriter, genMap,
+                                             &drillReporter );
+    }
+    else if( drillFormat == "gerber" )
+    {
+        GERBER_WRITER drillWriter( board.get() );
+        drillWriter.SetFormat();
+        drillWriter.SetOptions( board->GetAuxOrigin() );
+        drillWriter.SetMapFileFormat( PLOT_FORMAT_PDF );
+
+        success = plotController.PlotLayers( layers, format, &drillWriter, genMap,
+                                             &drillReporter );
+    }
+    else
+    {
+        success = plotController.PlotLayers( layers, format );
+    }
+
+    timer.Stop();
+
+    if( verbose )
+    {
+        std::cout << drillMessages;
+        std::cout << "Plotted " << layers.count() << " layers in " << timer.msecs() << " ms"
+                  << std::endl;
+    }
+
+    if( !success )
+    {
+        if( !verbose )
+            std::cerr << drillMessages;
+
+        return PLOT_JOB_RET_CODES::PLOT_FAILED;
+    }
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+/*
+ * Define the tool interface
+ */
+KI_TEST::UTILITY_PROGRAM plot_job_tool = {
+    "plot_job",
+    "Plot the layers and the drill files of a PCB concurrently",
+    plot_job_main_func,
+};
@@ -0,0 +1,312 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see CHANGELOG.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include "raytrace_bench.h"
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <common.h>
+#include <profile.h>
+#include <trigo.h>
+
+#include <wx/cmdline.h>
+
+#include <class_board.h>
+
+#include <3d_canvas/cinfo3d_visu.h>
+#include <3d_rendering/ctrack_ball.h>
+#include <3d_rendering/3d_render_raytracing/accelerators/cbvh_pbrt.h>
+#include <3d_rendering/3d_render_raytracing/accelerators/ccontainer.h>
+#include <3d_rendering/3d_render_raytracing/accelerators/ccontainer2d.h>
+#include <3d_rendering/3d_render_raytracing/shapes3D/ccylinder.h>
+#include <3d_rendering/3d_render_raytracing/shapes3D/cdummyblock.h>
+#include <3d_rendering/3d_render_raytracing/shapes3D/croundseg.h>
+
+
+/**
+ * A generated board scene: a board body with tracks, vias and pads on both
+ * sides, in 3D units, as the raytracer builds it from a real board.
+ */
+class BENCH_SCENE
+{
+public:
+    BENCH_SCENE( const BOARD& aBoard, int aTrackCount )
+    {
+        // A 100 x 70 mm board, scaled like CINFO3D_VISU does
+        const float mm = RANGE_SCALE_3D / 100.0f;
+        const float halfX = 50.0f * mm;
+        const float halfY = 35.0f * mm;
+        const float halfThickness = 0.8f * mm;
+        const float copper = 0.035f * mm;
+
+        m_objects.Add( new CDUMMYBLOCK( CBBOX( SFVEC3F( -halfX, -halfY, -halfThickness ),
+                                               SFVEC3F( halfX, halfY, halfThickness ) ) ) );
+
+        std::mt19937                          rng( 1 );
+        std::uniform_real_distribution<float> posX( -halfX, halfX );
+        std::uniform_real_distribution<float> posY( -halfY, halfY );
+        std::uniform_real_distribution<float> length( 1.0f * mm, 20.0f * mm );
+        std::uniform_int_distribution<int>    octant( 0, 7 );
+
+        for( int i = 0; i < aTrackCount; ++i )
+        {
+            const bool  top = ( i % 2 ) == 0;
+            const float zmin = top ? halfThickness : -halfThickness - copper;
+            const float zmax = zmin + copper;
+
+            const double  angle = octant( rng ) * M_PI / 4.0;
+            const float   len = length( rng );
+            const SFVEC2F start( posX( rng ), posY( rng ) );
+            const SFVEC2F end( start.x + len * cos( angle ), start.y + len * sin( angle ) );
+
+            auto seg = new CROUNDSEGMENT2D( start, end, 0.25f * mm, aBoard );
+            m_segments.Add( seg );
+            m_objects.Add( new CROUNDSEG( *seg, zmin, zmax ) );
+
+            // A via every 4 tracks, and a pad every 2 tracks, at the track ends
+            if( ( i % 4 ) == 0 )
+            {
+                m_objects.Add( new CVCYLINDER( end, -halfThickness - copper,
+                                               halfThickness + copper, 0.3f * mm ) );
+            }
+            else if( ( i % 2 ) == 1 )
+            {
+                const float pad = 0.5f * mm;
+
+                m_objects.Add( new CDUMMYBLOCK( CBBOX( SFVEC3F( start.x - pad, start.y - pad, zmin ),
+                                                       SFVEC3F( start.x + pad, start.y + pad,
+                                                                zmax + copper ) ) ) );
+            }
+        }
+    }
+
+    const CCONTAINER& GetObjects() const { return m_objects; }
+
+private:
+    CCONTAINER2D m_segments;
+    CCONTAINER   m_objects;
+};
+
+
+static const wxCmdLineEntryDesc g_cmdLineDesc[] = {
+    { wxCMD_LINE_SWITCH, "h", "help", _( "displays help on the command line parameters" ).mb_str(),
+            wxCMD_LINE_VAL_NONE, wxCMD_LINE_OPTION_HELP },
+    { wxCMD_LINE_SWITCH, "a", "all", _( "run with each supported instruction set" ).mb_str() },
+    { wxCMD_LINE_SWITCH, "1", "single", _( "use a single thread" ).mb_str() },
+    { wxCMD_LINE_OPTION, "n", "tracks", _( "number of generated tracks (default 20000)" ).mb_str(),
+            wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_OPTION, "i", "iterations", _( "number of frames (default 10)" ).mb_str(),
+            wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_OPTION, "s", "size", _( "frame size in pixels (default 1024)" ).mb_str(),
+            wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_OPTION, "t", "tilt", _( "camera tilt in degrees (default 30)" ).mb_str(),
+            wxCMD_LINE_VAL_DOUBLE },
+    { wxCMD_LINE_NONE }
+};
+
+
+static const char* simdName( RAYPACKET_SIMD aSIMD )
+{
+    switch( aSIMD )
+    {
+    case RAYPACKET_SIMD_AVX: return "AVX";
+    case RAYPACKET_SIMD_SSE: return "SSE";
+    default:                 return "none";
+    }
+}
+
+
+/**
+ * Trace all the packets aIterations times
+ * @return the number of rays that hit an object in a frame
+ */
+static size_t tracePackets( const CBVH_PBRT& aAccelerator, const std::vector<RAYPACKET>& aPackets,
+        long aIterations, bool aSingleThread )
+{
+    std::atomic<size_t> nextPacket( 0 );
+    std::atomic<size_t> hits( 0 );
+
+    const size_t total = aPackets.size() * aIterations;
+
+    auto worker = [&]() -> size_t
+    {
+        HITINFO_PACKET hitPacket[RAYPACKET_RAYS_PER_PACKET];
+        size_t         threadHits = 0;
+
+        for( size_t i = nextPacket++; i < total; i = nextPacket++ )
+        {
+            for( unsigned int r = 0; r < RAYPACKET_RAYS_PER_PACKET; ++r )
+            {
+                hitPacket[r].m_HitInfo.m_tHit = std::numeric_limits<float>::infinity();
+                hitPacket[r].m_HitInfo.m_acc_node_info = 0;
+                hitPacket[r].m_hitresult = false;
+            }
+
+            aAccelerator.Intersect( aPackets[i % aPackets.size()], hitPacket );
+
+            // Count the hits of the first frame only
+            if( i < aPackets.size() )
+            {
+                for( unsigned int r = 0; r < RAYPACKET_RAYS_PER_PACKET; ++r )
+                    threadHits += hitPacket[r].m_hitresult ? 1 : 0;
+            }
+        }
+
+        hits += threadHits;
+        return 1;
+    };
+
+    size_t parallelThreadCount = aSingleThread ? 1 :
+            std::max<size_t>( std::thread::hardware_concurrency(), 1 );
+
+    if( parallelThreadCount == 1 )
+    {
+        worker();
+    }
+    else
+    {
+        std::vector<std::future<size_t>> returns( parallelThreadCount );
+
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            returns[ii] = std::async( std::launch::async, worker );
+
+        for( auto& ret : returns )
+            ret.wait();
+    }
+
+    return hits;
+}
+
+
+int raytrace_bench_main_func( int argc, char** argv )
+{
+    wxMessageOutput::Set( new wxMessageOutputStderr );
+    wxCmdLineParser cl_parser( argc, argv );
+    cl_parser.SetDesc( g_cmdLineDesc );
+    cl_parser.AddUsageText(
+            _( "This program generates a board scene for the 3D raytracer (board body, tracks, "
+               "vias and pads), builds its BVH and traces primary ray packets through it, and "
+               "reports the number of rays traced per second." ) );
+
+    int cmd_parsed_ok = cl_parser.Parse();
+    if( cmd_parsed_ok != 0 )
+    {
+        // Help and invalid input both stop here
+        return ( cmd_parsed_ok == -1 ) ? KI_TEST::RET_CODES::OK : KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    const bool all = cl_parser.Found( "all" );
+    const bool single = cl_parser.Found( "single" );
+
+    long   trackCount = 20000;
+    long   iterations = 10;
+    long   size = 1024;
+    double tilt = 30.0;
+
+    cl_parser.Found( "tracks", &trackCount );
+    cl_parser.Found( "iterations", &iterations );
+    cl_parser.Found( "size", &size );
+    cl_parser.Found( "tilt", &tilt );
+
+    if( trackCount < 0 || iterations < 1 || size < RAYPACKET_DIM )
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+
+    // The 2D objects keep a reference to a board item
+    BOARD dummyBoard;
+
+    PROF_COUNTER buildTimer;
+
+    BENCH_SCENE scene( dummyBoard, trackCount );
+    CBVH_PBRT   accelerator( scene.GetObjects() );
+
+    buildTimer.Stop();
+
+    std::cout << "Scene: " << scene.GetObjects().GetList().size() << " objects, built in "
+              << buildTimer.msecs() << " ms" << std::endl;
+
+    CTRACK_BALL camera( RANGE_SCALE_3D );
+
+    camera.SetCurWindowSize( wxSize( size, size ) );
+    camera.RotateX( DEG2RAD( -tilt ) );
+
+    std::vector<RAYPACKET> packets;
+    packets.reserve( ( size / RAYPACKET_DIM ) * ( size / RAYPACKET_DIM ) );
+
+    for( int y = 0; y + RAYPACKET_DIM <= size; y += RAYPACKET_DIM )
+    {
+        for( int x = 0; x + RAYPACKET_DIM <= size; x += RAYPACKET_DIM )
+            packets.emplace_back( camera, SFVEC2I( x, y ) );
+    }
+
+    const RAYPACKET_SIMD best = RAYPACKET_GetSIMD();
+
+    std::vector<RAYPACKET_SIMD> simds;
+
+    if( all )
+    {
+        for( int simd = RAYPACKET_SIMD_NONE; simd <= best; ++simd )
+            simds.push_back( (RAYPACKET_SIMD) simd );
+    }
+    else
+    {
+        simds.push_back( best );
+    }
+
+    for( RAYPACKET_SIMD simd : simds )
+    {
+        RAYPACKET_SetSIMD( simd );
+
+        PROF_COUNTER timer;
+
+        const size_t hits = tracePackets( accelerator, packets, iterations, single );
+
+        timer.Stop();
+
+        const double rays = (double) packets.size() * RAYPACKET_RAYS_PER_PACKET * iterations;
+
+        std::cout << "SIMD " << simdName( simd ) << ": " << timer.msecs() << " ms, "
+                  << rays / ( timer.msecs() * 1e3 ) << " Mrays/s, "
+                  << hits << " hits per frame" << std::endl;
+    }
+
+    RAYPACKET_SetSIMD( best );
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+/*
+ * Define the tool interface
+ */
+KI_TEST::UTILITY_PROGRAM raytrace_bench_tool = {
+    "raytrace_bench",
+    "Benchmark the ray packet traversal of the 3D raytracer",
+    raytrace_bench_main_func,
+};
@@ -0,0 +1,269 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see CHANGELOG.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include "redraw_bench.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+#include <common.h>
+#include <profile.h>
+
+#include <wx/cmdline.h>
+
+#include <class_board.h>
+#include <class_drawsegment.h>
+#include <class_module.h>
+#include <class_track.h>
+#include <class_zone.h>
+#include <pcb_painter.h>
+#include <pcb_view.h>
+
+#include <gal/cairo/cairo_gal.h>
+#include <gal/gal_display_options.h>
+#include <view/view.h>
+
+#include <pcbnew_utils/board_file_utils.h>
+
+
+/**
+ * A Cairo GAL drawing into an in-memory image surface, so that the drawing code
+ * can be run without a window (and without a display).
+ */
+class CAIRO_IMAGE_GAL : public KIGFX::CAIRO_GAL_BASE
+{
+public:
+    CAIRO_IMAGE_GAL( KIGFX::GAL_DISPLAY_OPTIONS& aOptions, int aWidth, int aHeight ) :
+            CAIRO_GAL_BASE( aOptions )
+    {
+        surface = cairo_image_surface_create( GAL_FORMAT, aWidth, aHeight );
+        context = currentContext = cairo_create( surface );
+        SetScreenSize( VECTOR2I( aWidth, aHeight ) );
+        resetContext();
+    }
+};
+
+
+/**
+ * Redraw statistics accumulated over all the benchmark iterations
+ */
+struct REDRAW_TOTALS
+{
+    KIGFX::VIEW_REDRAW_STATS m_sum;
+    double                   m_minTime = 0.0;
+    double                   m_maxTime = 0.0;
+    int                      m_frames = 0;
+
+    void Add( const KIGFX::VIEW_REDRAW_STATS& aStats )
+    {
+        m_sum.layersDrawn += aStats.layersDrawn;
+        m_sum.itemsQueried += aStats.itemsQueried;
+        m_sum.itemsHidden += aStats.itemsHidden;
+        m_sum.itemsCulledLOD += aStats.itemsCulledLOD;
+        m_sum.itemsDrawnCached += aStats.itemsDrawnCached;
+        m_sum.itemsDrawnImmediate += aStats.itemsDrawnImmediate;
+        m_sum.itemsRecached += aStats.itemsRecached;
+        m_sum.tilesRendered += aStats.tilesRendered;
+        m_sum.tilesPainted += aStats.tilesPainted;
+        m_sum.redrawTime += aStats.redrawTime;
+
+        m_minTime = m_frames ? std::min( m_minTime, aStats.redrawTime ) : aStats.redrawTime;
+        m_maxTime = m_frames ? std::max( m_maxTime, aStats.redrawTime ) : aStats.redrawTime;
+        m_frames++;
+    }
+
+    void Report( std::ostream& aStream ) const
+    {
+        if( !m_frames )
+            return;
+
+        aStream << "Frames: " << m_frames << std::endl;
+        aStream << "Redraw time (ms): avg " << m_sum.redrawTime / m_frames << ", min "
+                << m_minTime << ", max " << m_maxTime << std::endl;
+        aStream << "Per frame: layers " << m_sum.layersDrawn / m_frames
+                << ", queried " << m_sum.itemsQueried / m_frames
+                << ", hidden " << m_sum.itemsHidden / m_frames
+                << ", LOD culled " << m_sum.itemsCulledLOD / m_frames
+                << ", cached " << m_sum.itemsDrawnCached / m_frames
+                << ", immediate " << m_sum.itemsDrawnImmediate / m_frames
+                << ", recached " << m_sum.itemsRecached / m_frames << std::endl;
+        aStream << "Tiles per frame: rendered " << m_sum.tilesRendered / m_frames
+                << ", painted " << m_sum.tilesPainted / m_frames << std::endl;
+    }
+};
+
+
+/**
+ * Add all the drawable items of a board to a view, the same way
+ * PCB_DRAW_PANEL_GAL::DisplayBoard() does
+ */
+static void addBoardToView( BOARD& aBoard, KIGFX::VIEW& aView )
+{
+    for( auto drawing : aBoard.Drawings() )
+        aView.Add( drawing );
+
+    for( auto track : aBoard.Tracks() )
+        aView.Add( track );
+
+    for( auto module : aBoard.Modules() )
+        aView.Add( module );
+
+    for( auto zone : aBoard.Zones() )
+    {
+        zone->CacheTriangulation();
+        aView.Add( zone );
+    }
+}
+
+
+static const wxCmdLineEntryDesc g_cmdLineDesc[] = {
+    { wxCMD_LINE_SWITCH, "h", "help", _( "displays help on the command line parameters" ).mb_str(),
+            wxCMD_LINE_VAL_NONE, wxCMD_LINE_OPTION_HELP },
+    { wxCMD_LINE_SWITCH, "v", "verbose", _( "print the statistics of each frame" ).mb_str() },
+    { wxCMD_LINE_SWITCH, "t", "tiles", _( "draw the layers using the raster tile cache" ).mb_str() },
+    { wxCMD_LINE_OPTION, "i", "iterations", _( "number of redraws (default 10)" ).mb_str(),
+            wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_OPTION, "s", "size", _( "image size in pixels (default 1024)" ).mb_str(),
+            wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_OPTION, "z", "zoom", _( "zoom factor relative to the board fit (default 1)" )
+            .mb_str(), wxCMD_LINE_VAL_DOUBLE },
+    { wxCMD_LINE_PARAM, nullptr, nullptr, _( "input file" ).mb_str(), wxCMD_LINE_VAL_STRING,
+            wxCMD_LINE_PARAM_OPTIONAL },
+    { wxCMD_LINE_NONE }
+};
+
+
+/**
+ * Tool-specific return codes
+ */
+enum REDRAW_BENCH_RET_CODES
+{
+    LOAD_FAILED = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+};
+
+
+int redraw_bench_main_func( int argc, char** argv )
+{
+    wxMessageOutput::Set( new wxMessageOutputStderr );
+    wxCmdLineParser cl_parser( argc, argv );
+    cl_parser.SetDesc( g_cmdLineDesc );
+    cl_parser.AddUsageText(
+            _( "This program loads a PCB file and redraws it repeatedly using the Cairo GAL "
+               "into an offscreen image, and reports the redraw times and statistics. "
+               "This can be used to profile the rendering of large boards without a GPU "
+               "profiler." ) );
+
+    int cmd_parsed_ok = cl_parser.Parse();
+    if( cmd_parsed_ok != 0 )
+    {
+        // Help and invalid input both stop here
+        return ( cmd_parsed_ok == -1 ) ? KI_TEST::RET_CODES::OK : KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    const bool verbose = cl_parser.Found( "verbose" );
+    const bool useTiles = cl_parser.Found( "tiles" );
+
+    long   iterations = 10;
+    long   size = 1024;
+    double zoom = 1.0;
+
+    cl_parser.Found( "iterations", &iterations );
+    cl_parser.Found( "size", &size );
+    cl_parser.Found( "zoom", &zoom );
+
+    if( iterations < 1 || size < 16 || zoom <= 0.0 )
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+
+    std::string filename;
+
+    if( cl_parser.GetParamCount() )
+        filename = cl_parser.GetParam( 0 ).ToStdString();
+
+    std::unique_ptr<BOARD> board = KI_TEST::ReadBoardFromFileOrStream( filename );
+
+    if( !board )
+        return REDRAW_BENCH_RET_CODES::LOAD_FAILED;
+
+    KIGFX::GAL_DISPLAY_OPTIONS options;
+    CAIRO_IMAGE_GAL            gal( options, size, size );
+    KIGFX::PCB_PAINTER         painter( &gal );
+    KIGFX::PCB_VIEW            view( false );
+
+    gal.SetWorldUnitLength( 1e-9 /* 1 nm */ / 0.0254 /* 1 inch in meters */ );
+
+    view.SetGAL( &gal );
+    view.SetPainter( &painter );
+    view.SetUseTileCache( useTiles );
+
+    // Software rendering: no cached layers, like the Cairo canvas
+    for( int i = 0; i < KIGFX::VIEW::VIEW_MAX_LAYERS; ++i )
+    {
+        view.SetLayerVisible( i, true );
+        view.SetLayerTarget( i, KIGFX::TARGET_NONCACHED );
+    }
+
+    addBoardToView( *board, view );
+
+    EDA_RECT bbox = board->GetBoundingBox();
+    view.SetViewport( BOX2D( bbox.GetOrigin(), bbox.GetSize() ) );
+    view.SetScale( view.GetScale() * zoom );
+
+    REDRAW_TOTALS totals;
+
+    for( long ii = 0; ii < iterations; ++ii )
+    {
+        view.MarkDirty();
+
+        {
+            KIGFX::GAL_DRAWING_CONTEXT ctx( &gal );
+            view.Redraw();
+        }
+
+        const KIGFX::VIEW_REDRAW_STATS& stats = view.GetRedrawStats();
+
+        if( verbose )
+        {
+            std::cout << "Frame " << ii << ": " << stats.redrawTime << " ms, "
+                      << stats.itemsQueried << " queried, " << stats.itemsCulledLOD
+                      << " LOD culled, " << stats.itemsDrawnImmediate << " drawn" << std::endl;
+        }
+
+        totals.Add( stats );
+    }
+
+    totals.Report( std::cout );
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+/*
+ * Define the tool interface
+ */
+KI_TEST::UTILITY_PROGRAM redraw_bench_tool = {
+    "redraw_bench",
+    "Benchmark the redraw of a PCB with the Cairo GAL",
+    redraw_bench_main_func,
+};
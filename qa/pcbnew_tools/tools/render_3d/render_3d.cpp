@@ -0,0 +1,178 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see CHANGELOG.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include "render_3d.h"
+
+#include <iostream>
+#include <string>
+
+#include <common.h>
+#include <profile.h>
+#include <reporter.h>
+#include <trigo.h>
+
+#include <wx/cmdline.h>
+#include <wx/image.h>
+
+#include <class_board.h>
+
+#include <3d_canvas/cinfo3d_visu.h>
+#include <3d_rendering/3d_render_raytracing/c3d_render_raytracing.h>
+
+#include <pcbnew_utils/board_file_utils.h>
+
+
+static const wxCmdLineEntryDesc g_cmdLineDesc[] = {
+    { wxCMD_LINE_SWITCH, "h", "help", _( "displays help on the command line parameters" ).mb_str(),
+            wxCMD_LINE_VAL_NONE, wxCMD_LINE_OPTION_HELP },
+    { wxCMD_LINE_SWITCH, "v", "verbose", _( "print the loading and render progress" ).mb_str() },
+    { wxCMD_LINE_SWITCH, "f", "fast", _( "no anti-aliasing and no post processing" ).mb_str() },
+    { wxCMD_LINE_OPTION, "o", "output", _( "output PNG file" ).mb_str(), wxCMD_LINE_VAL_STRING,
+            wxCMD_LINE_OPTION_MANDATORY },
+    { wxCMD_LINE_OPTION, "x", "width", _( "image width in pixels (default 1024)" ).mb_str(),
+            wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_OPTION, "y", "height", _( "image height in pixels (default 768)" ).mb_str(),
+            wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_OPTION, "r", "rotate", _( "rotation around the board normal, in degrees" )
+            .mb_str(), wxCMD_LINE_VAL_DOUBLE },
+    { wxCMD_LINE_OPTION, "t", "tilt", _( "rotation around the horizontal axis, in degrees" )
+            .mb_str(), wxCMD_LINE_VAL_DOUBLE },
+    { wxCMD_LINE_OPTION, "z", "zoom", _( "zoom factor (default 1)" ).mb_str(),
+            wxCMD_LINE_VAL_DOUBLE },
+    { wxCMD_LINE_PARAM, nullptr, nullptr, _( "input file" ).mb_str(), wxCMD_LINE_VAL_STRING,
+            wxCMD_LINE_PARAM_OPTIONAL },
+    { wxCMD_LINE_NONE }
+};
+
+
+/**
+ * Tool-specific return codes
+ */
+enum RENDER_3D_RET_CODES
+{
+    LOAD_FAILED = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+    RENDER_FAILED,
+    SAVE_FAILED,
+};
+
+
+int render_3d_main_func( int argc, char** argv )
+{
+    wxMessageOutput::Set( new wxMessageOutputStderr );
+    wxCmdLineParser cl_parser( argc, argv );
+    cl_parser.SetDesc( g_cmdLineDesc );
+    cl_parser.AddUsageText(
+            _( "This program loads a PCB file and renders it with the 3D raytracer into "
+               "a PNG file. The 3D models are not loaded. The rendering uses all the cores "
+               "and does not need a display or an OpenGL context." ) );
+
+    int cmd_parsed_ok = cl_parser.Parse();
+    if( cmd_parsed_ok != 0 )
+    {
+        // Help and invalid input both stop here
+        return ( cmd_parsed_ok == -1 ) ? KI_TEST::RET_CODES::OK : KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    const bool verbose = cl_parser.Found( "verbose" );
+    const bool fast = cl_parser.Found( "fast" );
+
+    wxString output;
+    long     width = 1024;
+    long     height = 768;
+    double   rotate = 0.0;
+    double   tilt = 0.0;
+    double   zoom = 1.0;
+
+    cl_parser.Found( "output", &output );
+    cl_parser.Found( "width", &width );
+    cl_parser.Found( "height", &height );
+    cl_parser.Found( "rotate", &rotate );
+    cl_parser.Found( "tilt", &tilt );
+    cl_parser.Found( "zoom", &zoom );
+
+    if( width < 1 || height < 1 || zoom <= 0.0 )
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+
+    std::string filename;
+
+    if( cl_parser.GetParamCount() )
+        filename = cl_parser.GetParam( 0 ).ToStdString();
+
+    std::unique_ptr<BOARD> board = KI_TEST::ReadBoardFromFileOrStream( filename );
+
+    if( !board )
+        return RENDER_3D_RET_CODES::LOAD_FAILED;
+
+    CINFO3D_VISU settings;
+
+    settings.SetBoard( board.get() );
+    settings.RenderEngineSet( RENDER_ENGINE_RAYTRACING );
+
+    // The 3D viewer default raytracing options
+    settings.SetFlag( FL_RENDER_RAYTRACING_SHADOWS, true );
+    settings.SetFlag( FL_RENDER_RAYTRACING_REFRACTIONS, true );
+    settings.SetFlag( FL_RENDER_RAYTRACING_REFLECTIONS, true );
+    settings.SetFlag( FL_RENDER_RAYTRACING_PROCEDURAL_TEXTURES, true );
+    settings.SetFlag( FL_RENDER_RAYTRACING_POST_PROCESSING, !fast );
+    settings.SetFlag( FL_RENDER_RAYTRACING_ANTI_ALIASING, !fast );
+
+    CCAMERA& camera = settings.CameraGet();
+
+    camera.RotateZ( DEG2RAD( rotate ) );
+    camera.RotateX( DEG2RAD( tilt ) );
+    camera.Zoom( zoom );
+
+    C3D_RENDER_RAYTRACING renderer( settings );
+    STDOUT_REPORTER       reporter;
+    wxImage               image;
+
+    renderer.ReloadRequest();
+
+    PROF_COUNTER timer;
+
+    if( !renderer.RenderToImage( wxSize( width, height ), image, verbose ? &reporter : nullptr ) )
+        return RENDER_3D_RET_CODES::RENDER_FAILED;
+
+    timer.Stop();
+
+    if( verbose )
+        std::cout << "Total time (load and render): " << timer.msecs() << " ms" << std::endl;
+
+    if( !wxImage::FindHandler( wxBITMAP_TYPE_PNG ) )
+        wxImage::AddHandler( new wxPNGHandler );
+
+    if( !image.SaveFile( output, wxBITMAP_TYPE_PNG ) )
+        return RENDER_3D_RET_CODES::SAVE_FAILED;
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+/*
+ * Define the tool interface
+ */
+KI_TEST::UTILITY_PROGRAM render_3d_tool = {
+    "render_3d",
+    "Render a PCB with the 3D raytracer into a PNG file",
+    render_3d_main_func,
+};
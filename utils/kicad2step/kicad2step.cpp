@@ -27,6 +27,7 @@
 #include <wx/log.h>
 #include <wx/string.h>
 #include <wx/filename.h>
+#include <chrono>
 #include <sstream>
 #include <iostream>
 #include <sstream>
@@ -94,6 +95,19 @@ static const wxCmdLineEntryDesc cmdLineDesc[] =
 wxIMPLEMENT_APP_CONSOLE( KICAD2MCAD );
 
 
+// print the time elapsed since aStart for the given stage and restart the stage timer
+static void reportStageTime( const char* aStage, std::chrono::steady_clock::time_point& aStart )
+{
+    auto now = std::chrono::steady_clock::now();
+    long long ms = std::chrono::duration_cast< std::chrono::milliseconds >( now - aStart ).count();
+
+    std::ostringstream ostr;
+    ostr << "** " << aStage << ": " << ms << " ms";
+    wxLogMessage( "%s", ostr.str().c_str() );
+    aStart = now;
+}
+
+
 bool KICAD2MCAD::OnInit()
 {
 #ifdef SUPPORTS_IGES
@@ -281,8 +295,12 @@ int KICAD2MCAD::OnRun()
     pcb.SetOrigin( m_xOrigin, m_yOrigin );
     pcb.SetMinDistance( m_minDistance );
 
+    auto stageStart = std::chrono::steady_clock::now();
+
     if( pcb.ReadFile( m_filename ) )
     {
+        reportStageTime( "read board", stageStart );
+
         if( m_useDrillOrigin )
             pcb.UseDrillOrigin( true );
 
@@ -294,6 +312,7 @@ int KICAD2MCAD::OnRun()
         try
         {
             pcb.ComposePCB( m_includeVirtual );
+            reportStageTime( "build board and component models", stageStart );
 
         #ifdef SUPPORTS_IGES
             if( m_fmtIGES )
@@ -302,6 +321,8 @@ int KICAD2MCAD::OnRun()
         #endif
                 res = pcb.WriteSTEP( outfile );
 
+            reportStageTime( "write output file", stageStart );
+
             if( !res )
                 return -1;
         }
@@ -22,6 +22,7 @@
  */
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <sstream>
 #include <string>
@@ -68,6 +69,7 @@
 #include <TopoDS_Face.hxx>
 #include <TopoDS_Compound.hxx>
 #include <TopoDS_Builder.hxx>
+#include <TopTools_ListOfShape.hxx>
 
 #include <Standard_Failure.hxx>
 
@@ -656,6 +658,45 @@ void PCBMODEL::SetPCBThickness( double aThickness )
 }
 
 
+// subtract all cutouts from the board in a single boolean operation
+bool PCBMODEL::cutHoles( TopoDS_Shape& aBoard )
+{
+#if ( defined OCC_VERSION_HEX ) && ( OCC_VERSION_HEX >= 0x060900 )
+    TopTools_ListOfShape arguments;
+    TopTools_ListOfShape tools;
+
+    arguments.Append( aBoard );
+
+    for( auto i : m_cutouts )
+        tools.Append( i );
+
+    // the cutouts are passed as separate tools rather than as a single compound
+    // since overlapping holes would make a compound self-interfering
+    BRepAlgoAPI_Cut cut;
+    cut.SetArguments( arguments );
+    cut.SetTools( tools );
+    cut.SetRunParallel( Standard_True );
+    cut.Build();
+
+    if( !cut.IsDone() || cut.Shape().IsNull() )
+    {
+        std::ostringstream ostr;
+#ifdef __WXDEBUG__
+        ostr << __FILE__ << ": " << __FUNCTION__ << ": " << __LINE__ << "\n";
+#endif /* __WXDEBUG */
+        ostr << "  * could not subtract the cutouts at once; subtracting them one by one\n";
+        wxLogMessage( "%s", ostr.str().c_str() );
+        return false;
+    }
+
+    aBoard = cut.Shape();
+    return true;
+#else
+    return false;
+#endif
+}
+
+
 // create the PCB (board only) model using the current outlines and drill holes
 bool PCBMODEL::CreatePCB()
 {
@@ -806,8 +847,23 @@ bool PCBMODEL::CreatePCB()
     }
 
     // subtract cutouts (if any)
-    for( auto i : m_cutouts )
-        board = BRepAlgoAPI_Cut( board, i );
+    if( !m_cutouts.empty() )
+    {
+        auto start = std::chrono::steady_clock::now();
+
+        if( !cutHoles( board ) )
+        {
+            for( auto i : m_cutouts )
+                board = BRepAlgoAPI_Cut( board, i );
+        }
+
+        auto end = std::chrono::steady_clock::now();
+        long long ms = std::chrono::duration_cast< std::chrono::milliseconds >( end - start ).count();
+
+        std::ostringstream ostr;
+        ostr << "  * subtracted " << m_cutouts.size() << " board cutouts in " << ms << " ms";
+        wxLogMessage( "%s", ostr.str().c_str() );
+    }
 
     // push the board to the data structure
     m_pcb_label = m_assy->AddComponent( m_assy_label, board );
@@ -110,6 +110,10 @@ class PCBMODEL
     TDF_Label transferModel( Handle( TDocStd_Document )& source,
         Handle( TDocStd_Document )& dest, TRIPLET aScale );
 
+    // subtract all cutouts from aBoard in a single boolean operation;
+    // returns false if this is not supported or fails (aBoard is unchanged)
+    bool cutHoles( TopoDS_Shape& aBoard );
+
 public:
     PCBMODEL();
     virtual ~PCBMODEL();